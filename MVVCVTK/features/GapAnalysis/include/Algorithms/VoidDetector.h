@@ -5,44 +5,145 @@
 // =====================================================================
 
 #include "VolumeBuffer.h"
+#include "VoxelBitMask.h"
 #include "GapAnalysisTypes.h"
 #include <vtkSMPTools.h>
 #include <vtkMath.h>
 #include <vector>
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <queue>
 #include <map>
 #include <cmath>
 #include <array>
 #include <mutex>
-#include <deque>
 
 // 空洞分析的纯 CPU 流水线；不持有 VTK/服务状态，所有中间 mask 都与输入体素采用
-// x-fast 布局 `x + y*dimX + z*dimX*dimY`。三个公开步骤必须按顺序消费彼此产物。
+// x-fast 布局 `x + y*dimX + z*dimX*dimY`，并以 GapBitMask 每 voxel 1 bit 存放。三个公开步骤必须按顺序消费彼此产物。
 class VoidDetector {
 public:
-    // ── Step 1：从体积六个边界做 6 邻域泛洪；返回 x-fast uint8 mask，1 表示未连通外界的 sub-ISO voxel ──
-    static std::vector<uint8_t> CreateInteriorMask(
+    // ── Step 1：从体积六个边界做 6 邻域泛洪；返回位 mask，置位表示未连通外界的 sub-ISO voxel ──
+    // 泛洪按 z 分块并行，跨块种子逐轮交换至不动点；结果与串行 BFS 逐位一致。
+    static GapBitMask CreateInteriorMask(
         const GapVolumeBuffer& vol,
         float               isoValue);
 
     // ── Step 2：在内部 mask 上应用 grayMax 与六邻域腐蚀，再从幸存种子回长原始候选 ──
+    // 回长与 Step 1 共用分块泛洪引擎；相邻关系保持扁平 offset 语义。
     // 当前只消费 grayMax 与 erosionIterations；grayMin、角度和张量窗口不参与本阶段。
-    static std::vector<uint8_t> BuildCandidates(
+    // 腐蚀按 x/y/z 三组位移按位与逐字处理 64 个 voxel，后续轮次只重算上一轮有变化的字块。
+    static GapBitMask BuildCandidates(
         const GapVolumeBuffer& vol,
-        const std::vector<uint8_t>& interiorMask,
+        const GapBitMask& interiorMask,
         const GapVoidParams& params);
 
     // ── Step 3：按 6 邻域生成连通区域、统计与 x-fast 标签体 ─────────
-    // outLabelVol 会被重建为 dims 乘积个元素；0 为未保留 voxel，正值与返回区域 id 对应。
+    // outLabels 须至少容纳 dims 乘积个元素并被逐个覆写；0 为未保留 voxel，正值与返回区域 id 对应。
+    // 调用方可直接传入最终 VTK_INT 标签图的标量区，避免再持有一份整卷 int 副本。
+    // 区域 id 按各区最小 voxel 序递增，与逐 voxel 扫描 + BFS 的编号一致；标记与统计均分块并行。
     // 当前只消费 minVolumeMM3；未执行结构张量或角度合并。
     static std::vector<VoidRegion> BuildRegions(
         const GapVolumeBuffer& vol,
-        std::vector<uint8_t>& candidateMask,
+        const GapBitMask& candidateMask,
+        const GapVoidParams& params,
+        int* outLabels);
+    // outLabelVol 会被重建为 dims 乘积个元素。
+    static std::vector<VoidRegion> BuildRegions(
+        const GapVolumeBuffer& vol,
+        const GapBitMask& candidateMask,
         const GapVoidParams& params,
         std::vector<int>& outLabelVol);
 
 private:
+    // 外部泛洪与连通标记分块的最少 voxel 数；块按整 slice 切分，与线程数无关，统计累加次序因而可复现。
+    static constexpr size_t kSlabVoxels = size_t{ 1 } << 18;
+
+    // 腐蚀脏块的字数（64K voxel）；块只决定跳过粒度，不影响结果。
+    static constexpr size_t kErosionBlockWords = 1024;
+
+    // 分块泛洪引擎：z 向分块并行，各块从本块种子出发做栈式泛洪，越出本块的邻居转交相邻块，
+    // 逐轮交换直至不再产生跨块种子；可达集合与分块、线程数无关。块首须对齐到 mask 字边界。
+    // seedSlab(slab, stack) 首轮压入本块已标记的种子；markNode(node) 标记并返回是否新标记，只在节点所属块内调用；
+    // expandNode(slab, node, push, lowerOut, upperOut) 枚举邻居：块内的交 push，越出下/上界的放入对应转交槽。
+    template <typename Node, typename SeedFn, typename MarkFn, typename ExpandFn>
+    static void SetSlabFlood(
+        size_t slabCount,
+        SeedFn&& seedSlab,
+        MarkFn&& markNode,
+        ExpandFn&& expandNode);
+
+    // 每块的 slice 数：不少于 kSlabVoxels，且块首 voxel 序是 64 的倍数，使各块写入的 mask 字互不重叠。
+    static size_t GetSlabSlices(size_t slice) noexcept;
+
+    // Step 1 按原生标量类型展开的实现；data 即 vol.voxelsPtr，灰度与 iso 比较时提升为 float。
+    template <typename T>
+    static GapBitMask CreateInteriorMask(
+        const GapVolumeBuffer& vol,
+        const T* data,
+        float isoValue);
+
+    // 单个临时标签或区域的一阶/二阶矩、灰度极值与 bbox；标记扫描时逐 voxel 累加，
+    // 区域统计只需按标签序合并，无需再按区域收集 voxel 序。坐标矩按无 origin 的 physical offset 累加。
+    struct RegionMoments {
+        std::uint64_t voxelCount = 0;
+        size_t seed = 0; // 最小 voxel 序，即旧 BFS 的种子
+        double sumX = 0, sumY = 0, sumZ = 0;
+        double sumXX = 0, sumYY = 0, sumZZ = 0;
+        double sumXY = 0, sumXZ = 0, sumYZ = 0;
+        double sumGray = 0, sumGraySq = 0;
+        double minGray = 1e9, maxGray = -1e9;
+        std::array<int, 6> bbox = { 0, 0, 0, 0, 0, 0 };
+
+        // 扫描序递增，首个 voxel 即 seed。
+        void SetVoxel(size_t index, int x, int y, int z,
+            const std::array<double, 3>& spacing, double gray) noexcept;
+        void SetMerged(const RegionMoments& other) noexcept;
+    };
+
+    // 分块并查集标记结果。临时标签 = 块偏移 + 块内标签 - 1，按首个 voxel 序递增；
+    // 标签体此时存块内标签，由 BuildRegions 回写为最终 id。
+    struct RegionLabels {
+        size_t slabSlices = 1;
+        std::vector<std::uint64_t> labelOffsets;     // 各块首个临时标签，末项为总数
+        std::vector<RegionMoments> labelMoments;     // 各临时标签直接覆盖 voxel 的矩
+        std::vector<std::uint64_t> labelComponents;  // 临时标签 -> 连通分量序号（按最小 voxel 序）
+        size_t componentCount = 0;
+    };
+
+    // dst[w] &= 源位序列自 64w+offset 起的 64 位，w 取 [begin, end)；越出源数组的位读作 0。
+    static void SetShiftedAnd(
+        std::uint64_t* dst,
+        const std::uint64_t* src,
+        size_t wordCount,
+        size_t begin,
+        size_t end,
+        long long offset) noexcept;
+    // 对 rawMask 做 iterations 轮六邻域腐蚀；只处理 x/y/z 均在 [1, d-2] 的 voxel，与逐 voxel 实现逐位一致。
+    static GapBitMask BuildErodedMask(
+        const std::array<int, 3>& dims,
+        const GapBitMask& rawMask,
+        int iterations);
+
+    static RegionLabels BuildRegionLabels(
+        const GapVolumeBuffer& vol,
+        const GapBitMask& candidateMask,
+        int* labelVol);
+    // 无锁并查集：父指针只指向更小标签，根即集合最小标签。
+    static std::uint64_t GetLabelRoot(
+        std::vector<std::atomic<std::uint64_t>>& parents,
+        std::uint64_t label) noexcept;
+    static void SetLabelUnion(
+        std::vector<std::atomic<std::uint64_t>>& parents,
+        std::uint64_t left,
+        std::uint64_t right) noexcept;
+    // 单个保留区的灰度、bbox、PCA、投影面积与近似表面积；labelVol 须已是最终 id。
+    // 矩来自标记扫描；投影与表面穿越只在区域 bbox 内按 labelVol 逐 voxel 判定。
+    static void SetRegionStatistics(
+        const GapVolumeBuffer& vol,
+        const int* labelVol,
+        const RegionMoments& moments,
+        VoidRegion& region);
+
     /*static std::array<float, 3> GetPrincipalDirection(
         const VolumeBuffer& vol, int x, int y, int z, int window) noexcept;*/
 };
@@ -73,448 +174,933 @@ private:
 //    };
 //}
 
-inline std::vector<uint8_t> VoidDetector::CreateInteriorMask(
+inline size_t VoidDetector::GetSlabSlices(size_t slice) noexcept
+{
+    // slice 与 64 的最大公因子 g 决定对齐步长 64/g：块 slice 数取该步长的倍数，块首即落在字边界。
+    size_t common = 1;
+    while (common < GapBitMask::kWordBits && slice % (common * 2) == 0) {
+        common *= 2;
+    }
+    const size_t step = GapBitMask::kWordBits / common;
+    const size_t slabSlices = std::max<size_t>(1, (kSlabVoxels + slice - 1) / slice);
+    return (slabSlices + step - 1) / step * step;
+}
+
+template <typename Node, typename SeedFn, typename MarkFn, typename ExpandFn>
+inline void VoidDetector::SetSlabFlood(
+    size_t slabCount,
+    SeedFn&& seedSlab,
+    MarkFn&& markNode,
+    ExpandFn&& expandNode)
+{
+    // 跨块种子按轮次双缓冲：本轮各块只写自己的 [cur] 槽、只读相邻块的 [prev] 槽；
+    // 下界槽交给 slab-1，上界槽交给 slab+1。mask 只在本块范围内读写，块间无需加锁。
+    std::array<std::vector<std::vector<Node>>, 2> toLower;
+    std::array<std::vector<std::vector<Node>>, 2> toUpper;
+    for (size_t buffer = 0; buffer < 2; ++buffer) {
+        toLower[buffer].resize(slabCount);
+        toUpper[buffer].resize(slabCount);
+    }
+
+    for (size_t round = 0;; ++round) {
+        const size_t cur = round & 1;
+        const size_t prev = cur ^ 1;
+        vtkSMPTools::For(0, static_cast<vtkIdType>(slabCount),
+            [&](vtkIdType first, vtkIdType last) {
+                std::vector<Node> stack;
+                for (vtkIdType slabId = first; slabId < last; ++slabId) {
+                    const size_t slab = (size_t)slabId;
+                    auto& lowerOut = toLower[cur][slab];
+                    auto& upperOut = toUpper[cur][slab];
+                    lowerOut.clear();
+                    upperOut.clear();
+                    stack.clear();
+                    const auto push = [&](const Node& node) {
+                        if (markNode(node)) {
+                            stack.push_back(node);
+                        }
+                    };
+
+                    if (round == 0) {
+                        seedSlab(slab, stack);
+                    }
+                    else {
+                        // 上一轮相邻块递来的邻居；重复或已被本块泛洪到的由 markNode 去重。
+                        if (slab > 0) {
+                            for (const Node& node : toUpper[prev][slab - 1]) {
+                                push(node);
+                            }
+                        }
+                        if (slab + 1 < slabCount) {
+                            for (const Node& node : toLower[prev][slab + 1]) {
+                                push(node);
+                            }
+                        }
+                    }
+
+                    while (!stack.empty()) {
+                        const Node node = stack.back();
+                        stack.pop_back();
+                        expandNode(slab, node, push, lowerOut, upperOut);
+                    }
+                }
+            });
+
+        bool hasSeeds = false;
+        for (size_t slab = 0; slab < slabCount && !hasSeeds; ++slab) {
+            hasSeeds = !toLower[cur][slab].empty() || !toUpper[cur][slab].empty();
+        }
+        if (!hasSeeds) {
+            break;
+        }
+    }
+}
+
+inline GapBitMask VoidDetector::CreateInteriorMask(
     const GapVolumeBuffer& vol, float isoValue)
 {
-    // 路径：六个体边界的 sub-ISO voxel 入队 -> 6 邻域泛洪标记 exterior ->
+    return vol.VisitVoxels([&](const auto* data) {
+        return CreateInteriorMask(vol, data, isoValue);
+    });
+}
+
+template <typename T>
+GapBitMask VoidDetector::CreateInteriorMask(
+    const GapVolumeBuffer& vol, const T* data, float isoValue)
+{
+    // 路径：经 SetSlabFlood 按 z 分块，各块并行从本块种子（无效 voxel 与六个体边界的开放 voxel）做 6 邻域泛洪 ->
+    // 越过块上下界的开放邻居交给相邻块作下一轮种子，直至某轮不再产生跨块种子 ->
     // 反转语义，仅保留“低于 iso 且无法连通边界”的内部空隙。
+    // exterior 是开放 voxel 上自种子可达的集合，与泛洪次序、分块和线程数无关，结果与串行 BFS 逐位一致。
     const int    dx = vol.dims[0];
     const int    dy = vol.dims[1];
     const int    dz = vol.dims[2];
 
     const size_t slice = (size_t)dx * dy;
     const size_t total = slice * dz;
-    const float* data = vol.voxelsPtr;
 
-    std::vector<uint8_t> exterior(total, 0);
+    GapBitMask exterior(total);
+    if (total == 0) {
+        return exterior;
+    }
 
     struct QNode {
-        // x-fast 扁平 offset，与同一节点的 [x, y, z] index 成对缓存以加速边界分支。
+        // x-fast 扁平 offset，与同一节点的 [x, y, z] index 成对缓存，越界判断无需除法还原坐标。
         size_t idx;
         int x, y, z;
     };
 
-    std::deque<QNode> q;
-
     const auto getOpen = [&](size_t idx) {
         return !vol.GetVoxelValid(idx) || data[idx] < isoValue;
     };
-    auto pushNode = [&](int x, int y, int z) {
-        size_t idx = (size_t)x + (size_t)y * dx + (size_t)z * slice;
-        if (getOpen(idx) && exterior[idx] == 0) {
-            exterior[idx] = 1;
-            q.push_back({ idx, x, y, z });
+
+    const size_t slabSlices = GetSlabSlices(slice);
+    const size_t slabCount = ((size_t)dz + slabSlices - 1) / slabSlices;
+    const auto markNode = [&exterior](const QNode& node) {
+        if (exterior.GetBit(node.idx)) {
+            return false;
         }
-        };
+        exterior.SetBit(node.idx);
+        return true;
+    };
 
     // 1. mask=0 表示分析域外；每个无效 voxel 都是 exterior 种子，使与裁切边界相邻的
-    // 低灰度有效 voxel 能连通域外，而不会被误判为封闭孔隙。
-    for (int z = 0; z < dz; ++z) {
-        for (int y = 0; y < dy; ++y) {
-            for (int x = 0; x < dx; ++x) {
-                const size_t idx = (size_t)x
-                    + (size_t)y * dx
-                    + (size_t)z * slice;
-                if (!vol.GetVoxelValid(idx)) {
-                    pushNode(x, y, z);
+    // 低灰度有效 voxel 能连通域外，而不会被误判为封闭孔隙。六个面上的开放 voxel 同为种子。
+    const auto seedSlab = [&](size_t slab, std::vector<QNode>& stack) {
+        const int zBegin = static_cast<int>(slab * slabSlices);
+        const int zEnd = static_cast<int>(std::min<size_t>(dz, (slab + 1) * slabSlices));
+        for (int z = zBegin; z < zEnd; ++z) {
+            const bool isZFace = z == 0 || z == dz - 1;
+            for (int y = 0; y < dy; ++y) {
+                const bool isYFace = isZFace || y == 0 || y == dy - 1;
+                size_t idx = (size_t)y * dx + (size_t)z * slice;
+                for (int x = 0; x < dx; ++x, ++idx) {
+                    const bool isFace = isYFace || x == 0 || x == dx - 1;
+                    if ((!vol.GetVoxelValid(idx) || (isFace && data[idx] < isoValue))
+                        && markNode({ idx, x, y, z })) {
+                        stack.push_back({ idx, x, y, z });
+                    }
                 }
             }
         }
-    }
+    };
+
+    // 2. 块内 6 邻域泛洪；邻居按 x/y/z 检查后再计算 offset，避免无符号减法越界或跨行回绕。
+    const int dxs[6] = { 1, -1, 0, 0, 0, 0 };
+    const int dys[6] = { 0, 0, 1, -1, 0, 0 };
+    const int dzs[6] = { 0, 0, 0, 0, 1, -1 };
+    const auto expandNode = [&](size_t slab, const QNode& curr, const auto& push,
+        std::vector<QNode>& lowerOut, std::vector<QNode>& upperOut) {
+        const int zBegin = static_cast<int>(slab * slabSlices);
+        const int zEnd = static_cast<int>(std::min<size_t>(dz, (slab + 1) * slabSlices));
+        for (int k = 0; k < 6; ++k) {
+            const int nx = curr.x + dxs[k];
+            const int ny = curr.y + dys[k];
+            const int nz = curr.z + dzs[k];
+            if (nx < 0 || nx >= dx || ny < 0 || ny >= dy || nz < 0 || nz >= dz) {
+                continue;
+            }
+            const size_t nidx = (size_t)nx + (size_t)ny * dx + (size_t)nz * slice;
+            if (!getOpen(nidx)) {
+                continue;
+            }
+            // 相邻块的 exterior 归对方写；这里只按只读的灰度/mask 判断开放性后转交。
+            if (nz < zBegin) {
+                lowerOut.push_back({ nidx, nx, ny, nz });
+            }
+            else if (nz >= zEnd) {
+                upperOut.push_back({ nidx, nx, ny, nz });
+            }
+            else {
+                push({ nidx, nx, ny, nz });
+            }
+        }
+    };
+    SetSlabFlood<QNode>(slabCount, seedSlab, markNode, expandNode);
+
+    // 3. 反转为内部孔隙：逐字拼出“有效且低于 iso”的位，再扣掉 exterior；字间独立，直接按区间并行。
+    std::uint64_t* words = exterior.GetWords();
+    vtkSMPTools::For(0, static_cast<vtkIdType>(exterior.GetWordCount()),
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType word = first; word < last; ++word) {
+                const size_t begin = (size_t)word * GapBitMask::kWordBits;
+                const size_t count = std::min(GapBitMask::kWordBits, total - begin);
+                std::uint64_t subIso = 0;
+                for (size_t bit = 0; bit < count; ++bit) {
+                    if (vol.GetVoxelValid(begin + bit) && data[begin + bit] < isoValue) {
+                        subIso |= std::uint64_t{ 1 } << bit;
+                    }
+                }
+                words[word] = subIso & ~words[word]; // 置位为内部孔隙，其余为固体或外部空气
+            }
+        });
+
+    return exterior;
+}
 
-    // 2. 六个面分三组扫描；边/角允许重复调用，但 exterior 门铃保证只入队一次。
-    for (int y = 0; y < dy; ++y) {
-        for (int x = 0; x < dx; ++x) {
-            pushNode(x, y, 0);
-            pushNode(x, y, dz - 1);
+inline void VoidDetector::SetShiftedAnd(
+    std::uint64_t* dst,
+    const std::uint64_t* src,
+    size_t wordCount,
+    size_t begin,
+    size_t end,
+    long long offset) noexcept
+{
+    // 字 w 的邻居字取源位序列自 64w+offset 起的 64 位：拆为整字位移 shiftWords 与字内位移 shiftBits。
+    const long long wordBits = (long long)GapBitMask::kWordBits;
+    const long long shiftWords = offset >= 0 ? offset / wordBits : -((-offset + wordBits - 1) / wordBits);
+    const unsigned shiftBits = static_cast<unsigned>(offset - shiftWords * wordBits);
+    const long long count = (long long)wordCount;
+    const auto getWord = [&](long long word) -> std::uint64_t {
+        const long long low = word + shiftWords;
+        const std::uint64_t lowBits = low >= 0 && low < count ? src[low] : 0;
+        if (shiftBits == 0) {
+            return lowBits;
         }
+        const std::uint64_t highBits = low + 1 >= 0 && low + 1 < count ? src[low + 1] : 0;
+        return (lowBits >> shiftBits) | (highBits << (GapBitMask::kWordBits - shiftBits));
+    };
+
+    // 两个源字都落在数组内的区间走无分支直线循环，便于编译器展开为 SIMD 移位与按位与；
+    // 只有靠近体首尾的少数字走逐字越界检查。
+    const long long fastBegin = std::max((long long)begin, -shiftWords);
+    const long long fastEnd = std::min((long long)end, count - shiftWords - (shiftBits == 0 ? 0 : 1));
+    long long word = (long long)begin;
+    for (; word < std::min(fastBegin, (long long)end); ++word) {
+        dst[word] &= getWord(word);
     }
-    for (int z = 1; z < dz - 1; ++z) {
-        for (int y = 0; y < dy; ++y) {
-            pushNode(0, y, z);
-            pushNode(dx - 1, y, z);
+    if (shiftBits == 0) {
+        for (; word < fastEnd; ++word) {
+            dst[word] &= src[word + shiftWords];
         }
     }
-    for (int z = 1; z < dz - 1; ++z) {
-        for (int x = 1; x < dx - 1; ++x) {
-            pushNode(x, 0, z);
-            pushNode(x, dy - 1, z);
+    else {
+        const unsigned highShift = GapBitMask::kWordBits - shiftBits;
+        for (; word < fastEnd; ++word) {
+            dst[word] &= (src[word + shiftWords] >> shiftBits) | (src[word + shiftWords + 1] << highShift);
         }
     }
+    for (; word < (long long)end; ++word) {
+        dst[word] &= getWord(word);
+    }
+}
 
-    const size_t off[6] = { 1,static_cast<size_t>(0) - 1,          // 代替 (size_t)-1
-    static_cast<size_t>(dx),
-    static_cast<size_t>(0) - static_cast<size_t>(dx),   // 代替 (size_t)-dx
-    slice,
-    static_cast<size_t>(0) - slice       // 代替 (size_t)-slice
-    };
-    const int dxs[6] = { 1, -1, 0, 0, 0, 0 };
-    const int dys[6] = { 0, 0, 1, -1, 0, 0 };
-    const int dzs[6] = { 0, 0, 0, 0, 1, -1 };
+inline GapBitMask VoidDetector::BuildErodedMask(
+    const std::array<int, 3>& dims,
+    const GapBitMask& rawMask,
+    int iterations)
+{
+    // 路径：六邻域腐蚀 = 当前 & 定义域 & x/y/z 三组 ±offset 位移的可分离按位与 ->
+    // 按字块记录每轮输出是否变化，下一轮只重算依赖范围内有变化的块 -> 两个缓冲按轮乒乓，不复制 raw。
+    // 腐蚀只作用于 x/y/z 均在 [1, d-2] 的 voxel，外壳一轮即清零；该定义域预先做成位 mask。
+    const int dx = dims[0];
+    const int dy = dims[1];
+    const int dz = dims[2];
+    const size_t slice = (size_t)dx * dy;
+    const size_t total = slice * dz;
 
-    while (!q.empty()) {
-        QNode curr = q.front();
-        q.pop_front();
-
-        if (curr.x > 0 && curr.x < dx - 1 && curr.y > 0 && curr.y < dy - 1 && curr.z > 0 && curr.z < dz - 1) {
-            // 内部节点可安全使用预计算扁平 offset；坐标随同更新，供其进入边界时切换安全分支。
-            for (int k = 0; k < 6; ++k) {
-                size_t nidx = curr.idx + off[k];
-                if (exterior[nidx] == 0 && getOpen(nidx)) {
-                    exterior[nidx] = 1;
-                    q.push_back({ nidx, curr.x + dxs[k], curr.y + dys[k], curr.z + dzs[k] });
-                }
-            }
-        }
-        else {
-            // 边界节点必须按 x/y/z 检查后重新计算 offset，避免无符号减法越界或跨行回绕。
-            for (int k = 0; k < 6; ++k) {
-                int nx = curr.x + dxs[k];
-                int ny = curr.y + dys[k];
-                int nz = curr.z + dzs[k];
-                if (nx >= 0 && nx < dx && ny >= 0 && ny < dy && nz >= 0 && nz < dz) {
-                    size_t nidx = (size_t)nx + (size_t)ny * dx + (size_t)nz * slice;
-                    if (exterior[nidx] == 0 && getOpen(nidx)) {
-                        exterior[nidx] = 1;
-                        q.push_back({ nidx, nx, ny, nz });
-                    }
-                }
+    GapBitMask domain(total);
+    if (dx > 2) {
+        for (int z = 1; z < dz - 1; ++z) {
+            for (int y = 1; y < dy - 1; ++y) {
+                const size_t rowBegin = (size_t)z * slice + (size_t)y * dx;
+                domain.SetRange(rowBegin + 1, rowBegin + (size_t)dx - 1);
             }
         }
     }
+    const std::array<long long, 6> offsets = { 1, -1, (long long)dx, -(long long)dx,
+                                               (long long)slice, -(long long)slice };
 
-    for (long long i = 0; i < (long long)total; ++i) {
-        if (vol.GetVoxelValid(static_cast<size_t>(i))
-            && data[i] < isoValue
-            && exterior[i] == 0) {
-            exterior[i] = 1; // 内部孔隙
+    // 一字输出只依赖前后 slice/64 + 1 字内的输入；块的依赖范围据此折算为前后 reachBlocks 块。
+    const size_t wordCount = rawMask.GetWordCount();
+    const size_t blockCount = (wordCount + kErosionBlockWords - 1) / kErosionBlockWords;
+    const size_t reachBlocks = (slice / GapBitMask::kWordBits + 1 + kErosionBlockWords - 1) / kErosionBlockWords;
+    std::vector<uint8_t> isChanged(blockCount, 1);
+    std::vector<uint8_t> isChangedNext(blockCount, 0);
+    std::vector<size_t> changedPrefix(blockCount + 1, 0);
+
+    // 乒乓约定：第 k 轮读 current、写 next，next 中存的是第 k-2 轮输出。
+    // 输入依赖范围未变的块，其输出等于上一轮输出；而该块上一轮也未变，next 已存同值，可整块跳过。
+    // 唯一例外是第 2 轮：next 尚未写过，跳过的块须从 current 整块拷贝。
+    std::array<GapBitMask, 2> buffers = { GapBitMask(total), GapBitMask() };
+    const GapBitMask* current = &rawMask;
+    for (int iter = 0; iter < iterations; ++iter) {
+        GapBitMask* next = &buffers[(size_t)iter & 1];
+        if (iter == 1) {
+            *next = GapBitMask(total);
         }
-        else {
-            exterior[i] = 0; // 固体或外部空气
+        for (size_t block = 0; block < blockCount; ++block) {
+            changedPrefix[block + 1] = changedPrefix[block] + isChanged[block];
+        }
+        if (changedPrefix[blockCount] == 0) {
+            break; // 已到不动点，后续轮次输出不变
         }
-    }
 
-    return exterior;
+        const std::uint64_t* currentWords = current->GetWords();
+        const std::uint64_t* domainWords = domain.GetWords();
+        std::uint64_t* nextWords = next->GetWords();
+        vtkSMPTools::For(0, static_cast<vtkIdType>(blockCount),
+            [&](vtkIdType first, vtkIdType last) {
+                for (vtkIdType blockId = first; blockId < last; ++blockId) {
+                    const size_t block = (size_t)blockId;
+                    const size_t begin = block * kErosionBlockWords;
+                    const size_t end = std::min(wordCount, begin + kErosionBlockWords);
+                    const size_t reachBegin = block > reachBlocks ? block - reachBlocks : 0;
+                    const size_t reachEnd = std::min(blockCount, block + reachBlocks + 1);
+                    if (changedPrefix[reachEnd] == changedPrefix[reachBegin]) {
+                        if (iter == 1) {
+                            std::copy(currentWords + begin, currentWords + end, nextWords + begin);
+                        }
+                        isChangedNext[block] = 0;
+                        continue;
+                    }
+                    for (size_t word = begin; word < end; ++word) {
+                        nextWords[word] = currentWords[word] & domainWords[word];
+                    }
+                    for (const long long offset : offsets) {
+                        SetShiftedAnd(nextWords, currentWords, wordCount, begin, end, offset);
+                    }
+                    isChangedNext[block] = std::equal(
+                        nextWords + begin, nextWords + end, currentWords + begin) ? 0 : 1;
+                }
+            });
+
+        std::swap(isChanged, isChangedNext);
+        current = next;
+    }
+    if (current == &rawMask) {
+        return rawMask;
+    }
+    return std::move(current == &buffers[0] ? buffers[0] : buffers[1]);
 }
 
-inline std::vector<uint8_t> VoidDetector::BuildCandidates(
+inline GapBitMask VoidDetector::BuildCandidates(
     const GapVolumeBuffer& vol,
-    const std::vector<uint8_t>& interiorMask,
+    const GapBitMask& interiorMask,
     const GapVoidParams& params)
 {
     // 路径：interior 与 grayMax 求交 -> N 轮六邻域腐蚀得到稳定种子 ->
-    // 沿原始 raw mask 回长，恢复与稳定种子连通的完整候选区域。
+    // 沿原始 raw mask 分块并行回长（测地重建），恢复与稳定种子连通的完整候选区域。
     const int dx = vol.dims[0];
     const int dy = vol.dims[1];
     const int dz = vol.dims[2];
     const size_t slice = (size_t)dx * dy;
     const size_t total = slice * dz;
 
-    std::vector<uint8_t> raw_mask(total, 0);
-
-    vtkSMPTools::For(0, static_cast<vtkIdType>(total),
-        [&](vtkIdType begin, vtkIdType end) {
-            for (vtkIdType i = begin; i < end; ++i) {
-                if (vol.GetVoxelValid(static_cast<size_t>(i))
-                    && interiorMask[i] > 0
-                    && vol.voxelsPtr[i] <= params.grayMax) {
-                    raw_mask[i] = 1;
-                }
-            }
-        });
-
-    const int erosionIterations = params.erosionIterations;
-    std::vector<uint8_t> eroded = raw_mask;
-    std::vector<uint8_t> eroded_next(total, 0);
-
-    for (int iter = 0; iter < erosionIterations; ++iter) {
-        std::fill(eroded_next.begin(), eroded_next.end(), 0);
-        vtkSMPTools::For(1, dz - 1, [&](vtkIdType begin, vtkIdType end) {
-            for (int z = begin; z < end; ++z) {
-                for (int y = 1; y < dy - 1; ++y) {
-                    for (int x = 1; x < dx - 1; ++x) {
-                        size_t idx = (size_t)z * slice + (size_t)y * dx + (size_t)x;
-                        if (eroded[idx] &&
-                            eroded[idx + 1] && eroded[idx - 1] &&
-                            eroded[idx + dx] && eroded[idx - dx] &&
-                            eroded[idx + slice] && eroded[idx - slice]) {
-                            eroded_next[idx] = 1;
+    // 1. 只有 interior 置位的 voxel 才需读灰度；全零字直接跳过。类型分支在整卷粒度展开一次。
+    GapBitMask raw_mask(total);
+    vol.VisitVoxels([&](const auto* data) {
+        const std::uint64_t* interiorWords = interiorMask.GetWords();
+        std::uint64_t* rawWords = raw_mask.GetWords();
+        vtkSMPTools::For(0, static_cast<vtkIdType>(raw_mask.GetWordCount()),
+            [&](vtkIdType first, vtkIdType last) {
+                for (vtkIdType word = first; word < last; ++word) {
+                    const std::uint64_t interiorBits = interiorWords[word];
+                    if (interiorBits == 0) {
+                        continue;
+                    }
+                    const size_t begin = (size_t)word * GapBitMask::kWordBits;
+                    std::uint64_t rawBits = 0;
+                    for (size_t bit = 0; bit < GapBitMask::kWordBits; ++bit) {
+                        if (((interiorBits >> bit) & 1u) != 0
+                            && vol.GetVoxelValid(begin + bit)
+                            && data[begin + bit] <= params.grayMax) {
+                            rawBits |= std::uint64_t{ 1 } << bit;
                         }
                     }
+                    rawWords[word] = rawBits;
                 }
-            }
             });
-        std::swap(eroded, eroded_next);
-    }
+    });
 
-    std::vector<uint8_t> candidates(total, 0);
-    std::queue<size_t> bfsQueue;
-
-    for (size_t i = 0; i < total; ++i) {
-        if (eroded[i]) {
-            bfsQueue.push(i);
-            candidates[i] = 1;
-        }
+    // 2. N 轮六邻域腐蚀得到稳定种子；无腐蚀时种子即 raw_mask，回长不会再增加 voxel。
+    const int erosionIterations = params.erosionIterations;
+    if (erosionIterations <= 0) {
+        return raw_mask;
     }
-
+    GapBitMask eroded = BuildErodedMask(vol.dims, raw_mask, erosionIterations);
+
+    // 3. 从稳定种子沿 raw_mask 回长：腐蚀结果是 raw_mask 的子集，直接作为候选初值。
+    // 只有邻接“raw 但非种子” voxel 的种子才需展开：逐字把该集合按六个 offset 反向位移后求或（一次字级膨胀），
+    // 与种子字求与即得前沿；其余种子的 raw 邻居都已是种子，展开不会新增 voxel。
+    GapBitMask candidates = eroded;
+    const size_t slabSlices = GetSlabSlices(slice);
+    const size_t slabCount = ((size_t)dz + slabSlices - 1) / slabSlices;
+    const size_t slabVoxels = slabSlices * slice;
     const std::array<long long, 6> offsets = { 1, -1, (long long)dx, -(long long)dx,
                                                (long long)slice, -(long long)slice };
+    const auto markNode = [&candidates](size_t idx) {
+        if (candidates.GetBit(idx)) {
+            return false;
+        }
+        candidates.SetBit(idx);
+        return true;
+    };
+    const auto seedSlab = [&](size_t slab, std::vector<size_t>& stack) {
+        const size_t begin = slab * slabVoxels;
+        const size_t end = std::min(total, begin + slabVoxels);
+        const size_t wordEnd = (end + GapBitMask::kWordBits - 1) / GapBitMask::kWordBits;
+        const std::uint64_t* seedWords = eroded.GetWords();
+        for (size_t word = begin / GapBitMask::kWordBits; word < wordEnd; ++word) {
+            const std::uint64_t seedBits = seedWords[word];
+            if (seedBits == 0) {
+                continue;
+            }
+            const long long wordBegin = (long long)(word * GapBitMask::kWordBits);
+            std::uint64_t growBits = 0;
+            for (const long long off : offsets) {
+                growBits |= raw_mask.GetWordAt(wordBegin + off) & ~eroded.GetWordAt(wordBegin + off);
+            }
+            const std::uint64_t frontBits = seedBits & growBits;
+            for (size_t bit = 0; frontBits != 0 && bit < GapBitMask::kWordBits; ++bit) {
+                if (((frontBits >> bit) & 1u) != 0) {
+                    stack.push_back(word * GapBitMask::kWordBits + bit);
+                }
+            }
+        }
+    };
     // [实现边界] 回长沿扁平 offset 检查 `nb < total`，没有同步检查 x/y/z；
     // 因而这里描述的是现有扁平相邻实现，不能把结果解释为经过严格坐标边界裁剪的 6 邻域。
-    while (!bfsQueue.empty()) {
-        size_t cur = bfsQueue.front();
-        bfsQueue.pop();
-        for (long long off : offsets) {
-            size_t nb = (size_t)((long long)cur + off);
-            if (nb < total && raw_mask[nb] && !candidates[nb]) {
-                candidates[nb] = 1;
-                bfsQueue.push(nb);
+    // 各 offset 不超过一个 slice，越出本块的邻居只会落在相邻块。
+    const auto expandNode = [&](size_t slab, size_t cur, const auto& push,
+        std::vector<size_t>& lowerOut, std::vector<size_t>& upperOut) {
+        const size_t begin = slab * slabVoxels;
+        const size_t end = std::min(total, begin + slabVoxels);
+        for (const long long off : offsets) {
+            const size_t nb = (size_t)((long long)cur + off);
+            if (nb >= total || !raw_mask.GetBit(nb)) {
+                continue;
+            }
+            if (nb < begin) {
+                lowerOut.push_back(nb);
+            }
+            else if (nb >= end) {
+                upperOut.push_back(nb);
+            }
+            else {
+                push(nb);
             }
         }
-    }
+    };
+    SetSlabFlood<size_t>(slabCount, seedSlab, markNode, expandNode);
     return candidates;
 }
 
-inline std::vector<VoidRegion> VoidDetector::BuildRegions(
+inline void VoidDetector::RegionMoments::SetVoxel(
+    size_t index, int x, int y, int z,
+    const std::array<double, 3>& spacing, double gray) noexcept
+{
+    if (voxelCount++ == 0) {
+        seed = index;
+        bbox = { x, x, y, y, z, z };
+    }
+    else {
+        bbox[0] = std::min(bbox[0], x);
+        bbox[1] = std::max(bbox[1], x);
+        bbox[2] = std::min(bbox[2], y);
+        bbox[3] = std::max(bbox[3], y);
+        bbox[4] = std::min(bbox[4], z);
+        bbox[5] = std::max(bbox[5], z);
+    }
+
+    const double px = (double)x * spacing[0];
+    const double py = (double)y * spacing[1];
+    const double pz = (double)z * spacing[2];
+    sumX += px; sumY += py; sumZ += pz;
+    sumXX += px * px; sumYY += py * py; sumZZ += pz * pz;
+    sumXY += px * py; sumXZ += px * pz; sumYZ += py * pz;
+
+    sumGray += gray;
+    sumGraySq += gray * gray;
+    minGray = std::min(minGray, gray);
+    maxGray = std::max(maxGray, gray);
+}
+
+inline void VoidDetector::RegionMoments::SetMerged(const RegionMoments& other) noexcept
+{
+    if (other.voxelCount == 0) {
+        return;
+    }
+    if (voxelCount == 0) {
+        *this = other;
+        return;
+    }
+
+    voxelCount += other.voxelCount;
+    seed = std::min(seed, other.seed);
+    sumX += other.sumX; sumY += other.sumY; sumZ += other.sumZ;
+    sumXX += other.sumXX; sumYY += other.sumYY; sumZZ += other.sumZZ;
+    sumXY += other.sumXY; sumXZ += other.sumXZ; sumYZ += other.sumYZ;
+    sumGray += other.sumGray;
+    sumGraySq += other.sumGraySq;
+    minGray = std::min(minGray, other.minGray);
+    maxGray = std::max(maxGray, other.maxGray);
+    for (size_t axis = 0; axis < 3; ++axis) {
+        bbox[axis * 2] = std::min(bbox[axis * 2], other.bbox[axis * 2]);
+        bbox[axis * 2 + 1] = std::max(bbox[axis * 2 + 1], other.bbox[axis * 2 + 1]);
+    }
+}
+
+inline std::uint64_t VoidDetector::GetLabelRoot(
+    std::vector<std::atomic<std::uint64_t>>& parents,
+    std::uint64_t label) noexcept
+{
+    // 父指针只会指向更小的标签；路径减半用 CAS 推进，失败说明他人已推进，继续向上即可。
+    for (;;) {
+        std::uint64_t parent = parents[label].load();
+        if (parent == label) {
+            return label;
+        }
+        const std::uint64_t grandParent = parents[parent].load();
+        if (grandParent != parent) {
+            parents[label].compare_exchange_weak(parent, grandParent);
+        }
+        label = grandParent;
+    }
+}
+
+inline void VoidDetector::SetLabelUnion(
+    std::vector<std::atomic<std::uint64_t>>& parents,
+    std::uint64_t left,
+    std::uint64_t right) noexcept
+{
+    // 较大根挂到较小根下；根仍为自指时 CAS 才成功，否则重新找根再试。
+    for (;;) {
+        left = GetLabelRoot(parents, left);
+        right = GetLabelRoot(parents, right);
+        if (left == right) {
+            return;
+        }
+        if (left < right) {
+            std::swap(left, right);
+        }
+        std::uint64_t expected = left;
+        if (parents[left].compare_exchange_strong(expected, right)) {
+            return;
+        }
+    }
+}
+
+inline VoidDetector::RegionLabels VoidDetector::BuildRegionLabels(
     const GapVolumeBuffer& vol,
-    std::vector<uint8_t>& candidateMask,
-    const GapVoidParams& params,
-    std::vector<int>& outLabelVol)
+    const GapBitMask& candidateMask,
+    int* labelVol)
 {
-    // 路径：扫描未标记候选 -> BFS 收集单区体素并累计一/二阶矩 -> 按最小体积筛选 ->
-    // 为保留区计算灰度、bbox、PCA、投影面积与近似表面积；被筛掉区的临时标签恢复为 0。
+    // 路径：按 z 分块，块内单遍扫描分配局部临时标签并在块内并查集合并 ->
+    // 全局标签表接入块内等价 -> 各块首层与前一块并行 CAS 合并 -> 串行按标签序编号分量。
+    // 相邻关系与旧 BFS 完全相同：只看扁平 offset ±1/±dx/±slice 是否落在数组内。
     const int dx = vol.dims[0];
     const int dy = vol.dims[1];
     const int dz = vol.dims[2];
     const size_t slice = (size_t)dx * dy;
     const size_t total = slice * dz;
 
-    const double voxelVol = vol.spacing[0] * vol.spacing[1] * vol.spacing[2];
-    outLabelVol.assign(total, 0);
+    RegionLabels result;
+    const size_t slabSlices = GetSlabSlices(slice);
+    result.slabSlices = slabSlices;
+    const size_t slabCount = ((size_t)dz + slabSlices - 1) / slabSlices;
+    const auto getSlabBegin = [&](size_t slab) {
+        return std::min(total, slab * slabSlices * slice);
+    };
+    const std::array<size_t, 3> backOffsets = { 1, (size_t)dx, slice };
+
+    // 1. 块内扫描：只看已扫过的 -1/-dx/-slice 邻居；新标签按扫描序递增，
+    // 因而每个标签的首个 voxel 序随标签单调，块内根恒为所在分量最早出现的标签。
+    // 同一遍扫描把坐标、灰度与 bbox 累加进块内标签的矩；各块独占自己的矩表，无需同步。
+    std::vector<std::vector<int>> slabParents(slabCount);
+    std::vector<std::vector<RegionMoments>> slabMoments(slabCount);
+    vol.VisitVoxels([&](const auto* data) {
+        vtkSMPTools::For(0, static_cast<vtkIdType>(slabCount),
+            [&](vtkIdType first, vtkIdType last) {
+                for (vtkIdType slab = first; slab < last; ++slab) {
+                    auto& parents = slabParents[(size_t)slab];
+                    auto& moments = slabMoments[(size_t)slab];
+                    parents.assign(1, 0);
+                    moments.assign(1, RegionMoments{});
+                    const auto getRoot = [&parents](int label) {
+                        while (parents[label] != label) {
+                            parents[label] = parents[parents[label]];
+                            label = parents[label];
+                        }
+                        return label;
+                    };
+                    const size_t begin = getSlabBegin((size_t)slab);
+                    const int zBegin = static_cast<int>((size_t)slab * slabSlices);
+                    const int zEnd = static_cast<int>(std::min<size_t>(dz, ((size_t)slab + 1) * slabSlices));
+                    size_t i = begin;
+                    for (int z = zBegin; z < zEnd; ++z) {
+                        for (int y = 0; y < dy; ++y) {
+                            for (int x = 0; x < dx; ++x, ++i) {
+                                if (!vol.GetVoxelValid(i) || !candidateMask.GetBit(i)) {
+                                    labelVol[i] = 0;
+                                    continue;
+                                }
+                                int label = 0;
+                                for (const size_t off : backOffsets) {
+                                    if (i < begin + off || labelVol[i - off] == 0) {
+                                        continue;
+                                    }
+                                    const int root = getRoot(labelVol[i - off]);
+                                    if (label == 0) {
+                                        label = root;
+                                    }
+                                    else if (root != label) {
+                                        parents[std::max(root, label)] = std::min(root, label);
+                                        label = std::min(root, label);
+                                    }
+                                }
+                                if (label == 0) {
+                                    label = static_cast<int>(parents.size());
+                                    parents.push_back(label);
+                                    moments.emplace_back();
+                                }
+                                labelVol[i] = label;
+                                moments[(size_t)label].SetVoxel(
+                                    i, x, y, z, vol.spacing, static_cast<double>(data[i]));
+                            }
+                        }
+                    }
+                    // 父标签恒小于子标签，升序一遍即可把每个标签直接指向块内根。
+                    for (size_t label = 1; label < parents.size(); ++label) {
+                        parents[label] = parents[(size_t)parents[label]];
+                    }
+                }
+            });
+    });
 
-    std::vector<VoidRegion> regions;
-    int currentID = 1;
+    // 2. 全局标签 = 块偏移 + 局部标签 - 1；块序与块内扫描序一致，全局标签仍按首个 voxel 序递增。
+    result.labelOffsets.assign(slabCount + 1, 0);
+    for (size_t slab = 0; slab < slabCount; ++slab) {
+        result.labelOffsets[slab + 1] =
+            result.labelOffsets[slab] + slabParents[slab].size() - 1;
+    }
+    const std::uint64_t labelCount = result.labelOffsets.back();
+    std::vector<std::atomic<std::uint64_t>> parents(labelCount);
+    result.labelMoments.resize(labelCount);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(slabCount),
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType slab = first; slab < last; ++slab) {
+                const std::uint64_t offset = result.labelOffsets[(size_t)slab];
+                const auto& slabParent = slabParents[(size_t)slab];
+                auto& moments = slabMoments[(size_t)slab];
+                for (size_t label = 1; label < slabParent.size(); ++label) {
+                    parents[offset + label - 1].store(offset + (std::uint64_t)slabParent[label] - 1);
+                    result.labelMoments[offset + label - 1] = moments[label];
+                }
+                std::vector<RegionMoments>().swap(moments);
+            }
+        });
+    std::vector<std::vector<int>>().swap(slabParents);
+    std::vector<std::vector<RegionMoments>>().swap(slabMoments);
+
+    // 3. 跨块边：只有块首 slice 个 voxel 的后向邻居可能落在前一块；各边界互不依赖，并行 CAS 合并。
+    vtkSMPTools::For(1, static_cast<vtkIdType>(slabCount),
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType slab = first; slab < last; ++slab) {
+                const size_t begin = getSlabBegin((size_t)slab);
+                const size_t end = std::min(begin + slice, getSlabBegin((size_t)slab + 1));
+                const std::uint64_t offset = result.labelOffsets[(size_t)slab];
+                const std::uint64_t prevOffset = result.labelOffsets[(size_t)slab - 1];
+                for (size_t i = begin; i < end; ++i) {
+                    if (labelVol[i] == 0) {
+                        continue;
+                    }
+                    for (const size_t off : backOffsets) {
+                        if (i < off || i - off >= begin || labelVol[i - off] == 0) {
+                            continue;
+                        }
+                        SetLabelUnion(parents,
+                            offset + (std::uint64_t)labelVol[i] - 1,
+                            prevOffset + (std::uint64_t)labelVol[i - off] - 1);
+                    }
+                }
+            }
+        });
 
-    const std::array<long long, 6> offsets6 = { 1, -1, (long long)dx, -(long long)dx, (long long)slice, -(long long)slice };
-    // [实现边界] 连通 BFS 与候选回长相同，只校验扁平 offset 是否落在总数组内；
-    // 当前行为可能把行/层端点视为相邻，注释与统计解释必须忠实于这一实现。
+    // 4. 根即分量内首个标签，也就是最小 voxel 序所在标签；按标签升序编号即旧 BFS 的发现顺序。
+    result.labelComponents.assign(labelCount, 0);
+    for (std::uint64_t label = 0; label < labelCount; ++label) {
+        const std::uint64_t root = GetLabelRoot(parents, label);
+        result.labelComponents[label] = root == label
+            ? result.componentCount++
+            : result.labelComponents[root];
+    }
+    return result;
+}
+
+inline void VoidDetector::SetRegionStatistics(
+    const GapVolumeBuffer& vol,
+    const int* labelVol,
+    const RegionMoments& moments,
+    VoidRegion& region)
+{
+    // 矩在标记扫描中按块、按标签序累加；合并次序固定，结果与线程数无关。
+    const int dx = vol.dims[0];
+    const int dy = vol.dims[1];
+    const int dz = vol.dims[2];
+    const size_t slice = (size_t)dx * dy;
+    const double voxelVol = vol.spacing[0] * vol.spacing[1] * vol.spacing[2];
 
     // 13 个无符号方向及其反向共同形成 26 邻域穿越计数，只用于近似表面积，不改变 6 邻域连通标签。
-    const std::vector<std::array<int, 3>> directions13 = {
+    static const std::array<std::array<int, 3>, 13> directions13 = { {
         {1,0,0}, {0,1,0}, {0,0,1},
         {1,1,0}, {1,-1,0}, {1,0,1}, {1,0,-1}, {0,1,1}, {0,1,-1},
         {1,1,1}, {1,1,-1}, {1,-1,1}, {1,-1,-1}
-    };
-
-    std::queue<size_t> q;
-
-    for (size_t i = 0; i < total; ++i) {
-        if (vol.GetVoxelValid(i)
-            && candidateMask[i] > 0
-            && outLabelVol[i] == 0) {
-
-            VoidRegion region;
-            region.id = currentID;
-
-            // 初始化统计变量
-            double sumGray = 0;
-            double sumGraySq = 0;
-            region.minGray = 1e9;
-            region.maxGray = -1e9;
-
-            int sz0 = (int)(i / slice);
-            int sy0 = (int)((i / dx) % dy);
-            int sx0 = (int)(i % dx);
-            region.seedVoxel = { sx0, sy0, sz0 };
-            region.bbox = { sx0, sx0, sy0, sy0, sz0, sz0 };
-
-            double sumX = 0, sumY = 0, sumZ = 0;
-            double sumXX = 0, sumYY = 0, sumZZ = 0;
-            double sumXY = 0, sumXZ = 0, sumYZ = 0;
-
-            std::vector<size_t> regionVoxels;
-            q.push(i);
-            outLabelVol[i] = currentID;
-
-            while (!q.empty()) {
-                size_t curr = q.front();
-                q.pop();
-                regionVoxels.push_back(curr);
-
-                int cz = (int)(curr / slice);
-                int cy = (int)((curr / dx) % dy);
-                int cx = (int)(curr % dx);
-
-                // --- 基础统计 ---
-                region.voxelCount++;
-                double px = (double)cx * vol.spacing[0];
-                double py = (double)cy * vol.spacing[1];
-                double pz = (double)cz * vol.spacing[2];
-
-                sumX += px; sumY += py; sumZ += pz;
-                sumXX += px * px; sumYY += py * py; sumZZ += pz * pz;
-                sumXY += px * py; sumXZ += px * pz; sumYZ += py * pz;
-
-                // --- 灰度统计 ---
-                double val = static_cast<double>(vol.voxelsPtr[curr]);
-                sumGray += val;
-                sumGraySq += val * val;
-                region.minGray = std::min(region.minGray, val);
-                region.maxGray = std::max(region.maxGray, val);
-
-                // --- 边界框更新 ---
-                region.bbox[0] = std::min(region.bbox[0], cx);
-                region.bbox[1] = std::max(region.bbox[1], cx);
-                region.bbox[2] = std::min(region.bbox[2], cy);
-                region.bbox[3] = std::max(region.bbox[3], cy);
-                region.bbox[4] = std::min(region.bbox[4], cz);
-                region.bbox[5] = std::max(region.bbox[5], cz);
-
-                for (long long off : offsets6) {
-                    size_t nb = (size_t)((long long)curr + off);
-                    if (nb < total
-                        && vol.GetVoxelValid(nb)
-                        && candidateMask[nb] > 0
-                        && outLabelVol[nb] == 0) {
-                        outLabelVol[nb] = currentID;
-                        q.push(nb);
-                    }
-                }
-            }
+    } };
+
+    const size_t seed = moments.seed;
+    region.seedVoxel = { (int)(seed % dx), (int)((seed / dx) % dy), (int)(seed / slice) };
+    region.bbox = moments.bbox;
+    region.voxelCount = moments.voxelCount;
+    region.minGray = moments.minGray;
+    region.maxGray = moments.maxGray;
+
+    const double sumGray = moments.sumGray;
+    const double sumGraySq = moments.sumGraySq;
+    const double sumX = moments.sumX, sumY = moments.sumY, sumZ = moments.sumZ;
+    const double sumXX = moments.sumXX, sumYY = moments.sumYY, sumZZ = moments.sumZZ;
+    const double sumXY = moments.sumXY, sumXZ = moments.sumXZ, sumYZ = moments.sumYZ;
+
+    region.volumeMM3 = region.voxelCount * voxelVol;
+
+    // 1. 重心
+    region.centroidMM[0] = sumX / region.voxelCount + vol.origin[0];
+    region.centroidMM[1] = sumY / region.voxelCount + vol.origin[1];
+    region.centroidMM[2] = sumZ / region.voxelCount + vol.origin[2];
+
+    // 2. 等效直径与半径
+    auto pi = std::acos(-1);
+    region.equivalentDiameterMM = pow((6.0 * region.volumeMM3) / pi, 1.0 / 3.0);
+    region.radius = region.equivalentDiameterMM / 2.0;
+
+    // 3. 灰度统计
+    region.meanGray = sumGray / region.voxelCount;
+    double variance = (sumGraySq / region.voxelCount) - (region.meanGray * region.meanGray);
+    region.stdDevGray = std::sqrt(std::max(0.0, variance));
+
+    // 4. 投影尺寸 (mm)
+    region.xProjection = (region.bbox[1] - region.bbox[0] + 1) * vol.spacing[0];
+    region.yProjection = (region.bbox[3] - region.bbox[2] + 1) * vol.spacing[1];
+    region.zProjection = (region.bbox[5] - region.bbox[4] + 1) * vol.spacing[2];
+
+    // 5. PCA：协方差在无 origin 的 physical offset 上计算；平移不改变特征值。
+    double cov[3][3];
+    cov[0][0] = sumXX / region.voxelCount - (sumX / region.voxelCount) * (sumX / region.voxelCount);
+    cov[1][1] = sumYY / region.voxelCount - (sumY / region.voxelCount) * (sumY / region.voxelCount);
+    cov[2][2] = sumZZ / region.voxelCount - (sumZ / region.voxelCount) * (sumZ / region.voxelCount);
+    cov[0][1] = cov[1][0] = sumXY / region.voxelCount - (sumX / region.voxelCount) * (sumY / region.voxelCount);
+    cov[0][2] = cov[2][0] = sumXZ / region.voxelCount - (sumX / region.voxelCount) * (sumZ / region.voxelCount);
+    cov[1][2] = cov[2][1] = sumYZ / region.voxelCount - (sumY / region.voxelCount) * (sumZ / region.voxelCount);
+
+    double* covPtr[3] = { cov[0], cov[1], cov[2] };
+    double eigenVals[3], eigenVecs[3][3];
+    double* vecPtr[3] = { eigenVecs[0], eigenVecs[1], eigenVecs[2] };
+    vtkMath::Jacobi(covPtr, eigenVals, vecPtr);
+
+    // vtkMath::Jacobi 返回降序特征值，单位为 mm^2；这里保存特征值而不是主轴长度。
+    region.pcaAxes = { eigenVals[0], eigenVals[1], eigenVals[2] };
+    if (eigenVals[0] > 1e-9) {
+        region.elongation = std::sqrt(std::max(0.0, eigenVals[1] / eigenVals[0]));
+        if (eigenVals[1] > 1e-9)
+            region.flatness = std::sqrt(std::max(0.0, eigenVals[2] / eigenVals[1]));
+        region.pcaDeviation1 = eigenVals[0] / (eigenVals[0] + eigenVals[1] + eigenVals[2]);
+        region.pcaMaxDeviationRatio = (eigenVals[2] > 1e-9) ? (eigenVals[0] / eigenVals[2]) : 0.0;
+    }
 
-            region.volumeMM3 = region.voxelCount * voxelVol;
-
-            if (region.volumeMM3 >= params.minVolumeMM3) {
-                // 只有达到阈值的区域才消费 currentID；这样 regions、labelVolume 正标签与 region.id 保持一一对应。
-                // 1. 重心
-                region.centroidMM[0] = sumX / region.voxelCount + vol.origin[0];
-                region.centroidMM[1] = sumY / region.voxelCount + vol.origin[1];
-                region.centroidMM[2] = sumZ / region.voxelCount + vol.origin[2];
-
-                // 2. 等效直径与半径
-                auto pi = std::acos(-1);
-                region.equivalentDiameterMM = pow((6.0 * region.volumeMM3) / pi, 1.0 / 3.0);
-                region.radius = region.equivalentDiameterMM / 2.0;
-
-                // 3. 灰度统计
-                region.meanGray = sumGray / region.voxelCount;
-                double variance = (sumGraySq / region.voxelCount) - (region.meanGray * region.meanGray);
-                region.stdDevGray = std::sqrt(std::max(0.0, variance));
-
-                // 4. 投影尺寸 (mm)
-                region.xProjection = (region.bbox[1] - region.bbox[0] + 1) * vol.spacing[0];
-                region.yProjection = (region.bbox[3] - region.bbox[2] + 1) * vol.spacing[1];
-                region.zProjection = (region.bbox[5] - region.bbox[4] + 1) * vol.spacing[2];
-
-                // 5. PCA：协方差在无 origin 的 physical offset 上计算；平移不改变特征值。
-                double cov[3][3];
-                cov[0][0] = sumXX / region.voxelCount - (sumX / region.voxelCount) * (sumX / region.voxelCount);
-                cov[1][1] = sumYY / region.voxelCount - (sumY / region.voxelCount) * (sumY / region.voxelCount);
-                cov[2][2] = sumZZ / region.voxelCount - (sumZ / region.voxelCount) * (sumZ / region.voxelCount);
-                cov[0][1] = cov[1][0] = sumXY / region.voxelCount - (sumX / region.voxelCount) * (sumY / region.voxelCount);
-                cov[0][2] = cov[2][0] = sumXZ / region.voxelCount - (sumX / region.voxelCount) * (sumZ / region.voxelCount);
-                cov[1][2] = cov[2][1] = sumYZ / region.voxelCount - (sumY / region.voxelCount) * (sumZ / region.voxelCount);
-
-                double* covPtr[3] = { cov[0], cov[1], cov[2] };
-                double eigenVals[3], eigenVecs[3][3];
-                double* vecPtr[3] = { eigenVecs[0], eigenVecs[1], eigenVecs[2] };
-                vtkMath::Jacobi(covPtr, eigenVals, vecPtr);
-
-                // vtkMath::Jacobi 返回降序特征值，单位为 mm^2；这里保存特征值而不是主轴长度。
-                region.pcaAxes = { eigenVals[0], eigenVals[1], eigenVals[2] };
-                if (eigenVals[0] > 1e-9) {
-                    region.elongation = std::sqrt(std::max(0.0, eigenVals[1] / eigenVals[0]));
-                    if (eigenVals[1] > 1e-9)
-                        region.flatness = std::sqrt(std::max(0.0, eigenVals[2] / eigenVals[1]));
-                    region.pcaDeviation1 = eigenVals[0] / (eigenVals[0] + eigenVals[1] + eigenVals[2]);
-                    region.pcaMaxDeviationRatio = (eigenVals[2] > 1e-9) ? (eigenVals[0] / eigenVals[2]) : 0.0;
+    // 6. 三个轴向占据投影面积，以及 13 方向边界穿越的近似表面积。
+    std::vector<uint8_t> projXY((size_t)(region.bbox[1] - region.bbox[0] + 1) * (region.bbox[3] - region.bbox[2] + 1), 0);
+    std::vector<uint8_t> projXZ((size_t)(region.bbox[1] - region.bbox[0] + 1) * (region.bbox[5] - region.bbox[4] + 1), 0);
+    std::vector<uint8_t> projYZ((size_t)(region.bbox[3] - region.bbox[2] + 1) * (region.bbox[5] - region.bbox[4] + 1), 0);
+
+    int w = region.bbox[1] - region.bbox[0] + 1;
+    int h = region.bbox[3] - region.bbox[2] + 1;
+
+    // 只扫描 bbox：labelVol 为本区 id 的 voxel 即区域成员，计数与访问次序无关。
+    size_t crossCount13 = 0;
+    for (int cz = region.bbox[4]; cz <= region.bbox[5]; ++cz) {
+        for (int cy = region.bbox[2]; cy <= region.bbox[3]; ++cy) {
+            for (int cx = region.bbox[0]; cx <= region.bbox[1]; ++cx) {
+                const size_t vIdx = (size_t)cx + (size_t)cy * dx + (size_t)cz * slice;
+                if (labelVol[vIdx] != region.id) {
+                    continue;
                 }
 
-                // 6. 三个轴向占据投影面积，以及 13 方向边界穿越的近似表面积。
-                std::vector<uint8_t> projXY((size_t)(region.bbox[1] - region.bbox[0] + 1) * (region.bbox[3] - region.bbox[2] + 1), 0);
-                std::vector<uint8_t> projXZ((size_t)(region.bbox[1] - region.bbox[0] + 1) * (region.bbox[5] - region.bbox[4] + 1), 0);
-                std::vector<uint8_t> projYZ((size_t)(region.bbox[3] - region.bbox[2] + 1) * (region.bbox[5] - region.bbox[4] + 1), 0);
-
-                int w = region.bbox[1] - region.bbox[0] + 1;
-                int h = region.bbox[3] - region.bbox[2] + 1;
-                int d = region.bbox[5] - region.bbox[4] + 1;
+                projXY[(size_t)(cx - region.bbox[0]) + (size_t)(cy - region.bbox[2]) * w] = 1;
+                projXZ[(size_t)(cx - region.bbox[0]) + (size_t)(cz - region.bbox[4]) * w] = 1;
+                projYZ[(size_t)(cy - region.bbox[2]) + (size_t)(cz - region.bbox[4]) * h] = 1;
 
-                size_t crossCount13 = 0;
-                std::vector<float> dists;
-                std::vector<size_t> boundaryVoxels;
+                for (const auto& dir : directions13) {
+                    int nx = cx + dir[0]; int ny = cy + dir[1]; int nz = cz + dir[2];
+                    if (nx < 0 || ny < 0 || nz < 0 || nx >= dx || ny >= dy || nz >= dz) {
+                        crossCount13++;
+                    }
+                    else {
+                        size_t nIdx = (size_t)nx + (size_t)ny * dx + (size_t)nz * slice;
+                        if (labelVol[nIdx] != region.id) { crossCount13++; }
+                    }
+                    // 正反两个方向都查，13 个方向覆盖完整 26 邻域。
+                    int mx = cx - dir[0]; int my = cy - dir[1]; int mz = cz - dir[2];
+                    if (mx < 0 || my < 0 || mz < 0 || mx >= dx || my >= dy || mz >= dz) {
+                        crossCount13++;
+                    }
+                    else {
+                        size_t mIdx = (size_t)mx + (size_t)my * dx + (size_t)mz * slice;
+                        if (labelVol[mIdx] != region.id) { crossCount13++; }
+                    }
+                }
+            }
+        }
+    }
 
-                // boundaryVoxels 当前只记录诊断性边界集合，后续公式仅使用 crossCount13；
-                // dists 同样未进入现有统计，不能据此声称已计算边界距离分布。
+    size_t cXY = 0; for (uint8_t v : projXY) if (v) cXY++;
+    size_t cXZ = 0; for (uint8_t v : projXZ) if (v) cXZ++;
+    size_t cYZ = 0; for (uint8_t v : projYZ) if (v) cYZ++;
 
-                for (size_t vIdx : regionVoxels) {
-                    int cz = (int)(vIdx / slice);
-                    int cy = (int)((vIdx / dx) % dy);
-                    int cx = (int)(vIdx % dx);
+    region.projectedAreaXYMM2 = cXY * vol.spacing[0] * vol.spacing[1];
+    region.projectedAreaXZMM2 = cXZ * vol.spacing[0] * vol.spacing[2];
+    region.projectedAreaYZMM2 = cYZ * vol.spacing[1] * vol.spacing[2];
 
-                    projXY[(size_t)(cx - region.bbox[0]) + (size_t)(cy - region.bbox[2]) * w] = 1;
-                    projXZ[(size_t)(cx - region.bbox[0]) + (size_t)(cz - region.bbox[4]) * w] = 1;
-                    projYZ[(size_t)(cy - region.bbox[2]) + (size_t)(cz - region.bbox[4]) * h] = 1;
+    // 表面积估算 (简化的13方向权重)
+    // 为简化，使用平均投影面积权重
+    double avgCrossArea = (vol.spacing[0] * vol.spacing[1] + vol.spacing[0] * vol.spacing[2] + vol.spacing[1] * vol.spacing[2]) / 3.0;
+    region.surfaceAreaMM2 = (double)crossCount13 * avgCrossArea / 13.0;
 
-                    bool isBoundary = false;
-                    for (const auto& dir : directions13) {
-                        int nx = cx + dir[0]; int ny = cy + dir[1]; int nz = cz + dir[2];
-                        if (nx < 0 || ny < 0 || nz < 0 || nx >= dx || ny >= dy || nz >= dz) {
-                            crossCount13++; isBoundary = true;
-                        }
-                        else {
-                            size_t nIdx = (size_t)nx + (size_t)ny * dx + (size_t)nz * slice;
-                            if (outLabelVol[nIdx] != currentID) { crossCount13++; isBoundary = true; }
-                        }
-                        // 反向也要查，或者遍历完后乘以2，这里我们查全部13个方向的邻居
-                        int mx = cx - dir[0]; int my = cy - dir[1]; int mz = cz - dir[2];
-                        if (mx < 0 || my < 0 || mz < 0 || mx >= dx || my >= dy || mz >= dz) {
-                            crossCount13++; isBoundary = true;
-                        }
-                        else {
-                            size_t mIdx = (size_t)mx + (size_t)my * dx + (size_t)mz * slice;
-                            if (outLabelVol[mIdx] != currentID) { crossCount13++; isBoundary = true; }
-                        }
-                    }
-                    if (isBoundary) boundaryVoxels.push_back(vIdx);
-                }
+    // 7. Compactness & Sphericity
+    if (region.surfaceAreaMM2 > 1e-9) {
+        region.compactness = (36.0 * pi * region.volumeMM3 * region.volumeMM3) / std::pow(region.surfaceAreaMM2, 3.0);
+        region.sphericity = std::pow(std::max(0.0, region.compactness), 1.0 / 3.0);
+    }
 
-                size_t cXY = 0; for (uint8_t v : projXY) if (v) cXY++;
-                size_t cXZ = 0; for (uint8_t v : projXZ) if (v) cXZ++;
-                size_t cYZ = 0; for (uint8_t v : projYZ) if (v) cYZ++;
+    // 8. Gap (Characteristic thickness)
+    // 粗略估计：使用体积/表面积比率 (V/S) 的两倍
+    if (region.surfaceAreaMM2 > 1e-9)
+        region.gapMM = 2.0 * (region.volumeMM3 / region.surfaceAreaMM2);
+}
 
-                region.projectedAreaXYMM2 = cXY * vol.spacing[0] * vol.spacing[1];
-                region.projectedAreaXZMM2 = cXZ * vol.spacing[0] * vol.spacing[2];
-                region.projectedAreaYZMM2 = cYZ * vol.spacing[1] * vol.spacing[2];
+inline std::vector<VoidRegion> VoidDetector::BuildRegions(
+    const GapVolumeBuffer& vol,
+    const GapBitMask& candidateMask,
+    const GapVoidParams& params,
+    int* outLabels)
+{
+    // 路径：分块并查集标记连通分量并累加各临时标签的矩 -> 按最小体积筛选并按首个 voxel 序编号 ->
+    // 按标签序合并各保留区的矩并回写标签体 -> 各保留区并行计算灰度、bbox、PCA、投影面积与近似表面积。
+    // [实现边界] 连通关系与候选回长相同，只校验扁平 offset 是否落在总数组内；
+    // 当前行为可能把行/层端点视为相邻，注释与统计解释必须忠实于这一实现。
+    const int dx = vol.dims[0];
+    const int dy = vol.dims[1];
+    const int dz = vol.dims[2];
+    const size_t slice = (size_t)dx * dy;
+    const size_t total = slice * dz;
 
-                // 表面积估算 (简化的13方向权重)
-                // 为简化，使用平均投影面积权重
-                double avgCrossArea = (vol.spacing[0] * vol.spacing[1] + vol.spacing[0] * vol.spacing[2] + vol.spacing[1] * vol.spacing[2]) / 3.0;
-                region.surfaceAreaMM2 = (double)crossCount13 * avgCrossArea / 13.0;
+    const double voxelVol = vol.spacing[0] * vol.spacing[1] * vol.spacing[2];
 
-                // 7. Compactness & Sphericity
-                if (region.surfaceAreaMM2 > 1e-9) {
-                    region.compactness = (36.0 * pi * region.volumeMM3 * region.volumeMM3) / std::pow(region.surfaceAreaMM2, 3.0);
-                    region.sphericity = std::pow(std::max(0.0, region.compactness), 1.0 / 3.0);
-                }
+    RegionLabels labels = BuildRegionLabels(vol, candidateMask, outLabels);
+    const size_t labelCount = labels.labelMoments.size();
+    const size_t slabCount = labels.labelOffsets.size() - 1;
 
-                // 8. Gap (Characteristic thickness)
-                // 粗略估计：使用体积/表面积比率 (V/S) 的两倍
-                if (region.surfaceAreaMM2 > 1e-9)
-                    region.gapMM = 2.0 * (region.volumeMM3 / region.surfaceAreaMM2);
+    // 1. 分量体素数由临时标签计数汇总；只有达到阈值的分量才消费 id，
+    // 这样 regions、标签体正值与 region.id 保持一一对应，且 id 按首个 voxel 序连续。
+    std::vector<std::uint64_t> componentCounts(labels.componentCount, 0);
+    for (size_t label = 0; label < labelCount; ++label) {
+        componentCounts[labels.labelComponents[label]] += labels.labelMoments[label].voxelCount;
+    }
+    std::vector<int> componentIds(labels.componentCount, 0);
+    int regionCount = 0;
+    for (size_t component = 0; component < labels.componentCount; ++component) {
+        if (componentCounts[component] * voxelVol >= params.minVolumeMM3) {
+            componentIds[component] = ++regionCount;
+        }
+    }
 
-                regions.push_back(region);
-                currentID++;
-            }
-            else
-            {
-                // 小区域在 BFS 时已临时写入 currentID；筛除时必须逐 voxel 回滚，且 currentID 不递增。
-                for (size_t vIdx : regionVoxels) {
-                    outLabelVol[vIdx] = 0;
+    // 2. 按临时标签升序合并矩；合并次序只取决于分块，与线程数无关，seed 取各标签首个 voxel 序的最小值。
+    std::vector<RegionMoments> regionMoments((size_t)regionCount);
+    for (size_t label = 0; label < labelCount; ++label) {
+        const int id = componentIds[labels.labelComponents[label]];
+        if (id > 0) {
+            regionMoments[(size_t)id - 1].SetMerged(labels.labelMoments[label]);
+        }
+    }
+    std::vector<RegionMoments>().swap(labels.labelMoments);
+
+    // 3. 回写最终标签：被筛掉或非候选 voxel 为 0。
+    const size_t slabVoxels = labels.slabSlices * slice;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(slabCount),
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType slab = first; slab < last; ++slab) {
+                const size_t begin = std::min(total, (size_t)slab * slabVoxels);
+                const size_t end = std::min(total, begin + slabVoxels);
+                const size_t offset = labels.labelOffsets[(size_t)slab];
+                for (size_t i = begin; i < end; ++i) {
+                    if (outLabels[i] == 0) {
+                        continue;
+                    }
+                    const size_t label = offset + (size_t)outLabels[i] - 1;
+                    outLabels[i] = componentIds[labels.labelComponents[label]];
                 }
             }
+        });
 
-        }
-    }
+    // 4. 区域间互不依赖，按最终标签并行统计；标签体此时只读。
+    std::vector<VoidRegion> regions((size_t)regionCount);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(regions.size()), 1,
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType index = first; index < last; ++index) {
+                VoidRegion& region = regions[(size_t)index];
+                region.id = static_cast<int>(index) + 1;
+                SetRegionStatistics(vol, outLabels, regionMoments[(size_t)index], region);
+            }
+        });
 
     return regions;
 }
+
+inline std::vector<VoidRegion> VoidDetector::BuildRegions(
+    const GapVolumeBuffer& vol,
+    const GapBitMask& candidateMask,
+    const GapVoidParams& params,
+    std::vector<int>& outLabelVol)
+{
+    outLabelVol.assign((size_t)vol.dims[0] * vol.dims[1] * vol.dims[2], 0);
+    return BuildRegions(vol, candidateMask, params, outLabelVol.data());
+}
@@ -11,9 +11,29 @@
 #include <cmath>
 #include <cstdint>
 #include <memory>
+#include <type_traits>
 #include <utility>
 
-// Gap 算法使用的只读体素快照：既支持自有 vector，也支持由 shared owner 锚定的零拷贝 float 别名。
+// 体素存储的原生标量类型；算法按类型展开，整数体无需整卷 float 工作副本。
+enum class GapScalarType {
+    Float32,
+    UInt8,
+    UInt16,
+    Int16
+};
+
+template <typename T>
+struct GapScalarTraits;
+template <>
+struct GapScalarTraits<float> { static constexpr GapScalarType kType = GapScalarType::Float32; };
+template <>
+struct GapScalarTraits<std::uint8_t> { static constexpr GapScalarType kType = GapScalarType::UInt8; };
+template <>
+struct GapScalarTraits<std::uint16_t> { static constexpr GapScalarType kType = GapScalarType::UInt16; };
+template <>
+struct GapScalarTraits<std::int16_t> { static constexpr GapScalarType kType = GapScalarType::Int16; };
+
+// Gap 算法使用的只读体素快照：既支持自有 float vector，也支持由 shared owner 锚定的零拷贝原生标量别名。
 // copy/move 会重新绑定 owned 模式的 data 指针，避免 vector 搬迁后 voxelsPtr 指向旧地址。
 class GapVolumeBuffer {
 public:
@@ -22,6 +42,7 @@ public:
     GapVolumeBuffer(const GapVolumeBuffer& other)
         : voxels(other.voxels),
           voxelsPtr(nullptr),
+          voxelType(other.voxelType),
           validMask(other.validMask),
           validMaskPtr(nullptr),
           dims(other.dims),
@@ -50,6 +71,7 @@ public:
     GapVolumeBuffer(GapVolumeBuffer&& other) noexcept
         : voxels(std::move(other.voxels)),
           voxelsPtr(other.voxelsPtr),
+          voxelType(other.voxelType),
           validMask(std::move(other.validMask)),
           validMaskPtr(other.validMaskPtr),
           dims(other.dims),
@@ -76,6 +98,7 @@ public:
 
         voxels = std::move(other.voxels);
         voxelsPtr = other.voxelsPtr;
+        voxelType = other.voxelType;
         validMask = std::move(other.validMask);
         validMaskPtr = other.validMaskPtr;
         dims = other.dims;
@@ -101,13 +124,15 @@ public:
         m_voxelOwner.reset();
         voxels = std::move(ownedVoxels);
         voxelsPtr = GetOwnedPointer();
+        voxelType = GapScalarType::Float32;
     }
 
-    // 已经是 float 的输入只保存只读别名；调用方必须保证 sharedVoxels 指向 voxelOwner 管理的存储，
-    // 且该存储至少覆盖 dims 乘积个 float。本函数只检查两个参数非空，无法验证归属或容量。
+    // float/uint8/uint16/int16 输入只保存只读别名；调用方必须保证 sharedVoxels 指向 voxelOwner 管理的存储，
+    // 且该存储至少覆盖 dims 乘积个 T。本函数只检查两个参数非空，无法验证归属或容量。
+    template <typename T>
     bool SetSharedVoxels(
         std::shared_ptr<const void> voxelOwner,
-        const float* sharedVoxels) noexcept {
+        const T* sharedVoxels) noexcept {
         if (!voxelOwner || !sharedVoxels) {
             return false;
         }
@@ -115,9 +140,27 @@ public:
         std::vector<float>().swap(voxels);
         m_voxelOwner = std::move(voxelOwner);
         voxelsPtr = sharedVoxels;
+        voxelType = GapScalarTraits<std::remove_cv_t<T>>::kType;
         return true;
     }
 
+    // 按 voxelType 把 voxelsPtr 还原为 const T* 后调用 fn；各实例化须返回同一类型。
+    // 逐 voxel 循环应放在 fn 内，使类型分支只在整卷粒度发生一次。
+    template <typename Fn>
+    decltype(auto) VisitVoxels(Fn&& fn) const {
+        switch (voxelType) {
+        case GapScalarType::UInt8:
+            return fn(static_cast<const std::uint8_t*>(voxelsPtr));
+        case GapScalarType::UInt16:
+            return fn(static_cast<const std::uint16_t*>(voxelsPtr));
+        case GapScalarType::Int16:
+            return fn(static_cast<const std::int16_t*>(voxelsPtr));
+        case GapScalarType::Float32:
+        default:
+            return fn(static_cast<const float*>(voxelsPtr));
+        }
+    }
+
     // 非空有效域与体素共享 x-fast 布局；0 表示分析域外，非 0 表示有效。
     void SetOwnedMask(std::vector<std::uint8_t> ownedMask) noexcept {
         m_maskOwner.reset();
@@ -158,7 +201,9 @@ public:
     // 直接改变该 public vector 的 size/capacity 会绕过别名重绑；生产方应通过 SetOwnedVoxels 或赋值运算更新。
     std::vector<float> voxels;
     // 非拥有只读别名；owned 模式指向 voxels，shared 模式由 m_voxelOwner 保证生命周期。
-    const float* voxelsPtr = nullptr;
+    // 元素类型由 voxelType 决定，读取须经 VisitVoxels 或 GetVoxelValue。
+    const void* voxelsPtr = nullptr;
+    GapScalarType voxelType = GapScalarType::Float32;
     // 空 vector/空别名表示整卷有效；非空时与 voxels 使用同一 x-fast offset。
     std::vector<std::uint8_t> validMask;
     const std::uint8_t* validMaskPtr = nullptr;
@@ -179,7 +224,8 @@ public:
         if (!voxelsPtr || x < 0 || x >= dims[0] ||
             y < 0 || y >= dims[1] ||
             z < 0 || z >= dims[2]) return 0.f;
-        return voxelsPtr[(size_t)x + (size_t)y * dims[0] + (size_t)z * (size_t)dims[0] * dims[1]];
+        const size_t index = (size_t)x + (size_t)y * dims[0] + (size_t)z * (size_t)dims[0] * dims[1];
+        return VisitVoxels([index](const auto* data) { return static_cast<float>(data[index]); });
     }
 
     // ── 三线性插值：体素索引坐标 ─────────────────────────────────────
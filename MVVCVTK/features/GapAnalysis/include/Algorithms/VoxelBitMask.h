@@ -0,0 +1,110 @@
+#pragma once
+// =====================================================================
+// Path: MVVCVTK/features/GapAnalysis/include/Algorithms/VoxelBitMask.h
+// VoxelBitMask.h - 空洞流水线的位压缩体素 mask（无 VTK 依赖）
+// =====================================================================
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// 每 voxel 1 bit 的 mask，位序即 x-fast 扁平序 `x + y*dimX + z*dimX*dimY`：
+// voxel i 位于第 i/64 个字的第 i%64 位。扁平 offset ±1/±dimX/±slice 因而对应整体位移，
+// 形态学与计数可按 64 voxel 一字处理。末字中超出 size 的位恒为 0，逐字运算的写方须保持这一不变量。
+class GapBitMask {
+public:
+    static constexpr std::size_t kWordBits = 64;
+
+    GapBitMask() = default;
+    explicit GapBitMask(std::size_t bitCount)
+        : m_words((bitCount + kWordBits - 1) / kWordBits, 0),
+          m_bitCount(bitCount) {
+    }
+
+    std::size_t GetSize() const noexcept { return m_bitCount; }
+    std::size_t GetWordCount() const noexcept { return m_words.size(); }
+    std::uint64_t* GetWords() noexcept { return m_words.data(); }
+    const std::uint64_t* GetWords() const noexcept { return m_words.data(); }
+
+    bool GetBit(std::size_t index) const noexcept {
+        return ((m_words[index / kWordBits] >> (index % kWordBits)) & 1u) != 0;
+    }
+
+    void SetBit(std::size_t index) noexcept {
+        m_words[index / kWordBits] |= std::uint64_t{ 1 } << (index % kWordBits);
+    }
+
+    // 置位 [begin, end)；整字部分直接写满，只有首尾字需要掩码。
+    void SetRange(std::size_t begin, std::size_t end) noexcept {
+        end = std::min(end, m_bitCount);
+        if (begin >= end) {
+            return;
+        }
+        const std::size_t firstWord = begin / kWordBits;
+        const std::size_t lastWord = (end - 1) / kWordBits;
+        const std::uint64_t firstMask = ~std::uint64_t{ 0 } << (begin % kWordBits);
+        const std::uint64_t lastMask = GetLowMask(end - lastWord * kWordBits);
+        if (firstWord == lastWord) {
+            m_words[firstWord] |= firstMask & lastMask;
+            return;
+        }
+        m_words[firstWord] |= firstMask;
+        std::fill(m_words.begin() + firstWord + 1, m_words.begin() + lastWord, ~std::uint64_t{ 0 });
+        m_words[lastWord] |= lastMask;
+    }
+
+    // 从 bitPos 起连续 64 个 voxel 的位，第 k 位对应 voxel bitPos+k；越出 [0, size) 的位读作 0。
+    // 逐字形态学用它取 ±offset 邻居：邻居字 = GetWordAt(wordBegin + offset)。
+    std::uint64_t GetWordAt(long long bitPos) const noexcept {
+        const long long wordCount = static_cast<long long>(m_words.size());
+        if (bitPos < 0) {
+            if (bitPos <= -static_cast<long long>(kWordBits) || wordCount == 0) {
+                return 0;
+            }
+            return m_words[0] << static_cast<unsigned>(-bitPos);
+        }
+        const long long word = bitPos / static_cast<long long>(kWordBits);
+        const unsigned shift = static_cast<unsigned>(bitPos % static_cast<long long>(kWordBits));
+        const std::uint64_t low = word < wordCount ? m_words[(std::size_t)word] : 0;
+        if (shift == 0) {
+            return low;
+        }
+        const std::uint64_t high = word + 1 < wordCount ? m_words[(std::size_t)word + 1] : 0;
+        return (low >> shift) | (high << (kWordBits - shift));
+    }
+
+    // 置位 voxel 总数；逐字 popcount。
+    std::size_t GetCount() const noexcept {
+        std::size_t count = 0;
+        for (const std::uint64_t word : m_words) {
+            count += GetBitCount(word);
+        }
+        return count;
+    }
+
+    void Clear() noexcept {
+        std::fill(m_words.begin(), m_words.end(), 0);
+    }
+
+    // 低 bitCount 位为 1 的掩码；bitCount 取 [1, 64]。
+    static std::uint64_t GetLowMask(std::size_t bitCount) noexcept {
+        return bitCount >= kWordBits ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << bitCount) - 1;
+    }
+
+    static std::size_t GetBitCount(std::uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+        // MSVC 的 __popcnt64 无条件生成 POPCNT 指令；这里用 SWAR 保持对旧 CPU 的兼容。
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<std::size_t>((word * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+private:
+    std::vector<std::uint64_t> m_words;
+    std::size_t m_bitCount = 0;
+};
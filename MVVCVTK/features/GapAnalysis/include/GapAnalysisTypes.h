@@ -80,7 +80,7 @@ struct GapVoidParams {
 
 // ── 空洞区域统计结果 ──────────────────────────────────────────────────
 struct VoidRegion {
-    // 被保留区域的正标签 ID；从 1 连续编号，并与 labelVolume/labelImage 的正值对应。
+    // 被保留区域的正标签 ID；从 1 连续编号，并与 labelImage 的正值对应。
     int                  id = 0;
     // 当前六邻域连通候选包含的 voxel 数。
     size_t               voxelCount = 0;
@@ -147,10 +147,9 @@ struct GapAnalysisResult {
     // 通过 minVolumeMM3 筛选的区域统计；id 与正标签值一一对应。
     std::vector<VoidRegion> voids;
     // 与输入体素一一对应的 x-fast 扁平标签：[x + y*dimX + z*dimX*dimY]，0 表示非保留区域。
-    std::vector<int>        labelVolume;
     // 标签体继承输入快照的 dimensions、spacing 与 origin；worker 构建一次，主线程只读并挂载。
     vtkSmartPointer<vtkImageData> labelImage;
-    // 与 voids、labelVolume 和 labelImage 在同一 worker 提交段发布的聚合统计。
+    // 与 voids 和 labelImage 在同一 worker 提交段发布的聚合统计。
     GapStatistics statistics;
     bool                    isSucceeded = false; // 只表示分析 payload 有效，不代表 display/overlay 已显示。
 };
@@ -89,6 +89,10 @@ private:
     const HostRenderViewSet* m_renderViews = nullptr;
     HostInputPort* m_inputPort = nullptr;
     std::function<ImageSnapshot()> m_getImageSnapshot;
+    // 可空：宿主不保存会话时分析结果只用于显示。
+    std::function<bool(
+        DataVersion,
+        vtkSmartPointer<vtkImageData>)> m_setLabelImage;
     std::function<bool(
         const std::vector<std::shared_ptr<InteractiveService>>&)>
         m_setActiveViews;
@@ -349,6 +353,7 @@ bool GapHostFeature::Impl::AttachHost(
     m_renderViews = context.renderViews;
     m_inputPort = context.inputPort;
     m_getImageSnapshot = context.getImageSnapshot;
+    m_setLabelImage = context.setLabelImage;
     m_setActiveViews = context.setActiveViews;
     m_ownerThread = std::this_thread::get_id();
 
@@ -407,6 +412,7 @@ bool GapHostFeature::Impl::DetachHost()
     m_activeVersion.reset();
     m_renderViews = nullptr;
     m_getImageSnapshot = {};
+    m_setLabelImage = {};
     m_isSwitchDown = false;
     m_isExitDown = false;
     m_isExitPending = false;
@@ -519,9 +525,24 @@ bool GapHostFeature::Impl::StartView(
     completeItem->onComplete = std::move(onComplete);
     const std::weak_ptr<CompleteItem> weakItem =
         completeItem;
+    // 回调由 service 在 owner thread 的显示 tick 中发出，service 此时必然存活。
+    // 标签体登记到分析所依据的 version；数据已换代时宿主拒绝，会话保存不会带上过期标签。
     const bool isAccepted = m_service->StartView(
         std::move(candidate->request),
-        [weakItem](bool isSuccess) {
+        [weakItem,
+            service = m_service.get(),
+            setLabelImage = m_setLabelImage,
+            version = candidate->version](bool isSuccess) {
+            // isSuccess 还包含 overlay 是否挂上；标签体只看分析本身是否成功。
+            if (setLabelImage
+                && service->GetAnalysisState()
+                    == GapAnalysisState::Succeeded) {
+                try {
+                    (void)setLabelImage(version, service->BuildLabelImage());
+                }
+                catch (...) {
+                }
+            }
             if (const auto item = weakItem.lock()) {
                 (void)SendComplete(item, isSuccess);
             }
@@ -666,6 +687,7 @@ bool GapHostFeature::Impl::ClearBorrowed()
     m_renderViews = nullptr;
     m_inputPort = nullptr;
     m_getImageSnapshot = {};
+    m_setLabelImage = {};
     m_setActiveViews = {};
     m_ownerThread = {};
     m_isInputAttached = false;
@@ -26,6 +26,41 @@
 #include <thread>
 #include <utility>
 
+namespace {
+// float/uint8/uint16/int16 输入只扫描有效 voxel 的数值域，再以 image 为 owner 共享原生标量；
+// 按具体类型展开，避免逐体素 GetTuple1 虚调用，也不分配整卷 float 工作副本。
+template <typename T>
+bool SetNativeVoxels(
+    vtkSmartPointer<vtkImageData> image,
+    const void* source,
+    std::size_t count,
+    GapVolumeBuffer& out)
+{
+    const auto* typedSource = static_cast<const T*>(source);
+    bool hasValidVoxel = false;
+    T minValue = (std::numeric_limits<T>::max)();
+    T maxValue = (std::numeric_limits<T>::lowest)();
+    for (std::size_t index = 0; index < count; ++index) {
+        if (!out.GetVoxelValid(index)) {
+            continue;
+        }
+        hasValidVoxel = true;
+        minValue = (std::min)(minValue, typedSource[index]);
+        maxValue = (std::max)(maxValue, typedSource[index]);
+    }
+    out.minVal = hasValidVoxel ? static_cast<float>(minValue) : 0.0f;
+    out.maxVal = hasValidVoxel ? static_cast<float>(maxValue) : 0.0f;
+    try {
+        std::shared_ptr<const void> imageOwner =
+            std::make_shared<vtkSmartPointer<vtkImageData>>(std::move(image));
+        return out.SetSharedVoxels(std::move(imageOwner), typedSource);
+    }
+    catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+} // namespace
+
 // GapAnalysis 的并发与显示编排边界：后台 worker 只消费不可变体素/参数快照并一次性提交结果；
 // 宿主 view 线程通过独立状态机消费终态、创建 overlay。分析状态、显示阶段和 overlay 可见意图互不推导。
 class GapAnalysisService::Impl final {
@@ -108,11 +143,10 @@ private:
         const GapSurfaceConfig& surface,
         const GapVoidParams& voidParams) const;
     vtkSmartPointer<vtkImageData> BuildLabelImage(
-        const std::vector<int>& labelVolume,
         const GapVolumeBuffer& volBuf) const;
     bool BuildStatistics(
         const GapVolumeBuffer& volBuf,
-        const std::vector<int>& labelVolume,
+        const int* labels,
         GapStatistics& statistics) const;
 
     VolumeBufferSnapshot GetInputSnapshot() const;
@@ -900,19 +934,27 @@ void GapAnalysisService::Impl::StartWorker(
         if (!m_isStopping.load()) {
             // 2. 候选检测只消费本任务参数副本，不读取随后可能更新的服务参数。
             auto candidates = VoidDetector::BuildCandidates(volBuf, interior, params.voidParams);
+            interior = GapBitMask(); // 后续阶段不再读取，先释放
             if (!m_isStopping.load()) {
-                // 3. 区域、label volume 与 label image 先在 worker 局部完整构造，再一次性提交。
+                // 3. 区域与 label image 先在 worker 局部完整构造，再一次性提交；
+                // 标签直接写入 label image 的标量区，不再另存一份整卷 int 副本。
                 GapAnalysisResult result;
-                result.voids = VoidDetector::BuildRegions(
-                    volBuf,
-                    candidates,
-                    params.voidParams,
-                    result.labelVolume);
-                result.labelImage = BuildLabelImage(result.labelVolume, volBuf);
-                if (result.labelImage
+                result.labelImage = BuildLabelImage(volBuf);
+                auto* labels = result.labelImage
+                    ? static_cast<int*>(result.labelImage->GetScalarPointer())
+                    : nullptr;
+                if (labels) {
+                    result.voids = VoidDetector::BuildRegions(
+                        volBuf,
+                        candidates,
+                        params.voidParams,
+                        labels);
+                    result.labelImage->Modified();
+                }
+                if (labels
                     && BuildStatistics(
                         volBuf,
-                        result.labelVolume,
+                        labels,
                         result.statistics)) {
                     result.isSucceeded = true;
                     {
@@ -1304,37 +1346,25 @@ bool GapAnalysisService::Impl::BuildVolumeBuffer(
     image->GetOrigin(origin);
     out.origin = { origin[0], origin[1], origin[2] }; // 输入 physical 坐标原点，沿 [x, y, z]。
 
-    // RawVolumeDataManager 当前产出 VTK_FLOAT；该路径只扫描数值域，不再分配或复制整卷体素。
-    if (scalars->GetDataType() == VTK_FLOAT) {
-        const auto* source = static_cast<const float*>(scalars->GetVoidPointer(0));
-        if (!source) {
-            return false;
-        }
-
-        bool hasValidVoxel = false;
-        float minValue = (std::numeric_limits<float>::max)();
-        float maxValue = (std::numeric_limits<float>::lowest)();
-        for (std::size_t index = 0; index < expectedCount; ++index) {
-            if (!out.GetVoxelValid(index)) {
-                continue;
-            }
-            hasValidVoxel = true;
-            minValue = (std::min)(minValue, source[index]);
-            maxValue = (std::max)(maxValue, source[index]);
-        }
-        out.minVal = hasValidVoxel ? minValue : 0.0f;
-        out.maxVal = hasValidVoxel ? maxValue : 0.0f;
-        try {
-            std::shared_ptr<const void> imageOwner =
-                std::make_shared<vtkSmartPointer<vtkImageData>>(std::move(image));
-            return out.SetSharedVoxels(std::move(imageOwner), source);
-        }
-        catch (const std::bad_alloc&) {
-            return false;
-        }
+    // 加载常用的 float/uint8/uint16/int16 直接共享原生存储，算法层按类型展开读取；
+    // 其余类型（double、int 等）才退回 VTK 通用取值生成 float 工作副本。
+    const void* source = scalars->GetVoidPointer(0);
+    if (!source) {
+        return false;
+    }
+    switch (scalars->GetDataType()) {
+    case VTK_FLOAT:
+        return SetNativeVoxels<float>(std::move(image), source, expectedCount, out);
+    case VTK_UNSIGNED_CHAR:
+        return SetNativeVoxels<std::uint8_t>(std::move(image), source, expectedCount, out);
+    case VTK_UNSIGNED_SHORT:
+        return SetNativeVoxels<std::uint16_t>(std::move(image), source, expectedCount, out);
+    case VTK_SHORT:
+        return SetNativeVoxels<std::int16_t>(std::move(image), source, expectedCount, out);
+    default:
+        break;
     }
 
-    // 插件接入非 float VTK image 时仍转换成连续 float 存储，算法层无需扩散 scalar 类型分支。
     std::vector<float> voxels;
     try {
         voxels.resize(expectedCount);
@@ -1367,7 +1397,7 @@ bool GapAnalysisService::Impl::BuildVolumeBuffer(
 
 bool GapAnalysisService::Impl::BuildStatistics(
     const GapVolumeBuffer& volBuf,
-    const std::vector<int>& labelVolume,
+    const int* labels,
     GapStatistics& statistics) const
 {
     statistics = {};
@@ -1382,7 +1412,7 @@ bool GapAnalysisService::Impl::BuildStatistics(
     }
 
     const auto voxelCount = dimX * dimY * dimZ;
-    if (labelVolume.size() != voxelCount) {
+    if (!labels) {
         return false;
     }
 
@@ -1393,11 +1423,11 @@ bool GapAnalysisService::Impl::BuildStatistics(
         if (isValid) {
             ++validVoxelCount;
         }
-        if (labelVolume[index] < 0
-            || (labelVolume[index] > 0 && !isValid)) {
+        if (labels[index] < 0
+            || (labels[index] > 0 && !isValid)) {
             return false;
         }
-        if (labelVolume[index] > 0) {
+        if (labels[index] > 0) {
             ++voidVoxelCount;
         }
     }
@@ -1431,19 +1461,14 @@ bool GapAnalysisService::Impl::BuildStatistics(
 }
 
 vtkSmartPointer<vtkImageData> GapAnalysisService::Impl::BuildLabelImage(
-    const std::vector<int>& labelVolume,
     const GapVolumeBuffer& volBuf) const
 {
-    // labelVolume 与输入共享 x-fast 线性布局；输出固定为单分量 VTK_INT，
+    // 标量区与输入共享 x-fast 线性布局，由 VoidDetector::BuildRegions 逐 voxel 覆写；输出固定为单分量 VTK_INT，
     // 并继承输入 dimensions/spacing/origin，使 slice overlay 可直接复用同一 physical 坐标。
-    if (labelVolume.empty()) {
-        return nullptr;
-    }
-
     const auto total = static_cast<std::size_t>(volBuf.dims[0])
         * static_cast<std::size_t>(volBuf.dims[1])
         * static_cast<std::size_t>(volBuf.dims[2]);
-    if (labelVolume.size() < total) {
+    if (total == 0) {
         return nullptr;
     }
 
@@ -1453,12 +1478,8 @@ vtkSmartPointer<vtkImageData> GapAnalysisService::Impl::BuildLabelImage(
     image->SetOrigin(volBuf.origin[0], volBuf.origin[1], volBuf.origin[2]);
     image->AllocateScalars(VTK_INT, 1);
 
-    auto* labelPtr = static_cast<int*>(image->GetScalarPointer());
-    if (!labelPtr) {
+    if (!image->GetScalarPointer()) {
         return nullptr;
     }
-
-    std::copy_n(labelVolume.begin(), total, labelPtr);
-    image->Modified();
     return image;
 }
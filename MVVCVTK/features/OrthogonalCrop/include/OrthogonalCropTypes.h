@@ -8,6 +8,7 @@
 // 不依赖 VizService、Renderer、Interactor、mapper 或具体窗口对象。
 
 #include "Render/RenderEffect.h"
+#include "VolumeTypes.h"
 
 #include <array>
 #include <cstddef>
@@ -175,5 +176,7 @@ struct CropBuildResult final {
     std::string message;
     vtkSmartPointer<vtkImageData> imageData;
     vtkSmartPointer<vtkImageData> maskImage;
+    // 可空；maskImage 相对输入有效域新裁掉的体素，变化过多时为空，统计退回整卷扫描。
+    std::shared_ptr<const ValidityMaskDelta> maskDelta;
     vtkSmartPointer<vtkPolyData> polyData;
 };
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <limits>
@@ -30,6 +31,9 @@ constexpr std::size_t kTexelSize = 4;
 constexpr float kBoxTolerance = 1.0e-6f;
 constexpr double kMatrixTolerance = 1.0e-12;
 constexpr std::size_t kRamMargin = 16ULL * 1024ULL * 1024ULL;
+// 增量区间数超过全卷体素数的 1/kMaskDeltaShare 时不再输出 mask 增量；每段 16 字节，
+// 区间表因此不超过 mask 本身的 1/4，破碎的裁切形状也不会让增量无界增长。
+constexpr std::size_t kMaskDeltaShare = 64;
 
 bool GetFinite(const double value)
 {
@@ -424,6 +428,37 @@ bool GetRamValid(
         + kRamMargin <= availableRamBytes;
 }
 
+// mask 增量可记录的最多区间数：不超过全卷 1/kMaskDeltaShare，且分层记录的容量余量与合并结果
+// 须落在 GetRamValid 预留之外的剩余内存内；增量只是加速，预算不足时放弃而不失败。
+std::size_t GetDeltaLimit(
+    vtkImageData* image,
+    const CropBuildParams& params,
+    const CropShaderPayload& payload,
+    const std::size_t fallbackAvailableRamBytes)
+{
+    const std::size_t pointCount =
+        static_cast<std::size_t>(image->GetNumberOfPoints());
+    const std::size_t shareLimit =
+        (pointCount + kMaskDeltaShare - 1) / kMaskDeltaShare;
+    const std::size_t availableRamBytes = params.availableRamBytes != 0
+        ? params.availableRamBytes
+        : fallbackAvailableRamBytes;
+    if (availableRamBytes == 0) {
+        return shareLimit;
+    }
+    const std::size_t tableBytes = payload.predicateTable
+        ? payload.predicateTable->rgbaValues.size() * sizeof(float)
+        : 0;
+    const std::size_t usedBytes = pointCount + tableBytes + kRamMargin;
+    if (usedBytes >= availableRamBytes) {
+        return 0;
+    }
+    return std::min(
+        shareLimit,
+        (availableRamBytes - usedBytes)
+            / (2 * sizeof(ValidityMaskRun)));
+}
+
 class CropImplicit final : public vtkImplicitFunction {
 public:
     static CropImplicit* New();
@@ -765,6 +800,19 @@ CropBuildResult CropAlgorithm::GetResult(
     std::vector<std::size_t> keptBySlice(
         static_cast<std::size_t>(zCount),
         0);
+    // 每层独立记录由保留变为裁掉的区间，行内相邻体素并入同一段；总段数超出预算后放弃增量，已记录的层也随之释放。
+    const std::size_t sliceSize =
+        static_cast<std::size_t>(xCount)
+        * static_cast<std::size_t>(yCount);
+    const std::size_t deltaLimit = GetDeltaLimit(
+        image,
+        params,
+        payload,
+        fallbackAvailableRamBytes);
+    std::vector<std::vector<ValidityMaskRun>> removedBySlice(
+        static_cast<std::size_t>(zCount));
+    std::atomic<std::size_t> removedCount{ 0 };
+    std::atomic<bool> isDeltaDropped{ false };
     vtkSMPTools::For(
         vtkIdType{ 0 },
         zCount,
@@ -784,6 +832,14 @@ CropBuildResult CropAlgorithm::GetResult(
                     outputMask
                     + zOffset * outputInc[2];
                 std::size_t sliceCount = 0;
+                auto& removedRuns = removedBySlice[
+                    static_cast<std::size_t>(zOffset)];
+                const bool isDeltaKept =
+                    !isDeltaDropped.load(
+                        std::memory_order_relaxed);
+                const std::uint64_t slicePoint =
+                    static_cast<std::uint64_t>(zOffset)
+                    * sliceSize;
                 for (vtkIdType yOffset = 0;
                     yOffset < yCount;
                     ++yOffset) {
@@ -832,12 +888,45 @@ CropBuildResult CropAlgorithm::GetResult(
                             isKept ? 255 : 0;
                         sliceCount +=
                             isKept ? 1 : 0;
+                        if (isDeltaKept
+                            && hasBaseline
+                            && !isKept) {
+                            const std::uint64_t point =
+                                slicePoint
+                                + static_cast<std::uint64_t>(
+                                    yOffset * xCount
+                                    + xOffset);
+                            if (!removedRuns.empty()
+                                && removedRuns.back().end
+                                    == point) {
+                                ++removedRuns.back().end;
+                            }
+                            else {
+                                removedRuns.push_back(
+                                    { point, point + 1 });
+                            }
+                        }
                     }
                 }
                 keptBySlice[
                     static_cast<std::size_t>(
                         zOffset)] =
                     sliceCount;
+                if (isDeltaKept
+                    && removedCount.fetch_add(
+                        removedRuns.size(),
+                        std::memory_order_relaxed)
+                        + removedRuns.size()
+                        > deltaLimit) {
+                    isDeltaDropped.store(
+                        true,
+                        std::memory_order_relaxed);
+                }
+                if (isDeltaDropped.load(
+                        std::memory_order_relaxed)) {
+                    std::vector<ValidityMaskRun>().swap(
+                        removedRuns);
+                }
             }
         });
     const std::size_t keptCount =
@@ -853,10 +942,30 @@ CropBuildResult CropAlgorithm::GetResult(
             "Crop image build removed every voxel.");
     }
 
+    std::shared_ptr<ValidityMaskDelta> maskDelta;
+    if (!isDeltaDropped.load()) {
+        maskDelta = std::make_shared<ValidityMaskDelta>();
+        maskDelta->parentVersion = params.inputVersion;
+        maskDelta->maskScalars =
+            maskImage->GetPointData()->GetScalars();
+        maskDelta->removedRuns.reserve(
+            removedCount.load());
+        // 逐层并入后立即释放该层，峰值只比结果多一层的区间表。
+        for (auto& removedRuns : removedBySlice) {
+            maskDelta->removedRuns.insert(
+                maskDelta->removedRuns.end(),
+                removedRuns.begin(),
+                removedRuns.end());
+            std::vector<ValidityMaskRun>().swap(
+                removedRuns);
+        }
+    }
+
     auto result = BuildResultBase(params);
     result.isSucceeded = true;
     result.imageData = std::move(outputImage);
     result.maskImage = std::move(maskImage);
+    result.maskDelta = std::move(maskDelta);
     return result;
 }
 
@@ -68,6 +68,29 @@ bool GetChordMatched(
         && event.isAltDown == chord.isAltDown
         && event.isShiftDown == chord.isShiftDown;
 }
+
+// 物化批次的裁切历史 = 根批次自带的历史（例如重开会话还原的）+ 本轮从根起算的完整前缀。
+std::shared_ptr<const std::vector<SessionCropOp>> BuildCropHistory(
+    const ImageSnapshot& rootSnapshot,
+    const std::vector<CropOpItem>& operations)
+{
+    auto history = std::make_shared<std::vector<SessionCropOp>>();
+    if (rootSnapshot && rootSnapshot->cropHistory) {
+        *history = *rootSnapshot->cropHistory;
+    }
+    history->reserve(history->size() + operations.size());
+    for (const auto& operation : operations) {
+        SessionCropOp item;
+        item.operationIndex = operation.operationIndex;
+        item.geometryType = static_cast<std::int32_t>(operation.geometryType);
+        item.removalMode = static_cast<std::int32_t>(operation.removalMode);
+        item.boxToInputModelMatrix = operation.boxToInputModelMatrix;
+        item.planeCenterInInputModel = operation.planeCenterInInputModel;
+        item.planeNormalInInputModel = operation.planeNormalInInputModel;
+        history->push_back(item);
+    }
+    return history;
+}
 }
 
 class CropHostFeature::Impl final {
@@ -613,6 +636,11 @@ bool CropHostFeature::Impl::SetImageResult(
     ImageState candidate = *expectedSnapshot;
     candidate.image = result.imageData;
     candidate.validityMask = result.maskImage;
+    // 增量相对 sourceSnapshot 的有效域；expectedSnapshot 上沿用来的旧增量不属于新 mask，一并替换。
+    candidate.maskDelta = result.maskDelta;
+    candidate.cropHistory = BuildCropHistory(
+        m_rootImage ? m_rootImage : sourceSnapshot,
+        result.operations);
     bool isPublished = false;
     ImageSnapshot publishedSnapshot;
     try {
@@ -34,6 +34,8 @@
 #include <optional>
 #include <utility>
 
+class ImagePyramid;
+
 // DataManager 原子提交的完整图像批次；几何、标量范围与 version 来自同一次提交。
 struct ImageState {
     vtkSmartPointer<vtkImageData> image;
@@ -45,6 +47,18 @@ struct ImageState {
     std::array<double, 3> origin = { 0.0, 0.0, 0.0 }; // RAS 物理原点 [x,y,z]
     std::array<double, 2> scalarRange = { 0.0, 0.0 }; // 当前标量闭区间 [min,max]
     DataVersion version = 0;
+    // 可空的加载期统计；描述 image 全部 scalar，不受 validityMask 影响。共享 scalar 的新批次可沿用。
+    std::shared_ptr<const VolumeStatistics> statistics;
+    // 可空的有效域增量；裁切物化时给出本批 mask 相对父批的变化，只作提交载体。
+    // DataManager 发布时把它移入单槽（见 GetMaskDelta），已发布的 snapshot 不持有，避免被长期引用钉住。
+    std::shared_ptr<const ValidityMaskDelta> maskDelta;
+    // 可空的裁切历史：自最初加载的数据起已物化进本批 image+mask 的全部裁切，按执行顺序排列。
+    // 裁切发布新批次时在父批历史后追加，其余新批次原样沿用；会话保存随之落盘，重开时还原。
+    std::shared_ptr<const std::vector<SessionCropOp>> cropHistory;
+    // 可空的 gap 标签体，与 maskDelta 一样只作提交载体：发布时移入按 version 登记的单槽（见 GetLabelImage）。
+    vtkSmartPointer<vtkImageData> labelImage;
+    // 流式加载期间的粗分辨率预览；只用于尽早出图，最终批次到达后被整体替换，不可作为分析或导出真源。
+    bool isPreview = false;
 };
 
 // 受控内部消费链只持有批次 owner，不修改 image；旧 version 随最后一个 owner 释放。
@@ -59,7 +73,8 @@ public:
     // 返回 current 的 const owner；调用方必须把 image/mask 视为只读。
     virtual ImageSnapshot GetImageSnapshot() const = 0;
 
-    // 返回当前 version 的独立 image；调用方可以连接 pipeline，写入也不会回写内部真源。
+    // 返回当前 version 的 image 视图：外壳独立，scalar 与各 version 共享且只读。
+    // 调用方可修改几何信息或连接 pipeline；需要原地写体素时须自行 DeepCopy 后再写。
     virtual vtkSmartPointer<vtkImageData> GetVtkImage() const = 0;
     virtual ImageState GetImageState() const = 0;
     virtual std::array<double, 2> GetScalarRange() const = 0;
@@ -71,20 +86,59 @@ public:
         const std::string& filePath,
         const VolumeLayout& layout) = 0;
     virtual bool SetFromBuffer(const VolumeBuffer& buffer) = 0;
+    // 打开 SessionArchive 会话文件并把 image+mask、标签体与裁切历史放入完整 pending 批次；不支持会话的数据源保持默认失败。
+    virtual bool SetSessionLoaded(const std::string& filePath)
+    {
+        (void)filePath;
+        return false;
+    }
     // 后台准备好新体数据后，由具备 VTK pipeline 写权限的消费线程接管并提交为 current；
     // hasPending 与领取动作在同一锁内产生：false 表示当前无批次，true + 返回 false 表示提交失败。
     // 通常由主线程 Timer 调用，Host 同步事务也可由其绑定线程调用。
     virtual bool SetCurrentFromPending(bool& hasPending) = 0;
+    // 只领取标记为 isPreview 的 pending 批次；完整批次留给 SetCurrentFromPending。
+    // 不支持流式预览的数据源保持默认实现：始终报告无预览。
+    virtual bool SetCurrentFromPreview(bool& hasPreview)
+    {
+        hasPreview = false;
+        return true;
+    }
     // 销毁尚未提交的完整 pending 批次；无 pending 也视为清理成功。
+    // 若 current 仍是已提交的流式预览，同时回滚到预览前的批次并发布为新 version。
     virtual bool ClearPending() = 0;
+    // 领取 version 批次发布时携带的 mask 增量并清空单槽；版本不符、已领取或数据源不保留增量时返回空。
+    // 统计按增量更新一次即缓存本批结果，之后不再需要它；任何新批次发布都会替换单槽。
+    virtual std::shared_ptr<const ValidityMaskDelta> GetMaskDelta(DataVersion version)
+    {
+        (void)version;
+        return nullptr;
+    }
+    // 把为 version 批次算出的 gap 标签体登记到单槽，供会话保存；version 已不是 current、
+    // 标签体不是单分量 int32 或几何与 image 不一致时拒绝。任何新批次发布都会替换单槽。
+    virtual bool SetLabelImage(DataVersion version, vtkSmartPointer<vtkImageData> labelImage)
+    {
+        (void)version;
+        (void)labelImage;
+        return false;
+    }
+    // 返回 version 批次登记的只读标签体；版本不符或未登记时返回空。与 GetMaskDelta 不同，读取不清空单槽。
+    virtual vtkSmartPointer<vtkImageData> GetLabelImage(DataVersion version) const
+    {
+        (void)version;
+        return nullptr;
+    }
     // 导出任务必须传入接纳时冻结的 imageSnapshot；后台不得重新读取 current。
     // outputDir 是 UTF-8 目录；params 一次冻结格式、几何变换与 PLY 颜色映射。
     virtual bool ExportData(
         const ImageSnapshot& imageSnapshot,
         const std::string& outputDir,
         const DataExportParams& params) = 0;
-    // dirPath 为 UTF-8 路径。
-    virtual bool ExportSlices(const std::string& dirPath, Orientation orientation, const WindowLevelParams& windowLevel, const std::array<double, 16>& modelToWorldMatrix) = 0;
+    // 与 ExportData 相同，imageSnapshot 在接纳时冻结，排队期间的裁切或重载不影响本次导出。
+    // dirPath 为 UTF-8 路径；control 可空，逐切片写进度，取消后删除已写出的切片并返回 false。
+    virtual bool ExportSlices(
+        const ImageSnapshot& imageSnapshot,
+        const std::string& dirPath, Orientation orientation, const WindowLevelParams& windowLevel, const std::array<double, 16>& modelToWorldMatrix,
+        const std::shared_ptr<ExportControl>& control = nullptr) = 0;
 };
 
 // ─────────────────────────────────────────────────────────────────────
@@ -97,6 +151,8 @@ public:
     virtual void SetInputData(vtkSmartPointer<vtkDataObject> data) = 0;
     // 默认策略把空 mask 视为整卷有效；体数据策略按需覆盖并消费二值有效域。
     virtual void SetInputMask(vtkSmartPointer<vtkImageData> validityMask) {}
+    // 注入会话共享的降采样层缓存；须在 SetInputData 前调用。未注入时策略自行构建本地降采样管线。
+    virtual void SetImagePyramid(std::shared_ptr<ImagePyramid> pyramid) {}
     virtual void AttachRenderer(vtkSmartPointer<vtkRenderer> renderer) = 0;
     virtual void DetachRenderer(vtkSmartPointer<vtkRenderer> renderer) = 0;
     virtual void SetCamera(vtkSmartPointer<vtkRenderer> renderer) {}
@@ -41,6 +41,12 @@ public:
         double rangeMin,
         double rangeMax,
         const std::array<double, 3>& spacing);
+    // File load 进行中的粗预览：只更新范围/spacing/窗宽窗位并广播结构刷新，
+    // 不改变 load 状态与 dataTrustedState，终态仍由 SetFileDataReady/SetFileLoadFailed 发布。
+    bool SetPreviewDataReady(
+        double rangeMin,
+        double rangeMax,
+        const std::array<double, 3>& spacing);
     bool SetFileLoadFailed();
     bool SetReloadLoadFailed();
     void SetPreInitConfig(const PreInitConfig& config);
@@ -16,6 +16,9 @@
 #include <cstddef>
 #include <string>
 #include <functional>
+#include <memory>
+
+class ExportControl;
 
 using DataVersion = std::uint64_t;
 
@@ -91,6 +94,10 @@ struct DataExportParams final {
     };
     std::array<double, 2> scalarRange = { 0.0, 0.0 };
     std::vector<TFNode> tfNodes;
+    // 网格格式的目标三角形数；0 表示保留全分辨率，超出时以二次误差度量抽稀到该数量附近。
+    std::size_t targetTriangleCount = 0;
+    // 可空的进度与取消槽；导出在 slab / 阶段边界写进度，取消后删除未完成文件并返回 false。
+    std::shared_ptr<ExportControl> control;
 };
 
 // --- 材质参数 ---
@@ -16,6 +16,7 @@
 #include "AppInterfaces.h"
 #include <vtkMatrix4x4.h>
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
@@ -24,6 +25,7 @@
 #include <thread>
 #include <vector>
 
+class ExportTaskQueue;
 class IStateEventSource;
 class SharedInteractionState;
 
@@ -32,7 +34,10 @@ class VizService
 {
 public:
     using TaskWork = std::packaged_task<bool()>;
+    // 只用于 load/reload worker；导出任务统一进入 ExportTaskQueue。
     using TaskStart = std::function<std::thread(TaskWork)>;
+    // 导出进度回调，在 SendUpdates 所在线程调用；progress 为 [0,1] 完成比例。
+    using ExportProgress = std::function<void(std::uint64_t exportId, double progress)>;
     // ================================================================
     // 构造 / 析构
     // 功能：绑定 DataManager、SharedInteractionState 与状态事件源三个核心对象。
@@ -75,6 +80,11 @@ public:
     std::array<double, 3> GetSpacing() const;
     void SetWindowLevel(double ww, double wc);
     void SetVisualConfig(const PreInitConfig& cfg);
+    // 注入会话共享的降采样层缓存；须在首次加载前调用，之后新建的 Strategy 与其它视图共享同一批层。
+    void SetImagePyramid(std::shared_ptr<ImagePyramid> pyramid);
+    // 注入会话共享的导出队列，多个视图的导出共用同一并发上限；nullptr 恢复本 service 自建的队列。
+    // 只影响之后发起的导出，已入队任务留在原队列。
+    void SetExportQueue(std::shared_ptr<ExportTaskQueue> queue);
     PreInitConfig GetVisualConfig() const;
     std::array<double, 2> GetScalarRange() const;
     bool SetVolumeQuality(const VolumeQualityParams& quality);
@@ -103,6 +113,12 @@ public:
         VolumeLayout layout,
         std::function<void(bool isSuccess)> onComplete = nullptr);
 
+    // 打开 SessionArchive 会话文件（UTF-8 路径）：几何、image 与 validityMask 均取自归档，
+    // 不需要 layout；加载状态与完成回调与 LoadFileAsync 相同。
+    bool LoadSessionAsync(
+        std::string path,
+        std::function<void(bool isSuccess)> onComplete = nullptr);
+
     // 重载入口：从上游重建缓冲区导入体数据，命名显式带 Reload。
     bool ReloadFromBufferAsync(
         VolumeBuffer buffer,
@@ -114,17 +130,27 @@ public:
 
     // ================================================================
     // 数据导出任务
-    // 功能：发起后台保存任务，并把保存完成结果延迟回到主线程。
-    // 作用：把导出 I/O 与当前渲染线程解耦。
+    // 功能：把导出任务排入导出队列，并把进度与完成结果延迟回到主线程。
+    // 作用：把导出 I/O 与当前渲染线程解耦，多个导出按队列并发上限排队运行。
     // 实现依赖对象由 Impl 与基础服务状态共同持有。
     // ================================================================
-    void ExportDataAsync(
+    // 返回导出标识；0 表示未能入队，此时 onComplete 仍以 false 回到主线程。
+    // onProgress 在入队后的首个 tick 必定回报一次（任务已失败结束的除外，宿主由此得知标识），之后只在进度前进时回报，
+    // 成功结束时补报 1.0 后再执行 onComplete。
+    // targetTriangleCount 仅对网格格式生效，0 表示全分辨率导出。
+    std::uint64_t ExportDataAsync(
         std::string outputDir,
         std::string extension,
-        std::function<void(bool isSuccess)> onComplete = nullptr);
-    void ExportSlicesAsync(const std::string& path,
+        std::size_t targetTriangleCount = 0,
+        std::function<void(bool isSuccess)> onComplete = nullptr,
+        ExportProgress onProgress = nullptr);
+    std::uint64_t ExportSlicesAsync(const std::string& path,
         std::optional<double> rotationAngleDeg = std::nullopt,
-        std::function<void(bool isSuccess)> onComplete = nullptr);
+        std::function<void(bool isSuccess)> onComplete = nullptr,
+        ExportProgress onProgress = nullptr);
+    // 只取消本 service 发起且尚未结束的导出：排队中立即以失败完成，运行中在下一 slab / 切片边界停止，
+    // 未完成的输出文件随之删除。标识不属于本 service 或已结束时返回 false。
+    bool CancelExport(std::uint64_t exportId);
 
     // ================================================================
     // InteractiveService — 交互接口
@@ -2,6 +2,7 @@
 
 #include "AppInterfaces.h"
 #include "AppState.h"
+#include <cstddef>
 #include <future>
 #include <memory>
 #include <optional>
@@ -9,24 +10,28 @@
 
 // 导出任务需要在调用线程拍下视觉状态快照，再把重采样 / I/O 放到后台执行。
 // 本 service 只负责构造任务和持有保存回调状态，不直接启动线程；
-// 线程托管仍由 VizService 统一完成，避免导出、加载各自发明一套生命周期策略。
+// 任务由 VizService 交给会话共享的 ExportTaskQueue 排队运行，结果仍回到 VizService 统一收口。
 class AppDataExportTaskService
 {
 public:
     AppDataExportTaskService(std::shared_ptr<AbstractDataManager> dataManager,
         std::shared_ptr<SharedInteractionState> sharedState);
 
-    // 在调用线程冻结 image/mask、iso、model-to-world、scalar range 与 TF；目录和规范后缀只透明传递。
+    // 在调用线程冻结 image/mask、iso、model-to-world、scalar range 与 TF；目录、规范后缀、
+    // 网格目标三角形数与可空的进度/取消槽只透明传递。
     std::optional<std::packaged_task<bool()>> BuildDataTask(
         std::string outputDir,
-        std::string extension);
+        std::string extension,
+        std::size_t targetTriangleCount = 0,
+        std::shared_ptr<ExportControl> control = nullptr);
 
     // path 是 UTF-8 输出目录；rotationAngleDeg 为可选角度（度），currentMode 必须对应真实切片方向。
     // 构造阶段快照姿态、世界坐标游标与窗宽窗位，后台只消费这些快照并投递结果。
     std::optional<std::packaged_task<bool()>> BuildSlicesTask(
         std::string path,
         std::optional<double> rotationAngleDeg,
-        VizMode currentMode);
+        VizMode currentMode,
+        std::shared_ptr<ExportControl> control = nullptr);
 
 private:
     // service 与 packaged_task 共享拥有 DataManager，保证后台重采样/I/O 期间数据入口存活。
@@ -19,6 +19,10 @@ public:
         std::string path,
         VolumeLayout layout);
 
+    // path 为 UTF-8 会话归档路径；几何由归档头给出。
+    std::optional<std::packaged_task<bool()>> BuildLoadSessionTask(
+        std::string path);
+
     std::optional<std::packaged_task<bool()>> BuildReloadTask(
         VolumeBuffer buffer);
 
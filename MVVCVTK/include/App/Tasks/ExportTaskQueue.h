@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ExportControl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+
+// 会话共享的导出调度器：任务按 FIFO 排队，最多 concurrency 个同时运行在复用的 worker 线程上。
+// 任务自身仍是 AppDataExportTaskService 构造的 packaged_task；本类只管排队、并发上限与取消，
+// 不解释导出格式，也不触碰 VTK 管线。结果经 future 交回调用方，由其在主线程统一收口。
+// worker 线程在首次入队时按需创建，数量不超过历史最大并发上限；析构时取消全部任务并 join。
+class ExportTaskQueue final {
+public:
+    // concurrency 为 0 时取 1。
+    explicit ExportTaskQueue(std::size_t concurrency = 2);
+    ~ExportTaskQueue();
+    ExportTaskQueue(const ExportTaskQueue&) = delete;
+    ExportTaskQueue& operator=(const ExportTaskQueue&) = delete;
+
+    // 入队成功返回从 1 递增的任务标识并给出 result；task 无效、control 为空或队列已关闭时返回 0。
+    // control 由调用方与 task 共同持有：task 内部据此写进度、检查取消。
+    // 任务结束后先销毁 task（释放其捕获的快照），再让 result 就绪。
+    std::uint64_t StartTask(
+        std::packaged_task<bool()> task,
+        std::shared_ptr<ExportControl> control,
+        std::future<bool>& result);
+    // 排队中的任务立即出队并以 false 就绪，不再运行；运行中的任务只置取消，
+    // 由导出在下一 slab / 切片边界自行停止。任务不存在或已结束时返回 false。
+    bool CancelTask(std::uint64_t taskId);
+
+    // 调整并发上限；已运行的任务不被打断，上限降低时待其结束后才按新上限调度。concurrency 为 0 时取 1。
+    void SetConcurrency(std::size_t concurrency);
+    std::size_t GetConcurrency() const;
+    std::size_t GetQueuedCount() const;
+    std::size_t GetRunningCount() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
@@ -2,25 +2,87 @@
 #include <vtkTable.h>
 #include <vtkImageData.h>
 #include <vtkSmartPointer.h>
-#include <vtkImageAccumulate.h>
 #include <vtkType.h>
+#include "VolumeTypes.h"
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
+#include <vector>
+
+// 直方图 bin 划分方式。Linear 与加载期统计一致；Log 按 log1p(v-min) 等分，压缩重尾 CT 的高值段；
+// Adaptive 先以细线性 bin 累计再按样本数等分合并，稀疏尾部自动变宽。常量体一律退化为 Linear。
+enum class HistogramBinning {
+    Linear,
+    Log,
+    Adaptive
+};
 
 // 数据分析转换图表对象
 class HistogramConverter {
 private:
-    int m_binCount = 2048; // 默认 Bin 数量
-    vtkSmartPointer<vtkImageAccumulate> m_accumulate; // 持久化，支持流式复用
+    int m_binCount = VolumeStatistics::kHistogramBinCount; // 默认 Bin 数量，与加载期统计一致
+    HistogramBinning m_binning = HistogramBinning::Linear;
+    // 单槽统计缓存：同一数据版本、同一 image/mask 及其修改时间只扫描一次。只比较地址不持有对象，
+    // 旧批次释放不受缓存影响；version 在提交间唯一，地址复用不会误命中。
+    std::uint64_t m_cachedVersion = 0;
+    const vtkImageData* m_cachedImage = nullptr;
+    const vtkImageData* m_cachedMask = nullptr;
+    vtkMTimeType m_cachedImageTime = 0;
+    vtkMTimeType m_cachedMaskTime = 0;
+    std::shared_ptr<const VolumeStatistics> m_cachedStatistics;
+    // 增量更新所需的父批状态：scalar 数组身份与修改时间、归 bin 参数及未合并计数
+    // （Linear/Log 即 histogram，Adaptive 为细 bin）。
+    const vtkDataArray* m_cachedScalars = nullptr;
+    vtkMTimeType m_cachedScalarsTime = 0;
+    HistogramBinning m_cachedBinning = HistogramBinning::Linear;
+    double m_cachedBinSpacing = 1.0;
+    double m_cachedLogScale = 0.0;
+    std::vector<std::uint64_t> m_cachedCounts;
 public:
     bool SetBinCount(int binCount);
-    vtkSmartPointer<vtkTable> GetOutputData(vtkSmartPointer<vtkImageData> input);
-    std::optional<double> GetHistogramPercentile(vtkImageData* image, double quantile);
+    void SetBinning(HistogramBinning binning);
+    HistogramBinning GetBinning() const { return m_binning; }
+    // validityMask 语义同 GetStatistics；Intensity 列为各 bin 起点。
+    vtkSmartPointer<vtkTable> GetOutputData(
+        vtkSmartPointer<vtkImageData> input,
+        vtkImageData* validityMask = nullptr);
+    std::optional<double> GetHistogramPercentile(
+        vtkImageData* image,
+        double quantile,
+        vtkImageData* validityMask = nullptr);
+    // 加载期统计已含直方图时只做 O(bins) 查表，不再扫描体数据；规则与 image 重载相同。
+    static std::optional<double> GetHistogramPercentile(
+        const VolumeStatistics& statistics,
+        double quantile);
+    // 一次累计扫描回答整批分位数，结果与 quantiles 顺序对应；任一分位数越界或统计不可用时返回空。
+    static std::optional<std::vector<double>> GetHistogramPercentiles(
+        const VolumeStatistics& statistics,
+        const std::vector<double>& quantiles);
+    // 不超过 value 所在 bin 的样本比例；低于范围为 0，不低于范围上界为 1。
+    static std::optional<double> GetHistogramCdf(
+        const VolumeStatistics& statistics,
+        double value);
+    // 逐 bin 累计比例，末项为 1；统计不可用时返回空数组。
+    static std::vector<double> BuildHistogramCdf(const VolumeStatistics& statistics);
+
+    // 直方图统计：范围取 image 全部非 NaN 标量，只累计 validityMask 非 0 的体素，mask 为空表示整卷有效；
+    // Linear 划分与 vtkImageAccumulate 逐 bin 一致。各线程独占 bin 数组后归并，计数与调度顺序无关。
+    // dataVersion 非 0 时按版本缓存，为 0 时按对象修改时间缓存；image 或 mask 不合法时返回空。非线程安全。
+    // maskDelta 指向本批 mask 且缓存恰为其父批、scalar 数组未变时，只对 removedRuns 覆盖的体素归 bin 并从父批计数扣减，
+    // 代价与变化体素数成正比；条件不满足或扣减出现负数时退回整卷扫描。
+    std::shared_ptr<const VolumeStatistics> GetStatistics(
+        vtkImageData* image,
+        vtkImageData* validityMask,
+        std::uint64_t dataVersion,
+        const ValidityMaskDelta* maskDelta = nullptr);
+    // 以已知的整卷统计（如加载期统计）预置无 mask 批次的缓存，供后续裁切增量更新；
+    // 仅接受与当前 bin 数和 Linear 划分一致、范围与 image 相同的统计，否则返回 false 且缓存不变。
+    bool SetCachedStatistics(
+        vtkImageData* image,
+        std::uint64_t dataVersion,
+        std::shared_ptr<const VolumeStatistics> statistics);
 
     // 直方图转图片；filePath 为 UTF-8 路径。
     void ExportHistogram(vtkSmartPointer<vtkImageData> input, const std::string& filePath);
-
-private:
-    // 内部复用：执行 accumulate 并返回频率指针，供 GetOutputData 与 ExportHistogram 共用同一管线。
-    vtkIdType* GetHistogramBuffer(vtkImageData* input, double outRange[2], double& outBinWidth);
 };
@@ -1,9 +1,13 @@
 #pragma once
 #include "AppInterfaces.h"
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <string>
 
+class VolumeCache;
+
 class BaseDataManager : public AbstractDataManager
 {
 protected:
@@ -13,7 +17,13 @@ protected:
 
     // 提交由派生类独占构造的 image，避免 TIFF 读取完成后再次复制整卷体素。
     bool SetOwnedImage(vtkSmartPointer<vtkImageData> image);
-    bool SetPendingImage(ImageState image);
+    // 放入 pending 单槽，覆盖未领取的旧候选；派生类可包装以观察批次交付顺序。
+    virtual bool SetPendingImage(ImageState image);
+    std::shared_ptr<const VolumeCache> GetVolumeCache() const;
+    // 缓存命中时依次发布预览与完整 pending 批次并返回 true；未挂接缓存或未命中返回 false，由调用方正常加载。
+    bool SetCachedImage(const std::string& filePath, const VolumeLayout& layout);
+    // 发布文件加载得到的 pending 批次；挂接缓存时随后在后台把同一批次写入缓存，写入失败只记录告警。
+    bool SetLoadedImage(const std::string& filePath, const VolumeLayout& layout, ImageState image);
 public:
     BaseDataManager();
     ~BaseDataManager() override;
@@ -36,15 +46,26 @@ public:
 
     // 基础/TIFF 数据源不支持 buffer pending 事务；RawVolumeDataManager 显式覆盖这两个入口。
     bool SetFromBuffer(const VolumeBuffer& buffer) override;
+    // 映射 SessionArchive 并把还原出的 image+mask、标签体与裁切历史放入完整 pending 批次；不经过磁盘缓存。
+    bool SetSessionLoaded(const std::string& filePath) override;
     bool SetCurrentFromPending(bool& hasPending) override;
+    bool SetCurrentFromPreview(bool& hasPreview) override;
     bool ClearPending() override;
+    std::shared_ptr<const ValidityMaskDelta> GetMaskDelta(DataVersion version) override;
+    bool SetLabelImage(DataVersion version, vtkSmartPointer<vtkImageData> labelImage) override;
+    vtkSmartPointer<vtkImageData> GetLabelImage(DataVersion version) const override;
+    // 为后续 SetDataLoaded 挂接磁盘缓存；nullptr 关闭。正在进行的加载继续使用入口处取得的缓存。
+    void SetVolumeCache(std::shared_ptr<const VolumeCache> cache);
 
     bool ExportData(
         const ImageSnapshot& imageSnapshot,
         const std::string& outputDir,
         const DataExportParams& params) override;
     // dirPath 为 UTF-8 路径。
-    bool ExportSlices(const std::string& dirPath, Orientation orientation, const WindowLevelParams& windowLevel, const std::array<double, 16>& modelToWorldMatrix) override;
+    bool ExportSlices(
+        const ImageSnapshot& imageSnapshot,
+        const std::string& dirPath, Orientation orientation, const WindowLevelParams& windowLevel, const std::array<double, 16>& modelToWorldMatrix,
+        const std::shared_ptr<ExportControl>& control = nullptr) override;
 };
 
 class RawVolumeDataManager : public BaseDataManager {
@@ -62,7 +83,17 @@ public:
     // 具备 VTK pipeline 写权限的消费线程领取 pending payload，触发 Modified() 后提交完整 current 图像状态。
     bool SetCurrentFromPending(bool& hasPending) override;
     bool ClearPending() override;
+    // 文件字节数不小于阈值时按 Z slab 流式读取，并在读取过程中发布 1/8 分辨率预览；
+    // 0 表示总是流式，SIZE_MAX 表示关闭。
+    void SetStreamThreshold(std::size_t byteCount) noexcept;
+
+private:
+    bool SetDataStreamed(
+        const std::string& filePath,
+        const VolumeLayout& layout,
+        vtkSmartPointer<vtkImageData> newImage);
 
+    std::atomic<std::size_t> m_streamThreshold;
 };
 
 class TiffVolumeDataManager : public BaseDataManager {
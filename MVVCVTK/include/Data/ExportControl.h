@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// 单个导出任务的进度与取消共享槽：worker 在 slab / 切片边界写进度并检查取消，
+// 调用方只读进度、只置取消。进度单调不减，取消一经置位不可撤销。
+class ExportControl final {
+public:
+    // doneCount / totalCount 折算为 [0,1]；并行完成顺序不定时只保留较大的值。
+    void SetProgress(std::size_t doneCount, std::size_t totalCount)
+    {
+        if (totalCount == 0) {
+            return;
+        }
+        const double progress = doneCount >= totalCount
+            ? 1.0
+            : static_cast<double>(doneCount) / static_cast<double>(totalCount);
+        double current = m_progress.load(std::memory_order_relaxed);
+        while (current < progress
+            && !m_progress.compare_exchange_weak(
+                current, progress, std::memory_order_relaxed)) {
+        }
+    }
+
+    double GetProgress() const
+    {
+        return m_progress.load(std::memory_order_relaxed);
+    }
+
+    void SetCancelled()
+    {
+        m_isCancelled.store(true, std::memory_order_relaxed);
+    }
+
+    bool GetIsCancelled() const
+    {
+        return m_isCancelled.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<double> m_progress{ 0.0 };
+    std::atomic<bool> m_isCancelled{ false };
+};
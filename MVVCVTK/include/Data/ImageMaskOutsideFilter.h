@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vtkImageAlgorithm.h>
+#include <vtkSmartPointer.h>
+
+// 等值面提取前的体素空间 mask 预处理：输出范围收缩到 mask 有效包围盒外扩一体素，
+// mask 为 0 的体素写成低于输入标量范围的"外侧值"，其余体素原样复制。下游 flying edges 据此
+// 把无效区当作等值面外侧，切口在提取时直接闭合，不再需要逐顶点查询 mask 的 clip 二次遍历。
+// 外侧值为 max(类型下界, min - max(1, max - min))，对任何高于外侧值的 iso 都在外侧：通常即
+// 任何不低于数据最小值的 iso；无符号类型且 min 贴近 0 时外侧值被夹为 0，需 iso > 0。
+// 未设置 mask 或 mask 全有效时输出直接共享输入 scalar；否则复制有效包围盒内的体素，
+// 复制结果随 pipeline 缓存，只在输入或 mask 变化时重做，iso 变化不触发。
+class ImageMaskOutsideFilter : public vtkImageAlgorithm {
+public:
+    static ImageMaskOutsideFilter* New();
+    vtkTypeMacro(ImageMaskOutsideFilter, vtkImageAlgorithm);
+
+    // mask 须为单分量 uchar 且 extent/origin/spacing 与输入一致，非 0 表示有效；nullptr 清除 mask。
+    // 只持有数据对象，不接入 pipeline；mask 原地修改时 GetMTime 会带上它的修改时间。
+    bool SetMask(vtkImageData* validityMask);
+    vtkImageData* GetMask() const;
+    vtkMTimeType GetMTime() override;
+
+protected:
+    ImageMaskOutsideFilter() = default;
+    ~ImageMaskOutsideFilter() override = default;
+
+    int RequestInformation(
+        vtkInformation* request,
+        vtkInformationVector** inputVector,
+        vtkInformationVector* outputVector) override;
+    int RequestData(
+        vtkInformation* request,
+        vtkInformationVector** inputVector,
+        vtkInformationVector* outputVector) override;
+
+private:
+    ImageMaskOutsideFilter(const ImageMaskOutsideFilter&) = delete;
+    ImageMaskOutsideFilter& operator=(const ImageMaskOutsideFilter&) = delete;
+
+    // 按 mask MTime 缓存有效体素包围盒与是否整卷有效；全无效时为空 extent。
+    bool SetValidExtent();
+
+    vtkSmartPointer<vtkImageData> m_mask;
+    vtkMTimeType m_validExtentTime = 0;
+    int m_validExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    bool m_isMaskFull = false;
+};
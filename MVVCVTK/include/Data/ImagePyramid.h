@@ -0,0 +1,56 @@
+#pragma once
+
+#include "AppInterfaces.h"
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+enum class PyramidLevelKind : std::uint8_t {
+    Image, // 线性插值的显示体
+    Mask   // 保持 0/255 的二值有效域
+};
+
+// 会话级多分辨率层缓存：以源 vtkImageData 身份与 MTime、目标最大轴尺寸和层类型为键，
+// 同一层只计算一次，所有视图共享只读输出。源 image 释放或快照换代后对应层被淘汰。
+// 返回的 vtkImageData 为共享只读层；调用方需要独立几何或 pipeline 时自行 ShallowCopy 外壳。
+class ImagePyramid final {
+public:
+    ImagePyramid();
+    ~ImagePyramid();
+    ImagePyramid(const ImagePyramid&) = delete;
+    ImagePyramid& operator=(const ImagePyramid&) = delete;
+
+    // 返回 input 最大轴不超过 targetDim 的层；已在其它线程构建中的同键层等待其结果而不重复计算。
+    // input 为空、targetDim 非正或重采样失败时返回 nullptr。
+    vtkSmartPointer<vtkImageData> GetLevel(
+        vtkImageData* input,
+        int targetDim,
+        PyramidLevelKind kind = PyramidLevelKind::Image);
+
+    // 并行构建 targetDims 中尚未缓存的层并等待全部完成；任一层失败返回 false，成功的层仍保留。
+    bool SetLevels(
+        vtkImageData* input,
+        const std::vector<int>& targetDims,
+        PyramidLevelKind kind = PyramidLevelKind::Image);
+
+    // 快照换代入口：淘汰不属于 snapshot image/mask 的层，并行预建两者的 766 显示层。
+    // 同一 image 与 version 重复调用直接返回 true。
+    bool SetSnapshot(const ImageSnapshot& snapshot);
+
+    // 第 level 级金字塔（每级最大轴减半，向上取整）的目标尺寸；level 为 0 时返回原最大轴。
+    static int GetLevelDim(vtkImageData* input, int level);
+
+    std::size_t GetLevelCount() const;
+    // 实际执行过的重采样次数，供诊断缓存命中率。
+    std::size_t GetBuildCount() const;
+    void Clear();
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+
+class vtkPolyData;
+class vtkUnsignedCharArray;
+
+// 网格导出用二进制序列化：直接读取模型空间三角网格，按固定块烘焙 model-to-world 后顺序写盘，
+// 不再生成变换后的整份 polydata。块内点变换与三角形打包由 vtkSMPTools 并行，块缓冲写出后复用。
+// 只接受纯三角 polys（verts/lines 忽略，strips 拒绝）；多字节字段统一按 little-endian 写出。
+class MeshWriter final {
+public:
+    // vertex 依次为 float x/y/z、可选 float nx/ny/nz 与可选 uchar red/green/blue，face 为 uchar 计数 + int 索引；
+    // 字段与 vtkPLYWriter 二进制输出一致，vtkPLYReader 可读回 Normals 与 "RGB"。colors 为空时不写颜色。
+    static bool SetPly(
+        const std::filesystem::path& filePath,
+        vtkPolyData* mesh,
+        const std::array<double, 16>& modelToWorld,
+        vtkUnsignedCharArray* colors);
+
+    // 80 字节头 + uint32 三角形数 + 每面 12 个 float 与 uint16 属性；面法向取世界坐标顶点叉积。
+    static bool SetStl(
+        const std::filesystem::path& filePath,
+        vtkPolyData* mesh,
+        const std::array<double, 16>& modelToWorld);
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "AppInterfaces.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 可保存与重开的完整会话：全分辨率 image 与可空 validityMask、可空 gap 标签体与裁切历史。
+struct SessionSnapshot {
+    // image 必须为单分量；validityMask 为单分量 uchar 且几何与 image 一致。version 与 isPreview 不落盘。
+    ImageState state;
+    // 可空的 GapAnalysis 标签体：单分量 int32，几何与 image 一致，0 表示非保留区域。
+    vtkSmartPointer<vtkImageData> labelImage;
+    std::vector<SessionCropOp> cropOperations;
+};
+
+// 原生会话容器：各层按 Z slab 分块独立压缩并带块表，image 用 LZ4，mask 与标签体用游程编码。
+// 读取时只映射文件并校验头与块表，块在真正被请求时才解压；整层读取按块并行。
+class SessionArchive final {
+public:
+    enum class Layer : std::uint32_t {
+        Image = 0,
+        Mask = 1,
+        Label = 2
+    };
+
+    // filePath 为 UTF-8；先写同目录临时文件再改名替换，失败时删除临时文件。
+    // chunkBytes 为每块目标原始字节数（至少一整张切片），0 取默认 4 MiB。
+    // control 可空：每批块落盘后写进度并检查取消；取消时删除临时文件、不改名，同名旧归档保持原样。
+    static bool SetSession(
+        const std::string& filePath,
+        const SessionSnapshot& snapshot,
+        std::size_t chunkBytes = 0,
+        const std::shared_ptr<ExportControl>& control = nullptr);
+
+    SessionArchive();
+    ~SessionArchive();
+    SessionArchive(const SessionArchive&) = delete;
+    SessionArchive& operator=(const SessionArchive&) = delete;
+
+    // 映射文件并校验魔数、版本、几何与全部块表；不解压任何块。失败时对象回到未加载状态。
+    bool Load(const std::string& filePath);
+    void Clear();
+
+    bool HasLayer(Layer layer) const;
+    // 以下元数据在 Load 成功后可用，不触发解压。
+    const std::array<int, 3>& GetDimensions() const;
+    const std::array<double, 3>& GetSpacing() const;
+    const std::array<double, 3>& GetOrigin() const;
+    const std::array<double, 2>& GetScalarRange() const;
+    // 归档中的加载期统计；未保存统计时为空。
+    const std::shared_ptr<const VolumeStatistics>& GetStatistics() const;
+    const std::vector<SessionCropOp>& GetCropOperations() const;
+    // 层的 VTK 标量类型；层不存在时返回 0。
+    int GetScalarType(Layer layer) const;
+
+    // 只解压覆盖 Z 闭区间 [zBegin, zEnd] 的块，把这些切片按 x-fast 连续写入 target。
+    // target 至少容纳 (zEnd - zBegin + 1) 张该层切片；区间越界、层不存在或块损坏时返回 false。
+    bool GetSlices(Layer layer, int zBegin, int zEnd, void* target) const;
+    // 按块并行解压整层为新的 vtkImageData；失败返回 nullptr。
+    vtkSmartPointer<vtkImageData> GetImage(Layer layer) const;
+    // 解压全部层并还原统计与裁切历史；state.version 为 0，调用方入库时再编号。
+    bool GetSession(SessionSnapshot& snapshot) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
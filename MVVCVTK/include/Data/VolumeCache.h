@@ -0,0 +1,38 @@
+#pragma once
+
+#include "AppInterfaces.h"
+#include "Data/VolumeTypes.h"
+
+#include <functional>
+#include <string>
+
+// 已加载体数据的本地磁盘缓存：以源路径、mtime、字节数与 VolumeLayout 为键，保存 RAS 顺序的单分量 scalar、
+// 加载统计与 1/8 点采样预览。体素按固定块 LZ4 压缩并带块表，命中时映射缓存文件并行解压各块。
+// 源为 TIFF 目录时，mtime/字节数取目录内全部普通文件的最大值与总和。
+class VolumeCache final {
+public:
+    // 命中后、完整体解压前交付的预览批次；isPreview 为 true，原点与完整体一致，spacing 按步长放大。
+    using PreviewVisit = std::function<void(ImageState preview)>;
+
+    // directoryPath 为 UTF-8；目录不存在时在首次写入时创建。
+    explicit VolumeCache(std::string directoryPath);
+
+    const std::string& GetDirectory() const noexcept;
+
+    // 键完全一致且文件结构校验通过才算命中，state 返回未编号（version 为 0）的完整批次。
+    // 未命中、缓存损坏或分配失败均返回 false 且不回调预览之外的任何副作用，调用方回退正常加载。
+    bool GetVolume(
+        const std::string& sourcePath,
+        const VolumeLayout& layout,
+        const PreviewVisit& visitPreview,
+        ImageState& state) const;
+
+    // 只接受单分量 image；先写同目录临时文件再改名替换，失败时删除临时文件，不影响已加载数据。
+    bool SetVolume(
+        const std::string& sourcePath,
+        const VolumeLayout& layout,
+        const ImageState& state) const;
+
+private:
+    std::string m_directory;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+struct VolumeStatistics;
+
+// LPS x-fast 体素到内部 RAS 布局的翻转内核；RAW、buffer 与 TIFF 三条加载链共用。
+// X 与 Y 同时翻转等价于把每个 Z 层的 x-fast 序列整体倒序，因此内核只需按层做连续倒序流。
+// 层内再切成固定块并交给 vtkSMPTools 并行；元素尺寸在编译期特化，1/2/4/8 字节走 SIMD 倒序。
+class VolumeReorder final {
+public:
+    // src 与 dst 均为连续 x-fast 存储且互不重叠；dims 为 [x,y,z] 元素数，elementBytes 为单个体素
+    // （含全部分量）的字节数。任一参数无效或尺寸乘积溢出时返回 false，且不写 dst。
+    static bool SetRasScalars(
+        const void* src,
+        void* dst,
+        const std::array<std::size_t, 3>& dims,
+        std::size_t elementBytes);
+
+    // 原地版本：供流式加载逐 slab 读入的已独占存储使用，避免再分配一份目标体。
+    static bool SetRasScalarsInPlace(
+        void* data,
+        const std::array<std::size_t, 3>& dims,
+        std::size_t elementBytes);
+
+    // 带统计的翻转：scalarType 为单分量 VTK 标量类型 id（VTK_FLOAT 等，不含 64 位整数）。
+    // min/max 与可选 checksum 在块写出后趁缓存仍热时顺带累计；直方图依赖全局范围，归并后再并行扫一遍。
+    // 类型不受支持或参数无效时返回 false 且不写数据；体内无有限范围时仍完成翻转，但 histogram 为空。
+    static bool SetRasScalars(
+        const void* src,
+        void* dst,
+        const std::array<std::size_t, 3>& dims,
+        int scalarType,
+        bool hasChecksum,
+        VolumeStatistics& statistics);
+
+    static bool SetRasScalarsInPlace(
+        void* data,
+        const std::array<std::size_t, 3>& dims,
+        int scalarType,
+        bool hasChecksum,
+        VolumeStatistics& statistics);
+
+    // 对已是 RAS 顺序的体只做统计，不改写数据；用于分段翻转（流式加载）后的整卷收尾。
+    // 结果与带统计的翻转逐字段一致，checksum 同样与分块方式无关。
+    static bool GetStatistics(
+        const void* data,
+        const std::array<std::size_t, 3>& dims,
+        int scalarType,
+        bool hasChecksum,
+        VolumeStatistics& statistics);
+};
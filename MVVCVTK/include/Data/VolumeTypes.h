@@ -2,20 +2,37 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <variant>
 #include <vector>
 
-// float32 三维体数据的已验证几何描述；Create 同时计算并校验 voxel/byte 数，避免调用方重复乘法溢出。
+class vtkDataArray;
+
+// 单分量体素的存储类型；工业 CT 多为 16 位，按原生宽度存储可省去一半内存与带宽。
+enum class VolumeScalarType : std::uint8_t {
+    UInt8,
+    UInt16,
+    Int16,
+    Float32
+};
+
+// 三维体数据的已验证几何与标量描述；Create 同时计算并校验 voxel/byte 数，避免调用方重复乘法溢出。
 class VolumeLayout final {
 public:
     static std::optional<VolumeLayout> Create(
         std::array<int, 3> dimensions,
         std::array<float, 3> spacing,
-        std::array<float, 3> origin);
+        std::array<float, 3> origin,
+        VolumeScalarType scalarType = VolumeScalarType::Float32);
+
+    // 单个体素的字节数；未知枚举值返回 0。
+    static std::size_t GetScalarBytes(VolumeScalarType scalarType) noexcept;
 
     const std::array<int, 3>& GetDimensions() const noexcept;
     const std::array<float, 3>& GetSpacing() const noexcept;
     const std::array<float, 3>& GetOrigin() const noexcept;
+    VolumeScalarType GetScalarType() const noexcept;
     std::size_t GetVoxelCount() const noexcept;
     std::size_t GetByteCount() const noexcept;
 
@@ -24,29 +41,99 @@ private:
         std::array<int, 3> dimensions,
         std::array<float, 3> spacing,
         std::array<float, 3> origin,
+        VolumeScalarType scalarType,
         std::size_t voxelCount,
         std::size_t byteCount) noexcept;
 
     std::array<int, 3> m_dimensions{}; // X/Y/Z 体素数，均为正数。
     std::array<float, 3> m_spacing{};  // X/Y/Z 物理间距，有限且大于零。
     std::array<float, 3> m_origin{};   // 物理原点，必须为有限值。
+    VolumeScalarType m_scalarType = VolumeScalarType::Float32; // 单分量体素存储类型。
     std::size_t m_voxelCount = 0;      // dimensions 安全乘积。
-    std::size_t m_byteCount = 0;       // voxelCount * sizeof(float) 的安全乘积。
+    std::size_t m_byteCount = 0;       // voxelCount * GetScalarBytes(scalarType) 的安全乘积。
 };
 
-// 拥有 voxel 存储及其匹配布局的不可分割值对象；Create 拒绝元素数不一致的组合。
+// 拥有 voxel 存储及其匹配布局的不可分割值对象；Create 拒绝元素数或标量类型与 layout 不一致的组合。
 class VolumeBuffer final {
 public:
     static std::optional<VolumeBuffer> Create(
         std::vector<float> voxels,
         VolumeLayout layout);
+    static std::optional<VolumeBuffer> Create(
+        std::vector<std::uint8_t> voxels,
+        VolumeLayout layout);
+    static std::optional<VolumeBuffer> Create(
+        std::vector<std::uint16_t> voxels,
+        VolumeLayout layout);
+    static std::optional<VolumeBuffer> Create(
+        std::vector<std::int16_t> voxels,
+        VolumeLayout layout);
 
+    // 仅 Float32 布局返回实际体素；其它标量类型返回空 vector，调用方应改用 GetData。
     const std::vector<float>& GetVoxels() const noexcept;
+    // 按 layout 标量类型解释的连续 x-fast 存储首地址。
+    const void* GetData() const noexcept;
     const VolumeLayout& GetLayout() const noexcept;
 
 private:
-    VolumeBuffer(std::vector<float> voxels, VolumeLayout layout) noexcept;
+    using Storage = std::variant<
+        std::vector<std::uint8_t>,
+        std::vector<std::uint16_t>,
+        std::vector<std::int16_t>,
+        std::vector<float>>;
+
+    VolumeBuffer(Storage voxels, VolumeLayout layout) noexcept;
+
+    Storage m_voxels;      // X 最快的连续单分量标量，元素类型与 layout 一致。
+    VolumeLayout m_layout; // 与 voxels 数量严格匹配的几何和字节计数。
+};
+
+// 加载翻转同批得到的标量统计；直方图沿用 HistogramConverter 的 bin 约定（起点为 scalarRange[0]，
+// 宽度为 range/(bins-1)），分位数查询因此与 vtkImageAccumulate 路径逐 bin 一致。
+struct VolumeStatistics {
+    static constexpr int kHistogramBinCount = 2048;
+
+    std::array<double, 2> scalarRange = { 0.0, 0.0 }; // 非 NaN 标量闭区间 [min,max]
+    std::vector<std::uint64_t> histogram;             // 各 bin 计数；空表示统计不可用
+    double binWidth = 0.0;                            // 单 bin 物理宽度；常量体或非线性 bin 为 0
+    // 非线性 bin 的升序起点，与 histogram 等长；空表示按 binWidth 等宽。加载期统计恒为等宽，缓存与归档不存此项。
+    std::vector<double> binStarts;
+    std::uint64_t checksum = 0;                       // RAS 顺序的位置相关校验和，与分块/线程无关
+    bool hasChecksum = false;
+};
+
+// 一段被裁掉的体素：x 最快线性序号的半开区间 [begin,end)。
+struct ValidityMaskRun {
+    std::uint64_t begin = 0;
+    std::uint64_t end = 0;
+
+    bool operator==(const ValidityMaskRun& other) const noexcept
+    {
+        return begin == other.begin && end == other.end;
+    }
+};
+
+// 相邻两批有效域之差：子批 mask 由 parentVersion 批次的 mask 去掉 removedRuns 覆盖的体素得到，scalar 不变。
+// 区间非空、按 begin 升序且互不重叠；裁切逐行产出连续段，表长与被切到的行数相当而不随裁掉的体素数增长。
+// maskScalars 为子批 mask 数组，只用于核对归属，不持有对象。
+struct ValidityMaskDelta {
+    std::uint64_t parentVersion = 0;
+    const vtkDataArray* maskScalars = nullptr;
+    std::vector<ValidityMaskRun> removedRuns;
+};
 
-    std::vector<float> m_voxels; // X 最快的连续单分量 float32 标量。
-    VolumeLayout m_layout;       // 与 voxels 数量严格匹配的几何和字节计数。
+// 已物化进图像批次的一次裁切参数；字段与 OrthogonalCrop 的 CropOpItem 一一对应，枚举按底层整数保存，
+// 核心层因此不依赖 feature 头文件，由 feature 侧负责与 CropOpItem 互转。会话归档按此结构落盘。
+struct SessionCropOp {
+    std::uint64_t operationIndex = 0;
+    std::int32_t geometryType = 0;
+    std::int32_t removalMode = 0;
+    std::array<double, 16> boxToInputModelMatrix = {
+        1.0, 0.0, 0.0, 0.0,
+        0.0, 1.0, 0.0, 0.0,
+        0.0, 0.0, 1.0, 0.0,
+        0.0, 0.0, 0.0, 1.0
+    };
+    std::array<double, 3> planeCenterInInputModel = { 0.0, 0.0, 0.0 };
+    std::array<double, 3> planeNormalInInputModel = { 0.0, 0.0, 1.0 };
 };
@@ -5,6 +5,8 @@
 #include <functional>
 #include <memory>
 
+class ExportTaskQueue;
+class ImagePyramid;
 class RawVolumeDataManager;
 class SharedInteractionState;
 class SharedStateBroadcaster;
@@ -20,6 +22,10 @@ struct HostCoreServices {
     std::shared_ptr<SharedStateBroadcaster> sharedStateBroadcaster;
     // 会话共享状态真源；render view 和 feature 只读/更新这里，不各自缓存加载状态。
     std::shared_ptr<SharedInteractionState> sharedState;
+    // 会话共享的降采样层缓存；全部 3D 视图对同一快照只计算一次显示层。为空时各视图自建。
+    std::shared_ptr<ImagePyramid> sharedPyramid;
+    // 会话共享的导出队列；全部视图的导出共用一个并发上限，避免多窗口同时导出时各自起线程争抢 IO。
+    std::shared_ptr<ExportTaskQueue> sharedExportQueue;
 
     // 返回只弱观察数据真源的冻结快照读取能力；core 销毁后返回空快照。
     std::function<ImageSnapshot()> GetImageReader() const;
@@ -28,4 +34,8 @@ struct HostCoreServices {
         ImageState,
         const ImageSnapshot&,
         ImageSnapshot&)> GetImageWriter() const;
+    // 返回按 version 登记 gap 标签体的能力；只弱观察数据真源，core 销毁后返回 false。
+    std::function<bool(
+        DataVersion,
+        vtkSmartPointer<vtkImageData>)> GetLabelWriter() const;
 };
@@ -34,6 +34,10 @@ struct HostFeatureContext final {
         ImageState,
         const ImageSnapshot&,
         ImageSnapshot&)> setImageState;
+    // 把 feature 为 version 批次算出的 gap 标签体登记到数据真源，供会话保存；批次已被替换时返回 false。
+    std::function<bool(
+        DataVersion,
+        vtkSmartPointer<vtkImageData>)> setLabelImage;
     // Feature 只上报已经由自身业务解析出的精确参与服务；宿主验证这些服务属于当前
     // view set，并负责维护活动来源，不向 Feature 暴露质量配置或渲染策略。
     std::function<bool(
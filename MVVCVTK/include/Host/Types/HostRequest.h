@@ -1,9 +1,14 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 
 using HostCompleteCallback =
     std::function<void(bool isSuccess)>;
+// 导出进度回调：在 host tick 线程调用，进度单调不减；首个 tick 必定回报一次（已失败结束的除外），
+// 调用方据此拿到 exportId 用于 HostExportCancelRequest。成功时在完成回调前补报 1.0。
+using HostProgressCallback =
+    std::function<void(std::uint64_t exportId, double progress)>;
 
 struct HostRequest {
     virtual ~HostRequest() = default;
@@ -4,6 +4,8 @@
 #include "Host/Types/HostValueTypes.h"
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -11,6 +13,7 @@
 struct HostLoadRequest final : HostRequest {
     std::string filePath; // UTF-8 文件路径。
     HostVolumeGeometry geometry;
+    HostScalarType scalarType = HostScalarType::Float32; // 文件内体素类型，决定 layout 字节数。
 };
 
 struct HostReloadRequest final : HostRequest {
@@ -18,12 +21,20 @@ struct HostReloadRequest final : HostRequest {
     HostVolumeGeometry geometry; // dimensions 的乘积必须与 voxels.size() 一致。
 };
 
+// 打开由 HostDataExportFormat::Session 保存的会话归档；几何取自归档头，按文件加载发布状态。
+struct HostSessionOpenRequest final : HostRequest {
+    std::string filePath; // UTF-8 .mvs 文件路径。
+};
+
 struct HostDataExportRequest final : HostRequest {
     std::string outputPath; // UTF-8 输出目录；文件名由 Data 层基于冻结数据生成。
     // 缺省时由 sourceView 模式收敛：体渲染导出 RAW，等值面导出 PLY。
     std::optional<HostDataExportFormat> format;
     // 未指定 selector 时使用 Primary3D。
     HostViewTarget sourceView;
+    // 仅网格格式生效：超过该三角形数时抽稀；0 表示全分辨率，RAW 忽略。
+    std::size_t targetTriangleCount = 0;
+    HostProgressCallback onProgress; // 可为空。
 };
 
 struct HostSliceExportRequest final : HostRequest {
@@ -31,6 +42,12 @@ struct HostSliceExportRequest final : HostRequest {
     // 热键缺省时由触发窗口补齐；显式请求仅在需要指定切片方向时设置。
     HostViewTarget sourceView;
     std::optional<double> angleDeg; // 可选的平面内旋转角；未提供时保持目标视图当前方向。
+    HostProgressCallback onProgress; // 可为空。
+};
+
+// 取消一个仍在排队或运行的导出；被取消的导出以失败完成，已写出的部分文件会被删除。
+struct HostExportCancelRequest final : HostRequest {
+    std::uint64_t exportId = 0; // 来自导出请求的进度回调。
 };
 
 struct HostViewSetRequest final : HostRequest {
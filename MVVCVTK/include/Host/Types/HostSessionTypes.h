@@ -80,4 +80,5 @@ struct HostRenderViewEndpoint {
 
 struct HostSessionConfig {
     std::vector<HostRenderViewConfig> renderViews; // 声明顺序即 topology 顺序，也决定多目标返回与首选窗口顺序。
+    std::string volumeCacheDirectory; // UTF-8；非空时文件加载先查磁盘缓存，未命中加载完成后在后台写入。
 };
@@ -11,6 +11,14 @@ struct HostVolumeGeometry {
     std::array<float, 3> origin{};             // 输入体数据的物理原点。
 };
 
+// RAW 文件的单分量体素类型；按原生宽度加载，16 位 CT 不再扩展为 float32。
+enum class HostScalarType {
+    UInt8,
+    UInt16,
+    Int16,
+    Float32
+};
+
 enum class HostRenderViewRole {
     Primary3D,
     Composite3D,
@@ -40,7 +48,8 @@ enum class HostDataExportFormat {
     Raw,
     Ply,
     Stl,
-    Obj
+    Obj,
+    Session // 原生会话归档（.mvs）：全分辨率 image 与 validityMask，可由 HostSessionOpenRequest 重开。
 };
 
 struct HostTransferNode {
@@ -5,6 +5,13 @@
 // 跨平台只读文件映射的 RAII owner；映射不复制文件内容，GetData 返回的借用地址依赖本对象存活。
 class MemMappedFile {
 public:
+    // All 在 Linux 上建立映射时即读入全部页，适合随后整体复制的一次性读取；
+    // OnDemand 按访问缺页，适合长期持有或只触及部分区域的映射，避免一次占满页缓存。
+    enum class Prefetch {
+        All,
+        OnDemand
+    };
+
     MemMappedFile() = default;
     ~MemMappedFile() { Clear(); }
     MemMappedFile(const MemMappedFile&) = delete;
@@ -12,7 +19,7 @@ public:
 
     /// @param length 0 = 映射整个文件
     // path 为 UTF-8；先清理旧映射再打开新文件，非零长度不得超过实际文件大小。
-    bool Load(const std::string& path, size_t length = 0);
+    bool Load(const std::string& path, size_t length = 0, Prefetch prefetch = Prefetch::All);
     // 幂等释放 view、mapping handle 与 file handle，并把对象恢复为空状态。
     void Clear();
 
@@ -1,11 +1,12 @@
 #pragma once
 #include "AppInterfaces.h"
 #include "ImageProcessor.h"
+#include "ImagePyramid.h"
 #include <vtkProp.h>
 #include <vtkProp3D.h>
 #include <vtkMatrix4x4.h>
 #include <vtkLookupTable.h>
-#include <vtkImageResample.h>
+#include <vtkTrivialProducer.h>
 #include <vtkWeakPointer.h>
 #include <vector>
 #include <algorithm>
@@ -15,7 +16,9 @@ protected:
     // 策略对全部可视 prop 的强引用 owner；renderer 在 Attach 后另持 VTK 引用，Detach 只解除挂载，不销毁本集合。
     std::vector<vtkSmartPointer<vtkProp>> m_managedProps;
     // GetDownsampledOutputPort 最近一次创建的 producer；返回端口在下次替换该成员或策略析构前有效。
-    vtkSmartPointer<vtkImageResample> m_resampleFilter;
+    vtkSmartPointer<vtkAlgorithm> m_resampleFilter;
+    // 会话共享的降采样层缓存；为空时降采样 producer 退回本策略私有的降采样管线。
+    std::shared_ptr<ImagePyramid> m_imagePyramid;
     std::weak_ptr<RenderEffect> m_renderEffect;
     std::shared_ptr<RenderEffectBinding> m_renderBinding;
     vtkWeakPointer<vtkRenderer> m_effectRenderer;
@@ -118,6 +121,11 @@ public:
         return true;
     }
 
+    void SetImagePyramid(std::shared_ptr<ImagePyramid> pyramid) override
+    {
+        m_imagePyramid = std::move(pyramid);
+    }
+
     bool SetRenderInputStamp(const RenderInputStamp inputStamp) override
     {
         if (m_renderInputStamp == inputStamp) {
@@ -245,10 +253,55 @@ protected:
             return nullptr;
         }
         // targetDim 是输出最大轴的目标体素数；降采样集中放在基类，避免 3D 策略复制同一逻辑。
-        m_resampleFilter = ImageProcessor::GetDownsampledImage(input, targetDim);
+        m_resampleFilter = BuildDownsampledProducer(input, targetDim);
         return m_resampleFilter ? m_resampleFilter->GetOutputPort() : nullptr;
     }
 
+    // 有共享金字塔时取其只读层，并包一层本策略私有的 ShallowCopy 外壳与 trivial producer，
+    // 各视图 pipeline 互不改写共享层；否则返回未执行的本地降采样管线。
+    vtkSmartPointer<vtkAlgorithm> BuildDownsampledProducer(
+        vtkImageData* input,
+        int targetDim,
+        PyramidLevelKind kind = PyramidLevelKind::Image)
+    {
+        if (!input) {
+            return nullptr;
+        }
+        if (!m_imagePyramid) {
+            if (kind == PyramidLevelKind::Mask) {
+                return ImageProcessor::GetDownsampledMask(input, targetDim);
+            }
+            return ImageProcessor::GetDownsampledImage(input, targetDim);
+        }
+        auto level = m_imagePyramid->GetLevel(input, targetDim, kind);
+        if (!level) {
+            return nullptr;
+        }
+        auto view = vtkSmartPointer<vtkImageData>::New();
+        view->ShallowCopy(level);
+        auto producer = vtkSmartPointer<vtkTrivialProducer>::New();
+        producer->SetOutput(view);
+        return producer;
+    }
+
+    // 同一输入需要多档层时先交给共享金字塔并行预建，随后逐档 BuildDownsampledProducer 只命中缓存。
+    void SetDownsampledLevels(
+        vtkImageData* input,
+        const std::vector<int>& targetDims,
+        PyramidLevelKind kind = PyramidLevelKind::Image)
+    {
+        if (m_imagePyramid && input) {
+            (void)m_imagePyramid->SetLevels(input, targetDims, kind);
+        }
+    }
+
+    static vtkImageData* GetProducerImage(vtkAlgorithm* producer)
+    {
+        return producer
+            ? vtkImageData::SafeDownCast(producer->GetOutputDataObject(0))
+            : nullptr;
+    }
+
     void ClampImageBounds(int& x, int& y, int& z, const int dims[3])
     {
         if (!dims) {
@@ -23,6 +23,7 @@ public:
     void SetInputData(vtkSmartPointer<vtkDataObject> data) override;
     void SetInputMask(
         vtkSmartPointer<vtkImageData> validityMask) override;
+    void SetImagePyramid(std::shared_ptr<ImagePyramid> pyramid) override;
     void AttachRenderer(vtkSmartPointer<vtkRenderer> renderer);
     void DetachRenderer(vtkSmartPointer<vtkRenderer> renderer);
     void SetCamera(vtkSmartPointer<vtkRenderer> renderer);
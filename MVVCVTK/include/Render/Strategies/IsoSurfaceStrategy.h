@@ -11,10 +11,9 @@
 #include <vtkPiecewiseFunction.h>
 #include <vtkCubeAxesActor.h>
 #include <vtkFlyingEdges3D.h>
-#include <vtkImageResample.h>
 #include <vtkRenderer.h>
 
-class vtkClipPolyData;
+class ImageMaskOutsideFilter;
 
 // --- 策略 A: 等值面渲染 ---
 class IsoSurfaceStrategy : public BaseVisualStrategy {
@@ -32,10 +31,8 @@ public:
     vtkProp3D* GetMainProp() override;
 private:
     class Mapper;
-    class MaskImplicit;
     RenderEffectTarget GetRenderEffectTarget() const override;
     void SetEffectBinding(RenderEffectBinding* binding) override;
-    bool SetMapperInput();
     // modelMatrix 按 input model -> world 解释；相机只跟随变换后的 m_dataCenter 平移焦点。
     void AlignCamera(const std::array<double, 16>& modelMatrix);
     // 等值面主 prop 与坐标轴 prop 均由策略强持有，并登记到基类 m_managedProps 统一挂载。
@@ -44,11 +41,12 @@ private:
     // ImageData 路径固定使用最大轴 766 的单一等值面 producer；
     // 通用交互来源只控制刷新调度，不改变几何分辨率或 mapper 输入。
     vtkSmartPointer<vtkFlyingEdges3D> m_isoFilter;
-    vtkSmartPointer<vtkImageResample> m_resample;
-    vtkSmartPointer<vtkImageResample> m_mask;
-    vtkSmartPointer<MaskImplicit> m_maskFunc;
-    vtkSmartPointer<vtkClipPolyData> m_clip;
-    // actor 使用的唯一 mapper；mask 只在同一质量 producer 与 clip 输出之间接线。
+    // 注入共享金字塔时为包装共享层的 trivial producer，否则为本地 ImageDownsampleFilter。
+    vtkSmartPointer<vtkAlgorithm> m_resample;
+    vtkSmartPointer<vtkAlgorithm> m_mask;
+    // 固定串在降采样层与 m_isoFilter 之间；无 mask 时直通，有 mask 时把无效体素压到等值面外侧。
+    vtkSmartPointer<ImageMaskOutsideFilter> m_maskFilter;
+    // actor 使用的唯一 mapper，输入始终为 m_isoFilter。
     vtkSmartPointer<Mapper> m_mapper;
     // 最近一次有效输入的强引用和身份缓存；同一 VTK 对象原地修改不等价于不可变快照。
     vtkSmartPointer<vtkDataObject> m_lastInput;
@@ -58,5 +56,4 @@ private:
     double m_dataCenter[3] = { 0.0, 0.0, 0.0 };
     // 最后一次共享状态等值面阈值，单位与输入标量一致。
     double m_currentIsoValue = 0.0;
-    bool m_hasMask = false;
 };
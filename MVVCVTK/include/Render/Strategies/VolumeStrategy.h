@@ -3,7 +3,6 @@
 #include <vtkActor.h>
 #include <vtkVolume.h>
 #include <vtkCubeAxesActor.h>
-#include <vtkImageResample.h>
 #include <vtkRenderer.h>
 
 class vtkImageAnisotropicDiffusion3D;
@@ -36,7 +35,7 @@ private:
     bool GetProducersReady() const;
     bool GetMasksReady(int customTargetDim) const;
     double GetQualityStep(
-        vtkImageResample* qualityResample) const;
+        vtkAlgorithm* qualityResample) const;
     bool BuildProducers();
     bool BuildMasks(int customTargetDim);
     bool SetMapperInput();
@@ -49,10 +48,11 @@ private:
     // volume 使用的唯一 GPU mapper；Feature 只在 Quality 与 Custom 缓存间切换连接。
     vtkSmartPointer<Mapper> m_mapper;
     // 两档 producer 的强引用：Quality 最大轴 766，Custom 使用调用方目标尺寸。
-    vtkSmartPointer<vtkImageResample> m_qualityResample;
-    vtkSmartPointer<vtkImageResample> m_customResample;
-    vtkSmartPointer<vtkImageResample> m_qualityMask;
-    vtkSmartPointer<vtkImageResample> m_customMask;
+    // 注入共享金字塔时为包装共享层的 trivial producer，否则为本地 ImageDownsampleFilter。
+    vtkSmartPointer<vtkAlgorithm> m_qualityResample;
+    vtkSmartPointer<vtkAlgorithm> m_customResample;
+    vtkSmartPointer<vtkAlgorithm> m_qualityMask;
+    vtkSmartPointer<vtkAlgorithm> m_customMask;
     vtkSmartPointer<vtkImageAnisotropicDiffusion3D> m_denoiseFilter;
     // 最近一次有效输入的强引用和身份缓存；只避免重复绑定，不冻结 vtkImageData 内部内容。
     vtkSmartPointer<vtkDataObject> m_lastInput;
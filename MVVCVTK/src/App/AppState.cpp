@@ -314,6 +314,26 @@ bool SharedInteractionState::SetImageDataReady(
     return true;
 }
 
+bool SharedInteractionState::SetPreviewDataReady(
+    double rangeMin,
+    double rangeMax,
+    const std::array<double, 3>& spacing)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        if (m_impl->m_activeLoadKind != LoadEventKind::File
+            || m_impl->m_isLoadPublishing
+            || m_impl->m_fileLoadState != LoadState::Loading) return false;
+        m_impl->m_dataRange = { rangeMin, rangeMax };
+        m_impl->m_spacing = spacing;
+        m_impl->m_windowLevel = { rangeMax - rangeMin, (rangeMin + rangeMax) * 0.5 };
+    }
+    // 不带 FileLoad 位：各 view 按普通数据替换走结构重建，load 终态队列保持不变。
+    try { m_impl->SendFlags(UpdateFlags::DataReady); }
+    catch (...) {}
+    return true;
+}
+
 bool SharedInteractionState::SetFileLoadFailed()
 {
     // File 失败意味着没有可信的新真源，因此 file 与 dataTrusted 同时进入 Failed。
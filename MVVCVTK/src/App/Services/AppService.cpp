@@ -5,6 +5,8 @@
 #include "CompositeStrategy.h"
 #include "DataConverters.h"
 #include "DataManager.h"
+#include "ExportTaskQueue.h"
+#include "ImagePyramid.h"
 #include "InteractionComputeService.h"
 #include "IsoSurfaceStrategy.h"
 #include "SliceStrategy.h"
@@ -25,6 +27,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 // ─────────────────────────────────────────────────────────────────────
 // 构造 / 析构
@@ -58,6 +61,8 @@ public:
     std::array<double, 3> GetSpacing() const;
     void SetWindowLevel(double ww, double wc);
     void SetVisualConfig(const PreInitConfig& cfg);
+    void SetImagePyramid(std::shared_ptr<ImagePyramid> pyramid);
+    void SetExportQueue(std::shared_ptr<ExportTaskQueue> queue);
     PreInitConfig GetVisualConfig() const;
     std::array<double, 2> GetScalarRange() const;
     bool SetVolumeQuality(const VolumeQualityParams& quality);
@@ -77,16 +82,22 @@ public:
     bool LoadFileAsync(std::string path,
         VolumeLayout layout,
         std::function<void(bool isSuccess)> onComplete);
+    bool LoadSessionAsync(std::string path,
+        std::function<void(bool isSuccess)> onComplete);
     bool ReloadFromBufferAsync(
         VolumeBuffer buffer,
         std::function<void(bool isSuccess)> onComplete);
-    void ExportDataAsync(
+    std::uint64_t ExportDataAsync(
         std::string outputDir,
         std::string extension,
-        std::function<void(bool isSuccess)> onComplete);
-    void ExportSlicesAsync(const std::string& path,
+        std::size_t targetTriangleCount,
+        std::function<void(bool isSuccess)> onComplete,
+        VizService::ExportProgress onProgress);
+    std::uint64_t ExportSlicesAsync(const std::string& path,
         std::optional<double> rotationAngleDeg,
-        std::function<void(bool isSuccess)> onComplete);
+        std::function<void(bool isSuccess)> onComplete,
+        VizService::ExportProgress onProgress);
+    bool CancelExport(std::uint64_t exportId);
     void SetSliceScroll(int delta);
     void SetCursorWorldPosition(double worldPos[3], int axis);
     std::array<double, 3> GetCursorWorld();
@@ -133,8 +144,19 @@ private:
     struct ActiveTask final {
         LoadEventKind loadKind = LoadEventKind::None; // None 用于普通导出，File/Reload 需要加载事务收尾。
         std::future<bool> result; // worker 只返回准备结果，不直接触碰 VTK 管线。
-        std::thread worker; // SendTasks 发现 future ready 后负责 join。
+        std::thread worker; // SendTasks 发现 future ready 后负责 join；导出任务在队列 worker 上运行，无此 owner。
         std::function<void(bool)> callback; // 延迟到主线程完成提交/管线同步后执行。
+        std::uint64_t exportId = 0; // 导出队列标识；0 表示 load/reload 任务。
+        std::shared_ptr<ExportTaskQueue> exportQueue; // 入队时的队列，取消与析构都回到同一队列。
+        std::shared_ptr<ExportControl> exportControl; // worker 写进度，SendTasks 只读。
+        VizService::ExportProgress onProgress;
+        double reportedProgress = -1.0; // 已回报的最大进度；初值保证首个 tick 必定回报。
+    };
+
+    struct ProgressReport final {
+        VizService::ExportProgress callback;
+        std::uint64_t exportId = 0;
+        double progress = 0.0;
     };
 
     struct Completion final {
@@ -147,6 +169,7 @@ private:
     void SetStateObserver();
     void SendStateFlags(UpdateFlags flags);
     void SendTasks();
+    void SendPreview();
     void SendCompletions();
     void SetTaskResult(ActiveTask task, bool isSuccess);
     void SetLoadResult(ActiveTask task, bool isSuccess);
@@ -177,6 +200,13 @@ private:
     bool StartTask(VizService::TaskWork task,
         LoadEventKind loadKind,
         std::function<void(bool)> callback);
+    bool StartFileLoad(std::optional<VizService::TaskWork> task,
+        std::function<void(bool)> onComplete);
+    std::uint64_t StartExport(VizService::TaskWork task,
+        std::shared_ptr<ExportControl> control,
+        std::function<void(bool)> callback,
+        VizService::ExportProgress onProgress);
+    static void SendProgress(std::vector<ProgressReport>& reports);
 
     // Service 共享持有会话数据源；File/Reload worker 都只 staging pending，
     // 再由 SendUpdates 所在线程的 owner 提交为 current。
@@ -227,6 +257,10 @@ private:
     bool m_isDenoiseOn = false;
     HistogramConverter m_histogram;
     VizService::TaskStart m_taskStart;
+    // 会话共享的降采样层缓存；为空时各 Strategy 自建降采样管线。
+    std::shared_ptr<ImagePyramid> m_imagePyramid;
+    // 导出任务队列；默认本 service 自建（worker 在首次导出时才创建），Host 注入会话共享队列。
+    std::shared_ptr<ExportTaskQueue> m_exportQueue;
     std::list<ActiveTask> m_activeTasks;
     mutable std::mutex m_activeTaskMutex;
     std::deque<Completion> m_completions;
@@ -264,6 +298,7 @@ VizService::Impl::Impl(
     }
     m_dataLoadTaskService = std::make_shared<AppDataLoadTaskService>(m_dataManager);
     m_dataExportTaskService = std::make_shared<AppDataExportTaskService>(m_dataManager, m_sharedState);
+    m_exportQueue = std::make_shared<ExportTaskQueue>();
 }
 
 VizService::Impl::~Impl()
@@ -274,6 +309,12 @@ VizService::Impl::~Impl()
         std::lock_guard<std::mutex> lock(m_activeTaskMutex);
         activeTasks.splice(activeTasks.end(), m_activeTasks);
     }
+    // 导出先取消再等待：排队中的立即以失败就绪，运行中的在下一取消检查点返回。
+    for (auto& task : activeTasks) {
+        if (task.exportQueue && task.exportId != 0) {
+            (void)task.exportQueue->CancelTask(task.exportId);
+        }
+    }
     for (auto& task : activeTasks) {
         if (task.result.valid()) {
             try { (void)task.result.get(); }
@@ -586,6 +627,16 @@ BackgroundColor VizService::GetBackground() const
     return m_impl->GetBackground();
 }
 
+void VizService::SetImagePyramid(std::shared_ptr<ImagePyramid> pyramid)
+{
+    m_impl->SetImagePyramid(std::move(pyramid));
+}
+
+void VizService::SetExportQueue(std::shared_ptr<ExportTaskQueue> queue)
+{
+    m_impl->SetExportQueue(std::move(queue));
+}
+
 bool VizService::SetSpacing(double sx, double sy, double sz)
 {
     return m_impl->SetSpacing(sx, sy, sz);
@@ -688,6 +739,14 @@ bool VizService::LoadFileAsync(
         std::move(path), std::move(layout), std::move(onComplete));
 }
 
+bool VizService::LoadSessionAsync(
+    std::string path,
+    std::function<void(bool isSuccess)> onComplete)
+{
+    return m_impl->LoadSessionAsync(
+        std::move(path), std::move(onComplete));
+}
+
 bool VizService::ReloadFromBufferAsync(
     VolumeBuffer buffer,
     std::function<void(bool isSuccess)> onComplete)
@@ -696,22 +755,31 @@ bool VizService::ReloadFromBufferAsync(
         std::move(buffer), std::move(onComplete));
 }
 
-void VizService::ExportDataAsync(
+std::uint64_t VizService::ExportDataAsync(
     std::string outputDir,
     std::string extension,
-    std::function<void(bool isSuccess)> onComplete)
+    std::size_t targetTriangleCount,
+    std::function<void(bool isSuccess)> onComplete,
+    ExportProgress onProgress)
 {
-    m_impl->ExportDataAsync(
+    return m_impl->ExportDataAsync(
         std::move(outputDir), std::move(extension),
-        std::move(onComplete));
+        targetTriangleCount, std::move(onComplete), std::move(onProgress));
 }
 
-void VizService::ExportSlicesAsync(
+std::uint64_t VizService::ExportSlicesAsync(
     const std::string& path,
     std::optional<double> rotationAngleDeg,
-    std::function<void(bool isSuccess)> onComplete)
+    std::function<void(bool isSuccess)> onComplete,
+    ExportProgress onProgress)
+{
+    return m_impl->ExportSlicesAsync(
+        path, rotationAngleDeg, std::move(onComplete), std::move(onProgress));
+}
+
+bool VizService::CancelExport(std::uint64_t exportId)
 {
-    m_impl->ExportSlicesAsync(path, rotationAngleDeg, std::move(onComplete));
+    return m_impl->CancelExport(exportId);
 }
 
 void VizService::SetSliceScroll(int delta)
@@ -1065,6 +1133,17 @@ BackgroundColor VizService::Impl::GetBackground() const
     return m_sharedState->GetBackground();
 }
 
+void VizService::Impl::SetImagePyramid(std::shared_ptr<ImagePyramid> pyramid)
+{
+    // 已缓存的 Strategy 仍沿用旧注入；下一次输入换代新建候选时切换到新缓存。
+    m_imagePyramid = std::move(pyramid);
+}
+
+void VizService::Impl::SetExportQueue(std::shared_ptr<ExportTaskQueue> queue)
+{
+    m_exportQueue = queue ? std::move(queue) : std::make_shared<ExportTaskQueue>();
+}
+
 bool VizService::Impl::SetSpacing(double sx, double sy, double sz)
 {
     if (!std::isfinite(sx) || !std::isfinite(sy) || !std::isfinite(sz)
@@ -1342,19 +1421,89 @@ bool VizService::Impl::StartTask(
     }
 }
 
+std::uint64_t VizService::Impl::StartExport(
+    VizService::TaskWork task,
+    std::shared_ptr<ExportControl> control,
+    std::function<void(bool)> callback,
+    VizService::ExportProgress onProgress)
+{
+    // 导出不经 m_taskStart：排队、并发上限与 worker 复用都交给共享队列，这里只登记 future/callback 槽。
+    const auto queue = m_exportQueue;
+    if (!m_isAccepting || !task.valid() || !control || !queue) {
+        SetCompletion(false, std::move(callback));
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_activeTaskMutex);
+    m_activeTasks.emplace_back();
+    auto entry = std::prev(m_activeTasks.end());
+    try {
+        entry->callback = std::move(callback);
+        entry->exportQueue = queue;
+        entry->exportControl = control;
+        entry->onProgress = std::move(onProgress);
+        entry->exportId = queue->StartTask(
+            std::move(task), std::move(control), entry->result);
+        if (entry->exportId != 0) {
+            return entry->exportId;
+        }
+    }
+    catch (...) {
+    }
+    auto failedCallback = std::move(entry->callback);
+    m_activeTasks.erase(entry);
+    SetCompletion(false, std::move(failedCallback));
+    return 0;
+}
+
+void VizService::Impl::SendProgress(std::vector<ProgressReport>& reports)
+{
+    for (auto& report : reports) {
+        try { report.callback(report.exportId, report.progress); }
+        catch (const std::exception& error) {
+            std::cerr << "[VizService] Progress failed: " << error.what() << '\n';
+        }
+        catch (...) {
+            std::cerr << "[VizService] Progress failed with an unknown exception.\n";
+        }
+    }
+}
+
 bool VizService::Impl::LoadFileAsync(
     std::string path,
     VolumeLayout layout,
     std::function<void(bool isSuccess)> onComplete)
 {
-    // File 链：构造任务 -> 领取全局 Load admission -> 清 pending -> 登记 owner -> 启动 worker。
-    // 任一后置步骤失败都会发布 FileFailed、释放 admission/owner，并把 callback 排入完成队列。
     if (!m_isAccepting || !m_dataLoadTaskService) {
         SetCompletion(false, std::move(onComplete));
         return false;
     }
-    auto task = m_dataLoadTaskService->BuildLoadFileTask(
-        std::move(path), std::move(layout));
+    return StartFileLoad(
+        m_dataLoadTaskService->BuildLoadFileTask(
+            std::move(path), std::move(layout)),
+        std::move(onComplete));
+}
+
+bool VizService::Impl::LoadSessionAsync(
+    std::string path,
+    std::function<void(bool isSuccess)> onComplete)
+{
+    // 会话归档替换整卷数据，与 File 加载共用 admission、owner 与预览/失败回滚语义。
+    if (!m_isAccepting || !m_dataLoadTaskService) {
+        SetCompletion(false, std::move(onComplete));
+        return false;
+    }
+    return StartFileLoad(
+        m_dataLoadTaskService->BuildLoadSessionTask(std::move(path)),
+        std::move(onComplete));
+}
+
+bool VizService::Impl::StartFileLoad(
+    std::optional<VizService::TaskWork> task,
+    std::function<void(bool)> onComplete)
+{
+    // File 链：构造任务 -> 领取全局 Load admission -> 清 pending -> 登记 owner -> 启动 worker。
+    // 任一后置步骤失败都会发布 FileFailed、释放 admission/owner，并把 callback 排入完成队列。
     if (!task || !m_sharedState
         || !m_sharedState->StartLoad(LoadEventKind::File)) {
         SetCompletion(false, std::move(onComplete));
@@ -1417,38 +1566,64 @@ bool VizService::Impl::ReloadFromBufferAsync(
     return true;
 }
 
-void VizService::Impl::ExportDataAsync(
+std::uint64_t VizService::Impl::ExportDataAsync(
     std::string outputDir,
     std::string extension,
-    std::function<void(bool isSuccess)> onComplete)
+    std::size_t targetTriangleCount,
+    std::function<void(bool isSuccess)> onComplete,
+    VizService::ExportProgress onProgress)
 {
+    auto control = std::make_shared<ExportControl>();
     auto task = m_dataExportTaskService
         ? m_dataExportTaskService->BuildDataTask(
             std::move(outputDir),
-            std::move(extension)) : std::nullopt;
+            std::move(extension),
+            targetTriangleCount, control) : std::nullopt;
     if (!task) {
         SetCompletion(false, std::move(onComplete));
-        return;
+        return 0;
     }
-    // StartTask 从这里开始独占 callback，并负责启动失败通知。
-    StartTask(std::move(*task), LoadEventKind::None, std::move(onComplete));
+    // StartExport 从这里开始独占 callback，并负责启动失败通知。
+    return StartExport(std::move(*task), std::move(control),
+        std::move(onComplete), std::move(onProgress));
 }
 
-void VizService::Impl::ExportSlicesAsync(
+std::uint64_t VizService::Impl::ExportSlicesAsync(
     const std::string& path,
     std::optional<double> rotationAngleDeg,
-    std::function<void(bool isSuccess)> onComplete)
+    std::function<void(bool isSuccess)> onComplete,
+    VizService::ExportProgress onProgress)
 {
     const VizMode currentMode = static_cast<VizMode>(m_pendingVizModeInt.load());
+    auto control = std::make_shared<ExportControl>();
     auto task = m_dataExportTaskService
         ? m_dataExportTaskService->BuildSlicesTask(
-            path, rotationAngleDeg, currentMode) : std::nullopt;
+            path, rotationAngleDeg, currentMode, control) : std::nullopt;
     if (!task) {
         SetCompletion(false, std::move(onComplete));
-        return;
+        return 0;
+    }
+    // StartExport 从这里开始独占 callback，并负责启动失败通知。
+    return StartExport(std::move(*task), std::move(control),
+        std::move(onComplete), std::move(onProgress));
+}
+
+bool VizService::Impl::CancelExport(std::uint64_t exportId)
+{
+    if (exportId == 0) return false;
+    std::shared_ptr<ExportTaskQueue> queue;
+    {
+        std::lock_guard<std::mutex> lock(m_activeTaskMutex);
+        const auto entry = std::find_if(
+            m_activeTasks.begin(), m_activeTasks.end(),
+            [exportId](const ActiveTask& task) {
+                return task.exportId == exportId;
+            });
+        if (entry == m_activeTasks.end()) return false;
+        queue = entry->exportQueue;
     }
-    // StartTask 从这里开始独占 callback，并负责启动失败通知。
-    StartTask(std::move(*task), LoadEventKind::None, std::move(onComplete));
+    // 队列锁不与 active 锁嵌套；取消后的失败结果仍由下一次 SendTasks 收口并回调。
+    return queue && queue->CancelTask(exportId);
 }
 
 // ─────────────────────────────────────────────────────────────────────
@@ -1670,7 +1845,8 @@ void VizService::Impl::SendUpdates()
     }
     // 更新入口按固定阶段收敛 pending/current、完成回调和渲染变更；常规由主线程 Timer 驱动，
     // 外部 reload handler 只允许发布 pending，最终提交仍由 owner Timer 消费。
-    // 1. 先领取所有 ready 任务并 join worker，load 的 pending 只由 owner 提交。
+    // 1. 先领取流式 File load 的粗预览，再领取所有 ready 任务并 join worker；load 的 pending 只由 owner 提交。
+    SendPreview();
     SendTasks();
 
     // Percentile intent 随 DataVersion 重算；各 view 可尝试解析，但 SharedState 只提交同一版本结果。
@@ -1730,7 +1906,9 @@ bool VizService::Impl::SendReloadUpdate()
 void VizService::Impl::SendTasks()
 {
     // 1. 锁内只把 ready future 从 active 列表 splice 到局部列表；未完成任务继续由 service 持有。
+    //    未完成的导出在此采样进度，只在超过已回报值时记一条，回调留到锁外执行。
     std::list<ActiveTask> readyTasks;
+    std::vector<ProgressReport> reports;
     {
         std::lock_guard<std::mutex> lock(m_activeTaskMutex);
         for (auto entry = m_activeTasks.begin(); entry != m_activeTasks.end();) {
@@ -1738,6 +1916,13 @@ void VizService::Impl::SendTasks()
                 && entry->result.wait_for(std::chrono::seconds(0))
                     == std::future_status::ready;
             if (!isReady) {
+                if (entry->onProgress && entry->exportControl) {
+                    const double progress = entry->exportControl->GetProgress();
+                    if (progress > entry->reportedProgress) {
+                        entry->reportedProgress = progress;
+                        reports.push_back({ entry->onProgress, entry->exportId, progress });
+                    }
+                }
                 ++entry;
                 continue;
             }
@@ -1745,16 +1930,42 @@ void VizService::Impl::SendTasks()
             readyTasks.splice(readyTasks.end(), m_activeTasks, ready);
         }
     }
+    SendProgress(reports);
     // 2. 锁外读取结果并 join worker，再区分普通任务 callback 与 Load/Reload 提交链。
+    //    成功的导出保证在完成回调前补报 1.0，调用方不必区分"进度未满但已完成"。
     for (auto& task : readyTasks) {
         bool isSuccess = false;
         try { isSuccess = task.result.get(); }
         catch (...) { isSuccess = false; }
         if (task.worker.joinable()) task.worker.join();
+        if (isSuccess && task.onProgress && task.reportedProgress < 1.0) {
+            reports.assign(1, { task.onProgress, task.exportId, 1.0 });
+            SendProgress(reports);
+        }
         SetTaskResult(std::move(task), isSuccess);
     }
 }
 
+void VizService::Impl::SendPreview()
+{
+    // 只有 File load 的 owner 提交预览；完整批次仍由 SetLoadResult 在任务结束后领取。
+    if (!m_dataManager || !m_sharedState
+        || !GetOwnedLoad(LoadEventKind::File)) {
+        return;
+    }
+    bool hasPreview = false;
+    if (!m_dataManager->SetCurrentFromPreview(hasPreview) || !hasPreview) {
+        return;
+    }
+    const auto snapshot = m_dataManager->GetImageSnapshot();
+    if (snapshot && snapshot->isPreview) {
+        (void)m_sharedState->SetPreviewDataReady(
+            snapshot->scalarRange[0],
+            snapshot->scalarRange[1],
+            snapshot->spacing);
+    }
+}
+
 void VizService::Impl::SetTaskResult(ActiveTask task, bool isSuccess)
 {
     if (task.loadKind == LoadEventKind::None) {
@@ -1771,6 +1982,7 @@ void VizService::Impl::SetLoadResult(ActiveTask task, bool isSuccess)
     if (isSuccess && m_dataManager) {
         isSuccess = m_dataManager->SetCurrentFromPending(hasPending) && hasPending;
     }
+    // 失败时 ClearPending 同时把已提交为 current 的流式预览回滚到加载前批次。
     if (!isSuccess && m_dataManager) m_dataManager->ClearPending();
 
     // callback 暂存到 owner 槽，待共享终态广播、各视图管线同步和 admission 释放后再执行。
@@ -1961,6 +2173,16 @@ bool VizService::Impl::BuildPipeline()
                 << '\n';
         }
 
+        // 共享金字塔按快照换代预建显示层；其它视图随后重建管线时只等待或命中同一批层。
+        // 切片视图直接消费原分辨率 image，不触发预建。
+        const bool isDownsampledMode =
+            mode == VizMode::Volume
+            || mode == VizMode::IsoSurface
+            || mode == VizMode::CompositeVolume
+            || mode == VizMode::CompositeIsoSurface;
+        if (m_imagePyramid && isDownsampledMode) {
+            (void)m_imagePyramid->SetSnapshot(currentSnapshot);
+        }
         // 候选 strategy 先完成输入校验，成功后才替换当前渲染真源。
         candidateStrategy->SetInputData(currentSnapshot->image);
         candidateStrategy->SetInputMask(
@@ -2100,11 +2322,31 @@ VizService::Impl::GetTransferPresetNodes(
         return std::nullopt;
     }
 
-    const auto low = m_histogram.GetHistogramPercentile(
-        snapshot->image, 0.02);
-    const auto high = m_histogram.GetHistogramPercentile(
-        snapshot->image, 0.98);
-    if (!low || !high || *high < *low) {
+    // 加载期统计覆盖整卷，只在没有有效域时可直接查表，并预置为缓存供首次裁切增量扣减；
+    // 裁切后或缺统计时按版本统计有效体素，带 mask 增量且父批在缓存中时只处理变化体素。
+    // 同一批次重复应用预设命中缓存。两个分位数由同一次累计回答。
+    auto statistics = snapshot->statistics;
+    if (statistics && !snapshot->validityMask) {
+        (void)m_histogram.SetCachedStatistics(
+            snapshot->image, snapshot->version, statistics);
+    }
+    else {
+        // 增量在此被领取；本批统计随即进入缓存，单槽中的区间表不再保留。
+        const auto maskDelta = m_dataManager
+            ? m_dataManager->GetMaskDelta(snapshot->version) : nullptr;
+        statistics = m_histogram.GetStatistics(
+            snapshot->image, snapshot->validityMask, snapshot->version,
+            maskDelta.get());
+    }
+    const auto percentiles = statistics
+        ? HistogramConverter::GetHistogramPercentiles(*statistics, { 0.02, 0.98 })
+        : std::nullopt;
+    if (!percentiles) {
+        return std::nullopt;
+    }
+    const double low = (*percentiles)[0];
+    const double high = (*percentiles)[1];
+    if (high < low) {
         return std::nullopt;
     }
 
@@ -2121,9 +2363,9 @@ VizService::Impl::GetTransferPresetNodes(
     }
 
     double lowPosition = std::clamp(
-        (*low - rangeMin) / rangeWidth, 0.0, 1.0);
+        (low - rangeMin) / rangeWidth, 0.0, 1.0);
     double highPosition = std::clamp(
-        (*high - rangeMin) / rangeWidth, 0.0, 1.0);
+        (high - rangeMin) / rangeWidth, 0.0, 1.0);
     if (highPosition <= lowPosition) {
         lowPosition = 0.0;
         highPosition = 1.0;
@@ -2334,5 +2576,6 @@ VizService::Impl::CreateStrategy(const VizMode mode)
     default:
         return nullptr;
     }
+    strategy->SetImagePyramid(m_imagePyramid);
     return strategy;
 }
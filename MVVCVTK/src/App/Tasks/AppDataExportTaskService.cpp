@@ -16,7 +16,9 @@ AppDataExportTaskService::AppDataExportTaskService(
 std::optional<std::packaged_task<bool()>>
 AppDataExportTaskService::BuildDataTask(
     std::string outputDir,
-    std::string extension)
+    std::string extension,
+    std::size_t targetTriangleCount,
+    std::shared_ptr<ExportControl> control)
 {
     if (!m_dataManager || !m_sharedState
         || outputDir.empty() || extension.empty()) {
@@ -35,6 +37,8 @@ AppDataExportTaskService::BuildDataTask(
     params.modelToWorld = m_sharedState->GetModelMatrix();
     params.scalarRange = m_sharedState->GetDataRange();
     m_sharedState->GetTFNodes(params.tfNodes);
+    params.targetTriangleCount = targetTriangleCount;
+    params.control = std::move(control);
     return std::packaged_task<bool()>(
         [dataManager, imageSnapshot,
          outputDir = std::move(outputDir),
@@ -58,7 +62,8 @@ std::optional<std::packaged_task<bool()>>
 AppDataExportTaskService::BuildSlicesTask(
     std::string path,
     std::optional<double> rotationAngleDeg,
-    VizMode currentMode)
+    VizMode currentMode,
+    std::shared_ptr<ExportControl> control)
 {
     if (!m_dataManager || !m_sharedState || path.empty()
         || InteractionComputeService::GetSliceAxis(currentMode) < 0) {
@@ -70,15 +75,22 @@ AppDataExportTaskService::BuildSlicesTask(
     auto exportData = InteractionComputeService::GetSliceExportData(
         modelToWorld, currentMode, cursorWorld, rotationAngleDeg);
     if (!exportData) return std::nullopt;
+    // 与窗宽窗位、矩阵同时冻结批次；排队期间的裁切或重载不会换掉待导出的体数据。
+    const auto imageSnapshot = m_dataManager->GetImageSnapshot();
+    if (!imageSnapshot || !imageSnapshot->image
+        || imageSnapshot->image->GetNumberOfPoints() == 0) {
+        return std::nullopt;
+    }
 
     auto dataManager = m_dataManager;
     return std::packaged_task<bool()>(
-        [dataManager, path = std::move(path),
-         exportData = std::move(*exportData), windowLevel]() mutable
+        [dataManager, imageSnapshot, path = std::move(path),
+         exportData = std::move(*exportData), windowLevel,
+         control = std::move(control)]() mutable
         {
             try {
                 return dataManager->ExportSlices(
-                    path, exportData.orientation, windowLevel, exportData.matrix);
+                    imageSnapshot, path, exportData.orientation, windowLevel, exportData.matrix, control);
             }
             catch (const std::exception& error) {
                 std::cerr << "[Export] Worker failed: " << error.what() << '\n';
@@ -34,6 +34,28 @@ AppDataLoadTaskService::BuildLoadFileTask(
         });
 }
 
+std::optional<std::packaged_task<bool()>>
+AppDataLoadTaskService::BuildLoadSessionTask(std::string path)
+{
+    if (!m_dataManager || path.empty()) return std::nullopt;
+    auto dataManager = m_dataManager;
+    return std::packaged_task<bool()>(
+        [dataManager, path = std::move(path)]()
+        {
+            try {
+                return dataManager->SetSessionLoaded(path);
+            }
+            catch (const std::exception& error) {
+                std::cerr << "[LoadSessionAsync] Worker failed: "
+                    << error.what() << '\n';
+            }
+            catch (...) {
+                std::cerr << "[LoadSessionAsync] Worker failed with an unknown exception.\n";
+            }
+            return false;
+        });
+}
+
 std::optional<std::packaged_task<bool()>>
 AppDataLoadTaskService::BuildReloadTask(VolumeBuffer buffer)
 {
@@ -0,0 +1,223 @@
+#include "ExportTaskQueue.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ExportTaskQueue::Impl final {
+public:
+    struct Entry final {
+        std::uint64_t taskId = 0;
+        std::packaged_task<bool()> task;
+        std::shared_ptr<ExportControl> control;
+        std::promise<bool> result;
+    };
+
+    // worker 循环：按 FIFO 领取任务，运行数不超过并发上限；停止时直接返回，排队任务由析构收尾。
+    void SendTasks();
+    // 锁内调用：按"运行中 + 排队"的需要补足 worker，至多 m_concurrency 个；失败返回 false。
+    bool SetWorkers();
+    // 出队或被关闭的任务不再运行：先销毁 task 释放其捕获的快照，再以 false 就绪。
+    static void SetCancelled(Entry& entry);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_taskReady;
+    std::deque<Entry> m_queuedTasks;
+    // 运行中任务的取消槽；键为任务标识。
+    std::map<std::uint64_t, std::shared_ptr<ExportControl>> m_runningTasks;
+    std::vector<std::thread> m_workers;
+    std::size_t m_concurrency = 1;
+    std::uint64_t m_nextTaskId = 1;
+    bool m_isStopping = false;
+};
+
+void ExportTaskQueue::Impl::SendTasks()
+{
+    for (;;) {
+        Entry entry;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_taskReady.wait(lock, [this] {
+                return m_isStopping
+                    || (!m_queuedTasks.empty()
+                        && m_runningTasks.size() < m_concurrency);
+            });
+            if (m_isStopping) {
+                return;
+            }
+            entry = std::move(m_queuedTasks.front());
+            m_queuedTasks.pop_front();
+            m_runningTasks.emplace(entry.taskId, entry.control);
+        }
+
+        // 排队期间已被置取消的任务（例如调用方直接写 control）不再启动导出。
+        bool isSuccess = false;
+        if (!entry.control->GetIsCancelled()) {
+            try {
+                auto taskResult = entry.task.get_future();
+                entry.task();
+                isSuccess = taskResult.get();
+            }
+            catch (...) {
+                isSuccess = false;
+            }
+        }
+        entry.task = std::packaged_task<bool()>();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_runningTasks.erase(entry.taskId);
+        }
+        // 腾出的并发槽可能让排队任务就绪；先唤醒再发布结果，调用方看到 ready 时计数已更新。
+        m_taskReady.notify_all();
+        entry.result.set_value(isSuccess);
+    }
+}
+
+bool ExportTaskQueue::Impl::SetWorkers()
+{
+    const std::size_t neededCount = std::min(
+        m_concurrency, m_runningTasks.size() + m_queuedTasks.size());
+    try {
+        while (m_workers.size() < neededCount) {
+            m_workers.emplace_back([this] { SendTasks(); });
+        }
+    }
+    catch (...) {
+        return !m_workers.empty();
+    }
+    return true;
+}
+
+void ExportTaskQueue::Impl::SetCancelled(Entry& entry)
+{
+    if (entry.control) {
+        entry.control->SetCancelled();
+    }
+    entry.task = std::packaged_task<bool()>();
+    entry.result.set_value(false);
+}
+
+ExportTaskQueue::ExportTaskQueue(std::size_t concurrency)
+    : m_impl(std::make_unique<Impl>())
+{
+    m_impl->m_concurrency = std::max<std::size_t>(concurrency, 1);
+}
+
+ExportTaskQueue::~ExportTaskQueue()
+{
+    std::deque<Impl::Entry> queuedTasks;
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        m_impl->m_isStopping = true;
+        queuedTasks.swap(m_impl->m_queuedTasks);
+        for (auto& runningTask : m_impl->m_runningTasks) {
+            runningTask.second->SetCancelled();
+        }
+        workers.swap(m_impl->m_workers);
+    }
+    m_impl->m_taskReady.notify_all();
+    for (auto& entry : queuedTasks) {
+        Impl::SetCancelled(entry);
+    }
+    // 运行中的任务在下一取消检查点返回；worker 发布结果后看到停止标志即退出。
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+std::uint64_t ExportTaskQueue::StartTask(
+    std::packaged_task<bool()> task,
+    std::shared_ptr<ExportControl> control,
+    std::future<bool>& result)
+{
+    if (!task.valid() || !control) {
+        return 0;
+    }
+    std::uint64_t taskId = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        if (m_impl->m_isStopping) {
+            return 0;
+        }
+        Impl::Entry entry;
+        entry.taskId = m_impl->m_nextTaskId;
+        entry.task = std::move(task);
+        entry.control = std::move(control);
+        auto entryResult = entry.result.get_future();
+        m_impl->m_queuedTasks.push_back(std::move(entry));
+        // 连一个 worker 都无法创建时撤销入队，调用方按启动失败处理。
+        if (!m_impl->SetWorkers()) {
+            m_impl->m_queuedTasks.pop_back();
+            return 0;
+        }
+        taskId = m_impl->m_nextTaskId++;
+        result = std::move(entryResult);
+    }
+    m_impl->m_taskReady.notify_all();
+    return taskId;
+}
+
+bool ExportTaskQueue::CancelTask(std::uint64_t taskId)
+{
+    std::optional<Impl::Entry> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        auto& queuedTasks = m_impl->m_queuedTasks;
+        const auto queued = std::find_if(
+            queuedTasks.begin(), queuedTasks.end(),
+            [taskId](const Impl::Entry& entry) {
+                return entry.taskId == taskId;
+            });
+        if (queued != queuedTasks.end()) {
+            cancelled = std::move(*queued);
+            queuedTasks.erase(queued);
+        }
+        else {
+            const auto running = m_impl->m_runningTasks.find(taskId);
+            if (running == m_impl->m_runningTasks.end()) {
+                return false;
+            }
+            running->second->SetCancelled();
+            return true;
+        }
+    }
+    Impl::SetCancelled(*cancelled);
+    return true;
+}
+
+void ExportTaskQueue::SetConcurrency(std::size_t concurrency)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        m_impl->m_concurrency = std::max<std::size_t>(concurrency, 1);
+        (void)m_impl->SetWorkers();
+    }
+    m_impl->m_taskReady.notify_all();
+}
+
+std::size_t ExportTaskQueue::GetConcurrency() const
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+    return m_impl->m_concurrency;
+}
+
+std::size_t ExportTaskQueue::GetQueuedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+    return m_impl->m_queuedTasks.size();
+}
+
+std::size_t ExportTaskQueue::GetRunningCount() const
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+    return m_impl->m_runningTasks.size();
+}
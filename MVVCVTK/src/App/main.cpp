@@ -7,11 +7,14 @@
 #include "Host/GapHostFeature.h"
 #include "Host/Types/HostRequestTypes.h"
 #include "Host/VtkAppHostSession.h"
+#include "Platform/Path.h"
 
 #include <algorithm>
 #include <cstddef>
 #include <exception>
+#include <filesystem>
 #include <memory>
+#include <system_error>
 #include <string>
 #include <utility>
 #include <vector>
@@ -233,6 +236,15 @@ int main()
     HostSessionConfig sessionConfig;
     sessionConfig.renderViews =
         std::move(renderViews);
+    // 体数据缓存放在系统临时目录；取不到临时目录时不启用缓存，加载照常读取源文件。
+    std::error_code tempError;
+    const auto tempDir =
+        std::filesystem::temp_directory_path(tempError);
+    if (!tempError) {
+        sessionConfig.volumeCacheDirectory =
+            PlatformPath::GetUtf8Path(
+                tempDir / "MVVCVTK" / "VolumeCache");
+    }
     VtkAppHostSession session(
         std::move(sessionConfig));
     if (!session.BuildSession()) {
@@ -1,7 +1,7 @@
 #include "DataConverters.h"
 #include "Platform/Path.h"
-#include <vtkImageAccumulate.h>
 #include <vtkDoubleArray.h>
+#include <vtkDataArray.h>
 #include <vtkIdTypeArray.h>
 #include <vtkPointData.h>
 #include <filesystem>
@@ -9,26 +9,371 @@
 #include <vtkJPEGWriter.h>
 #include <vtkPNGWriter.h>
 #include <vtkImageData.h>
+#include <vtkSMPTools.h>
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <limits>
+#include <thread>
+#include <utility>
 #include <vector>
 
+namespace {
+// 单个累计分组覆盖的最少体素数；分组过小时 bin 数组归并开销会超过扫描本身。
+constexpr std::size_t kHistogramGroupValues = std::size_t{ 1 } << 18;
+// Adaptive 划分先用 bins*kAdaptiveRefine 个细线性 bin 累计，再合并为等样本数的粗 bin。
+constexpr std::size_t kAdaptiveRefine = 8;
+
+double GetBinStart(const VolumeStatistics& statistics, std::size_t bin)
+{
+    return statistics.binStarts.empty()
+        ? statistics.scalarRange[0] + static_cast<double>(bin) * statistics.binWidth
+        : statistics.binStarts[bin];
+}
+
+bool GetStatisticsUsable(const VolumeStatistics& statistics)
+{
+    return !statistics.histogram.empty()
+        && statistics.histogram.size()
+            <= static_cast<std::size_t>(std::numeric_limits<int>::max())
+        && (statistics.binStarts.empty()
+            || statistics.binStarts.size() == statistics.histogram.size())
+        && std::isfinite(statistics.scalarRange[0])
+        && std::isfinite(statistics.scalarRange[1])
+        && statistics.scalarRange[1] >= statistics.scalarRange[0];
+}
+
+// 最近秩分位数：每个分位数取首个累计计数达到 ceil(q*N) 的 bin 起点，并钳制到标量范围。
+// 目标秩升序排列后只走一遍累计，批量查询与逐个查询结果逐项相同。
+bool SetBinPercentiles(
+    const VolumeStatistics& statistics,
+    const std::vector<double>& quantiles,
+    std::vector<double>& values)
+{
+    const auto& range = statistics.scalarRange;
+    const auto& frequencies = statistics.histogram;
+    values.assign(quantiles.size(), range[1]);
+    std::vector<std::pair<long double, std::size_t>> targets;
+    for (std::size_t index = 0; index < quantiles.size(); ++index) {
+        const double quantile = quantiles[index];
+        if (quantile == 0.0 || range[0] == range[1]) {
+            values[index] = range[0];
+        }
+        else if (quantile != 1.0) {
+            targets.emplace_back(static_cast<long double>(quantile), index);
+        }
+    }
+    if (targets.empty()) {
+        return true;
+    }
+
+    long double sampleCount = 0.0L;
+    for (const auto frequency : frequencies) {
+        sampleCount += static_cast<long double>(frequency);
+    }
+    if (sampleCount <= 0.0L) {
+        return false;
+    }
+    for (auto& target : targets) {
+        target.first = std::ceil(target.first * sampleCount);
+    }
+    std::sort(targets.begin(), targets.end());
+
+    long double currentRank = 0.0L;
+    std::size_t nextTarget = 0;
+    for (std::size_t i = 0; i < frequencies.size() && nextTarget < targets.size(); ++i) {
+        currentRank += static_cast<long double>(frequencies[i]);
+        while (nextTarget < targets.size()
+            && currentRank >= targets[nextTarget].first) {
+            values[targets[nextTarget].second] =
+                std::clamp(GetBinStart(statistics, i), range[0], range[1]);
+            ++nextTarget;
+        }
+    }
+    return true;
+}
+
+// 从 index 起跨过与 isValid 同类的连续 mask 字节，返回首个异类字节的位置。
+// 裁切 mask 以长段为主，整 8 字节判断全零/无零字节，段内不再逐体素分支。
+std::size_t GetRunEnd(
+    const unsigned char* mask,
+    std::size_t index,
+    std::size_t end,
+    bool isValid)
+{
+    constexpr std::uint64_t kLowBits = 0x0101010101010101ULL;
+    constexpr std::uint64_t kHighBits = 0x8080808080808080ULL;
+    while (index + sizeof(std::uint64_t) <= end) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, mask + index, sizeof(word));
+        const bool hasZeroByte = ((word - kLowBits) & ~word & kHighBits) != 0;
+        if (isValid ? hasZeroByte : word != 0) {
+            break;
+        }
+        index += sizeof(word);
+    }
+    while (index < end && (mask[index] != 0) == isValid) {
+        ++index;
+    }
+    return index;
+}
+
+// 按连续区段分组累计，组内独占 bin 数组，整数计数求和与调度顺序无关；mask 按有效段整段累计。
+// runs 非空时只累计这些区间（共 itemCount 段）覆盖的标量，mask 不参与。
+// 线性位置与 vtkImageAccumulate 相同：floor((v-origin)/spacing)；对数位置为 log1p(v-origin)*scale。
+// 越界与 NaN 不计。
+template <bool IsLog, typename T>
+void SetBinnedHistogram(
+    const T* values,
+    const unsigned char* mask,
+    const ValidityMaskRun* runs,
+    std::size_t itemCount,
+    double origin,
+    double binSpacing,
+    double logScale,
+    std::vector<std::uint64_t>& histogram)
+{
+    const std::size_t binCount = histogram.size();
+    const double binLimit = static_cast<double>(binCount);
+    const std::size_t groupLimit = std::max<std::size_t>(
+        1, 2 * static_cast<std::size_t>(std::thread::hardware_concurrency()));
+    // 分组数按实际累计的体素数定；区间模式下组数不超过段数，组内按段数均分。
+    std::size_t valueCount = itemCount;
+    if (runs) {
+        valueCount = 0;
+        for (std::size_t index = 0; index < itemCount; ++index) {
+            valueCount += static_cast<std::size_t>(runs[index].end - runs[index].begin);
+        }
+    }
+    const std::size_t groupCount = std::max<std::size_t>(1, std::min({
+        groupLimit,
+        runs ? itemCount : groupLimit,
+        (valueCount + kHistogramGroupValues - 1) / kHistogramGroupValues }));
+    std::vector<std::vector<std::uint64_t>> groupBins(
+        groupCount, std::vector<std::uint64_t>(binCount, 0));
+    vtkSMPTools::For(
+        vtkIdType{ 0 },
+        static_cast<vtkIdType>(groupCount),
+        vtkIdType{ 1 },
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType group = first; group < last; ++group) {
+                const std::size_t groupIndex = static_cast<std::size_t>(group);
+                const std::size_t begin = itemCount * groupIndex / groupCount;
+                const std::size_t end = itemCount * (groupIndex + 1) / groupCount;
+                auto& bins = groupBins[groupIndex];
+                const auto addValue = [&](double value) {
+                    const double offset = value - origin;
+                    const double position = IsLog
+                        ? std::log1p(offset) * logScale
+                        : offset / binSpacing;
+                    if (position >= 0.0 && position < binLimit) {
+                        ++bins[static_cast<std::size_t>(position)];
+                    }
+                };
+                const auto addRun = [&](std::size_t runBegin, std::size_t runEnd) {
+                    for (std::size_t index = runBegin; index < runEnd; ++index) {
+                        addValue(static_cast<double>(values[index]));
+                    }
+                };
+                if (runs) {
+                    for (std::size_t index = begin; index < end; ++index) {
+                        addRun(static_cast<std::size_t>(runs[index].begin),
+                            static_cast<std::size_t>(runs[index].end));
+                    }
+                    continue;
+                }
+                if (!mask) {
+                    addRun(begin, end);
+                    continue;
+                }
+                for (std::size_t index = begin; index < end;) {
+                    const std::size_t runBegin = GetRunEnd(mask, index, end, false);
+                    const std::size_t runEnd = GetRunEnd(mask, runBegin, end, true);
+                    addRun(runBegin, runEnd);
+                    index = runEnd;
+                }
+            }
+        });
+
+    histogram.assign(binCount, 0);
+    for (const auto& bins : groupBins) {
+        for (std::size_t bin = 0; bin < binCount; ++bin) {
+            histogram[bin] += bins[bin];
+        }
+    }
+}
+
+// 按标量类型分派；64 位整数按 double 归 bin，与 accumulate 管线相同。runs 语义同 SetBinnedHistogram。
+template <bool IsLog>
+bool SetScalarHistogram(
+    vtkDataArray* scalars,
+    const unsigned char* mask,
+    const std::vector<ValidityMaskRun>* runs,
+    double origin,
+    double binSpacing,
+    double logScale,
+    std::vector<std::uint64_t>& histogram)
+{
+    const auto itemCount = runs
+        ? runs->size()
+        : static_cast<std::size_t>(scalars->GetNumberOfTuples());
+    const ValidityMaskRun* runData = runs ? runs->data() : nullptr;
+    switch (scalars->GetDataType()) {
+        vtkTemplateMacro(SetBinnedHistogram<IsLog>(
+            static_cast<const VTK_TT*>(scalars->GetVoidPointer(0)),
+            mask, runData, itemCount, origin, binSpacing, logScale, histogram));
+    default:
+        return false;
+    }
+    return true;
+}
+
+// 细 bin 按累计配额合并：第 k 个粗 bin 在累计计数首次达到 (k+1)/bins 时关闭，末个粗 bin 吸收余下细 bin。
+// 新粗 bin 只在有样本的细 bin 处开启，空段并入前一粗 bin，离群值因此得到贴近自身的 bin 起点。
+// 单个细 bin 的样本超过多份配额时不再拆分，粗 bin 数因此可能少于 binCount。
+void SetAdaptiveBins(
+    const std::vector<std::uint64_t>& fineBins,
+    double origin,
+    double fineSpacing,
+    int binCount,
+    VolumeStatistics& statistics)
+{
+    std::uint64_t sampleCount = 0;
+    for (const auto count : fineBins) {
+        sampleCount += count;
+    }
+    statistics.histogram.clear();
+    statistics.binStarts.clear();
+    const auto targetCount = static_cast<std::size_t>(binCount);
+    long double currentCount = 0.0L;
+    bool isOpen = false;
+    for (std::size_t fine = 0; fine < fineBins.size(); ++fine) {
+        if (!isOpen && fineBins[fine] == 0 && !statistics.histogram.empty()) {
+            continue;
+        }
+        if (!isOpen) {
+            statistics.binStarts.push_back(
+                origin + static_cast<double>(fine) * fineSpacing);
+            statistics.histogram.push_back(0);
+            isOpen = true;
+        }
+        statistics.histogram.back() += fineBins[fine];
+        currentCount += static_cast<long double>(fineBins[fine]);
+        const std::size_t closedCount = statistics.histogram.size();
+        if (closedCount < targetCount
+            && currentCount * static_cast<long double>(targetCount)
+                >= static_cast<long double>(closedCount)
+                    * static_cast<long double>(sampleCount)) {
+            isOpen = false;
+        }
+    }
+}
+
+// Linear 划分的 bin 间距：单 bin 时取略大于范围宽度，使最大值仍落在 bin 0；常量体取 1。
+double GetLinearSpacing(double rangeWidth, int binCount)
+{
+    if (rangeWidth > 0.0 && binCount == 1) {
+        return std::nextafter(rangeWidth, std::numeric_limits<double>::infinity());
+    }
+    return rangeWidth > 0.0 ? rangeWidth / static_cast<double>(binCount - 1) : 1.0;
+}
+
+// 把 removedRuns 覆盖的标量按与父批相同的参数归 bin 后从 counts 扣减。区间为空、越界、未按升序互不重叠，
+// 或任一 bin 不足扣减（说明 delta 与父批不符）时返回 false，counts 内容随之作废。
+bool SetRemovedCounts(
+    vtkDataArray* scalars,
+    const std::vector<ValidityMaskRun>& removedRuns,
+    bool isLog,
+    double origin,
+    double binSpacing,
+    double logScale,
+    std::vector<std::uint64_t>& counts)
+{
+    const auto valueCount = static_cast<std::uint64_t>(scalars->GetNumberOfTuples());
+    std::uint64_t previousEnd = 0;
+    for (const auto& run : removedRuns) {
+        if (run.begin < previousEnd || run.begin >= run.end || run.end > valueCount) {
+            return false;
+        }
+        previousEnd = run.end;
+    }
+    std::vector<std::uint64_t> removedCounts(counts.size(), 0);
+    const bool isBuilt = isLog
+        ? SetScalarHistogram<true>(
+            scalars, nullptr, &removedRuns, origin, binSpacing, logScale, removedCounts)
+        : SetScalarHistogram<false>(
+            scalars, nullptr, &removedRuns, origin, binSpacing, 0.0, removedCounts);
+    if (!isBuilt) {
+        return false;
+    }
+    for (std::size_t bin = 0; bin < counts.size(); ++bin) {
+        if (removedCounts[bin] > counts[bin]) {
+            return false;
+        }
+        counts[bin] -= removedCounts[bin];
+    }
+    return true;
+}
+
+// 由未合并计数生成统计：Linear/Log 直接作为 histogram，Adaptive 把细 bin 合并为等样本数粗 bin。
+void SetCountStatistics(
+    const std::vector<std::uint64_t>& counts,
+    HistogramBinning binning,
+    double binSpacing,
+    double logScale,
+    int binCount,
+    VolumeStatistics& statistics)
+{
+    const auto& range = statistics.scalarRange;
+    statistics.binWidth = 0.0;
+    statistics.binStarts.clear();
+    if (binning == HistogramBinning::Adaptive) {
+        SetAdaptiveBins(counts, range[0], binSpacing, binCount, statistics);
+        return;
+    }
+    statistics.histogram = counts;
+    if (binning == HistogramBinning::Log) {
+        statistics.binStarts.resize(statistics.histogram.size());
+        for (std::size_t bin = 0; bin < statistics.binStarts.size(); ++bin) {
+            statistics.binStarts[bin] = std::min(range[1],
+                range[0] + std::expm1(static_cast<double>(bin) / logScale));
+        }
+    }
+    else if (range[1] > range[0]) {
+        statistics.binWidth = binSpacing;
+    }
+}
+} // namespace
+
 bool HistogramConverter::SetBinCount(int binCount)
 {
     if (binCount <= 0) {
         return false;
     }
+    if (binCount != m_binCount) {
+        m_cachedStatistics.reset();
+    }
     m_binCount = binCount;
     return true;
 }
 
-vtkSmartPointer<vtkTable> HistogramConverter::GetOutputData(vtkSmartPointer<vtkImageData> input) {
-    if (!input) return nullptr;
-    double range[2], binWidth;
-    vtkIdType* frequencies = GetHistogramBuffer(input, range, binWidth);
-    if (!frequencies) return nullptr;
+void HistogramConverter::SetBinning(HistogramBinning binning)
+{
+    if (binning != m_binning) {
+        m_cachedStatistics.reset();
+    }
+    m_binning = binning;
+}
+
+vtkSmartPointer<vtkTable> HistogramConverter::GetOutputData(
+    vtkSmartPointer<vtkImageData> input,
+    vtkImageData* validityMask)
+{
+    const auto statistics = GetStatistics(input, validityMask, 0);
+    if (!statistics) return nullptr;
+    const auto binCount = static_cast<vtkIdType>(statistics->histogram.size());
 
     auto table = vtkSmartPointer<vtkTable>::New();
     auto colX = vtkSmartPointer<vtkDoubleArray>::New(); colX->SetName("Intensity");
@@ -36,14 +381,14 @@ vtkSmartPointer<vtkTable> HistogramConverter::GetOutputData(vtkSmartPointer<vtkI
     auto colLogY = vtkSmartPointer<vtkDoubleArray>::New(); colLogY->SetName("LogFrequency");
 
     // 预分配避免 InsertNextValue 反复扩容
-    colX->SetNumberOfTuples(m_binCount);
-    colY->SetNumberOfTuples(m_binCount);
-    colLogY->SetNumberOfTuples(m_binCount);
-
-    for (int i = 0; i < m_binCount; i++) {
-        const vtkIdType frequency = frequencies[i];
-        colX->SetValue(i, range[0] + static_cast<double>(i) * binWidth);
-        colY->SetValue(i, frequency);
+    colX->SetNumberOfTuples(binCount);
+    colY->SetNumberOfTuples(binCount);
+    colLogY->SetNumberOfTuples(binCount);
+
+    for (vtkIdType i = 0; i < binCount; i++) {
+        const auto frequency = statistics->histogram[static_cast<std::size_t>(i)];
+        colX->SetValue(i, GetBinStart(*statistics, static_cast<std::size_t>(i)));
+        colY->SetValue(i, static_cast<vtkIdType>(frequency));
         colLogY->SetValue(i, std::log(static_cast<double>(frequency) + 1.0));
     }
     table->AddColumn(colX); table->AddColumn(colY); table->AddColumn(colLogY);
@@ -52,15 +397,15 @@ vtkSmartPointer<vtkTable> HistogramConverter::GetOutputData(vtkSmartPointer<vtkI
 
 
 void HistogramConverter::ExportHistogram(vtkSmartPointer<vtkImageData> input, const std::string& filePath) {
-    if (!input) return;
-    double range[2], binWidth;
-    // 复用 GetHistogramBuffer 持有的 accumulate 管线；输入未修改时由 VTK 跳过重复计算。
-    vtkIdType* freqs = GetHistogramBuffer(input, range, binWidth);
-    if (!freqs) return;
+    // 统计按 image 修改时间缓存；输入未修改时不重复扫描。
+    const auto statistics = GetStatistics(input, nullptr, 0);
+    if (!statistics) return;
+    const auto& freqs = statistics->histogram;
+    const int binCount = static_cast<int>(freqs.size());
 
-    std::vector<double> logHist(m_binCount);
+    std::vector<double> logHist(freqs.size());
     double maxLog = 0.0;
-    for (int i = 0; i < m_binCount; ++i) {
+    for (int i = 0; i < binCount; ++i) {
         logHist[i] = std::log(static_cast<double>(freqs[i]) + 1.0);
         if (logHist[i] > maxLog) maxLog = logHist[i];
     }
@@ -74,7 +419,7 @@ void HistogramConverter::ExportHistogram(vtkSmartPointer<vtkImageData> input, co
 
     for (int y = 0; y < H; ++y) {
         for (int x = 0; x < W; ++x) {
-            int binIdx = (x * m_binCount) / W;
+            int binIdx = (x * binCount) / W;
             int h_limit = static_cast<int>((logHist[binIdx] / (maxLog > 0.0 ? maxLog : 1.0)) * H * 0.9);
             unsigned char* pix = ptr + (y * W + x) * 3;
 
@@ -115,90 +460,266 @@ void HistogramConverter::ExportHistogram(vtkSmartPointer<vtkImageData> input, co
 
 std::optional<double> HistogramConverter::GetHistogramPercentile(
     vtkImageData* image,
-    double quantile)
+    double quantile,
+    vtkImageData* validityMask)
 {
     if (!std::isfinite(quantile) || quantile < 0.0 || quantile > 1.0) {
         return std::nullopt;
     }
-
-    double range[2] = { 0.0, 0.0 };
-    double binWidth = 0.0;
-    vtkIdType* frequencies = GetHistogramBuffer(image, range, binWidth);
-    if (!frequencies) {
+    const auto statistics = GetStatistics(image, validityMask, 0);
+    if (!statistics) {
         return std::nullopt;
     }
-    if (quantile == 0.0 || range[0] == range[1]) {
-        return range[0];
+    return GetHistogramPercentile(*statistics, quantile);
+}
+
+std::optional<double> HistogramConverter::GetHistogramPercentile(
+    const VolumeStatistics& statistics,
+    double quantile)
+{
+    if (!std::isfinite(quantile) || quantile < 0.0 || quantile > 1.0
+        || !GetStatisticsUsable(statistics)) {
+        return std::nullopt;
     }
-    if (quantile == 1.0) {
-        return range[1];
+    std::vector<double> values;
+    if (!SetBinPercentiles(statistics, std::vector<double>{ quantile }, values)) {
+        return std::nullopt;
     }
+    return values.front();
+}
 
-    long double sampleCount = 0.0L;
-    for (int i = 0; i < m_binCount; ++i) {
-        sampleCount += static_cast<long double>(frequencies[i]);
+std::optional<std::vector<double>> HistogramConverter::GetHistogramPercentiles(
+    const VolumeStatistics& statistics,
+    const std::vector<double>& quantiles)
+{
+    if (!GetStatisticsUsable(statistics)) {
+        return std::nullopt;
     }
-    if (sampleCount <= 0.0L) {
+    for (const double quantile : quantiles) {
+        if (!std::isfinite(quantile) || quantile < 0.0 || quantile > 1.0) {
+            return std::nullopt;
+        }
+    }
+    std::vector<double> values;
+    if (!SetBinPercentiles(statistics, quantiles, values)) {
         return std::nullopt;
     }
+    return values;
+}
 
-    const long double targetRank =
-        std::ceil(static_cast<long double>(quantile) * sampleCount);
-    long double currentRank = 0.0L;
-    for (int i = 0; i < m_binCount; ++i) {
-        currentRank += static_cast<long double>(frequencies[i]);
-        if (currentRank >= targetRank) {
-            const double estimate =
-                range[0] + static_cast<double>(i) * binWidth;
-            return std::clamp(estimate, range[0], range[1]);
+std::optional<double> HistogramConverter::GetHistogramCdf(
+    const VolumeStatistics& statistics,
+    double value)
+{
+    if (std::isnan(value) || !GetStatisticsUsable(statistics)) {
+        return std::nullopt;
+    }
+    std::uint64_t sampleCount = 0;
+    for (const auto count : statistics.histogram) {
+        sampleCount += count;
+    }
+    if (sampleCount == 0) {
+        return std::nullopt;
+    }
+    if (value < statistics.scalarRange[0]) {
+        return 0.0;
+    }
+    std::size_t lastBin = statistics.histogram.size() - 1;
+    if (value < statistics.scalarRange[1]) {
+        if (!statistics.binStarts.empty()) {
+            const auto next = std::upper_bound(
+                statistics.binStarts.begin(), statistics.binStarts.end(), value);
+            lastBin = static_cast<std::size_t>(
+                std::max<std::ptrdiff_t>(1, next - statistics.binStarts.begin()) - 1);
         }
+        else if (statistics.binWidth > 0.0) {
+            lastBin = std::min(lastBin, static_cast<std::size_t>(
+                (value - statistics.scalarRange[0]) / statistics.binWidth));
+        }
+    }
+    std::uint64_t currentCount = 0;
+    for (std::size_t bin = 0; bin <= lastBin; ++bin) {
+        currentCount += statistics.histogram[bin];
     }
-    return range[1];
+    return static_cast<double>(currentCount) / static_cast<double>(sampleCount);
 }
 
-vtkIdType* HistogramConverter::GetHistogramBuffer(vtkImageData* input, double outRange[2], double& outBinWidth)
+std::vector<double> HistogramConverter::BuildHistogramCdf(
+    const VolumeStatistics& statistics)
 {
-    if (!input || !input->GetPointData() || !input->GetPointData()->GetScalars() || m_binCount <= 0) {
-        outRange[0] = 0.0;
-        outRange[1] = 0.0;
-        outBinWidth = 0.0;
-        return nullptr;
+    std::vector<double> cdf;
+    if (!GetStatisticsUsable(statistics)) {
+        return cdf;
+    }
+    std::uint64_t sampleCount = 0;
+    for (const auto count : statistics.histogram) {
+        sampleCount += count;
     }
+    if (sampleCount == 0) {
+        return cdf;
+    }
+    cdf.resize(statistics.histogram.size());
+    std::uint64_t currentCount = 0;
+    for (std::size_t bin = 0; bin < cdf.size(); ++bin) {
+        currentCount += statistics.histogram[bin];
+        cdf[bin] = static_cast<double>(currentCount) / static_cast<double>(sampleCount);
+    }
+    return cdf;
+}
 
-    input->GetScalarRange(outRange);
-    if (!std::isfinite(outRange[0]) || !std::isfinite(outRange[1])
-        || outRange[1] < outRange[0]) {
-        outBinWidth = 0.0;
+std::shared_ptr<const VolumeStatistics> HistogramConverter::GetStatistics(
+    vtkImageData* image,
+    vtkImageData* validityMask,
+    std::uint64_t dataVersion,
+    const ValidityMaskDelta* maskDelta)
+{
+    auto* scalars = image && image->GetPointData()
+        ? image->GetPointData()->GetScalars() : nullptr;
+    if (!scalars || scalars->GetNumberOfComponents() != 1 || m_binCount <= 0) {
         return nullptr;
     }
+    auto* maskScalars = validityMask && validityMask->GetPointData()
+        ? validityMask->GetPointData()->GetScalars() : nullptr;
+    if (validityMask
+        && (!maskScalars
+            || maskScalars->GetDataType() != VTK_UNSIGNED_CHAR
+            || maskScalars->GetNumberOfComponents() != 1
+            || maskScalars->GetNumberOfTuples() != scalars->GetNumberOfTuples())) {
+        return nullptr;
+    }
+    const vtkMTimeType scalarsTime = scalars->GetMTime();
+    const vtkMTimeType imageTime = std::max(image->GetMTime(), scalarsTime);
+    const vtkMTimeType maskTime = maskScalars
+        ? std::max(validityMask->GetMTime(), maskScalars->GetMTime()) : 0;
+    if (m_cachedStatistics
+        && m_cachedVersion == dataVersion
+        && m_cachedImage == image && m_cachedMask == validityMask
+        && m_cachedImageTime == imageTime && m_cachedMaskTime == maskTime) {
+        return m_cachedStatistics;
+    }
 
-    const double rangeWidth = outRange[1] - outRange[0];
+    auto statistics = std::make_shared<VolumeStatistics>();
+    HistogramBinning binning = HistogramBinning::Linear;
     double binSpacing = 1.0;
-    if (rangeWidth > 0.0 && m_binCount == 1) {
-        outBinWidth = std::nextafter(
-            rangeWidth, std::numeric_limits<double>::infinity());
-        binSpacing = outBinWidth;
+    double logScale = 0.0;
+    std::vector<std::uint64_t> counts;
+    bool isBuilt = false;
+
+    // 增量路径：本批与缓存父批共享同一 scalar 数组，本批 mask 正是 delta 描述的子 mask，
+    // 范围与归 bin 参数沿用父批，只对被裁掉的体素归 bin 后扣减。
+    if (maskDelta && maskScalars && dataVersion != 0
+        && m_cachedStatistics
+        && maskDelta->parentVersion != 0
+        && maskDelta->parentVersion == m_cachedVersion
+        && maskDelta->maskScalars == maskScalars
+        && m_cachedScalars == scalars
+        && m_cachedScalarsTime == scalarsTime) {
+        statistics->scalarRange = m_cachedStatistics->scalarRange;
+        statistics->checksum = m_cachedStatistics->checksum;
+        statistics->hasChecksum = m_cachedStatistics->hasChecksum;
+        binning = m_cachedBinning;
+        binSpacing = m_cachedBinSpacing;
+        logScale = m_cachedLogScale;
+        counts = m_cachedCounts;
+        isBuilt = SetRemovedCounts(
+            scalars, maskDelta->removedRuns, binning == HistogramBinning::Log,
+            statistics->scalarRange[0], binSpacing, logScale, counts);
+        if (!isBuilt) {
+            statistics = std::make_shared<VolumeStatistics>();
+        }
     }
-    else if (rangeWidth > 0.0) {
-        outBinWidth = rangeWidth / static_cast<double>(m_binCount - 1);
-        binSpacing = outBinWidth;
+
+    if (!isBuilt) {
+        // 范围沿用 image 全部标量（与 accumulate 管线一致），mask 只决定哪些体素计数。
+        double range[2] = { 0.0, 0.0 };
+        image->GetScalarRange(range);
+        if (!std::isfinite(range[0]) || !std::isfinite(range[1]) || range[1] < range[0]) {
+            return nullptr;
+        }
+        statistics->scalarRange = { range[0], range[1] };
+        const double rangeWidth = range[1] - range[0];
+        const auto* mask = maskScalars
+            ? static_cast<const unsigned char*>(maskScalars->GetVoidPointer(0)) : nullptr;
+        binning = rangeWidth > 0.0 && m_binCount > 1
+            ? m_binning : HistogramBinning::Linear;
+
+        if (binning == HistogramBinning::Log) {
+            logScale = static_cast<double>(m_binCount - 1) / std::log1p(rangeWidth);
+            counts.assign(static_cast<std::size_t>(m_binCount), 0);
+            isBuilt = SetScalarHistogram<true>(
+                scalars, mask, nullptr, range[0], binSpacing, logScale, counts);
+        }
+        else if (binning == HistogramBinning::Adaptive) {
+            const std::size_t fineCount =
+                static_cast<std::size_t>(m_binCount) * kAdaptiveRefine;
+            binSpacing = rangeWidth / static_cast<double>(fineCount - 1);
+            counts.assign(fineCount, 0);
+            isBuilt = SetScalarHistogram<false>(
+                scalars, mask, nullptr, range[0], binSpacing, 0.0, counts);
+        }
+        else {
+            binSpacing = GetLinearSpacing(rangeWidth, m_binCount);
+            counts.assign(static_cast<std::size_t>(m_binCount), 0);
+            isBuilt = SetScalarHistogram<false>(
+                scalars, mask, nullptr, range[0], binSpacing, 0.0, counts);
+        }
     }
-    else {
-        outBinWidth = 0.0;
+    if (!isBuilt) {
+        return nullptr;
     }
+    SetCountStatistics(counts, binning, binSpacing, logScale, m_binCount, *statistics);
 
-    // 流式连接：input 没变时 VTK pipeline 不会重复计算
-    if (!m_accumulate)
-		m_accumulate = vtkSmartPointer<vtkImageAccumulate>::New();
-    m_accumulate->SetInputData(input);
-    m_accumulate->SetComponentExtent(0, m_binCount - 1, 0, 0, 0, 0);
-    m_accumulate->SetComponentOrigin(outRange[0], 0, 0);
-    m_accumulate->SetComponentSpacing(binSpacing, 0, 0);
-    m_accumulate->Update();
+    m_cachedVersion = dataVersion;
+    m_cachedImage = image;
+    m_cachedMask = validityMask;
+    m_cachedImageTime = imageTime;
+    m_cachedMaskTime = maskTime;
+    m_cachedStatistics = statistics;
+    m_cachedScalars = scalars;
+    m_cachedScalarsTime = scalarsTime;
+    m_cachedBinning = binning;
+    m_cachedBinSpacing = binSpacing;
+    m_cachedLogScale = logScale;
+    m_cachedCounts = std::move(counts);
+    return statistics;
+}
 
-    if (!m_accumulate->GetOutput() || !m_accumulate->GetOutput()->GetPointData() || !m_accumulate->GetOutput()->GetPointData()->GetScalars()) {
-        return nullptr;
+bool HistogramConverter::SetCachedStatistics(
+    vtkImageData* image,
+    std::uint64_t dataVersion,
+    std::shared_ptr<const VolumeStatistics> statistics)
+{
+    auto* scalars = image && image->GetPointData()
+        ? image->GetPointData()->GetScalars() : nullptr;
+    if (!scalars || scalars->GetNumberOfComponents() != 1 || dataVersion == 0
+        || !statistics || !GetStatisticsUsable(*statistics)
+        || !statistics->binStarts.empty()
+        || statistics->histogram.size() != static_cast<std::size_t>(m_binCount)) {
+        return false;
+    }
+    double range[2] = { 0.0, 0.0 };
+    image->GetScalarRange(range);
+    const double rangeWidth = range[1] - range[0];
+    const double binSpacing = GetLinearSpacing(rangeWidth, m_binCount);
+    if (range[0] != statistics->scalarRange[0]
+        || range[1] != statistics->scalarRange[1]
+        || (rangeWidth > 0.0 && m_binCount > 1 && m_binning != HistogramBinning::Linear)
+        || statistics->binWidth != (rangeWidth > 0.0 ? binSpacing : 0.0)) {
+        return false;
     }
 
-    return static_cast<vtkIdType*>(m_accumulate->GetOutput()->GetScalarPointer());
+    const vtkMTimeType scalarsTime = scalars->GetMTime();
+    m_cachedVersion = dataVersion;
+    m_cachedImage = image;
+    m_cachedMask = nullptr;
+    m_cachedImageTime = std::max(image->GetMTime(), scalarsTime);
+    m_cachedMaskTime = 0;
+    m_cachedScalars = scalars;
+    m_cachedScalarsTime = scalarsTime;
+    m_cachedBinning = HistogramBinning::Linear;
+    m_cachedBinSpacing = binSpacing;
+    m_cachedLogScale = 0.0;
+    m_cachedCounts = statistics->histogram;
+    m_cachedStatistics = std::move(statistics);
+    return true;
 }
@@ -1,24 +1,26 @@
 #include "DataManager.h"
 #include "Platform/Path.h"
 #include <vtkDataArray.h>
-#include <vtkFloatArray.h>
 #include <vtkPointData.h>
 #include <vtkUnsignedCharArray.h>
-#include <vtkClipPolyData.h>
 #include <vtkColorTransferFunction.h>
 #include <vtkErrorCode.h>
 #include <vtkFlyingEdges3D.h>
-#include <vtkImplicitVolume.h>
 #include <vtkOBJWriter.h>
-#include <vtkPLYWriter.h>
-#include <vtkSTLWriter.h>
+#include <vtkPolyDataNormals.h>
+#include <vtkQuadricDecimation.h>
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkTriangleFilter.h>
 #include <fstream>
 #include <filesystem>
+#include <future>
 #include <vtkTIFFReader.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkSMPTools.h>
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <iostream>
 #include <iomanip>
@@ -27,16 +29,122 @@
 #include <mutex>
 #include <optional>
 #include <sstream>
+#include <type_traits>
 #include <vtkTransform.h>
 #include <vtkImageReslice.h>
+#include <vtkInformation.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
 #include <vtkImageChangeInformation.h>
 #include <vtkPNGWriter.h>
 #include <vtkImageImport.h>
-#include <vtkImageAppend.h>
 #include <vtkMatrix3x3.h>
 #include <vtkMatrix4x4.h>
 #include <cstring>
-#include "MemMappedFile.h"
+#include "ExportControl.h"
+#include "ImageMaskOutsideFilter.h"
+#include "MeshWriter.h"
+#include "SessionArchive.h"
+#include "VolumeCache.h"
+#include "VolumeReorder.h"
+
+namespace {
+
+// 流式加载参数：默认只对 GB 级文件启用；每个 slab 约 64 MiB 且不超过全卷 1/kStreamMinSlabs，
+// 读完即翻转并采样预览。阈值调低到小文件时仍按多段推进，预览不会退化为读完才出现。
+constexpr std::size_t kStreamThresholdBytes = 1024ULL * 1024ULL * 1024ULL;
+constexpr std::size_t kStreamSlabBytes = 64ULL * 1024ULL * 1024ULL;
+constexpr std::size_t kStreamMinSlabs = 8;
+// 预览按 8 体素步长点采样（体积 1/512）；首个 slab 落地即发布，后续刷新至少间隔 500 ms，避免各 view 频繁重建管线。
+constexpr int kPreviewStride = 8;
+constexpr auto kPreviewInterval = std::chrono::milliseconds(500);
+// 变换 RAW 导出每个 slab 约 64 MiB；双缓冲下重采样结果的常驻内存约为两个 slab。
+constexpr std::size_t kExportSlabBytes = 64ULL * 1024ULL * 1024ULL;
+
+// 导出取消检查点与进度写入；control 为空表示调用方不关心进度且不可取消。
+bool GetExportCancelled(const std::shared_ptr<ExportControl>& control)
+{
+    return control && control->GetIsCancelled();
+}
+
+void SetExportProgress(
+    const std::shared_ptr<ExportControl>& control,
+    std::size_t doneCount,
+    std::size_t totalCount)
+{
+    if (control) {
+        control->SetProgress(doneCount, totalCount);
+    }
+}
+
+// 流式预览逐点读取原生标量并转为 float；按 VTK 类型一次选定函数，避免逐体素分派。
+using SampleReader = float (*)(const void* data, std::size_t index);
+
+template <typename T>
+float GetSample(const void* data, std::size_t index)
+{
+    return static_cast<float>(static_cast<const T*>(data)[index]);
+}
+
+SampleReader GetSampleReader(int scalarType)
+{
+    switch (scalarType) {
+    case VTK_UNSIGNED_CHAR:
+        return &GetSample<unsigned char>;
+    case VTK_UNSIGNED_SHORT:
+        return &GetSample<unsigned short>;
+    case VTK_SHORT:
+        return &GetSample<short>;
+    case VTK_FLOAT:
+        return &GetSample<float>;
+    default:
+        return nullptr;
+    }
+}
+
+// 网格着色用 TF 预采样表项数；相邻项间线性插值，与逐点求值的差异远小于 8 位量化步长。
+constexpr int kMeshColorTableSize = 4096;
+
+// 逐点按表插值出 RGB；任一标量非有限时返回 false，调用方拒绝整个网格。
+template <typename T>
+bool SetMeshColors(
+    const T* scalars,
+    int components,
+    vtkIdType pointCount,
+    const double* colorTable,
+    double tableMin,
+    double tableScale,
+    unsigned char* rgb)
+{
+    std::atomic<bool> hasFailed{ false };
+    vtkSMPTools::For(0, pointCount,
+        [&](vtkIdType begin, vtkIdType end) {
+            for (vtkIdType pointId = begin; pointId < end; ++pointId) {
+                const double scalar = static_cast<double>(
+                    scalars[pointId * components]);
+                if (!std::isfinite(scalar)) {
+                    hasFailed.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                const double position = std::clamp(
+                    (scalar - tableMin) * tableScale,
+                    0.0, static_cast<double>(kMeshColorTableSize - 1));
+                const int index = std::min(
+                    static_cast<int>(position), kMeshColorTableSize - 2);
+                const double weight = position - index;
+                const double* lower = colorTable + index * 3;
+                unsigned char* target = rgb + pointId * 3;
+                for (int component = 0; component < 3; ++component) {
+                    const double mapped = lower[component]
+                        + (lower[component + 3] - lower[component]) * weight;
+                    target[component] = static_cast<unsigned char>(
+                        std::lround(std::clamp(mapped, 0.0, 1.0) * 255.0));
+                }
+            }
+        });
+    return !hasFailed.load();
+}
+
+} // namespace
 
 class BaseDataManager::Impl final {
 public:
@@ -52,17 +160,122 @@ public:
     {
     }
 
+    ~Impl()
+    {
+        // 缓存文件须完整落盘或留下临时文件由下次写入覆盖；析构等待最后一次后台写入结束。
+        if (m_cacheWrite.valid()) {
+            m_cacheWrite.wait();
+        }
+    }
+
+    // 后台压缩写入缓存，加载线程交付 pending 后立即返回；新写入先等待上一次完成，同一目录串行落盘。
+    // state 只持有独立外壳与只读共享的 scalar，不与 current 的 VTK 对象并发访问。
+    void StartCacheWrite(
+        std::shared_ptr<const VolumeCache> cache,
+        std::string filePath,
+        VolumeLayout layout,
+        ImageState state)
+    {
+        std::lock_guard<std::mutex> lock(m_cacheWriteMutex);
+        auto previousWrite = std::move(m_cacheWrite);
+        m_cacheWrite = std::async(std::launch::async,
+            [cache = std::move(cache), filePath = std::move(filePath),
+             layout = std::move(layout), state = std::move(state),
+             previousWrite = std::move(previousWrite)]() mutable {
+                if (previousWrite.valid()) {
+                    previousWrite.wait();
+                }
+                try {
+                    if (cache->SetVolume(filePath, layout, state)) {
+                        return;
+                    }
+                }
+                catch (const std::exception& error) {
+                    std::cerr << "[Warning] Volume cache write failed: " << error.what() << std::endl;
+                }
+                std::cerr << "[Warning] Failed to store volume cache for: " << filePath << std::endl;
+            });
+    }
+
+    // modelToWorld 线性部分为带符号轴置换（恒等、90°/180° 旋转或镜像）且对应轴 spacing 相同时，
+    // reslice 自动裁剪后的网格与源体素逐点重合。此时输出第 a 轴直接按 strides[a] 步进读取源 scalar。
+    struct AxisPermutation {
+        std::array<int, 3> dims = { 0, 0, 0 };                 // 输出各轴体素数
+        std::array<std::ptrdiff_t, 3> strides = { 0, 0, 0 };  // 输出各轴在源中的体素步长，镜像轴为负
+        std::ptrdiff_t baseOffset = 0;                        // 输出 (0,0,0) 在源中的体素偏移
+    };
+
+    // 切片栈在体数据中的体素步长：图片列/行与切片序号各自映射到一个体数据轴，镜像轴步长为负。
+    struct SliceStackLayout {
+        int width = 0;
+        int height = 0;
+        vtkIdType sliceCount = 0;
+        std::ptrdiff_t baseOffset = 0;
+        std::ptrdiff_t columnStride = 0;
+        std::ptrdiff_t rowStride = 0;
+        std::ptrdiff_t sliceStride = 0;
+        int components = 1;
+    };
+
+    // 非带符号轴置换、含投影分量或置换轴 spacing 不一致时返回 std::nullopt，调用方回退 reslice。
+    static std::optional<AxisPermutation> GetAxisPermutation(
+        vtkImageData* image,
+        const std::array<double, 16>& modelToWorld);
+
+    // 置换路径：按输出 Z slab 把源 scalar 转置进缓冲并整块写出；恒等矩阵直接分块写源内存。
+    static bool ExportPermutedRaw(
+        vtkImageData* image,
+        const AxisPermutation& permutation,
+        const std::string& outputDir,
+        const std::shared_ptr<ExportControl>& control);
+    template <typename T>
+    static void SetPermutedSlab(
+        const T* source,
+        const AxisPermutation& permutation,
+        int zBegin,
+        int zEnd,
+        T* target);
+
+    // 按切片并行填充灰度并编码 PNG；每个工作线程复用一张切片缓冲与一个 writer，
+    // 同时在途的切片数不超过线程数。filePaths 与切片序号一一对应，任一张失败或被取消返回 false。
+    template <typename T>
+    static bool SetSliceStack(
+        const T* values,
+        const unsigned char* mask,
+        const SliceStackLayout& layout,
+        const WindowLevelParams& windowLevel,
+        const std::vector<std::string>& filePaths,
+        const std::shared_ptr<ExportControl>& control);
+
+    // 通用仿射回退：线性 reslice 到自动裁剪的轴对齐体，mask 以最近邻采样到同一网格。
+    static bool BuildReslicedSlices(
+        vtkImageData* imageCopy,
+        vtkImageData* maskCopy,
+        const std::array<double, 16>& modelToWorldMatrix,
+        vtkSmartPointer<vtkImageData>& outputImage,
+        vtkSmartPointer<vtkImageData>& outputMask);
+
     static bool ExportRaw(
         const ImageSnapshot& imageSnapshot,
         const std::string& outputDir,
-        const std::array<double, 16>& modelToWorldMatrix);
+        const std::array<double, 16>& modelToWorldMatrix,
+        const std::shared_ptr<ExportControl>& control);
     static bool ExportMesh(
         const ImageSnapshot& imageSnapshot,
         const std::string& outputDir,
         const DataExportParams& params);
+    static bool ExportSession(
+        const ImageSnapshot& imageSnapshot,
+        vtkSmartPointer<vtkImageData> labelImage,
+        const std::string& outputDir,
+        const std::shared_ptr<ExportControl>& control);
     static bool BuildMeshColors(
         vtkPolyData* mesh,
         const DataExportParams& params);
+    // 抽稀到 targetTriangleCount 附近并重算点法向；失败返回 nullptr。
+    static vtkSmartPointer<vtkPolyData> BuildDecimatedMesh(
+        vtkPolyData* mesh,
+        std::size_t targetTriangleCount);
     static bool GetIsAffine(
         const std::array<double, 16>& modelToWorld);
     static std::filesystem::path BuildExportPath(
@@ -87,6 +300,45 @@ public:
         return rasOrigin;
     }
 
+    // 新建只共享只读数组的 vtkImageData 外壳；外壳几何可独立修改，voxel 不复制。
+    static vtkSmartPointer<vtkImageData> GetImageView(vtkImageData* source)
+    {
+        auto view = vtkSmartPointer<vtkImageData>::New();
+        view->ShallowCopy(source);
+        return view;
+    }
+
+    static int GetVtkScalarType(VolumeScalarType scalarType)
+    {
+        switch (scalarType) {
+        case VolumeScalarType::UInt8:
+            return VTK_UNSIGNED_CHAR;
+        case VolumeScalarType::UInt16:
+            return VTK_UNSIGNED_SHORT;
+        case VolumeScalarType::Int16:
+            return VTK_SHORT;
+        case VolumeScalarType::Float32:
+        default:
+            return VTK_FLOAT;
+        }
+    }
+
+    // 统计可用时直接复用其范围，否则回退 VTK 整卷扫描；返回可随批次发布的 statistics owner。
+    static std::shared_ptr<const VolumeStatistics> GetLoadedStatistics(
+        VolumeStatistics statistics,
+        vtkImageData* image,
+        std::array<double, 2>& range)
+    {
+        if (statistics.histogram.empty()) {
+            double scalarRange[2] = { 0.0, 0.0 };
+            image->GetScalarRange(scalarRange);
+            range = { scalarRange[0], scalarRange[1] };
+            return nullptr;
+        }
+        range = statistics.scalarRange;
+        return std::make_shared<const VolumeStatistics>(std::move(statistics));
+    }
+
     static std::optional<size_t> GetVoxelCount(const int dims[3])
     {
         size_t voxelCount = 1;
@@ -160,14 +412,41 @@ public:
         return true;
     }
 
+    // 标签体只按体素序号与 image 对应，几何随 image；因此只核对维度、类型与分量数。
+    static bool GetLabelValid(
+        vtkImageData* image,
+        vtkImageData* labelImage)
+    {
+        if (!labelImage) {
+            return true;
+        }
+        if (!image
+            || labelImage->GetScalarType() != VTK_INT
+            || labelImage->GetNumberOfScalarComponents() != 1
+            || !labelImage->GetScalarPointer()) {
+            return false;
+        }
+        int imageDims[3] = {};
+        int labelDims[3] = {};
+        image->GetDimensions(imageDims);
+        labelImage->GetDimensions(labelDims);
+        return imageDims[0] == labelDims[0]
+            && imageDims[1] == labelDims[1]
+            && imageDims[2] == labelDims[2];
+    }
+
     bool SetCurrent(ImageState state)
     {
         if (!state.image
-            || !GetMaskValid(state.image, state.validityMask)) {
+            || !GetMaskValid(state.image, state.validityMask)
+            || !GetLabelValid(state.image, state.labelImage)) {
             return false;
         }
         auto nextState = std::make_shared<ImageState>(std::move(state));
         std::shared_ptr<const ImageState> retiredState;
+        std::shared_ptr<const ValidityMaskDelta> retiredDelta;
+        vtkSmartPointer<vtkImageData> retiredLabel;
+        ImageSnapshot retiredBase;
         {
             std::lock_guard<std::mutex> lock(m_dataMutex);
             if (!m_current
@@ -175,73 +454,64 @@ public:
                 return false;
             }
             nextState->version = m_current->version + 1;
+            retiredDelta = SetMaskDelta(*nextState);
+            retiredLabel = SetLabelImage(*nextState);
+            // 首个预览替换 current 时记下原批次，供加载失败回滚；非预览批次发布后不再需要。
+            if (!nextState->isPreview) {
+                retiredBase = std::move(m_previewBase);
+            }
+            else if (!m_current->isPreview) {
+                m_previewBase = m_current;
+            }
             retiredState = std::move(m_current);
             m_current = std::move(nextState);
         }
         return true;
     }
 
+    // 须在 m_dataMutex 内、批次编号后调用：把待发布批次携带的 mask 增量移入单槽，发布出去的 ImageState 不再持有它。
+    // 返回被替换的旧增量，由调用方在锁外释放。
+    std::shared_ptr<const ValidityMaskDelta> SetMaskDelta(ImageState& nextState)
+    {
+        auto retiredDelta = std::move(m_maskDelta);
+        m_maskDelta = std::move(nextState.maskDelta);
+        nextState.maskDelta = nullptr;
+        m_maskDeltaVersion = m_maskDelta ? nextState.version : 0;
+        return retiredDelta;
+    }
+
+    // 与 SetMaskDelta 同一时机调用：批次携带的标签体（可空）替换单槽，旧批次登记的标签体随之退役。
+    // 返回被替换的旧标签体，由调用方在锁外释放。
+    vtkSmartPointer<vtkImageData> SetLabelImage(ImageState& nextState)
+    {
+        auto retiredLabel = std::move(m_labelImage);
+        m_labelImage = std::move(nextState.labelImage);
+        nextState.labelImage = nullptr;
+        m_labelVersion = m_labelImage ? nextState.version : 0;
+        return retiredLabel;
+    }
+
     // current ImageState 与 scalar range 共用此锁；snapshot 是跨字段一致性的读取入口。
     mutable std::mutex m_dataMutex;
     // current 只向受控内部消费链发布 const owner；写入只能通过 DataManager 提交新批次。
     ImageSnapshot m_current;
     mutable std::mutex m_pendingMutex;
     ImageState m_pending{};
+    // 可选磁盘缓存；加载线程在入口处取 owner 快照，运行中替换只影响后续加载。
+    mutable std::mutex m_cacheMutex;
+    std::shared_ptr<const VolumeCache> m_volumeCache;
+    std::mutex m_cacheWriteMutex;
+    std::future<void> m_cacheWrite;
+    // 流式预览首次替换 current 前的批次，受 m_dataMutex 保护；完整批次发布后清空，ClearPending 据此回滚。
+    ImageSnapshot m_previewBase;
+    // current 批次发布时携带的 mask 增量单槽，受 m_dataMutex 保护；只保留最新一批，领取后清空。
+    std::shared_ptr<const ValidityMaskDelta> m_maskDelta;
+    DataVersion m_maskDeltaVersion = 0;
+    // m_labelVersion 批次登记的 gap 标签体单槽，受 m_dataMutex 保护；新批次发布时替换，读取不清空。
+    vtkSmartPointer<vtkImageData> m_labelImage;
+    DataVersion m_labelVersion = 0;
     // 与 current image 同批提交的 RAS 物理轴间距 [x,y,z]，单位沿用输入。
 
-    bool SetRasScalars(
-        const float* src,
-        float* dst,
-        const int dims[3],
-        size_t availableCount) const
-    {
-        const auto voxelCount = GetVoxelCount(dims);
-        if (!voxelCount) {
-            return false;
-        }
-        const size_t nx = static_cast<size_t>(dims[0]);
-        const size_t ny = static_cast<size_t>(dims[1]);
-        const size_t nz = static_cast<size_t>(dims[2]);
-        const size_t sliceSize = nx * ny;
-        const size_t totalCount = *voxelCount;
-
-        if (!dst || totalCount == 0 || availableCount > totalCount) {
-            return false;
-        }
-
-        if (!src || availableCount == 0) {
-            std::fill(dst, dst + totalCount, 0.0f);
-            return true;
-        }
-
-        if (availableCount == totalCount) {
-            for (size_t z = 0; z < nz; ++z) {
-                const size_t srcSliceOffset = z * sliceSize;
-                const size_t dstSliceOffset = z * sliceSize;
-                for (size_t y = 0; y < ny; ++y) {
-                    const float* srcRow = src + srcSliceOffset + y * nx;
-                    float* dstRow = dst + dstSliceOffset + (ny - 1 - y) * nx;
-                    for (size_t x = 0; x < nx; ++x) {
-                        dstRow[nx - 1 - x] = srcRow[x];
-                    }
-                }
-            }
-            return true;
-        }
-
-        std::fill(dst, dst + totalCount, 0.0f);
-        for (size_t srcIndex = 0; srcIndex < availableCount; ++srcIndex) {
-            const size_t z = srcIndex / sliceSize;
-            const size_t rem = srcIndex % sliceSize;
-            const size_t y = rem / nx;
-            const size_t x = rem % nx;
-            const size_t dstIndex = z * sliceSize + (ny - 1 - y) * nx + (nx - 1 - x);
-            dst[dstIndex] = src[srcIndex];
-        }
-
-        return true;
-    }
-
     std::string GetOrientName(Orientation value) const
     {
         switch (value) {
@@ -270,9 +540,9 @@ public:
         }
     }
 
-    unsigned char GetWindowGray(
+    static unsigned char GetWindowGray(
         double value,
-        const WindowLevelParams& params) const
+        const WindowLevelParams& params)
     {
         const double safeWindowWidth = std::max(params.windowWidth, 1e-6); // 当前导出使用的窗宽，避免除零
         const double windowMin = params.windowCenter - safeWindowWidth * 0.5; // 当前灰度映射下限
@@ -286,10 +556,21 @@ class TiffVolumeDataManager::Impl final {
 public:
     vtkSmartPointer<vtkImageData> LoadImage(
         const std::string& inputPath,
-        const VolumeLayout& layout);
+        const VolumeLayout& layout,
+        VolumeStatistics& statistics);
 
 private:
-    bool SetLpsRasImage(vtkImageData* source, vtkImageData* target) const;
+    // 以首张切片与 layout 定型并预分配 RAS 目标体；其余切片在 vtkSMPTools 线程上并行解码，
+    // 每张切片使用独立的 vtkTIFFReader，解码结果直接翻转写入对应 Z 平面。
+    vtkSmartPointer<vtkImageData> LoadSeries(
+        const std::vector<std::string>& fileList,
+        const VolumeLayout& layout,
+        VolumeStatistics& statistics) const;
+
+    bool SetLpsRasImage(
+        vtkImageData* source,
+        vtkImageData* target,
+        VolumeStatistics& statistics) const;
 };
 
 BaseDataManager::BaseDataManager()
@@ -344,17 +625,14 @@ bool BaseDataManager::SetSpacing(const std::array<double, 3>& spacing)
         }
 
         // spacing 只修改 VTK 外壳；scalar 在版本间保持只读共享，避免复制整卷 voxel。
-        auto candidate = vtkSmartPointer<vtkImageData>::New();
-        candidate->ShallowCopy(baseState->image);
+        auto candidate = Impl::GetImageView(baseState->image);
         candidate->SetSpacing(spacing.data());
 
         auto nextState = std::make_shared<ImageState>(*baseState);
         nextState->image = std::move(candidate);
         if (baseState->validityMask) {
             auto maskCandidate =
-                vtkSmartPointer<vtkImageData>::New();
-            maskCandidate->ShallowCopy(
-                baseState->validityMask);
+                Impl::GetImageView(baseState->validityMask);
             maskCandidate->SetSpacing(spacing.data());
             nextState->validityMask =
                 std::move(maskCandidate);
@@ -362,12 +640,17 @@ bool BaseDataManager::SetSpacing(const std::array<double, 3>& spacing)
         nextState->spacing = spacing;
         nextState->version = baseState->version + 1;
         std::shared_ptr<const ImageState> retiredState;
+        std::shared_ptr<const ValidityMaskDelta> retiredDelta;
+        vtkSmartPointer<vtkImageData> retiredLabel;
         {
             std::lock_guard<std::mutex> lock(m_impl->m_dataMutex);
             // 3. 仅当 current 仍是基准对象才提交；并发发布抢先时重试，三次冲突后返回失败。
             if (m_impl->m_current != baseState) {
                 continue;
             }
+            retiredDelta = m_impl->SetMaskDelta(*nextState);
+            // 标签体按物理间距分析得出，spacing 变化后不再代表新批次，随单槽一起退役。
+            retiredLabel = m_impl->SetLabelImage(*nextState);
             retiredState = std::move(m_impl->m_current);
             m_impl->m_current = std::move(nextState);
         }
@@ -384,17 +667,14 @@ DataVersion BaseDataManager::GetDataVersion() const
 
 ImageState BaseDataManager::GetImageState() const
 {
+    // 每次调用只新建 vtkImageData 外壳并共享当前批次的只读 scalar/mask 数组，内存开销与体大小无关。
     const auto currentState = GetImageSnapshot();
     ImageState publicState = *currentState;
     if (publicState.image) {
-        auto imageCopy = vtkSmartPointer<vtkImageData>::New();
-        imageCopy->DeepCopy(publicState.image);
-        publicState.image = std::move(imageCopy);
+        publicState.image = Impl::GetImageView(publicState.image);
     }
     if (publicState.validityMask) {
-        auto maskCopy = vtkSmartPointer<vtkImageData>::New();
-        maskCopy->DeepCopy(publicState.validityMask);
-        publicState.validityMask = std::move(maskCopy);
+        publicState.validityMask = Impl::GetImageView(publicState.validityMask);
     }
     return publicState;
 }
@@ -415,6 +695,8 @@ bool BaseDataManager::SetCurrentData(
         || !state.image
         || !Impl::GetMaskValid(
             state.image, state.validityMask)
+        || !Impl::GetLabelValid(
+            state.image, state.labelImage)
         || expectedSnapshot->version
             == std::numeric_limits<DataVersion>::max()) {
         return false;
@@ -423,6 +705,9 @@ bool BaseDataManager::SetCurrentData(
     auto nextState =
         std::make_shared<ImageState>(std::move(state));
     std::shared_ptr<const ImageState> retiredState;
+    std::shared_ptr<const ValidityMaskDelta> retiredDelta;
+    vtkSmartPointer<vtkImageData> retiredLabel;
+    ImageSnapshot retiredBase;
     {
         std::lock_guard<std::mutex> lock(m_impl->m_dataMutex);
         // 同时比较 owner 身份与 version，避免 ABA 或并发 load 覆盖更晚 current。
@@ -432,6 +717,11 @@ bool BaseDataManager::SetCurrentData(
             return false;
         }
         nextState->version = expectedSnapshot->version + 1;
+        retiredDelta = m_impl->SetMaskDelta(*nextState);
+        retiredLabel = m_impl->SetLabelImage(*nextState);
+        if (!nextState->isPreview) {
+            retiredBase = std::move(m_impl->m_previewBase);
+        }
         retiredState = std::move(m_impl->m_current);
         m_impl->m_current = std::move(nextState);
         publishedSnapshot = m_impl->m_current;
@@ -445,6 +735,84 @@ bool BaseDataManager::SetFromBuffer(
     return false;
 }
 
+bool BaseDataManager::SetSessionLoaded(const std::string& filePath)
+{
+    // 归档只映射不预取；几何、统计与裁切历史直接取元数据，只解压归档中实际存在的层，不再全卷重扫。
+    SessionArchive archive;
+    if (filePath.empty() || !archive.Load(filePath)) {
+        return false;
+    }
+    ImageState state;
+    state.image = archive.GetImage(SessionArchive::Layer::Image);
+    if (archive.HasLayer(SessionArchive::Layer::Mask)) {
+        state.validityMask = archive.GetImage(SessionArchive::Layer::Mask);
+        if (!state.validityMask) {
+            return false;
+        }
+    }
+    // 标签体随 pending 批次提交，发布时登记到新 version 的单槽，之后再次保存仍会带上。
+    if (archive.HasLayer(SessionArchive::Layer::Label)) {
+        state.labelImage = archive.GetImage(SessionArchive::Layer::Label);
+        if (!state.labelImage) {
+            return false;
+        }
+    }
+    if (!state.image
+        || !Impl::GetMaskValid(state.image, state.validityMask)
+        || !Impl::GetLabelValid(state.image, state.labelImage)) {
+        return false;
+    }
+    state.dims = archive.GetDimensions();
+    state.spacing = archive.GetSpacing();
+    state.origin = archive.GetOrigin();
+    state.scalarRange = archive.GetScalarRange();
+    state.statistics = archive.GetStatistics();
+    if (!archive.GetCropOperations().empty()) {
+        state.cropHistory = std::make_shared<const std::vector<SessionCropOp>>(
+            archive.GetCropOperations());
+    }
+    return SetPendingImage(std::move(state));
+}
+
+std::shared_ptr<const ValidityMaskDelta> BaseDataManager::GetMaskDelta(DataVersion version)
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_dataMutex);
+    if (version == 0 || m_impl->m_maskDeltaVersion != version) {
+        return nullptr;
+    }
+    m_impl->m_maskDeltaVersion = 0;
+    return std::move(m_impl->m_maskDelta);
+}
+
+bool BaseDataManager::SetLabelImage(
+    DataVersion version,
+    vtkSmartPointer<vtkImageData> labelImage)
+{
+    if (version == 0 || !labelImage) {
+        return false;
+    }
+    vtkSmartPointer<vtkImageData> retiredLabel;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_dataMutex);
+        if (m_impl->m_current->version != version
+            || !Impl::GetLabelValid(m_impl->m_current->image, labelImage)) {
+            return false;
+        }
+        retiredLabel = std::move(m_impl->m_labelImage);
+        m_impl->m_labelImage = std::move(labelImage);
+        m_impl->m_labelVersion = version;
+    }
+    return true;
+}
+
+vtkSmartPointer<vtkImageData> BaseDataManager::GetLabelImage(DataVersion version) const
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_dataMutex);
+    return version != 0 && m_impl->m_labelVersion == version
+        ? m_impl->m_labelImage
+        : nullptr;
+}
+
 bool BaseDataManager::SetCurrentFromPending(bool& hasPending)
 {
     // pending 是单槽 staging：锁内一次性 take，锁外调用 VTK Modified/发布 current。
@@ -462,6 +830,22 @@ bool BaseDataManager::SetCurrentFromPending(bool& hasPending)
     return m_impl->SetCurrent(std::move(incoming));
 }
 
+bool BaseDataManager::SetCurrentFromPreview(bool& hasPreview)
+{
+    // 与 SetCurrentFromPending 共用单槽，但只领取预览；完整批次到达后会覆盖未领取的预览。
+    hasPreview = false;
+    ImageState incoming;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_pendingMutex);
+        if (!m_impl->m_pending.image || !m_impl->m_pending.isPreview) return true;
+        hasPreview = true;
+        incoming = std::move(m_impl->m_pending);
+        m_impl->m_pending = {};
+    }
+    incoming.image->Modified();
+    return m_impl->SetCurrent(std::move(incoming));
+}
+
 bool BaseDataManager::ClearPending()
 {
     ImageState retiredPending;
@@ -471,7 +855,23 @@ bool BaseDataManager::ClearPending()
         retiredPending = std::move(m_impl->m_pending);
         m_impl->m_pending = {};
     }
-    return true;
+    // 预览已提交为 current 而完整批次被放弃：回滚到预览前的批次，current 不残留粗分辨率过渡数据。
+    ImageSnapshot previewBase;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_dataMutex);
+        if (m_impl->m_current->isPreview) {
+            previewBase = std::move(m_impl->m_previewBase);
+        }
+    }
+    if (!previewBase) {
+        return true;
+    }
+    ImageState restoredState = *previewBase;
+    restoredState.image = Impl::GetImageView(previewBase->image);
+    if (previewBase->validityMask) {
+        restoredState.validityMask = Impl::GetImageView(previewBase->validityMask);
+    }
+    return m_impl->SetCurrent(std::move(restoredState));
 }
 
 bool BaseDataManager::SetPendingImage(ImageState image)
@@ -487,6 +887,56 @@ bool BaseDataManager::SetPendingImage(ImageState image)
     return true;
 }
 
+void BaseDataManager::SetVolumeCache(std::shared_ptr<const VolumeCache> cache)
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_cacheMutex);
+    m_impl->m_volumeCache = std::move(cache);
+}
+
+std::shared_ptr<const VolumeCache> BaseDataManager::GetVolumeCache() const
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_cacheMutex);
+    return m_impl->m_volumeCache;
+}
+
+bool BaseDataManager::SetCachedImage(
+    const std::string& filePath,
+    const VolumeLayout& layout)
+{
+    const auto cache = GetVolumeCache();
+    if (!cache) {
+        return false;
+    }
+    // 预览先进入 pending 单槽；完整批次随后覆盖未被领取的预览，与流式加载的交付顺序一致。
+    ImageState cachedState;
+    if (!cache->GetVolume(
+            filePath, layout,
+            [this](ImageState preview) { (void)SetPendingImage(std::move(preview)); },
+            cachedState)) {
+        return false;
+    }
+    return SetPendingImage(std::move(cachedState));
+}
+
+bool BaseDataManager::SetLoadedImage(
+    const std::string& filePath,
+    const VolumeLayout& layout,
+    ImageState image)
+{
+    const auto cache = GetVolumeCache();
+    if (!cache) {
+        return SetPendingImage(std::move(image));
+    }
+    // scalar 在版本间只读共享，先交付 pending 再后台压缩落盘；写缓存失败不影响本次加载结果。
+    ImageState storedState = image;
+    storedState.image = Impl::GetImageView(image.image);
+    if (!SetPendingImage(std::move(image))) {
+        return false;
+    }
+    m_impl->StartCacheWrite(cache, filePath, layout, std::move(storedState));
+    return true;
+}
+
 bool BaseDataManager::SetOwnedImage(vtkSmartPointer<vtkImageData> image)
 {
     if (!image) {
@@ -513,36 +963,131 @@ bool BaseDataManager::SetOwnedImage(vtkSmartPointer<vtkImageData> image)
     });
 }
 
-bool BaseDataManager::ExportSlices(
-    const std::string& dirPath,
-    Orientation orientation,
+template <typename T>
+bool BaseDataManager::Impl::SetSliceStack(
+    const T* values,
+    const unsigned char* mask,
+    const SliceStackLayout& layout,
     const WindowLevelParams& windowLevel,
-    const std::array<double, 16>& modelToWorldMatrix)
+    const std::vector<std::string>& filePaths,
+    const std::shared_ptr<ExportControl>& control)
 {
-
-    // 导出路径：1. 固定 current 批次并把 modelToWorld 取逆；2. 重采样到轴对齐体数据；
-    // 3. 按 Orientation 将二维像素映射回 X/Y/Z；4. 应用窗宽窗位并逐层写 PNG。
-
-    if (dirPath.empty()) {
-        std::cerr << "[Export] Slice image export failed: output directory is empty." << std::endl;
+    if (!values || layout.width <= 0 || layout.height <= 0
+        || filePaths.size() != static_cast<std::size_t>(layout.sliceCount)) {
         return false;
     }
 
-    auto imageCopy = vtkSmartPointer<vtkImageData>::New();
-    vtkSmartPointer<vtkImageData> maskCopy;
-    std::shared_ptr<const ImageState> currentState;
-    {
-        std::lock_guard<std::mutex> lock(m_impl->m_dataMutex);
-        currentState = m_impl->m_current;
-    }
-    if (!currentState->image) return false;
-    imageCopy->ShallowCopy(currentState->image);
-    if (currentState->validityMask) {
-        maskCopy = vtkSmartPointer<vtkImageData>::New();
-        maskCopy->ShallowCopy(
-            currentState->validityMask);
+    // 8/16 位整数按类型全值域预建窗宽窗位表，逐像素只剩一次查表；其余类型逐值计算。
+    // 表项同样由 GetWindowGray 生成，两条路径的输出逐字节一致。
+    constexpr bool kHasLut = std::is_integral_v<T> && sizeof(T) <= 2;
+    constexpr long long kLutMin = kHasLut
+        ? static_cast<long long>(std::numeric_limits<T>::min()) : 0;
+    std::vector<unsigned char> grayLut;
+    if constexpr (kHasLut) {
+        constexpr long long kLutMax =
+            static_cast<long long>(std::numeric_limits<T>::max());
+        grayLut.resize(static_cast<std::size_t>(kLutMax - kLutMin + 1));
+        for (long long value = kLutMin; value <= kLutMax; ++value) {
+            grayLut[static_cast<std::size_t>(value - kLutMin)] =
+                GetWindowGray(static_cast<double>(value), windowLevel);
+        }
     }
+    const unsigned char* lut = grayLut.data();
+    const auto getGray = [lut, &windowLevel](T value) -> unsigned char {
+        if constexpr (kHasLut) {
+            return lut[static_cast<long long>(value) - kLutMin];
+        }
+        else {
+            return GetWindowGray(static_cast<double>(value), windowLevel);
+        }
+    };
+
+    const std::ptrdiff_t components = static_cast<std::ptrdiff_t>(layout.components);
+    vtkSMPThreadLocalObject<vtkImageData> sliceImages;
+    vtkSMPThreadLocalObject<vtkPNGWriter> writers;
+    std::atomic<bool> hasFailed{ false };
+    std::atomic<std::size_t> writtenCount{ 0 };
+    const auto sliceCount = static_cast<std::size_t>(layout.sliceCount);
+    vtkSMPTools::For(0, layout.sliceCount, 1,
+        [&](vtkIdType begin, vtkIdType end) {
+            vtkImageData* sliceImage = sliceImages.Local();
+            vtkPNGWriter* writer = writers.Local();
+            for (vtkIdType sliceIndex = begin;
+                 sliceIndex < end && !hasFailed.load(std::memory_order_relaxed);
+                 ++sliceIndex) {
+                // 取消只在切片边界生效；已在编码的切片写完后其余线程随 hasFailed 一并停止。
+                if (GetExportCancelled(control)) {
+                    hasFailed.store(true, std::memory_order_relaxed);
+                    break;
+                }
+                try {
+                    int sliceDims[3] = { 0, 0, 0 };
+                    sliceImage->GetDimensions(sliceDims);
+                    if (!sliceImage->GetPointData()->GetScalars()
+                        || sliceDims[0] != layout.width
+                        || sliceDims[1] != layout.height) {
+                        sliceImage->SetDimensions(layout.width, layout.height, 1);
+                        sliceImage->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+                    }
+                    auto* dst = static_cast<unsigned char*>(
+                        sliceImage->GetScalarPointer());
+                    if (!dst) {
+                        hasFailed.store(true, std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    const std::ptrdiff_t sliceOffset = layout.baseOffset
+                        + static_cast<std::ptrdiff_t>(sliceIndex) * layout.sliceStride;
+                    for (int py = 0; py < layout.height; ++py) {
+                        const std::ptrdiff_t rowOffset =
+                            sliceOffset + static_cast<std::ptrdiff_t>(py) * layout.rowStride;
+                        unsigned char* dstRow =
+                            dst + static_cast<std::size_t>(py) * layout.width;
+                        if (mask) {
+                            for (int px = 0; px < layout.width; ++px) {
+                                const std::ptrdiff_t voxel = rowOffset
+                                    + static_cast<std::ptrdiff_t>(px) * layout.columnStride;
+                                dstRow[px] = mask[voxel] != 0
+                                    ? getGray(values[voxel * components])
+                                    : 0;
+                            }
+                        }
+                        else {
+                            for (int px = 0; px < layout.width; ++px) {
+                                const std::ptrdiff_t voxel = rowOffset
+                                    + static_cast<std::ptrdiff_t>(px) * layout.columnStride;
+                                dstRow[px] = getGray(values[voxel * components]);
+                            }
+                        }
+                    }
+                    sliceImage->Modified();
+
+                    writer->SetFileName(
+                        filePaths[static_cast<std::size_t>(sliceIndex)].c_str());
+                    writer->SetInputData(sliceImage);
+                    writer->Write();
+                    if (writer->GetErrorCode() != 0) {
+                        hasFailed.store(true, std::memory_order_relaxed);
+                    }
+                    else {
+                        SetExportProgress(control, ++writtenCount, sliceCount);
+                    }
+                }
+                catch (...) {
+                    hasFailed.store(true, std::memory_order_relaxed);
+                }
+            }
+        });
+    return !hasFailed.load();
+}
 
+bool BaseDataManager::Impl::BuildReslicedSlices(
+    vtkImageData* imageCopy,
+    vtkImageData* maskCopy,
+    const std::array<double, 16>& modelToWorldMatrix,
+    vtkSmartPointer<vtkImageData>& outputImage,
+    vtkSmartPointer<vtkImageData>& outputMask)
+{
     auto worldToModelMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
     worldToModelMatrix->DeepCopy(modelToWorldMatrix.data());
     worldToModelMatrix->Invert();
@@ -568,20 +1113,12 @@ bool BaseDataManager::ExportSlices(
         return false;
     }
 
-    auto outputImage = reslice->GetOutput();
+    outputImage = reslice->GetOutput();
     if (!outputImage || outputImage->GetNumberOfPoints() == 0) {
         return false;
     }
 
-    int dims[3] = { 0, 0, 0 };
-    outputImage->GetDimensions(dims);
-    if (dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0) {
-        return false;
-    }
-    int outputExtent[6] = { 0, -1, 0, -1, 0, -1 };
-    outputImage->GetExtent(outputExtent);
-
-    vtkSmartPointer<vtkImageData> outputMask;
+    outputMask = nullptr;
     if (maskCopy) {
         auto maskReslice =
             vtkSmartPointer<vtkImageReslice>::New();
@@ -613,6 +1150,87 @@ bool BaseDataManager::ExportSlices(
         }
     }
 
+    // 输出与 reslice 管线脱钩，不再经 producer 间接持有输入；调用方随后可以释放源批次。
+    const auto detach = [](vtkSmartPointer<vtkImageData>& image) {
+        if (image) {
+            auto detached = vtkSmartPointer<vtkImageData>::New();
+            detached->ShallowCopy(image);
+            image = detached;
+        }
+    };
+    detach(outputImage);
+    detach(outputMask);
+    return true;
+}
+
+bool BaseDataManager::ExportSlices(
+    const ImageSnapshot& imageSnapshot,
+    const std::string& dirPath,
+    Orientation orientation,
+    const WindowLevelParams& windowLevel,
+    const std::array<double, 16>& modelToWorldMatrix,
+    const std::shared_ptr<ExportControl>& control)
+{
+
+    // 导出路径：1. 使用接纳时冻结的批次；2. 轴置换矩阵直接按步长读源体，其余取逆后重采样到轴对齐体数据；
+    // 3. 按 Orientation 将二维像素映射回 X/Y/Z；4. 按切片并行查表映射窗宽窗位并编码写 PNG。
+
+    if (dirPath.empty()) {
+        std::cerr << "[Export] Slice image export failed: output directory is empty." << std::endl;
+        return false;
+    }
+    if (GetExportCancelled(control)) {
+        return false;
+    }
+
+    auto imageCopy = vtkSmartPointer<vtkImageData>::New();
+    vtkSmartPointer<vtkImageData> maskCopy;
+    ImageSnapshot currentState = imageSnapshot;
+    if (!currentState || !currentState->image) return false;
+    imageCopy->ShallowCopy(currentState->image);
+    if (currentState->validityMask) {
+        maskCopy = vtkSmartPointer<vtkImageData>::New();
+        maskCopy->ShallowCopy(
+            currentState->validityMask);
+    }
+
+    // A. 带符号轴置换：直接按步长读取 snapshot 的 scalar 与 mask，跳过插值与整卷临时体，结果逐体素精确。
+    // B. 其它仿射：线性 reslice 到轴对齐体数据，mask 以最近邻重采样到同一网格。
+    vtkSmartPointer<vtkImageData> outputImage;
+    vtkSmartPointer<vtkImageData> outputMask;
+    std::array<int, 3> dims = { 0, 0, 0 };
+    std::array<std::ptrdiff_t, 3> axisStrides = { 0, 0, 0 };
+    std::ptrdiff_t baseOffset = 0;
+    const auto permutation = Impl::GetAxisPermutation(imageCopy, modelToWorldMatrix);
+    if (permutation && Impl::GetMaskValid(imageCopy, maskCopy)) {
+        outputImage = imageCopy;
+        outputMask = maskCopy;
+        dims = permutation->dims;
+        axisStrides = permutation->strides;
+        baseOffset = permutation->baseOffset;
+    }
+    else {
+        if (!Impl::BuildReslicedSlices(
+                imageCopy, maskCopy, modelToWorldMatrix,
+                outputImage, outputMask)) {
+            return false;
+        }
+        // 重采样结果已独立于源批次；逐切片编码耗时较长，先释放 snapshot，旧批次可随最后 owner 回收。
+        imageCopy = nullptr;
+        maskCopy = nullptr;
+        currentState.reset();
+        // reslice 输出为连续 X 优先布局。
+        outputImage->GetDimensions(dims.data());
+        axisStrides = {
+            1,
+            static_cast<std::ptrdiff_t>(dims[0]),
+            static_cast<std::ptrdiff_t>(dims[0]) * dims[1]
+        };
+    }
+    if (dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0) {
+        return false;
+    }
+
     std::filesystem::path outputDir = PlatformPath::GetNativePath(dirPath);
     if (outputDir.has_extension()) {
         outputDir = outputDir.parent_path() / outputDir.stem();
@@ -630,75 +1248,66 @@ bool BaseDataManager::ExportSlices(
 
     const int sliceAxis = static_cast<int>(orientation); // 与 Orientation 枚举值保持一致
     const int sliceCount = dims[sliceAxis];
-    const std::array<int, 2> sliceSize = m_impl->GetSliceSize(dims, orientation); // 当前导出图片宽高
-    const int width = sliceSize[0];
-    const int height = sliceSize[1];
+    const std::array<int, 2> sliceSize = m_impl->GetSliceSize(dims.data(), orientation); // 当前导出图片宽高
     const int digits = std::max(4, static_cast<int>(std::to_string(std::max(sliceCount - 1, 0)).size()));
     const std::string orientationName = m_impl->GetOrientName(orientation);
 
-    for (int sliceIndex = 0; sliceIndex < sliceCount; ++sliceIndex) {
-        auto sliceImage = vtkSmartPointer<vtkImageData>::New();
-        sliceImage->SetDimensions(width, height, 1);
-        sliceImage->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
-
-        auto* dst = static_cast<unsigned char*>(sliceImage->GetScalarPointer());
-        if (!dst) {
-            return false;
-        }
-        for (int py = 0; py < height; ++py) {
-            for (int px = 0; px < width; ++px) {
-                int x = 0;
-                int y = 0;
-                int z = 0;
-
-                // A. TopDown 固定 Z，图片横纵轴映射为 X/Y。
-                if (orientation == Orientation::Top_down) {
-                    x = outputExtent[0] + px;
-                    y = outputExtent[2] + py;
-                    z = outputExtent[4] + sliceIndex;
-                }
-                // B. FrontBack 固定 Y，图片横纵轴映射为 X/Z。
-                else if (orientation == Orientation::Front_back) {
-                    x = outputExtent[0] + px;
-                    y = outputExtent[2] + sliceIndex;
-                    z = outputExtent[4] + py;
-                }
-                // C. LeftRight 固定 X，图片横纵轴映射为 Y/Z。
-                else {
-                    x = outputExtent[0] + sliceIndex;
-                    y = outputExtent[2] + px;
-                    z = outputExtent[4] + py;
-                }
-                const bool isValid = !outputMask
-                    || outputMask->GetScalarComponentAsDouble(
-                        x, y, z, 0) != 0.0;
-                const double value =
-                    outputImage->GetScalarComponentAsDouble(
-                        x, y, z, 0);
-                dst[py * width + px] = isValid
-                    ? m_impl->GetWindowGray(
-                        value, windowLevel)
-                    : 0;
-            }
-        }
+    // TopDown 固定 Z 映射 X/Y，FrontBack 固定 Y 映射 X/Z，LeftRight 固定 X 映射 Y/Z。
+    Impl::SliceStackLayout layout;
+    layout.width = sliceSize[0];
+    layout.height = sliceSize[1];
+    layout.sliceCount = sliceCount;
+    layout.baseOffset = baseOffset;
+    layout.components = std::max(outputImage->GetNumberOfScalarComponents(), 1);
+    if (orientation == Orientation::Front_back) {
+        layout.columnStride = axisStrides[0];
+        layout.rowStride = axisStrides[2];
+        layout.sliceStride = axisStrides[1];
+    }
+    else if (orientation == Orientation::Left_right) {
+        layout.columnStride = axisStrides[1];
+        layout.rowStride = axisStrides[2];
+        layout.sliceStride = axisStrides[0];
+    }
+    else {
+        layout.columnStride = axisStrides[0];
+        layout.rowStride = axisStrides[1];
+        layout.sliceStride = axisStrides[2];
+    }
 
+    std::vector<std::string> filePaths;
+    filePaths.reserve(static_cast<std::size_t>(sliceCount));
+    for (int sliceIndex = 0; sliceIndex < sliceCount; ++sliceIndex) {
         std::ostringstream fileName;
         fileName << orientationName << "_"
             << std::setw(digits) << std::setfill('0') << sliceIndex
             << ".png";
+        filePaths.push_back(PlatformPath::GetUtf8Path(outputDir / fileName.str()));
+    }
 
-        auto writer = vtkSmartPointer<vtkPNGWriter>::New();
-        const std::filesystem::path outputFilePath = outputDir / fileName.str();
-        const std::string vtkFileName = PlatformPath::GetUtf8Path(outputFilePath);
-        writer->SetFileName(vtkFileName.c_str());
-        writer->SetInputData(sliceImage);
-        writer->Write();
-        if (writer->GetErrorCode() != 0) {
-            return false;
+    const auto* maskValues = outputMask
+        ? static_cast<const unsigned char*>(outputMask->GetScalarPointer())
+        : nullptr;
+    if (outputMask && !maskValues) {
+        return false;
+    }
+    void* imageValues = outputImage->GetScalarPointer();
+    bool isWritten = false;
+    switch (outputImage->GetScalarType()) {
+        vtkTemplateMacro(isWritten = Impl::SetSliceStack(
+            static_cast<const VTK_TT*>(imageValues),
+            maskValues, layout, windowLevel, filePaths, control));
+    default:
+        return false;
+    }
+    if (!isWritten && GetExportCancelled(control)) {
+        // 取消时删除本次已写出的切片，输出目录不留半套切片栈。
+        std::error_code error;
+        for (const auto& filePath : filePaths) {
+            std::filesystem::remove(PlatformPath::GetNativePath(filePath), error);
         }
     }
-
-    return true;
+    return isWritten;
 }
 
 bool BaseDataManager::ExportData(
@@ -709,6 +1318,7 @@ bool BaseDataManager::ExportData(
     if (!imageSnapshot || !imageSnapshot->image
         || imageSnapshot->image->GetNumberOfPoints() == 0
         || outputDir.empty()
+        || GetExportCancelled(params.control)
         || !Impl::GetMaskValid(
             imageSnapshot->image,
             imageSnapshot->validityMask)) {
@@ -732,7 +1342,8 @@ bool BaseDataManager::ExportData(
     if (normalizedExtension != ".raw"
         && normalizedExtension != ".ply"
         && normalizedExtension != ".stl"
-        && normalizedExtension != ".obj") {
+        && normalizedExtension != ".obj"
+        && normalizedExtension != ".mvs") {
         return false;
     }
 
@@ -753,7 +1364,13 @@ bool BaseDataManager::ExportData(
     if (normalizedExtension == ".raw") {
         return Impl::ExportRaw(
             imageSnapshot, outputDir,
-            params.modelToWorld);
+            params.modelToWorld, params.control);
+    }
+    if (normalizedExtension == ".mvs") {
+        // 标签体只随登记它的批次保存；冻结批次已被替换时单槽不再对应，归档不带标签层。
+        return Impl::ExportSession(
+            imageSnapshot, GetLabelImage(imageSnapshot->version),
+            outputDir, params.control);
     }
     DataExportParams normalizedParams = params;
     normalizedParams.extension = std::move(
@@ -811,35 +1428,212 @@ bool BaseDataManager::Impl::GetIsAffine(
             * determinantScale;
 }
 
-std::filesystem::path
-BaseDataManager::Impl::BuildExportPath(
-    const std::string& outputDir,
-    const int dimensions[3],
-    const std::string& extension)
-{
-    const std::string fileName =
-        std::to_string(dimensions[0])
-        + "x" + std::to_string(dimensions[1])
-        + "x" + std::to_string(dimensions[2])
-        + "_transform" + extension;
-    return PlatformPath::GetNativePath(outputDir)
-        / std::filesystem::path(fileName);
+std::filesystem::path
+BaseDataManager::Impl::BuildExportPath(
+    const std::string& outputDir,
+    const int dimensions[3],
+    const std::string& extension)
+{
+    const std::string fileName =
+        std::to_string(dimensions[0])
+        + "x" + std::to_string(dimensions[1])
+        + "x" + std::to_string(dimensions[2])
+        + "_transform" + extension;
+    return PlatformPath::GetNativePath(outputDir)
+        / std::filesystem::path(fileName);
+}
+
+std::optional<BaseDataManager::Impl::AxisPermutation>
+BaseDataManager::Impl::GetAxisPermutation(
+    vtkImageData* image,
+    const std::array<double, 16>& modelToWorld)
+{
+    if (!image || modelToWorld[12] != 0.0 || modelToWorld[13] != 0.0
+        || modelToWorld[14] != 0.0 || modelToWorld[15] != 1.0) {
+        return std::nullopt;
+    }
+    int dims[3] = { 0, 0, 0 };
+    double spacing[3] = { 0.0, 0.0, 0.0 };
+    image->GetDimensions(dims);
+    image->GetSpacing(spacing);
+    if (dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0) {
+        return std::nullopt;
+    }
+
+    const std::array<std::ptrdiff_t, 3> sourceStrides = {
+        1,
+        static_cast<std::ptrdiff_t>(dims[0]),
+        static_cast<std::ptrdiff_t>(dims[0]) * dims[1]
+    };
+    AxisPermutation permutation;
+    std::array<bool, 3> isSourceUsed = { false, false, false };
+    // 行主序 modelToWorld 的第 a 行只允许一个 ±1：世界第 a 轴取自模型第 sourceAxis 轴。
+    for (int axis = 0; axis < 3; ++axis) {
+        int sourceAxis = -1;
+        std::ptrdiff_t sign = 0;
+        for (int column = 0; column < 3; ++column) {
+            const double value = modelToWorld[axis * 4 + column];
+            if (value == 0.0) {
+                continue;
+            }
+            if (sourceAxis >= 0 || (value != 1.0 && value != -1.0)) {
+                return std::nullopt;
+            }
+            sourceAxis = column;
+            sign = value > 0.0 ? 1 : -1;
+        }
+        if (sourceAxis < 0 || isSourceUsed[sourceAxis]) {
+            return std::nullopt;
+        }
+        isSourceUsed[sourceAxis] = true;
+        // reslice 输出第 a 轴沿用输入第 a 轴 spacing；只有与来源轴相同时网格才逐点重合。
+        if (spacing[axis] != spacing[sourceAxis]) {
+            return std::nullopt;
+        }
+        permutation.dims[axis] = dims[sourceAxis];
+        permutation.strides[axis] = sign * sourceStrides[sourceAxis];
+        if (sign < 0) {
+            permutation.baseOffset +=
+                static_cast<std::ptrdiff_t>(dims[sourceAxis] - 1) * sourceStrides[sourceAxis];
+        }
+    }
+    return permutation;
+}
+
+template <typename T>
+void BaseDataManager::Impl::SetPermutedSlab(
+    const T* source,
+    const AxisPermutation& permutation,
+    int zBegin,
+    int zEnd,
+    T* target)
+{
+    const std::size_t width = static_cast<std::size_t>(permutation.dims[0]);
+    const std::size_t height = static_cast<std::size_t>(permutation.dims[1]);
+    vtkSMPTools::For(zBegin, zEnd,
+        [&](vtkIdType begin, vtkIdType end) {
+            for (vtkIdType z = begin; z < end; ++z) {
+                for (std::size_t y = 0; y < height; ++y) {
+                    const T* sourceRow = source + permutation.baseOffset
+                        + static_cast<std::ptrdiff_t>(z) * permutation.strides[2]
+                        + static_cast<std::ptrdiff_t>(y) * permutation.strides[1];
+                    T* targetRow = target
+                        + (static_cast<std::size_t>(z - zBegin) * height + y) * width;
+                    const std::ptrdiff_t columnStride = permutation.strides[0];
+                    for (std::size_t x = 0; x < width; ++x) {
+                        targetRow[x] = sourceRow[static_cast<std::ptrdiff_t>(x) * columnStride];
+                    }
+                }
+            }
+        });
+}
+
+bool BaseDataManager::Impl::ExportPermutedRaw(
+    vtkImageData* image,
+    const AxisPermutation& permutation,
+    const std::string& outputDir,
+    const std::shared_ptr<ExportControl>& control)
+{
+    const auto* source = static_cast<const char*>(image->GetScalarPointer());
+    if (!source) {
+        return false;
+    }
+    const int scalarType = image->GetScalarType();
+    const size_t elementBytes = static_cast<size_t>(image->GetScalarSize());
+    const size_t planeBytes = static_cast<size_t>(permutation.dims[0])
+        * static_cast<size_t>(permutation.dims[1]) * elementBytes;
+    const int nz = permutation.dims[2];
+    const int slabDepth = static_cast<int>(std::clamp<size_t>(
+        kExportSlabBytes / planeBytes, 1, static_cast<size_t>(nz)));
+    const bool isIdentity = permutation.baseOffset == 0
+        && permutation.strides[0] == 1
+        && permutation.strides[1] == permutation.dims[0]
+        && permutation.strides[2]
+            == static_cast<std::ptrdiff_t>(permutation.dims[0]) * permutation.dims[1];
+
+    const auto finalPath = BuildExportPath(
+        outputDir, permutation.dims.data(), ".raw");
+    std::ofstream rawFile(finalPath, std::ios::binary);
+    if (!rawFile.is_open()) {
+        std::cerr
+            << "[Error] Failed to open RAW file for writing: "
+            << PlatformPath::GetUtf8Path(finalPath)
+            << std::endl;
+        return false;
+    }
+
+    // 恒等矩阵时源 scalar 已是目标布局，按 slab 大小分块直接写出；其余置换先转置进 slab 缓冲。
+    std::vector<char> slabBuffer;
+    if (!isIdentity) {
+        slabBuffer.resize(planeBytes * static_cast<size_t>(slabDepth));
+    }
+    for (int z0 = 0; z0 < nz; z0 += slabDepth) {
+        if (GetExportCancelled(control)) {
+            rawFile.close();
+            std::error_code error;
+            std::filesystem::remove(finalPath, error);
+            return false;
+        }
+        const int z1 = std::min(z0 + slabDepth, nz);
+        const char* slab = source + static_cast<size_t>(z0) * planeBytes;
+        if (!isIdentity) {
+            switch (scalarType) {
+                vtkTemplateMacro(SetPermutedSlab(
+                    reinterpret_cast<const VTK_TT*>(source),
+                    permutation, z0, z1,
+                    reinterpret_cast<VTK_TT*>(slabBuffer.data())));
+            default:
+                return false;
+            }
+            slab = slabBuffer.data();
+        }
+        rawFile.write(slab,
+            static_cast<std::streamsize>(planeBytes * static_cast<size_t>(z1 - z0)));
+        if (!rawFile) {
+            return false;
+        }
+        SetExportProgress(control, static_cast<std::size_t>(z1), static_cast<std::size_t>(nz));
+    }
+
+    rawFile.close();
+    if (!rawFile) {
+        return false;
+    }
+    std::cout << "[Export] Successfully saved permuted RAW to: "
+        << PlatformPath::GetUtf8Path(finalPath) << "\n"
+        << "[Export] IMPORTANT: New Dimensions are "
+        << permutation.dims[0] << " x " << permutation.dims[1]
+        << " x " << permutation.dims[2] << std::endl;
+    return true;
 }
 
 bool BaseDataManager::Impl::ExportRaw(
     const ImageSnapshot& imageSnapshot,
     const std::string& outputDir,
-    const std::array<double, 16>& modelToWorldMatrix)
+    const std::array<double, 16>& modelToWorldMatrix,
+    const std::shared_ptr<ExportControl>& control)
 {
     // RAW 导出路径：固定接纳时的 immutable snapshot -> 逆变换重采样 -> 自动裁剪新 bounds ->
-    // 按 VTK increments 逐行剥离 padding，最终写出无头、X-fast 的 float32 数据。
+    // 按输出 Z slab 流式重采样并整块写出无头、X-fast 的原生类型数据，不物化整卷变换结果。
     if (!imageSnapshot || !imageSnapshot->image
         || outputDir.empty()) {
         return false;
     }
-    vtkSmartPointer<vtkImageData> imageCopy = vtkSmartPointer<vtkImageData>::New();
-    // snapshot 批次不可变，因此可建立只读浅拷贝供导出管线使用。
-    imageCopy->ShallowCopy(imageSnapshot->image);
+
+    // RAW 按加载时的原生单分量类型（uint8/uint16/int16/float32）写出；其它标量布局必须显式拒绝。
+    const int scalarType = imageSnapshot->image->GetScalarType();
+    if ((scalarType != VTK_UNSIGNED_CHAR && scalarType != VTK_UNSIGNED_SHORT
+            && scalarType != VTK_SHORT && scalarType != VTK_FLOAT)
+        || imageSnapshot->image->GetNumberOfScalarComponents() != 1) {
+        return false;
+    }
+
+    // 恒等与带符号轴置换不经插值，直接从 snapshot scalar 按步长转置写出，结果逐体素精确。
+    if (const auto permutation = GetAxisPermutation(
+            imageSnapshot->image, modelToWorldMatrix)) {
+        return ExportPermutedRaw(
+            imageSnapshot->image, *permutation, outputDir, control);
+    }
 
     //  VTK 逆变换矩阵
     auto worldToModelMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
@@ -849,56 +1643,62 @@ bool BaseDataManager::Impl::ExportRaw(
     auto worldToModelTransform = vtkSmartPointer<vtkTransform>::New();
     worldToModelTransform->SetMatrix(worldToModelMatrix);
 
-    // 利用 vtkImageReslice 进行核心插值运算
-    auto reslice = vtkSmartPointer<vtkImageReslice>::New();
-    reslice->SetInputData(imageCopy);
-    reslice->SetResliceTransform(worldToModelTransform);
-    reslice->SetInterpolationModeToLinear();
-
-    // VTK 会自动计算旋转后新的 Bounding Box，避免模型的边角被切割。
-    // 这会导致输出的数据维度（Dimensions）发生变化。
-    reslice->SetOutputDimensionality(3);
-
-    reslice->SetAutoCropOutput(true);
     double range[2];
-    imageCopy->GetScalarRange(range);
-    reslice->SetBackgroundLevel(range[0]); // 取真实的最小标量值
+    imageSnapshot->image->GetScalarRange(range);
 
+    // 双缓冲：两个 reslice 各持一个 slab 输出，后台计算 slab N+1 时主线程写出 slab N。
+    // 每个 reslice 接入独立的 ShallowCopy 外壳，并行 Update 不共享同一数据对象的 pipeline 信息。
+    std::array<vtkSmartPointer<vtkImageReslice>, 2> reslices;
     try {
-        // 更新管线，触发计算
-        reslice->Update();
+        for (auto& reslice : reslices) {
+            // snapshot 批次不可变，因此可建立只读浅拷贝供导出管线使用。
+            auto imageCopy = vtkSmartPointer<vtkImageData>::New();
+            imageCopy->ShallowCopy(imageSnapshot->image);
+
+            reslice = vtkSmartPointer<vtkImageReslice>::New();
+            reslice->SetInputData(imageCopy);
+            reslice->SetResliceTransform(worldToModelTransform);
+            reslice->SetInterpolationModeToLinear();
+            // VTK 会自动计算旋转后新的 Bounding Box，避免模型的边角被切割；输出维度随之变化。
+            reslice->SetOutputDimensionality(3);
+            reslice->SetAutoCropOutput(true);
+            reslice->SetBackgroundLevel(range[0]); // 取真实的最小标量值
+            reslice->UpdateInformation();
+        }
     }
     catch (...) {
         std::cerr << "[Error] Exception during image reslicing/changing info." << std::endl;
         return false;
     }
 
-    auto outputImage = reslice->GetOutput();
-    if (!outputImage || outputImage->GetNumberOfPoints() == 0) {
+    // 只走 RequestInformation 得到裁剪后的整卷范围；体素按 slab 请求时才计算。
+    int wholeExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    reslices[0]->GetOutputInformation(0)->Get(
+        vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), wholeExtent);
+    const int newDims[3] = {
+        wholeExtent[1] - wholeExtent[0] + 1,
+        wholeExtent[3] - wholeExtent[2] + 1,
+        wholeExtent[5] - wholeExtent[4] + 1
+    };
+    if (newDims[0] <= 0 || newDims[1] <= 0 || newDims[2] <= 0) {
         std::cerr << "[Error] Reslice produced an empty image!" << std::endl;
         return false;
     }
 
-    // RAW 契约固定为单分量 float32；其它标量布局必须显式拒绝，不能按 float* 误解释。
-    if (outputImage->GetScalarType() != VTK_FLOAT
-        || outputImage->GetNumberOfScalarComponents() != 1) {
-        return false;
-    }
-    int newDims[3];
-    outputImage->GetDimensions(newDims);
-    float* outDataPtr = static_cast<float*>(outputImage->GetScalarPointer());
-
-    if (!outDataPtr) {
-        return false;
-    }
+    const size_t elementBytes = static_cast<size_t>(imageSnapshot->image->GetScalarSize());
+    const size_t rowBytes = static_cast<size_t>(newDims[0]) * elementBytes;
+    const size_t planeBytes = rowBytes * static_cast<size_t>(newDims[1]);
 
-    vtkIdType incs[3];
-    outputImage->GetIncrements(incs);
+    // slab 深度受 kExportSlabBytes 约束，并至少切成两块，使计算与写盘始终可以重叠。
+    const int nz = newDims[2];
+    const int slabDepth = static_cast<int>(std::clamp<size_t>(
+        kExportSlabBytes / planeBytes, 1, static_cast<size_t>((nz + 1) / 2)));
+    const int slabCount = (nz + slabDepth - 1) / slabDepth;
 
     const auto finalPath = BuildExportPath(
         outputDir, newDims, ".raw");
 
-    // 按 x-fast、逐行无 padding 的 float32 裸数据写出，不附带维度、spacing、origin 等元数据。
+    // 按 x-fast、逐行无 padding 的原生类型裸数据写出，不附带维度、spacing、origin 等元数据。
     std::ofstream rawFile(finalPath, std::ios::binary);
     if (!rawFile.is_open()) {
         std::cerr
@@ -908,18 +1708,95 @@ bool BaseDataManager::Impl::ExportRaw(
         return false;
     }
 
-    // 由于旋转后行尾可能有 Padding（根据 VTK 内部内存布局），不能直接写入整块内存。
-    size_t rowBytes = static_cast<size_t>(newDims[0]) * sizeof(float);
-    for (int z = 0; z < newDims[2]; ++z) {
-        for (int y = 0; y < newDims[1]; ++y) {
-            // 利用真实步长计算出当前行准确的内存起始地址
-            float* rowPtr = outDataPtr + z * incs[2] + y * incs[1];
-            // 每次只写入当前行真正有效的数据宽度（摒弃行尾的 Padding）
-            rawFile.write(reinterpret_cast<const char*>(rowPtr), rowBytes);
-            if (!rawFile) {
+    const auto getSlabExtent = [&wholeExtent, slabDepth, nz](int slabIndex) {
+        const int z0 = slabIndex * slabDepth;
+        const int z1 = std::min(z0 + slabDepth, nz) - 1;
+        return std::array<int, 6>{
+            wholeExtent[0], wholeExtent[1],
+            wholeExtent[2], wholeExtent[3],
+            wholeExtent[4] + z0, wholeExtent[4] + z1
+        };
+    };
+    const auto buildSlab = [&reslices, &getSlabExtent](int slabIndex) {
+        try {
+            auto slabExtent = getSlabExtent(slabIndex);
+            auto& reslice = reslices[static_cast<size_t>(slabIndex % 2)];
+            if (!reslice->UpdateExtent(slabExtent.data())) {
                 return false;
             }
+            auto* slab = reslice->GetOutput();
+            return slab && slab->GetScalarPointer() != nullptr;
+        }
+        catch (...) {
+            return false;
+        }
+    };
+    // slab 输出覆盖请求范围即可；范围恰好相等时整块连续写出，否则逐行定位后写出有效宽度。
+    const auto writeSlab = [&](int slabIndex) {
+        const auto slabExtent = getSlabExtent(slabIndex);
+        vtkImageData* slab = reslices[static_cast<size_t>(slabIndex % 2)]->GetOutput();
+        int outputExtent[6] = { 0, -1, 0, -1, 0, -1 };
+        slab->GetExtent(outputExtent);
+        if (std::equal(slabExtent.begin(), slabExtent.end(), outputExtent)) {
+            const size_t slabBytes = planeBytes
+                * static_cast<size_t>(slabExtent[5] - slabExtent[4] + 1);
+            rawFile.write(
+                static_cast<const char*>(slab->GetScalarPointer()),
+                static_cast<std::streamsize>(slabBytes));
+            return static_cast<bool>(rawFile);
+        }
+        for (int z = slabExtent[4]; z <= slabExtent[5]; ++z) {
+            for (int y = slabExtent[2]; y <= slabExtent[3]; ++y) {
+                const auto* rowPtr = static_cast<const char*>(
+                    slab->GetScalarPointer(slabExtent[0], y, z));
+                if (!rowPtr) {
+                    return false;
+                }
+                rawFile.write(rowPtr, static_cast<std::streamsize>(rowBytes));
+                if (!rawFile) {
+                    return false;
+                }
+            }
         }
+        return true;
+    };
+
+    bool isWritten = true;
+    bool isCancelled = false;
+    std::future<bool> pendingSlab = std::async(std::launch::async, buildSlab, 0);
+    for (int slabIndex = 0; slabIndex < slabCount; ++slabIndex) {
+        if (!pendingSlab.get()) {
+            isWritten = false;
+            break;
+        }
+        // 取消在 slab 边界生效：不再预取下一块，已重采样的本块也不再写出。
+        if (GetExportCancelled(control)) {
+            isCancelled = true;
+            break;
+        }
+        // 下一块使用另一个 reslice 的输出缓冲，与本块写盘互不覆盖。
+        if (slabIndex + 1 < slabCount) {
+            pendingSlab = std::async(std::launch::async, buildSlab, slabIndex + 1);
+        }
+        if (!writeSlab(slabIndex)) {
+            isWritten = false;
+            break;
+        }
+        SetExportProgress(control,
+            static_cast<std::size_t>(slabIndex + 1), static_cast<std::size_t>(slabCount));
+    }
+    if (pendingSlab.valid()) {
+        pendingSlab.wait();
+    }
+    if (isCancelled) {
+        rawFile.close();
+        std::error_code error;
+        std::filesystem::remove(finalPath, error);
+        return false;
+    }
+    if (!isWritten) {
+        std::cerr << "[Error] Failed to reslice or write RAW slab." << std::endl;
+        return false;
     }
 
     rawFile.close();
@@ -934,6 +1811,41 @@ bool BaseDataManager::Impl::ExportRaw(
     return true;
 }
 
+bool BaseDataManager::Impl::ExportSession(
+    const ImageSnapshot& imageSnapshot,
+    vtkSmartPointer<vtkImageData> labelImage,
+    const std::string& outputDir,
+    const std::shared_ptr<ExportControl>& control)
+{
+    // 会话保存的是数据本身而非可视姿态：image 与 mask 按冻结批次原样写入，不应用 model-to-world。
+    SessionSnapshot session;
+    session.state = *imageSnapshot;
+    session.state.maskDelta.reset();
+    session.state.labelImage = nullptr;
+    session.labelImage = std::move(labelImage);
+    if (session.state.cropHistory) {
+        session.cropOperations = *session.state.cropHistory;
+    }
+    const std::string fileName =
+        std::to_string(session.state.dims[0])
+        + "x" + std::to_string(session.state.dims[1])
+        + "x" + std::to_string(session.state.dims[2])
+        + "_session.mvs";
+    const auto finalPath = PlatformPath::GetNativePath(outputDir)
+        / std::filesystem::path(fileName);
+    const std::string utf8Path = PlatformPath::GetUtf8Path(finalPath);
+    // 取消在块批边界生效：归档删除临时文件且不改名，同名旧会话不受影响。
+    if (!SessionArchive::SetSession(utf8Path, session, 0, control)) {
+        if (!GetExportCancelled(control)) {
+            std::cerr << "[Error] Failed to write session archive: " << utf8Path << std::endl;
+        }
+        return false;
+    }
+    SetExportProgress(control, 1, 1);
+    std::cout << "[Export] Successfully saved session to: " << utf8Path << std::endl;
+    return true;
+}
+
 bool BaseDataManager::Impl::ExportMesh(
     const ImageSnapshot& imageSnapshot,
     const std::string& outputDir,
@@ -947,60 +1859,35 @@ bool BaseDataManager::Impl::ExportMesh(
     }
 
     // 1. 全分辨率 image 与 mask 来自同一个 ImageState，不读取显示 mapper。
+    //    mask 在体素空间把无效体素压到等值面外侧，提取即得闭合切口，不再逐顶点回查 mask 后 clip。
     auto imageCopy =
         vtkSmartPointer<vtkImageData>::New();
     imageCopy->ShallowCopy(imageSnapshot->image);
+    auto maskFilter =
+        vtkSmartPointer<ImageMaskOutsideFilter>::New();
+    maskFilter->SetInputData(imageCopy);
+    if (imageSnapshot->validityMask) {
+        auto maskCopy =
+            vtkSmartPointer<vtkImageData>::New();
+        maskCopy->ShallowCopy(
+            imageSnapshot->validityMask);
+        if (!maskFilter->SetMask(maskCopy)) {
+            return false;
+        }
+    }
     auto isoFilter =
         vtkSmartPointer<vtkFlyingEdges3D>::New();
-    isoFilter->SetInputData(imageCopy);
+    isoFilter->SetInputConnection(
+        maskFilter->GetOutputPort());
     isoFilter->SetValue(0, params.isoValue);
     isoFilter->ComputeNormalsOn();
     isoFilter->ComputeGradientsOff();
 
-    vtkAlgorithmOutput* surfacePort =
-        isoFilter->GetOutputPort();
-    vtkSmartPointer<vtkImageData> maskCopy;
-    vtkSmartPointer<vtkImplicitVolume> maskFunction;
-    vtkSmartPointer<vtkClipPolyData> maskClip;
-    if (imageSnapshot->validityMask) {
-        maskCopy = vtkSmartPointer<vtkImageData>::New();
-        maskCopy->ShallowCopy(
-            imageSnapshot->validityMask);
-        maskFunction =
-            vtkSmartPointer<vtkImplicitVolume>::New();
-        maskFunction->SetVolume(maskCopy);
-        maskFunction->SetOutValue(-1.0);
-        maskClip =
-            vtkSmartPointer<vtkClipPolyData>::New();
-        maskClip->SetInputConnection(surfacePort);
-        maskClip->SetClipFunction(maskFunction);
-        // 二值 mask 为 0/255；127.5 令边界落在相邻体素中心之间。
-        maskClip->SetValue(127.5);
-        maskClip->InsideOutOff();
-        maskClip->GenerateClippedOutputOff();
-        surfacePort = maskClip->GetOutputPort();
-    }
-
-    // 2. 文件没有 actor，在写出前把 model-to-world 烘焙到点和法向量。
-    auto modelMatrix =
-        vtkSmartPointer<vtkMatrix4x4>::New();
-    modelMatrix->DeepCopy(
-        params.modelToWorld.data());
-    auto modelToWorld =
-        vtkSmartPointer<vtkTransform>::New();
-    modelToWorld->SetMatrix(modelMatrix);
-    auto transformFilter =
-        vtkSmartPointer<
-            vtkTransformPolyDataFilter>::New();
-    transformFilter->SetInputConnection(
-        surfacePort);
-    transformFilter->SetTransform(modelToWorld);
-
-    // 3. 三种 writer 共用同一份三角网格；仅在 Data 底层按后缀选择序列化器。
+    // 2. 三角化与可选抽稀都在模型空间完成；model-to-world 只在写出时烘焙，不再生成变换后的整份网格。
     auto triangleFilter =
         vtkSmartPointer<vtkTriangleFilter>::New();
     triangleFilter->SetInputConnection(
-        transformFilter->GetOutputPort());
+        isoFilter->GetOutputPort());
     try {
         triangleFilter->Update();
     }
@@ -1009,51 +1896,85 @@ bool BaseDataManager::Impl::ExportMesh(
             << "[Export] PolyData generation failed.\n";
         return false;
     }
-    vtkPolyData* outputMesh =
+    vtkSmartPointer<vtkPolyData> outputMesh =
         triangleFilter->GetOutput();
     if (!outputMesh
         || outputMesh->GetNumberOfPoints() == 0
-        || outputMesh->GetNumberOfCells() == 0) {
+        || outputMesh->GetNumberOfCells() == 0
+        || GetExportCancelled(params.control)) {
         return false;
     }
+    // 网格导出按提取、抽稀/着色、写出三个阶段粗粒度回报进度，取消只在阶段之间生效。
+    SetExportProgress(params.control, 1, 3);
+    const auto triangleCount = static_cast<std::size_t>(
+        outputMesh->GetNumberOfPolys());
+    if (params.targetTriangleCount > 0
+        && triangleCount > params.targetTriangleCount) {
+        outputMesh = BuildDecimatedMesh(
+            outputMesh, params.targetTriangleCount);
+        if (!outputMesh
+            || outputMesh->GetNumberOfPoints() == 0
+            || outputMesh->GetNumberOfCells() == 0) {
+            return false;
+        }
+    }
 
+    // 3. PLY/STL 由 MeshWriter 分块并行烘焙坐标并直接写二进制；OBJ 仍经 VTK 变换与 writer。
     int sourceDims[3] = {};
     imageCopy->GetDimensions(sourceDims);
     const auto outputPath = BuildExportPath(
         outputDir, sourceDims, params.extension);
-    const std::string vtkFileName =
-        PlatformPath::GetUtf8Path(outputPath);
-    int errorCode = vtkErrorCode::NoError;
+    bool isWritten = false;
     if (params.extension == ".ply") {
-        if (!BuildMeshColors(outputMesh, params)) {
+        if (!BuildMeshColors(outputMesh, params)
+            || GetExportCancelled(params.control)) {
             return false;
         }
-        auto writer =
-            vtkSmartPointer<vtkPLYWriter>::New();
-        writer->SetFileName(vtkFileName.c_str());
-        writer->SetFileTypeToBinary();
-        writer->SetArrayName("RGB");
-        writer->SetColorModeToDefault();
-        writer->SetInputData(outputMesh);
-        writer->Write();
-        errorCode = writer->GetErrorCode();
+        SetExportProgress(params.control, 2, 3);
+        isWritten = MeshWriter::SetPly(
+            outputPath, outputMesh, params.modelToWorld,
+            vtkUnsignedCharArray::SafeDownCast(
+                outputMesh->GetPointData()->GetArray("RGB")));
     }
     else if (params.extension == ".stl") {
-        auto writer =
-            vtkSmartPointer<vtkSTLWriter>::New();
-        writer->SetFileName(vtkFileName.c_str());
-        writer->SetFileTypeToBinary();
-        writer->SetInputData(outputMesh);
-        writer->Write();
-        errorCode = writer->GetErrorCode();
+        if (GetExportCancelled(params.control)) {
+            return false;
+        }
+        SetExportProgress(params.control, 2, 3);
+        isWritten = MeshWriter::SetStl(
+            outputPath, outputMesh, params.modelToWorld);
     }
     else if (params.extension == ".obj") {
+        if (GetExportCancelled(params.control)) {
+            return false;
+        }
+        SetExportProgress(params.control, 2, 3);
+        auto modelMatrix =
+            vtkSmartPointer<vtkMatrix4x4>::New();
+        modelMatrix->DeepCopy(
+            params.modelToWorld.data());
+        auto modelToWorld =
+            vtkSmartPointer<vtkTransform>::New();
+        modelToWorld->SetMatrix(modelMatrix);
+        auto transformFilter =
+            vtkSmartPointer<
+                vtkTransformPolyDataFilter>::New();
+        transformFilter->SetInputData(outputMesh);
+        transformFilter->SetTransform(modelToWorld);
         auto writer =
             vtkSmartPointer<vtkOBJWriter>::New();
+        const std::string vtkFileName =
+            PlatformPath::GetUtf8Path(outputPath);
         writer->SetFileName(vtkFileName.c_str());
-        writer->SetInputData(outputMesh);
-        writer->Write();
-        errorCode = writer->GetErrorCode();
+        writer->SetInputConnection(
+            transformFilter->GetOutputPort());
+        try {
+            writer->Write();
+        }
+        catch (...) {
+            return false;
+        }
+        isWritten = writer->GetErrorCode() == vtkErrorCode::NoError;
     }
     else {
         return false;
@@ -1063,8 +1984,50 @@ bool BaseDataManager::Impl::ExportMesh(
     const auto fileSize =
         std::filesystem::file_size(
             outputPath, fileError);
-    return errorCode == vtkErrorCode::NoError
-        && !fileError && fileSize > 0;
+    const bool isSaved = isWritten && !fileError && fileSize > 0;
+    if (isSaved) {
+        SetExportProgress(params.control, 3, 3);
+    }
+    return isSaved;
+}
+
+vtkSmartPointer<vtkPolyData> BaseDataManager::Impl::BuildDecimatedMesh(
+    vtkPolyData* mesh,
+    std::size_t targetTriangleCount)
+{
+    const auto triangleCount = mesh
+        ? static_cast<double>(mesh->GetNumberOfPolys()) : 0.0;
+    if (triangleCount <= 0.0 || targetTriangleCount == 0) {
+        return nullptr;
+    }
+    // 二次误差抽稀保持体积并把 iso 标量插值到保留顶点，PLY 着色仍取自最终网格；
+    // 顶点位置改变后原梯度法向失效，按面重新计算且不拆分顶点，点数只减不增。
+    auto decimation =
+        vtkSmartPointer<vtkQuadricDecimation>::New();
+    decimation->SetInputData(mesh);
+    decimation->SetTargetReduction(std::clamp(
+        1.0 - static_cast<double>(targetTriangleCount) / triangleCount,
+        0.0, 1.0));
+    decimation->VolumePreservationOn();
+    decimation->MapPointDataOn();
+    auto normals =
+        vtkSmartPointer<vtkPolyDataNormals>::New();
+    normals->SetInputConnection(
+        decimation->GetOutputPort());
+    normals->ComputePointNormalsOn();
+    normals->ComputeCellNormalsOff();
+    normals->SplittingOff();
+    normals->ConsistencyOff();
+    try {
+        normals->Update();
+    }
+    catch (...) {
+        std::cerr
+            << "[Export] Mesh decimation failed.\n";
+        return nullptr;
+    }
+    vtkSmartPointer<vtkPolyData> output = normals->GetOutput();
+    return output;
 }
 
 bool BaseDataManager::Impl::BuildMeshColors(
@@ -1128,30 +2091,47 @@ bool BaseDataManager::Impl::BuildMeshColors(
             != mesh->GetNumberOfPoints()) {
         return false;
     }
+
+    // 3. TF 在 scalar range 上预采样为定长 RGB 表，逐点只剩表内线性插值与取整，按点并行。
+    // range 外的标量落到表端点，与 vtkColorTransferFunction 的钳制语义一致。
+    std::vector<double> colorTable(
+        static_cast<std::size_t>(kMeshColorTableSize) * 3);
+    double tableScale = 0.0;
+    if (params.scalarRange[1] > params.scalarRange[0]) {
+        colorMap->GetTable(
+            params.scalarRange[0], params.scalarRange[1],
+            kMeshColorTableSize, colorTable.data());
+        tableScale = static_cast<double>(kMeshColorTableSize - 1)
+            / (params.scalarRange[1] - params.scalarRange[0]);
+    }
+    else {
+        colorMap->GetColor(params.scalarRange[0], colorTable.data());
+        for (int index = 1; index < kMeshColorTableSize; ++index) {
+            std::copy_n(colorTable.data(), 3, colorTable.data() + index * 3);
+        }
+    }
+
     auto colors =
         vtkSmartPointer<vtkUnsignedCharArray>::New();
     colors->SetName("RGB");
     colors->SetNumberOfComponents(3);
     colors->SetNumberOfTuples(
         mesh->GetNumberOfPoints());
-    for (vtkIdType pointId = 0;
-        pointId < mesh->GetNumberOfPoints(); ++pointId) {
-        const double scalar =
-            pointScalars->GetComponent(pointId, 0);
-        if (!std::isfinite(scalar)) {
-            return false;
-        }
-        double mapped[3] = {};
-        colorMap->GetColor(scalar, mapped);
-        unsigned char rgb[3] = {};
-        for (int component = 0; component < 3;
-            ++component) {
-            const double normalized = std::clamp(
-                mapped[component], 0.0, 1.0);
-            rgb[component] = static_cast<unsigned char>(
-                std::lround(normalized * 255.0));
-        }
-        colors->SetTypedTuple(pointId, rgb);
+    bool isMapped = false;
+    switch (pointScalars->GetDataType()) {
+        vtkTemplateMacro(isMapped = SetMeshColors(
+            static_cast<const VTK_TT*>(pointScalars->GetVoidPointer(0)),
+            pointScalars->GetNumberOfComponents(),
+            mesh->GetNumberOfPoints(),
+            colorTable.data(),
+            params.scalarRange[0],
+            tableScale,
+            colors->GetPointer(0)));
+    default:
+        return false;
+    }
+    if (!isMapped) {
+        return false;
     }
 
     mesh->GetPointData()->AddArray(colors);
@@ -1159,6 +2139,7 @@ bool BaseDataManager::Impl::BuildMeshColors(
 }
 
 RawVolumeDataManager::RawVolumeDataManager()
+    : m_streamThreshold(kStreamThresholdBytes)
 {
 }
 
@@ -1178,6 +2159,9 @@ bool RawVolumeDataManager::SetDataLoaded(
     if (fileError || fileBytes != layout.GetByteCount()) {
         return false;
     }
+    if (SetCachedImage(filePath, layout)) {
+        return true;
+    }
 
     // 输入 layout 明确描述 LPS 物理空间；加载链只负责转换为内部 RAS 空间。
     const auto& spacing = layout.GetSpacing();
@@ -1200,29 +2184,183 @@ bool RawVolumeDataManager::SetDataLoaded(
     newImage->SetDimensions(rasDims[0], rasDims[1], rasDims[2]);
     newImage->SetSpacing(rasSpacing[0], rasSpacing[1], rasSpacing[2]);
     newImage->SetOrigin(rasOrigin[0], rasOrigin[1], rasOrigin[2]);
-    newImage->AllocateScalars(VTK_FLOAT, 1);
-
-    float* dst = static_cast<float*>(newImage->GetScalarPointer());
-    MemMappedFile mmf;
-    if (!mmf.Load(filePath) || mmf.GetSize() != layout.GetByteCount()
-        || !m_impl->SetRasScalars(
-            static_cast<const float*>(mmf.GetData()), dst,
-            rasDims, layout.GetVoxelCount())) {
+    if (layout.GetByteCount() >= m_streamThreshold.load(std::memory_order_relaxed)) {
+        return SetDataStreamed(filePath, layout, std::move(newImage));
+    }
+
+    // 与流式路径一样把源文件直接读入最终 scalar 再原地翻转并统计；不经映射中转，
+    // 峰值常驻只有一份体数据，而不是映射页与目标 scalar 各一份。
+    const int scalarType = BaseDataManager::Impl::GetVtkScalarType(layout.GetScalarType());
+    VolumeStatistics statistics;
+    newImage->AllocateScalars(scalarType, 1);
+    auto* scalars = static_cast<char*>(newImage->GetScalarPointer());
+    std::ifstream rawFile(PlatformPath::GetNativePath(filePath), std::ios::binary);
+    const auto byteCount = static_cast<std::streamsize>(layout.GetByteCount());
+    if (!scalars || !rawFile
+        || !rawFile.read(scalars, byteCount)
+        || rawFile.gcount() != byteCount
+        || !VolumeReorder::SetRasScalarsInPlace(
+            scalars,
+            { static_cast<size_t>(rasDims[0]), static_cast<size_t>(rasDims[1]),
+                static_cast<size_t>(rasDims[2]) },
+            scalarType, true, statistics)) {
         return false;
     }
 
     newImage->Modified();
-    double range[2] = { 0.0, 0.0 };
-    newImage->GetScalarRange(range);
+    std::array<double, 2> range = { 0.0, 0.0 };
+    auto loadedStatistics = BaseDataManager::Impl::GetLoadedStatistics(
+        std::move(statistics), newImage, range);
 
-    return SetPendingImage({
+    return SetLoadedImage(filePath, layout, {
         std::move(newImage),
         {},
         dimensions,
         rasSpacing,
         rasOrigin,
-        { range[0], range[1] },
-        0
+        range,
+        0,
+        std::move(loadedStatistics)
+    });
+}
+
+void RawVolumeDataManager::SetStreamThreshold(std::size_t byteCount) noexcept
+{
+    m_streamThreshold.store(byteCount, std::memory_order_relaxed);
+}
+
+bool RawVolumeDataManager::SetDataStreamed(
+    const std::string& filePath,
+    const VolumeLayout& layout,
+    vtkSmartPointer<vtkImageData> newImage)
+{
+    // 流式路径：1. 按 Z slab 顺序读入最终 scalar 并原地翻转；2. 每个 slab 落地后采样 1/8 预览，
+    // 按间隔以 isPreview 批次发布到 pending；3. 读完后整卷统计并发布完整批次，覆盖未领取的预览。
+    std::ifstream rawFile(PlatformPath::GetNativePath(filePath), std::ios::binary);
+    if (!rawFile) {
+        return false;
+    }
+    const int scalarType = BaseDataManager::Impl::GetVtkScalarType(layout.GetScalarType());
+    newImage->AllocateScalars(scalarType, 1);
+    auto* dst = static_cast<unsigned char*>(newImage->GetScalarPointer());
+    const auto getSample = GetSampleReader(scalarType);
+    if (!dst || !getSample) {
+        return false;
+    }
+
+    const auto& dimensions = layout.GetDimensions();
+    const size_t nx = static_cast<size_t>(dimensions[0]);
+    const size_t ny = static_cast<size_t>(dimensions[1]);
+    const size_t nz = static_cast<size_t>(dimensions[2]);
+    const size_t sliceSize = nx * ny;
+    const size_t elementBytes = VolumeLayout::GetScalarBytes(layout.GetScalarType());
+    const size_t sliceBytes = sliceSize * elementBytes;
+    const size_t slabDepth = std::clamp<size_t>(
+        std::min(kStreamSlabBytes / sliceBytes, (nz + kStreamMinSlabs - 1) / kStreamMinSlabs), 1, nz);
+
+    double spacingRaw[3] = { 1.0, 1.0, 1.0 };
+    double originRaw[3] = { 0.0, 0.0, 0.0 };
+    newImage->GetSpacing(spacingRaw);
+    newImage->GetOrigin(originRaw);
+    const std::array<double, 3> rasSpacing = { spacingRaw[0], spacingRaw[1], spacingRaw[2] };
+    const std::array<double, 3> rasOrigin = { originRaw[0], originRaw[1], originRaw[2] };
+
+    // 预览体素 (px,py,pz) 取全分辨率 (8px,8py,8pz)；原点不变，spacing 放大 8 倍，几何与完整体对齐。
+    // 预览统一以 float 发布，整数体也不必为过渡帧复制类型分支。
+    const size_t stride = static_cast<size_t>(kPreviewStride);
+    const std::array<int, 3> previewDims = {
+        static_cast<int>((nx + stride - 1) / stride),
+        static_cast<int>((ny + stride - 1) / stride),
+        static_cast<int>((nz + stride - 1) / stride)
+    };
+    const size_t previewNx = static_cast<size_t>(previewDims[0]);
+    const size_t previewSlice = previewNx * static_cast<size_t>(previewDims[1]);
+    std::vector<float> previewVoxels(
+        previewSlice * static_cast<size_t>(previewDims[2]), 0.0f);
+    size_t previewFilled = 0;
+    float previewMin = std::numeric_limits<float>::infinity();
+    float previewMax = -std::numeric_limits<float>::infinity();
+    // 回拨一个间隔，使首个 slab 落地即满足发布条件。
+    auto lastPublish = std::chrono::steady_clock::now() - kPreviewInterval;
+
+    const auto setPreviewPublished = [&]() {
+        auto previewImage = vtkSmartPointer<vtkImageData>::New();
+        previewImage->SetDimensions(previewDims[0], previewDims[1], previewDims[2]);
+        previewImage->SetSpacing(
+            rasSpacing[0] * stride, rasSpacing[1] * stride, rasSpacing[2] * stride);
+        previewImage->SetOrigin(rasOrigin[0], rasOrigin[1], rasOrigin[2]);
+        previewImage->AllocateScalars(VTK_FLOAT, 1);
+        // 每次发布独立 image：上一帧预览可能已是 current，由渲染线程只读持有。
+        float* previewDst = static_cast<float*>(previewImage->GetScalarPointer());
+        const size_t filledCount = previewFilled * previewSlice;
+        std::copy_n(previewVoxels.data(), filledCount, previewDst);
+        // 尚未读到的层以已读最小值填充，避免未知区域在传输函数中显示为实体。
+        std::fill(previewDst + filledCount, previewDst + previewVoxels.size(), previewMin);
+        ImageState previewState{
+            std::move(previewImage),
+            {},
+            previewDims,
+            { rasSpacing[0] * stride, rasSpacing[1] * stride, rasSpacing[2] * stride },
+            rasOrigin,
+            { previewMin, previewMax },
+            0
+        };
+        previewState.isPreview = true;
+        return SetPendingImage(std::move(previewState));
+    };
+
+    for (size_t z0 = 0; z0 < nz; z0 += slabDepth) {
+        const size_t z1 = std::min(nz, z0 + slabDepth);
+        unsigned char* slab = dst + z0 * sliceBytes;
+        const std::streamsize slabBytes =
+            static_cast<std::streamsize>((z1 - z0) * sliceBytes);
+        if (!rawFile.read(reinterpret_cast<char*>(slab), slabBytes)
+            || rawFile.gcount() != slabBytes
+            || !VolumeReorder::SetRasScalarsInPlace(
+                slab, { nx, ny, z1 - z0 }, elementBytes)) {
+            return false;
+        }
+
+        for (size_t pz = (z0 + stride - 1) / stride; pz * stride < z1; ++pz) {
+            const size_t sliceOffset = pz * stride * sliceSize;
+            float* previewPlane = previewVoxels.data() + pz * previewSlice;
+            for (size_t py = 0; py < static_cast<size_t>(previewDims[1]); ++py) {
+                const size_t rowOffset = sliceOffset + py * stride * nx;
+                for (size_t px = 0; px < previewNx; ++px) {
+                    const float value = getSample(dst, rowOffset + px * stride);
+                    previewPlane[py * previewNx + px] = value;
+                    if (value < previewMin) previewMin = value;
+                    if (value > previewMax) previewMax = value;
+                }
+            }
+            previewFilled = pz + 1;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (z1 < nz && previewFilled > 0 && previewMin <= previewMax
+            && now - lastPublish >= kPreviewInterval) {
+            // 预览只是加速出图；发布失败不影响完整批次。
+            (void)setPreviewPublished();
+            lastPublish = now;
+        }
+    }
+
+    // 分段翻转无法复用单次调用内的统计，收尾再做一次纯内存统计，仍省去 GetScalarRange 与 accumulate。
+    VolumeStatistics statistics;
+    (void)VolumeReorder::GetStatistics(dst, { nx, ny, nz }, scalarType, true, statistics);
+    newImage->Modified();
+    std::array<double, 2> range = { 0.0, 0.0 };
+    auto loadedStatistics = BaseDataManager::Impl::GetLoadedStatistics(
+        std::move(statistics), newImage, range);
+    return SetLoadedImage(filePath, layout, {
+        std::move(newImage),
+        {},
+        dimensions,
+        rasSpacing,
+        rasOrigin,
+        range,
+        0,
+        std::move(loadedStatistics)
     });
 }
 
@@ -1250,18 +2388,24 @@ bool RawVolumeDataManager::SetFromBuffer(
     newImage->SetDimensions(dims[0], dims[1], dims[2]);
     newImage->SetSpacing(rasSpacing[0], rasSpacing[1], rasSpacing[2]);
     newImage->SetOrigin(rasOrigin[0], rasOrigin[1], rasOrigin[2]);
-    newImage->AllocateScalars(VTK_FLOAT, 1);
-    float* dst = static_cast<float*>(newImage->GetScalarPointer());
-    if (!m_impl->SetRasScalars(
-        buffer.GetVoxels().data(), dst, rasDims, layout.GetVoxelCount())) {
+    const int scalarType = BaseDataManager::Impl::GetVtkScalarType(layout.GetScalarType());
+    newImage->AllocateScalars(scalarType, 1);
+    VolumeStatistics statistics;
+    if (!buffer.GetData() || !newImage->GetScalarPointer()
+        || !VolumeReorder::SetRasScalars(
+            buffer.GetData(), newImage->GetScalarPointer(),
+            { static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]),
+                static_cast<size_t>(dims[2]) },
+            scalarType, true, statistics)) {
         return false;
     }
-    double range[2] = { 0.0, 0.0 };
-    newImage->GetScalarRange(range);
+    std::array<double, 2> range = { 0.0, 0.0 };
+    auto loadedStatistics = BaseDataManager::Impl::GetLoadedStatistics(
+        std::move(statistics), newImage, range);
 
     return SetPendingImage({
         std::move(newImage), {}, dims, rasSpacing, rasOrigin,
-        { range[0], range[1] }, 0 });
+        range, 0, std::move(loadedStatistics) });
 }
 
 bool RawVolumeDataManager::SetImageSnapshot(vtkSmartPointer<vtkImageData> image)
@@ -1328,25 +2472,32 @@ bool TiffVolumeDataManager::SetDataLoaded(
         return false;
     }
 
-    auto image = m_impl->LoadImage(inputPath, layout);
+    if (SetCachedImage(inputPath, layout)) {
+        return true;
+    }
+
+    VolumeStatistics statistics;
+    auto image = m_impl->LoadImage(inputPath, layout, statistics);
     if (!image) return false;
-    double range[2] = { 0.0, 0.0 };
-    image->GetScalarRange(range);
+    std::array<double, 2> range = { 0.0, 0.0 };
+    auto loadedStatistics = BaseDataManager::Impl::GetLoadedStatistics(
+        std::move(statistics), image, range);
     const auto& dimensions = layout.GetDimensions();
     double spacing[3] = { 1.0, 1.0, 1.0 };
     double origin[3] = { 0.0, 0.0, 0.0 };
     image->GetSpacing(spacing);
     image->GetOrigin(origin);
-    return SetPendingImage({
+    return SetLoadedImage(inputPath, layout, {
         std::move(image), {}, dimensions,
         { spacing[0], spacing[1], spacing[2] },
         { origin[0], origin[1], origin[2] },
-        { range[0], range[1] }, 0 });
+        range, 0, std::move(loadedStatistics) });
 }
 
 vtkSmartPointer<vtkImageData> TiffVolumeDataManager::Impl::LoadImage(
     const std::string& inputPath,
-    const VolumeLayout& layout) {
+    const VolumeLayout& layout,
+    VolumeStatistics& statistics) {
     // 路径检查
     const std::filesystem::path pathObj = PlatformPath::GetNativePath(inputPath);
     if (!std::filesystem::exists(pathObj)) {
@@ -1437,66 +2588,8 @@ vtkSmartPointer<vtkImageData> TiffVolumeDataManager::Impl::LoadImage(
         // 排序
         std::sort(fileList.begin(), fileList.end(), naturalSort);
 
-        // 每张 TIFF 独立解码后沿 Z 轴组装，避开批量 SetFileNames 在部分 Windows
-        // libtiff 构建中的跨文件状态损坏；fileList 的自然排序仍是切片顺序真源。
-        auto append = vtkSmartPointer<vtkImageAppend>::New();
-        append->SetAppendAxis(2);
-        std::vector<vtkSmartPointer<vtkImageData>> slices;
-        slices.reserve(fileList.size());
-        int expectedExtent[6] = { 0, -1, 0, -1, 0, -1 };
-        int expectedScalarType = VTK_VOID;
-        int expectedComponents = 0;
-        try {
-            for (const auto& file : fileList) {
-                auto sliceReader = vtkSmartPointer<vtkTIFFReader>::New();
-                sliceReader->SetFileName(file.c_str());
-                if (!sliceReader->CanReadFile(file.c_str())) {
-                    return nullptr;
-                }
-                sliceReader->Update();
-                if (sliceReader->GetErrorCode() != 0
-                    || !sliceReader->GetOutput()
-                    || sliceReader->GetOutput()->GetNumberOfPoints() == 0) {
-                    return nullptr;
-                }
-                auto slice = vtkSmartPointer<vtkImageData>::New();
-                slice->DeepCopy(sliceReader->GetOutput());
-                int sliceExtent[6] = { 0, -1, 0, -1, 0, -1 };
-                slice->GetExtent(sliceExtent);
-                if (slice->GetDimensions()[0] <= 0
-                    || slice->GetDimensions()[1] <= 0
-                    || slice->GetDimensions()[2] != 1) {
-                    return nullptr;
-                }
-                if (slices.empty()) {
-                    std::copy(std::begin(sliceExtent), std::end(sliceExtent), expectedExtent);
-                    expectedScalarType = slice->GetScalarType();
-                    expectedComponents = slice->GetNumberOfScalarComponents();
-                }
-                else if (sliceExtent[0] != expectedExtent[0]
-                    || sliceExtent[1] != expectedExtent[1]
-                    || sliceExtent[2] != expectedExtent[2]
-                    || sliceExtent[3] != expectedExtent[3]
-                    || slice->GetScalarType() != expectedScalarType
-                    || slice->GetNumberOfScalarComponents() != expectedComponents) {
-                    return nullptr;
-                }
-                slices.push_back(slice);
-                append->AddInputData(slice);
-            }
-            append->Update();
-        }
-        catch (...) {
-            std::cerr << "[Error] Exception during TIFF series reading." << std::endl;
-            return nullptr;
-        }
-        if (append->GetErrorCode() != 0
-            || !append->GetOutput()
-            || append->GetOutput()->GetNumberOfPoints() == 0) {
-            return nullptr;
-        }
-        decodedImage = vtkSmartPointer<vtkImageData>::New();
-        decodedImage->DeepCopy(append->GetOutput());
+        // fileList 的自然排序是切片顺序真源；逐层并行解码并直接写入最终 RAS 体。
+        return LoadSeries(fileList, layout, statistics);
     }
     else {
         // 单文件
@@ -1521,8 +2614,8 @@ vtkSmartPointer<vtkImageData> TiffVolumeDataManager::Impl::LoadImage(
             std::cerr << "[Error] Exception during TIFF reading." << std::endl;
             return nullptr;
         }
-        decodedImage = vtkSmartPointer<vtkImageData>::New();
-        decodedImage->DeepCopy(reader->GetOutput());
+        // 翻转本身会写入独立的目标体，解码输出只需随 reader 生命周期读取一次，无需先整卷复制。
+        decodedImage = reader->GetOutput();
     }
 
     auto output = decodedImage;
@@ -1547,7 +2640,7 @@ vtkSmartPointer<vtkImageData> TiffVolumeDataManager::Impl::LoadImage(
     lpsImage->SetOrigin(origin[0], origin[1], origin[2]);
 
     auto newImage = vtkSmartPointer<vtkImageData>::New();
-    if (!SetLpsRasImage(lpsImage, newImage)) {
+    if (!SetLpsRasImage(lpsImage, newImage, statistics)) {
         return nullptr;
     }
 
@@ -1558,9 +2651,138 @@ vtkSmartPointer<vtkImageData> TiffVolumeDataManager::Impl::LoadImage(
     return newImage;
 }
 
+vtkSmartPointer<vtkImageData> TiffVolumeDataManager::Impl::LoadSeries(
+    const std::vector<std::string>& fileList,
+    const VolumeLayout& layout,
+    VolumeStatistics& statistics) const
+{
+    const auto& expectedDims = layout.GetDimensions();
+    if (fileList.size() != static_cast<size_t>(expectedDims[2])) {
+        std::cerr << "[Error] TIFF slice count does not match volume layout." << std::endl;
+        return nullptr;
+    }
+
+    // 单张切片解码：任一读取失败、非单层或 XY 尺寸与 layout 不符都视为整卷失败。
+    // 每张 TIFF 独立 reader 解码，避开批量 SetFileNames 或跨文件复用 reader 在部分 Windows
+    // libtiff 构建中的跨文件状态损坏；fileList 的自然排序仍是切片顺序真源。
+    const auto getSlice = [&expectedDims](const std::string& file) -> vtkSmartPointer<vtkImageData> {
+        auto reader = vtkSmartPointer<vtkTIFFReader>::New();
+        reader->SetFileName(file.c_str());
+        if (!reader->CanReadFile(file.c_str())) {
+            return nullptr;
+        }
+        reader->Update();
+        vtkSmartPointer<vtkImageData> slice = reader->GetOutput();
+        if (reader->GetErrorCode() != 0
+            || !slice
+            || slice->GetNumberOfPoints() == 0
+            || !slice->GetScalarPointer()) {
+            return nullptr;
+        }
+        const int* sliceDims = slice->GetDimensions();
+        if (sliceDims[0] != expectedDims[0]
+            || sliceDims[1] != expectedDims[1]
+            || sliceDims[2] != 1) {
+            return nullptr;
+        }
+        return slice;
+    };
+
+    auto newImage = vtkSmartPointer<vtkImageData>::New();
+    int scalarType = VTK_VOID;
+    int componentCount = 0;
+    size_t pixelBytes = 0;
+    try {
+        // 首张切片在调用线程解码，用于确定标量类型与分量数并分配唯一一份目标体。
+        const vtkSmartPointer<vtkImageData> firstSlice = getSlice(fileList.front());
+        if (!firstSlice) {
+            return nullptr;
+        }
+        scalarType = firstSlice->GetScalarType();
+        componentCount = firstSlice->GetNumberOfScalarComponents();
+        pixelBytes = static_cast<size_t>(componentCount)
+            * static_cast<size_t>(firstSlice->GetScalarSize());
+
+        const auto& spacing = layout.GetSpacing();
+        const auto& origin = layout.GetOrigin();
+        const std::array<double, 3> imageSpacing = { spacing[0], spacing[1], spacing[2] };
+        const std::array<double, 3> rasOrigin = BaseDataManager::Impl::GetRasOrigin(
+            { origin[0], origin[1], origin[2] }, expectedDims.data(), imageSpacing);
+        newImage->SetDimensions(expectedDims[0], expectedDims[1], expectedDims[2]);
+        newImage->SetSpacing(imageSpacing[0], imageSpacing[1], imageSpacing[2]);
+        newImage->SetOrigin(rasOrigin[0], rasOrigin[1], rasOrigin[2]);
+        newImage->AllocateScalars(scalarType, componentCount);
+        if (!newImage->GetScalarPointer()) {
+            return nullptr;
+        }
+
+        const std::array<size_t, 3> sliceDims = {
+            static_cast<size_t>(expectedDims[0]),
+            static_cast<size_t>(expectedDims[1]),
+            1
+        };
+        const size_t planeBytes = sliceDims[0] * sliceDims[1] * pixelBytes;
+        auto* target = static_cast<unsigned char*>(newImage->GetScalarPointer());
+        if (!VolumeReorder::SetRasScalars(
+            firstSlice->GetScalarPointer(), target, sliceDims, pixelBytes)) {
+            return nullptr;
+        }
+
+        // LPS->RAS 只翻转 X/Y，Z 平面序号与 fileList 下标一致；各平面互不重叠，可无锁写入。
+        // 并发度由 vtkSMPTools 后端线程数约束，外层已并行时内层翻转退化为串行。
+        std::atomic<bool> hasFailed{ false };
+        vtkSMPTools::For(1, static_cast<vtkIdType>(fileList.size()), 1,
+            [&](vtkIdType begin, vtkIdType end) {
+                for (vtkIdType z = begin; z < end && !hasFailed.load(std::memory_order_relaxed); ++z) {
+                    try {
+                        const vtkSmartPointer<vtkImageData> slice =
+                            getSlice(fileList[static_cast<size_t>(z)]);
+                        if (!slice
+                            || slice->GetScalarType() != scalarType
+                            || slice->GetNumberOfScalarComponents() != componentCount
+                            || !VolumeReorder::SetRasScalars(
+                                slice->GetScalarPointer(),
+                                target + static_cast<size_t>(z) * planeBytes,
+                                sliceDims, pixelBytes)) {
+                            hasFailed.store(true, std::memory_order_relaxed);
+                        }
+                    }
+                    catch (...) {
+                        hasFailed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            });
+        if (hasFailed.load()) {
+            std::cerr << "[Error] Failed to decode TIFF series slice." << std::endl;
+            return nullptr;
+        }
+    }
+    catch (...) {
+        std::cerr << "[Error] Exception during TIFF series reading." << std::endl;
+        return nullptr;
+    }
+
+    // 单分量常见类型在整卷落位后补一次只读统计；其余类型由调用方回退 VTK 范围扫描。
+    if (componentCount == 1) {
+        const std::array<size_t, 3> volumeDims = {
+            static_cast<size_t>(expectedDims[0]),
+            static_cast<size_t>(expectedDims[1]),
+            static_cast<size_t>(expectedDims[2])
+        };
+        VolumeReorder::GetStatistics(
+            newImage->GetScalarPointer(), volumeDims, scalarType, true, statistics);
+    }
+    newImage->Modified();
+
+    std::cout << "[Success] Loaded Volume: " << expectedDims[0] << "x"
+        << expectedDims[1] << "x" << expectedDims[2] << std::endl;
+    return newImage;
+}
+
 bool TiffVolumeDataManager::Impl::SetLpsRasImage(
     vtkImageData* source,
-    vtkImageData* target) const
+    vtkImageData* target,
+    VolumeStatistics& statistics) const
 {
     if (!source || !target) {
         return false;
@@ -1593,30 +2815,23 @@ bool TiffVolumeDataManager::Impl::SetLpsRasImage(
     const int componentCount = source->GetNumberOfScalarComponents();
     const int scalarSize = source->GetScalarSize();
     const size_t pixelBytes = static_cast<size_t>(componentCount) * static_cast<size_t>(scalarSize);
-    const size_t nx = static_cast<size_t>(dims[0]);
-    const size_t ny = static_cast<size_t>(dims[1]);
-    const size_t rowBytes = nx * pixelBytes;
-    const size_t sliceBytes = ny * rowBytes;
-
-    const char* srcBase = static_cast<const char*>(source->GetScalarPointer());
-    char* dstBase = static_cast<char*>(target->GetScalarPointer());
-    if (!srcBase || !dstBase) {
-        return false;
+    const std::array<size_t, 3> volumeDims = {
+        static_cast<size_t>(dims[0]),
+        static_cast<size_t>(dims[1]),
+        static_cast<size_t>(dims[2])
+    };
+    // 单分量常见类型在翻转时顺带产出统计；多分量或 64 位整数退回纯翻转，由调用方回退 VTK 范围扫描。
+    if (componentCount == 1
+        && VolumeReorder::SetRasScalars(
+            source->GetScalarPointer(), target->GetScalarPointer(),
+            volumeDims, source->GetScalarType(), true, statistics)) {
+        target->Modified();
+        return true;
     }
-
-    for (size_t z = 0; z < static_cast<size_t>(dims[2]); ++z) {
-        const size_t srcSliceOffset = z * sliceBytes;
-        const size_t dstSliceOffset = z * sliceBytes;
-        for (size_t y = 0; y < ny; ++y) {
-            const char* srcRow = srcBase + srcSliceOffset + y * rowBytes;
-            char* dstRow = dstBase + dstSliceOffset + (ny - 1 - y) * rowBytes;
-            for (size_t x = 0; x < nx; ++x) {
-                std::memcpy(
-                    dstRow + (nx - 1 - x) * pixelBytes,
-                    srcRow + x * pixelBytes,
-                    pixelBytes);
-            }
-        }
+    if (!VolumeReorder::SetRasScalars(
+        source->GetScalarPointer(), target->GetScalarPointer(),
+        volumeDims, pixelBytes)) {
+        return false;
     }
 
     target->Modified();
@@ -0,0 +1,412 @@
+#include "Data/ImageDownsampleFilter.h"
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace {
+// 单轴可分离核：输出样本 o 读取输入 [first[o], first[o] + count[o])，权重自 weights[start[o]] 起连续存放。
+struct AxisKernel {
+    std::vector<int> first;
+    std::vector<int> count;
+    std::vector<std::size_t> start;
+    std::vector<float> weights;
+};
+
+// in/out 范围为绝对 extent 下标，first 为相对输入范围起点的下标。
+// 缩小时三角核半宽取一个输出间距（以输入体素计），放大或等倍时退化为线性插值；边界处按有效权重重新归一。
+AxisKernel BuildAxisKernel(
+    int inMin,
+    int inMax,
+    int outMin,
+    int outMax,
+    double factor)
+{
+    AxisKernel kernel;
+    const int outCount = outMax - outMin + 1;
+    kernel.first.resize(static_cast<std::size_t>(outCount));
+    kernel.count.resize(static_cast<std::size_t>(outCount));
+    kernel.start.resize(static_cast<std::size_t>(outCount));
+    const double radius = factor < 1.0 ? 1.0 / factor : 1.0;
+    for (int index = 0; index < outCount; ++index) {
+        const double center = static_cast<double>(outMin + index) / factor;
+        const int low = std::max(
+            inMin, static_cast<int>(std::floor(center - radius)) + 1);
+        const int high = std::min(
+            inMax, static_cast<int>(std::ceil(center + radius)) - 1);
+        const std::size_t start = kernel.weights.size();
+        double sum = 0.0;
+        for (int source = low; source <= high; ++source) {
+            const double weight = std::max(
+                0.0, 1.0 - std::abs(source - center) / radius);
+            kernel.weights.push_back(static_cast<float>(weight));
+            sum += weight;
+        }
+        const auto slot = static_cast<std::size_t>(index);
+        kernel.start[slot] = start;
+        if (sum <= 0.0) {
+            // 采样中心落在输入范围外或核被浮点误差截空时取最近体素。
+            kernel.weights.resize(start);
+            const double nearest = std::round(center);
+            const int source = static_cast<int>(std::min<double>(
+                inMax, std::max<double>(inMin, nearest)));
+            kernel.weights.push_back(1.0f);
+            kernel.first[slot] = source - inMin;
+            kernel.count[slot] = 1;
+            continue;
+        }
+        for (std::size_t tap = start; tap < kernel.weights.size(); ++tap) {
+            kernel.weights[tap] = static_cast<float>(kernel.weights[tap] / sum);
+        }
+        kernel.first[slot] = low - inMin;
+        kernel.count[slot] = high - low + 1;
+    }
+    return kernel;
+}
+
+template <typename T, typename Acc>
+T GetStored(Acc value)
+{
+    if constexpr (std::is_integral<T>::value) {
+        const Acc rounded = std::round(value);
+        const Acc lowest = static_cast<Acc>(std::numeric_limits<T>::lowest());
+        const Acc highest = static_cast<Acc>(std::numeric_limits<T>::max());
+        return static_cast<T>(std::min(highest, std::max(lowest, rounded)));
+    }
+    else {
+        return static_cast<T>(value);
+    }
+}
+
+struct VolumeShape {
+    int inDims[3] = { 0, 0, 0 };
+    int outDims[3] = { 0, 0, 0 };
+    int components = 1;
+};
+
+// Z 遍把输入平面乘加到整面累加缓冲，Y 遍把平面行乘加到输出行缓冲，二者都是连续内存上的
+// 定长 axpy，编译器可直接向量化；X 遍只作用于已缩小两轴的数据。每个线程复用自己的缓冲。
+template <typename T>
+bool SetAverageSlices(
+    const T* input,
+    T* output,
+    const VolumeShape& shape,
+    const AxisKernel* kernels)
+{
+    using Acc = typename std::conditional<
+        std::is_same<T, double>::value, double, float>::type;
+    const std::size_t components = static_cast<std::size_t>(shape.components);
+    const std::size_t inRow = static_cast<std::size_t>(shape.inDims[0]) * components;
+    const std::size_t inPlane = inRow * static_cast<std::size_t>(shape.inDims[1]);
+    const std::size_t outRow = static_cast<std::size_t>(shape.outDims[0]) * components;
+    const std::size_t outPlane = outRow * static_cast<std::size_t>(shape.outDims[1]);
+    vtkSMPThreadLocal<std::vector<Acc>> planeLocal;
+    vtkSMPThreadLocal<std::vector<Acc>> rowsLocal;
+    std::atomic<bool> isFailed{ false };
+    vtkSMPTools::For(0, shape.outDims[2],
+        [&](vtkIdType begin, vtkIdType end) {
+            try {
+                auto& plane = planeLocal.Local();
+                auto& rows = rowsLocal.Local();
+                plane.resize(inPlane);
+                rows.resize(inRow * static_cast<std::size_t>(shape.outDims[1]));
+                for (vtkIdType z = begin; z < end; ++z) {
+                    const auto zSlot = static_cast<std::size_t>(z);
+                    std::fill(plane.begin(), plane.end(), Acc(0));
+                    for (int tap = 0; tap < kernels[2].count[zSlot]; ++tap) {
+                        const Acc weight = kernels[2].weights[kernels[2].start[zSlot] + tap];
+                        const T* source = input
+                            + static_cast<std::size_t>(kernels[2].first[zSlot] + tap) * inPlane;
+                        Acc* target = plane.data();
+                        for (std::size_t index = 0; index < inPlane; ++index) {
+                            target[index] += weight * static_cast<Acc>(source[index]);
+                        }
+                    }
+
+                    for (int y = 0; y < shape.outDims[1]; ++y) {
+                        const auto ySlot = static_cast<std::size_t>(y);
+                        Acc* row = rows.data() + ySlot * inRow;
+                        std::fill(row, row + inRow, Acc(0));
+                        for (int tap = 0; tap < kernels[1].count[ySlot]; ++tap) {
+                            const Acc weight = kernels[1].weights[kernels[1].start[ySlot] + tap];
+                            const Acc* source = plane.data()
+                                + static_cast<std::size_t>(kernels[1].first[ySlot] + tap) * inRow;
+                            for (std::size_t index = 0; index < inRow; ++index) {
+                                row[index] += weight * source[index];
+                            }
+                        }
+                    }
+
+                    T* target = output + zSlot * outPlane;
+                    for (int y = 0; y < shape.outDims[1]; ++y) {
+                        const Acc* row = rows.data() + static_cast<std::size_t>(y) * inRow;
+                        for (int x = 0; x < shape.outDims[0]; ++x) {
+                            const auto xSlot = static_cast<std::size_t>(x);
+                            const float* weights =
+                                kernels[0].weights.data() + kernels[0].start[xSlot];
+                            const Acc* source = row
+                                + static_cast<std::size_t>(kernels[0].first[xSlot]) * components;
+                            for (std::size_t component = 0; component < components; ++component) {
+                                Acc sum = 0;
+                                for (int tap = 0; tap < kernels[0].count[xSlot]; ++tap) {
+                                    sum += static_cast<Acc>(weights[tap])
+                                        * source[static_cast<std::size_t>(tap) * components + component];
+                                }
+                                *target++ = GetStored<T>(sum);
+                            }
+                        }
+                    }
+                }
+            }
+            catch (...) {
+                isFailed = true;
+            }
+        });
+    return !isFailed;
+}
+
+// 与 Average 使用同一足迹，逐遍取最大值；只要足迹内存在有效体素，输出即保持有效。
+template <typename T>
+bool SetMaxSlices(
+    const T* input,
+    T* output,
+    const VolumeShape& shape,
+    const AxisKernel* kernels)
+{
+    const std::size_t components = static_cast<std::size_t>(shape.components);
+    const std::size_t inRow = static_cast<std::size_t>(shape.inDims[0]) * components;
+    const std::size_t inPlane = inRow * static_cast<std::size_t>(shape.inDims[1]);
+    const std::size_t outRow = static_cast<std::size_t>(shape.outDims[0]) * components;
+    const std::size_t outPlane = outRow * static_cast<std::size_t>(shape.outDims[1]);
+    vtkSMPThreadLocal<std::vector<T>> planeLocal;
+    vtkSMPThreadLocal<std::vector<T>> rowsLocal;
+    std::atomic<bool> isFailed{ false };
+    vtkSMPTools::For(0, shape.outDims[2],
+        [&](vtkIdType begin, vtkIdType end) {
+            try {
+                auto& plane = planeLocal.Local();
+                auto& rows = rowsLocal.Local();
+                plane.resize(inPlane);
+                rows.resize(inRow * static_cast<std::size_t>(shape.outDims[1]));
+                for (vtkIdType z = begin; z < end; ++z) {
+                    const auto zSlot = static_cast<std::size_t>(z);
+                    const T* firstPlane = input
+                        + static_cast<std::size_t>(kernels[2].first[zSlot]) * inPlane;
+                    std::copy(firstPlane, firstPlane + inPlane, plane.begin());
+                    for (int tap = 1; tap < kernels[2].count[zSlot]; ++tap) {
+                        const T* source = firstPlane + static_cast<std::size_t>(tap) * inPlane;
+                        T* target = plane.data();
+                        for (std::size_t index = 0; index < inPlane; ++index) {
+                            target[index] = std::max(target[index], source[index]);
+                        }
+                    }
+
+                    for (int y = 0; y < shape.outDims[1]; ++y) {
+                        const auto ySlot = static_cast<std::size_t>(y);
+                        T* row = rows.data() + ySlot * inRow;
+                        const T* firstRow = plane.data()
+                            + static_cast<std::size_t>(kernels[1].first[ySlot]) * inRow;
+                        std::copy(firstRow, firstRow + inRow, row);
+                        for (int tap = 1; tap < kernels[1].count[ySlot]; ++tap) {
+                            const T* source = firstRow + static_cast<std::size_t>(tap) * inRow;
+                            for (std::size_t index = 0; index < inRow; ++index) {
+                                row[index] = std::max(row[index], source[index]);
+                            }
+                        }
+                    }
+
+                    T* target = output + zSlot * outPlane;
+                    for (int y = 0; y < shape.outDims[1]; ++y) {
+                        const T* row = rows.data() + static_cast<std::size_t>(y) * inRow;
+                        for (int x = 0; x < shape.outDims[0]; ++x) {
+                            const auto xSlot = static_cast<std::size_t>(x);
+                            const T* source = row
+                                + static_cast<std::size_t>(kernels[0].first[xSlot]) * components;
+                            for (std::size_t component = 0; component < components; ++component) {
+                                T value = source[component];
+                                for (int tap = 1; tap < kernels[0].count[xSlot]; ++tap) {
+                                    value = std::max(value,
+                                        source[static_cast<std::size_t>(tap) * components + component]);
+                                }
+                                *target++ = value;
+                            }
+                        }
+                    }
+                }
+            }
+            catch (...) {
+                isFailed = true;
+            }
+        });
+    return !isFailed;
+}
+
+template <typename T>
+bool SetDownsampled(
+    const void* input,
+    void* output,
+    const VolumeShape& shape,
+    const AxisKernel* kernels,
+    bool isMax)
+{
+    return isMax
+        ? SetMaxSlices(static_cast<const T*>(input), static_cast<T*>(output), shape, kernels)
+        : SetAverageSlices(static_cast<const T*>(input), static_cast<T*>(output), shape, kernels);
+}
+} // namespace
+
+vtkStandardNewMacro(ImageDownsampleFilter);
+
+void ImageDownsampleFilter::SetAxisMagnificationFactor(int axis, double factor)
+{
+    if (axis < 0 || axis > 2 || !std::isfinite(factor) || factor <= 0.0
+        || m_factors[axis] == factor) {
+        return;
+    }
+    m_factors[axis] = factor;
+    Modified();
+}
+
+double ImageDownsampleFilter::GetAxisMagnificationFactor(int axis) const
+{
+    return axis >= 0 && axis <= 2 ? m_factors[axis] : 0.0;
+}
+
+void ImageDownsampleFilter::SetMode(Mode mode)
+{
+    if (m_mode == mode) {
+        return;
+    }
+    m_mode = mode;
+    Modified();
+}
+
+ImageDownsampleFilter::Mode ImageDownsampleFilter::GetMode() const
+{
+    return m_mode;
+}
+
+int ImageDownsampleFilter::RequestInformation(
+    vtkInformation*,
+    vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector)
+{
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int extent[6] = { 0, -1, 0, -1, 0, -1 };
+    double spacing[3] = { 1.0, 1.0, 1.0 };
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
+    inInfo->Get(vtkDataObject::SPACING(), spacing);
+    for (int axis = 0; axis < 3; ++axis) {
+        const double factor = m_factors[axis];
+        extent[2 * axis] = static_cast<int>(std::ceil(extent[2 * axis] * factor));
+        extent[2 * axis + 1] = static_cast<int>(std::floor(extent[2 * axis + 1] * factor));
+        spacing[axis] /= factor;
+    }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+    outInfo->Set(vtkDataObject::SPACING(), spacing, 3);
+    return 1;
+}
+
+int ImageDownsampleFilter::RequestUpdateExtent(
+    vtkInformation*,
+    vtkInformationVector** inputVector,
+    vtkInformationVector*)
+{
+    // 三角核足迹跨越整卷分片边界，始终请求完整输入。
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    int extent[6] = { 0, -1, 0, -1, 0, -1 };
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+    return 1;
+}
+
+int ImageDownsampleFilter::RequestData(
+    vtkInformation*,
+    vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector)
+{
+    auto* input = vtkImageData::GetData(inputVector[0]);
+    auto* output = vtkImageData::GetData(outputVector);
+    auto* inScalars = input ? input->GetPointData()->GetScalars() : nullptr;
+    if (!output || !inScalars) {
+        return 0;
+    }
+    if (m_factors[0] == 1.0 && m_factors[1] == 1.0 && m_factors[2] == 1.0) {
+        // 等倍输出不复制体素；下游只读共享输入 scalar。
+        output->ShallowCopy(input);
+        return 1;
+    }
+
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int inExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    int outExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    double spacing[3] = { 1.0, 1.0, 1.0 };
+    input->GetExtent(inExtent);
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), outExtent);
+    outInfo->Get(vtkDataObject::SPACING(), spacing);
+
+    VolumeShape shape;
+    shape.components = inScalars->GetNumberOfComponents();
+    AxisKernel kernels[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        shape.inDims[axis] = inExtent[2 * axis + 1] - inExtent[2 * axis] + 1;
+        shape.outDims[axis] = outExtent[2 * axis + 1] - outExtent[2 * axis] + 1;
+        if (shape.inDims[axis] <= 0 || shape.outDims[axis] <= 0) {
+            return 0;
+        }
+    }
+    if (shape.components <= 0) {
+        return 0;
+    }
+
+    try {
+        for (int axis = 0; axis < 3; ++axis) {
+            kernels[axis] = BuildAxisKernel(
+                inExtent[2 * axis], inExtent[2 * axis + 1],
+                outExtent[2 * axis], outExtent[2 * axis + 1],
+                m_factors[axis]);
+        }
+        output->SetExtent(outExtent);
+        output->SetSpacing(spacing);
+        output->SetOrigin(input->GetOrigin());
+        output->SetDirectionMatrix(input->GetDirectionMatrix());
+        output->AllocateScalars(inScalars->GetDataType(), shape.components);
+    }
+    catch (...) {
+        return 0;
+    }
+    auto* outScalars = output->GetPointData()->GetScalars();
+    if (!outScalars) {
+        return 0;
+    }
+    outScalars->SetName(inScalars->GetName());
+
+    const bool isMax = m_mode == Mode::Max;
+    bool isDone = false;
+    switch (inScalars->GetDataType()) {
+        vtkTemplateMacro(isDone = SetDownsampled<VTK_TT>(
+            inScalars->GetVoidPointer(0),
+            outScalars->GetVoidPointer(0),
+            shape,
+            kernels,
+            isMax));
+    default:
+        return 0;
+    }
+    return isDone ? 1 : 0;
+}
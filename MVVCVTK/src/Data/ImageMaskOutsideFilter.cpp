@@ -0,0 +1,333 @@
+#include "Data/ImageMaskOutsideFilter.h"
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkInformation.h>
+#include <vtkInformationVector.h>
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPTools.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace {
+// mask 与输入的 origin/spacing 按相对误差比较；降采样层由同一倍率算出，只差浮点舍入。
+constexpr double kGeometryTolerance = 1e-6;
+
+// 输出范围 [outExtent] 内逐体素读取输入与 mask；三者均为 x 最快的连续布局，extent 各自独立。
+struct MaskedCopyShape {
+    int outExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    int inExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    int maskExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    int components = 1;
+};
+
+bool GetNear(double left, double right)
+{
+    return std::abs(left - right)
+        <= kGeometryTolerance * std::max({ 1.0, std::abs(left), std::abs(right) });
+}
+
+std::size_t GetOffset(const int extent[6], int x, int y, int z)
+{
+    const auto dimX = static_cast<std::size_t>(extent[1] - extent[0] + 1);
+    const auto dimY = static_cast<std::size_t>(extent[3] - extent[2] + 1);
+    return (static_cast<std::size_t>(z - extent[4]) * dimY
+        + static_cast<std::size_t>(y - extent[2])) * dimX
+        + static_cast<std::size_t>(x - extent[0]);
+}
+
+// 外侧值取 min - max(1, max - min) 并夹到类型下界：不至于让 flying edges 的中心差分梯度在
+// 浮点溢出或整数相减时越界。未被夹住时它严格低于 min；无符号类型在 min < max(1, max - min)
+// 时被夹成 0，只对 iso > 0 保证在外侧，与头文件约定一致。
+template <typename T>
+T GetOutsideValue(const double range[2])
+{
+    const double lowest = std::is_floating_point_v<T>
+        ? -static_cast<double>(std::numeric_limits<float>::max())
+        : static_cast<double>(std::numeric_limits<T>::lowest());
+    if (!std::isfinite(range[0]) || !std::isfinite(range[1]) || range[0] > range[1]) {
+        return static_cast<T>(lowest);
+    }
+    const double outside = range[0] - std::max(1.0, range[1] - range[0]);
+    return static_cast<T>(std::max(lowest, outside));
+}
+
+template <typename T>
+void SetMaskedSlices(
+    const T* input,
+    T* output,
+    const unsigned char* mask,
+    const MaskedCopyShape& shape,
+    const double range[2])
+{
+    const T outside = GetOutsideValue<T>(range);
+    const int components = shape.components;
+    const int* outExtent = shape.outExtent;
+    const int rowVoxels = outExtent[1] - outExtent[0] + 1;
+    vtkSMPTools::For(outExtent[4], outExtent[5] + 1,
+        [&](vtkIdType zBegin, vtkIdType zEnd) {
+            for (int z = static_cast<int>(zBegin); z < static_cast<int>(zEnd); ++z) {
+                for (int y = outExtent[2]; y <= outExtent[3]; ++y) {
+                    const T* inRow = input
+                        + GetOffset(shape.inExtent, outExtent[0], y, z) * components;
+                    const unsigned char* maskRow = mask
+                        + GetOffset(shape.maskExtent, outExtent[0], y, z);
+                    T* outRow = output
+                        + GetOffset(outExtent, outExtent[0], y, z) * components;
+                    for (int x = 0; x < rowVoxels; ++x) {
+                        const bool isValid = maskRow[x] != 0;
+                        for (int component = 0; component < components; ++component) {
+                            const std::size_t index =
+                                static_cast<std::size_t>(x) * components + component;
+                            outRow[index] = isValid ? inRow[index] : outside;
+                        }
+                    }
+                }
+            }
+        });
+}
+} // namespace
+
+vtkStandardNewMacro(ImageMaskOutsideFilter);
+
+bool ImageMaskOutsideFilter::SetMask(vtkImageData* validityMask)
+{
+    if (validityMask
+        && (validityMask->GetScalarType() != VTK_UNSIGNED_CHAR
+            || validityMask->GetNumberOfScalarComponents() != 1
+            || !validityMask->GetScalarPointer())) {
+        return false;
+    }
+    if (m_mask.GetPointer() != validityMask) {
+        m_mask = validityMask;
+        m_validExtentTime = 0;
+        Modified();
+    }
+    return true;
+}
+
+vtkImageData* ImageMaskOutsideFilter::GetMask() const
+{
+    return m_mask;
+}
+
+vtkMTimeType ImageMaskOutsideFilter::GetMTime()
+{
+    const vtkMTimeType filterTime = Superclass::GetMTime();
+    return m_mask ? std::max(filterTime, m_mask->GetMTime()) : filterTime;
+}
+
+bool ImageMaskOutsideFilter::SetValidExtent()
+{
+    if (!m_mask) {
+        return false;
+    }
+    const vtkMTimeType maskTime = m_mask->GetMTime();
+    if (m_validExtentTime == maskTime) {
+        return true;
+    }
+    int extent[6] = { 0, -1, 0, -1, 0, -1 };
+    m_mask->GetExtent(extent);
+    const auto* mask = static_cast<const unsigned char*>(m_mask->GetScalarPointer());
+    if (!mask) {
+        return false;
+    }
+
+    // 每线程累积 {xMin, xMax, yMin, yMax, zMin, zMax}；行内只找首尾非零体素。
+    using Bounds = std::array<int, 6>;
+    const Bounds emptyBounds = {
+        std::numeric_limits<int>::max(), std::numeric_limits<int>::min(),
+        std::numeric_limits<int>::max(), std::numeric_limits<int>::min(),
+        std::numeric_limits<int>::max(), std::numeric_limits<int>::min()
+    };
+    vtkSMPThreadLocal<Bounds> localBounds(emptyBounds);
+    // 每线程是否见过无效体素；全程未见则整卷有效，RequestData 可直接共享输入 scalar。
+    vtkSMPThreadLocal<unsigned char> localHoles(0);
+    const int rowVoxels = extent[1] - extent[0] + 1;
+    vtkSMPTools::For(extent[4], extent[5] + 1,
+        [&](vtkIdType zBegin, vtkIdType zEnd) {
+            Bounds& bounds = localBounds.Local();
+            unsigned char& hasHole = localHoles.Local();
+            for (int z = static_cast<int>(zBegin); z < static_cast<int>(zEnd); ++z) {
+                for (int y = extent[2]; y <= extent[3]; ++y) {
+                    const unsigned char* row = mask + GetOffset(extent, extent[0], y, z);
+                    const unsigned char* rowEnd = row + rowVoxels;
+                    const auto* first = std::find_if(row, rowEnd,
+                        [](unsigned char value) { return value != 0; });
+                    if (first == rowEnd) {
+                        hasHole = 1;
+                        continue;
+                    }
+                    const auto* last = std::find_if(
+                        std::make_reverse_iterator(rowEnd),
+                        std::make_reverse_iterator(first),
+                        [](unsigned char value) { return value != 0; }).base() - 1;
+                    // 已见过空洞的线程不再扫行内部；行首尾都有效时才需确认中间没有 0。
+                    if (!hasHole
+                        && (first != row || last != rowEnd - 1
+                            || std::find(first, last, static_cast<unsigned char>(0)) != last)) {
+                        hasHole = 1;
+                    }
+                    bounds[0] = std::min(bounds[0], extent[0] + static_cast<int>(first - row));
+                    bounds[1] = std::max(bounds[1], extent[0] + static_cast<int>(last - row));
+                    bounds[2] = std::min(bounds[2], y);
+                    bounds[3] = std::max(bounds[3], y);
+                    bounds[4] = std::min(bounds[4], z);
+                    bounds[5] = std::max(bounds[5], z);
+                }
+            }
+        });
+
+    Bounds merged = emptyBounds;
+    for (const Bounds& bounds : localBounds) {
+        for (int axis = 0; axis < 3; ++axis) {
+            merged[2 * axis] = std::min(merged[2 * axis], bounds[2 * axis]);
+            merged[2 * axis + 1] = std::max(merged[2 * axis + 1], bounds[2 * axis + 1]);
+        }
+    }
+    if (merged[0] > merged[1]) {
+        std::fill(std::begin(m_validExtent), std::end(m_validExtent), 0);
+        m_validExtent[1] = m_validExtent[3] = m_validExtent[5] = -1;
+    }
+    else {
+        std::copy(merged.begin(), merged.end(), m_validExtent);
+    }
+    m_isMaskFull = merged[0] <= merged[1]
+        && std::none_of(localHoles.begin(), localHoles.end(),
+            [](unsigned char hasHole) { return hasHole != 0; });
+    m_validExtentTime = maskTime;
+    return true;
+}
+
+int ImageMaskOutsideFilter::RequestInformation(
+    vtkInformation*,
+    vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector)
+{
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    int extent[6] = { 0, -1, 0, -1, 0, -1 };
+    inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent);
+    if (!m_mask) {
+        outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+        return 1;
+    }
+
+    int maskExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    double spacing[3] = { 1.0, 1.0, 1.0 };
+    double origin[3] = { 0.0, 0.0, 0.0 };
+    m_mask->GetExtent(maskExtent);
+    inInfo->Get(vtkDataObject::SPACING(), spacing);
+    inInfo->Get(vtkDataObject::ORIGIN(), origin);
+    for (int axis = 0; axis < 3; ++axis) {
+        if (maskExtent[2 * axis] != extent[2 * axis]
+            || maskExtent[2 * axis + 1] != extent[2 * axis + 1]
+            || !GetNear(m_mask->GetSpacing()[axis], spacing[axis])
+            || !GetNear(m_mask->GetOrigin()[axis], origin[axis])) {
+            vtkErrorMacro(<< "Validity mask geometry does not match the input image.");
+            return 0;
+        }
+    }
+    if (!SetValidExtent()) {
+        return 0;
+    }
+
+    // 包围盒外扩一体素，让有效区贴着包围盒的面也能与外侧值相交闭合；整卷边界处保持开放。
+    int outExtent[6] = { 0, -1, 0, -1, 0, -1 };
+    if (m_validExtent[0] <= m_validExtent[1]) {
+        for (int axis = 0; axis < 3; ++axis) {
+            outExtent[2 * axis] = std::max(extent[2 * axis], m_validExtent[2 * axis] - 1);
+            outExtent[2 * axis + 1] =
+                std::min(extent[2 * axis + 1], m_validExtent[2 * axis + 1] + 1);
+        }
+    }
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), outExtent, 6);
+    return 1;
+}
+
+int ImageMaskOutsideFilter::RequestData(
+    vtkInformation*,
+    vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector)
+{
+    auto* input = vtkImageData::GetData(inputVector[0]);
+    auto* output = vtkImageData::GetData(outputVector);
+    auto* inScalars = input ? input->GetPointData()->GetScalars() : nullptr;
+    if (!output || !inScalars) {
+        return 0;
+    }
+    if (!m_mask) {
+        output->ShallowCopy(input);
+        return 1;
+    }
+
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    MaskedCopyShape shape;
+    shape.components = inScalars->GetNumberOfComponents();
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), shape.outExtent);
+    input->GetExtent(shape.inExtent);
+    m_mask->GetExtent(shape.maskExtent);
+    const bool isEmpty = shape.outExtent[0] > shape.outExtent[1]
+        || shape.outExtent[2] > shape.outExtent[3]
+        || shape.outExtent[4] > shape.outExtent[5];
+    for (int axis = 0; axis < 3 && !isEmpty; ++axis) {
+        if (shape.outExtent[2 * axis] < shape.inExtent[2 * axis]
+            || shape.outExtent[2 * axis + 1] > shape.inExtent[2 * axis + 1]) {
+            return 0;
+        }
+    }
+    if (shape.components <= 0) {
+        return 0;
+    }
+    // 全有效 mask（例如撤销全部裁切后）不改写任何体素：与无 mask 一样共享输入 scalar，不复制。
+    if (m_isMaskFull
+        && std::equal(std::begin(shape.outExtent), std::end(shape.outExtent), shape.inExtent)) {
+        output->ShallowCopy(input);
+        return 1;
+    }
+
+    try {
+        output->SetExtent(shape.outExtent);
+        output->SetSpacing(input->GetSpacing());
+        output->SetOrigin(input->GetOrigin());
+        output->SetDirectionMatrix(input->GetDirectionMatrix());
+        output->AllocateScalars(inScalars->GetDataType(), shape.components);
+    }
+    catch (...) {
+        return 0;
+    }
+    auto* outScalars = output->GetPointData()->GetScalars();
+    if (!outScalars) {
+        return 0;
+    }
+    outScalars->SetName(inScalars->GetName());
+    if (isEmpty) {
+        // mask 全无效：输出空体，下游等值面为空网格。
+        return 1;
+    }
+
+    const auto* mask = static_cast<const unsigned char*>(m_mask->GetScalarPointer());
+    // flying edges 默认按第 0 分量提取；range 由数组按 MTime 缓存，同一输入重复执行不再扫描。
+    double range[2] = { 0.0, -1.0 };
+    inScalars->GetRange(range, 0);
+    switch (inScalars->GetDataType()) {
+        vtkTemplateMacro(SetMaskedSlices<VTK_TT>(
+            static_cast<const VTK_TT*>(inScalars->GetVoidPointer(0)),
+            static_cast<VTK_TT*>(outScalars->GetVoidPointer(0)),
+            mask,
+            shape,
+            range));
+    default:
+        return 0;
+    }
+    return 1;
+}
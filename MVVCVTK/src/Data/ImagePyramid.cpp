@@ -0,0 +1,315 @@
+#include "Data/ImagePyramid.h"
+#include "ImageProcessor.h"
+
+#include <vtkSMPTools.h>
+#include <vtkWeakPointer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <utility>
+
+namespace {
+// 3D 视图共同使用的显示层最大轴；快照换代时预建，首个视图重建管线时即可命中。
+constexpr int kDisplayTargetDim = 766;
+}
+
+class ImagePyramid::Impl final {
+public:
+    using LevelFuture = std::shared_future<vtkSmartPointer<vtkImageData>>;
+
+    struct LevelRequest {
+        vtkImageData* input = nullptr;
+        int targetDim = 0;
+        PyramidLevelKind kind = PyramidLevelKind::Image;
+    };
+
+    // 锁内查找或登记全部请求层，锁外并行兑现本次登记的层，再等待其余线程正在构建的层。
+    // 结果与 requests 一一对应；失败层为 nullptr 且从缓存移除，后续请求可重试。
+    std::vector<vtkSmartPointer<vtkImageData>> GetLevels(
+        const std::vector<LevelRequest>& requests);
+    void ClearExpired();
+    // 只保留 source 属于 keepSources 的层；用于快照换代时释放旧批次的显示层。
+    void ClearOtherSources(const std::vector<vtkImageData*>& keepSources);
+    static vtkSmartPointer<vtkImageData> BuildLevel(
+        vtkImageData* input, int targetDim, PyramidLevelKind kind);
+
+    struct Level {
+        std::uint64_t id = 0;
+        // 弱观察源 image；源释放后自动失效，地址复用不会误命中。
+        vtkWeakPointer<vtkImageData> source;
+        vtkMTimeType sourceMTime = 0;
+        int targetDim = 0;
+        PyramidLevelKind kind = PyramidLevelKind::Image;
+        LevelFuture output;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<Level> m_levels;
+    std::uint64_t m_nextId = 1;
+    vtkWeakPointer<vtkImageData> m_snapshotImage;
+    DataVersion m_snapshotVersion = 0;
+    std::atomic<std::size_t> m_buildCount{ 0 };
+};
+
+vtkSmartPointer<vtkImageData> ImagePyramid::Impl::BuildLevel(
+    vtkImageData* input,
+    int targetDim,
+    PyramidLevelKind kind)
+{
+    try {
+        auto resample = kind == PyramidLevelKind::Mask
+            ? ImageProcessor::GetDownsampledMask(input, targetDim)
+            : ImageProcessor::GetDownsampledImage(input, targetDim);
+        if (!resample) {
+            return nullptr;
+        }
+        resample->Update();
+        auto* output = resample->GetOutput();
+        if (!output || output->GetNumberOfPoints() <= 0) {
+            return nullptr;
+        }
+        // 与 filter 脱钩：层只持有 scalar，不让共享输出随某个视图的 pipeline 重新执行。
+        auto level = vtkSmartPointer<vtkImageData>::New();
+        level->ShallowCopy(output);
+        return level;
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void ImagePyramid::Impl::ClearExpired()
+{
+    m_levels.erase(
+        std::remove_if(m_levels.begin(), m_levels.end(),
+            [](const Level& level) {
+                auto* source = level.source.GetPointer();
+                return !source || source->GetMTime() != level.sourceMTime;
+            }),
+        m_levels.end());
+}
+
+void ImagePyramid::Impl::ClearOtherSources(
+    const std::vector<vtkImageData*>& keepSources)
+{
+    m_levels.erase(
+        std::remove_if(m_levels.begin(), m_levels.end(),
+            [&keepSources](const Level& level) {
+                return std::find(
+                    keepSources.begin(),
+                    keepSources.end(),
+                    level.source.GetPointer()) == keepSources.end();
+            }),
+        m_levels.end());
+}
+
+std::vector<vtkSmartPointer<vtkImageData>> ImagePyramid::Impl::GetLevels(
+    const std::vector<LevelRequest>& requests)
+{
+    struct Claim {
+        std::size_t requestIndex = 0;
+        std::uint64_t id = 0;
+        std::promise<vtkSmartPointer<vtkImageData>> promise;
+        vtkSmartPointer<vtkImageData> source;
+        vtkSmartPointer<vtkImageData> output;
+    };
+
+    std::vector<vtkSmartPointer<vtkImageData>> results(requests.size());
+    std::vector<LevelFuture> futures(requests.size());
+    std::vector<Claim> claims;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ClearExpired();
+        for (std::size_t index = 0; index < requests.size(); ++index) {
+            const auto& request = requests[index];
+            if (!request.input || request.targetDim <= 0) {
+                continue;
+            }
+            const vtkMTimeType sourceMTime = request.input->GetMTime();
+            const auto found = std::find_if(
+                m_levels.begin(), m_levels.end(),
+                [&request, sourceMTime](const Level& level) {
+                    return level.source.GetPointer() == request.input
+                        && level.sourceMTime == sourceMTime
+                        && level.targetDim == request.targetDim
+                        && level.kind == request.kind;
+                });
+            if (found != m_levels.end()) {
+                futures[index] = found->output;
+                continue;
+            }
+
+            Claim claim;
+            claim.requestIndex = index;
+            claim.id = m_nextId++;
+            Level level;
+            level.id = claim.id;
+            level.source = request.input;
+            level.sourceMTime = sourceMTime;
+            level.targetDim = request.targetDim;
+            level.kind = request.kind;
+            level.output = claim.promise.get_future().share();
+            futures[index] = level.output;
+            m_levels.push_back(std::move(level));
+            claims.push_back(std::move(claim));
+        }
+    }
+
+    if (!claims.empty()) {
+        // 每层使用独立 ShallowCopy 外壳接入各自的 resample，避免并行 Update 共享同一数据对象的 pipeline 信息。
+        for (auto& claim : claims) {
+            try {
+                claim.source = vtkSmartPointer<vtkImageData>::New();
+                claim.source->ShallowCopy(requests[claim.requestIndex].input);
+            }
+            catch (...) {
+                claim.source = nullptr;
+            }
+        }
+        vtkSMPTools::For(0, static_cast<vtkIdType>(claims.size()), 1,
+            [this, &claims, &requests](vtkIdType begin, vtkIdType end) {
+                for (vtkIdType index = begin; index < end; ++index) {
+                    auto& claim = claims[static_cast<std::size_t>(index)];
+                    if (!claim.source) {
+                        continue;
+                    }
+                    const auto& request = requests[claim.requestIndex];
+                    claim.output = BuildLevel(
+                        claim.source, request.targetDim, request.kind);
+                    ++m_buildCount;
+                }
+            });
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& claim : claims) {
+            if (!claim.output) {
+                m_levels.erase(
+                    std::remove_if(m_levels.begin(), m_levels.end(),
+                        [&claim](const Level& level) {
+                            return level.id == claim.id;
+                        }),
+                    m_levels.end());
+            }
+            claim.promise.set_value(claim.output);
+        }
+    }
+
+    for (std::size_t index = 0; index < futures.size(); ++index) {
+        if (futures[index].valid()) {
+            results[index] = futures[index].get();
+        }
+    }
+    return results;
+}
+
+ImagePyramid::ImagePyramid()
+    : m_impl(std::make_unique<Impl>())
+{
+}
+
+ImagePyramid::~ImagePyramid() = default;
+
+vtkSmartPointer<vtkImageData> ImagePyramid::GetLevel(
+    vtkImageData* input,
+    int targetDim,
+    PyramidLevelKind kind)
+{
+    return m_impl->GetLevels({ { input, targetDim, kind } }).front();
+}
+
+bool ImagePyramid::SetLevels(
+    vtkImageData* input,
+    const std::vector<int>& targetDims,
+    PyramidLevelKind kind)
+{
+    if (!input || targetDims.empty()) {
+        return false;
+    }
+    std::vector<Impl::LevelRequest> requests;
+    requests.reserve(targetDims.size());
+    for (const int targetDim : targetDims) {
+        if (targetDim <= 0) {
+            return false;
+        }
+        requests.push_back({ input, targetDim, kind });
+    }
+    const auto levels = m_impl->GetLevels(requests);
+    return std::all_of(levels.begin(), levels.end(),
+        [](const vtkSmartPointer<vtkImageData>& level) {
+            return level != nullptr;
+        });
+}
+
+bool ImagePyramid::SetSnapshot(const ImageSnapshot& snapshot)
+{
+    if (!snapshot || !snapshot->image) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+        if (m_impl->m_snapshotImage.GetPointer() != snapshot->image.GetPointer()
+            || m_impl->m_snapshotVersion != snapshot->version) {
+            m_impl->ClearOtherSources({
+                snapshot->image.GetPointer(),
+                snapshot->validityMask.GetPointer() });
+            m_impl->m_snapshotImage = snapshot->image.GetPointer();
+            m_impl->m_snapshotVersion = snapshot->version;
+        }
+    }
+
+    // image 与 mask 的显示层在同一批并行构建；已由其它视图登记的层只等待结果。
+    std::vector<Impl::LevelRequest> requests = {
+        { snapshot->image.GetPointer(), kDisplayTargetDim, PyramidLevelKind::Image }
+    };
+    if (snapshot->validityMask) {
+        requests.push_back({
+            snapshot->validityMask.GetPointer(),
+            kDisplayTargetDim,
+            PyramidLevelKind::Mask });
+    }
+    const auto levels = m_impl->GetLevels(requests);
+    return std::all_of(levels.begin(), levels.end(),
+        [](const vtkSmartPointer<vtkImageData>& level) {
+            return level != nullptr;
+        });
+}
+
+int ImagePyramid::GetLevelDim(vtkImageData* input, int level)
+{
+    if (!input || level < 0) {
+        return 0;
+    }
+    int dims[3] = { 0, 0, 0 };
+    input->GetDimensions(dims);
+    int targetDim = std::max({ dims[0], dims[1], dims[2] });
+    for (int index = 0; index < level && targetDim > 1; ++index) {
+        targetDim = (targetDim + 1) / 2;
+    }
+    return targetDim;
+}
+
+std::size_t ImagePyramid::GetLevelCount() const
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+    return static_cast<std::size_t>(std::count_if(
+        m_impl->m_levels.begin(), m_impl->m_levels.end(),
+        [](const Impl::Level& level) {
+            auto* source = level.source.GetPointer();
+            return source && source->GetMTime() == level.sourceMTime;
+        }));
+}
+
+std::size_t ImagePyramid::GetBuildCount() const
+{
+    return m_impl->m_buildCount.load();
+}
+
+void ImagePyramid::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_impl->m_mutex);
+    m_impl->m_levels.clear();
+    m_impl->m_snapshotImage = nullptr;
+    m_impl->m_snapshotVersion = 0;
+}
@@ -0,0 +1,343 @@
+#include "Data/MeshWriter.h"
+
+#include <vtkByteSwap.h>
+#include <vtkCellArray.h>
+#include <vtkDataArray.h>
+#include <vtkIdList.h>
+#include <vtkMath.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkSMPTools.h>
+#include <vtkUnsignedCharArray.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+// 每块打包的点或三角形数；PLY 顶点块约 1.7 MiB、STL 三角形块约 3.2 MiB，块缓冲写出后复用。
+constexpr vtkIdType kChunkItems = 64 * 1024;
+constexpr std::size_t kStlHeaderBytes = 80;
+constexpr std::size_t kStlTriangleBytes = 12 * sizeof(float) + sizeof(std::uint16_t);
+constexpr std::size_t kPlyFaceBytes = 1 + 3 * sizeof(std::int32_t);
+
+// 点按完整仿射矩阵变换；法向用线性部分的逆转置并重新归一化，与 vtkTransformPolyDataFilter 一致。
+struct WorldTransform {
+    double point[3][4] = {};
+    double normal[3][3] = {};
+};
+
+bool BuildWorldTransform(
+    const std::array<double, 16>& modelToWorld,
+    WorldTransform& transform)
+{
+    double linear[3][3] = {};
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            const double value = modelToWorld[row * 4 + column];
+            if (!std::isfinite(value)) {
+                return false;
+            }
+            transform.point[row][column] = value;
+            if (column < 3) {
+                linear[row][column] = value;
+            }
+        }
+    }
+    const double determinant = vtkMath::Determinant3x3(linear);
+    if (!std::isfinite(determinant) || determinant == 0.0) {
+        return false;
+    }
+    double inverse[3][3] = {};
+    vtkMath::Invert3x3(linear, inverse);
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            transform.normal[row][column] = inverse[column][row];
+        }
+    }
+    return true;
+}
+
+void SetWorldPoint(
+    const WorldTransform& transform,
+    const double model[3],
+    double world[3])
+{
+    for (int row = 0; row < 3; ++row) {
+        world[row] = transform.point[row][0] * model[0]
+            + transform.point[row][1] * model[1]
+            + transform.point[row][2] * model[2]
+            + transform.point[row][3];
+    }
+}
+
+void SetWorldNormal(
+    const WorldTransform& transform,
+    const double model[3],
+    double world[3])
+{
+    for (int row = 0; row < 3; ++row) {
+        world[row] = transform.normal[row][0] * model[0]
+            + transform.normal[row][1] * model[1]
+            + transform.normal[row][2] * model[2];
+    }
+    vtkMath::Normalize(world);
+}
+
+void SetFloat(char* target, double value)
+{
+    const float narrowed = static_cast<float>(value);
+    std::memcpy(target, &narrowed, sizeof(float));
+    vtkByteSwap::Swap4LE(target);
+}
+
+void SetInt32(char* target, std::int32_t value)
+{
+    std::memcpy(target, &value, sizeof(value));
+    vtkByteSwap::Swap4LE(target);
+}
+
+// 纯三角 polys 才能按定长记录打包；strips 需先经 vtkTriangleFilter 展开。
+vtkIdType GetTriangleCount(vtkPolyData* mesh)
+{
+    if (!mesh || !mesh->GetPoints() || mesh->GetNumberOfPoints() == 0
+        || mesh->GetNumberOfStrips() != 0) {
+        return 0;
+    }
+    vtkCellArray* polys = mesh->GetPolys();
+    if (!polys || polys->GetNumberOfCells() == 0
+        || polys->IsHomogeneous() != 3) {
+        return 0;
+    }
+    return polys->GetNumberOfCells();
+}
+
+// 把 [0, count) 按块并行打包成 recordBytes 定长记录，每块打包完成后一次写出。
+template <typename Pack>
+bool SetRecords(
+    std::ofstream& file,
+    vtkIdType count,
+    std::size_t recordBytes,
+    const Pack& pack)
+{
+    std::vector<char> buffer(
+        static_cast<std::size_t>(std::min(count, kChunkItems)) * recordBytes);
+    std::atomic<bool> hasFailed{ false };
+    for (vtkIdType chunkBegin = 0; chunkBegin < count; chunkBegin += kChunkItems) {
+        const vtkIdType chunkEnd = std::min(chunkBegin + kChunkItems, count);
+        vtkSMPTools::For(chunkBegin, chunkEnd,
+            [&](vtkIdType begin, vtkIdType end) {
+                for (vtkIdType id = begin;
+                     id < end && !hasFailed.load(std::memory_order_relaxed);
+                     ++id) {
+                    char* record = buffer.data()
+                        + static_cast<std::size_t>(id - chunkBegin) * recordBytes;
+                    if (!pack(id, record)) {
+                        hasFailed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            });
+        if (hasFailed.load()) {
+            return false;
+        }
+        file.write(buffer.data(), static_cast<std::streamsize>(
+            static_cast<std::size_t>(chunkEnd - chunkBegin) * recordBytes));
+        if (!file) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 写失败时删除半成品，调用方不会把截断文件当作导出结果。
+bool SetFileClosed(std::ofstream& file, const std::filesystem::path& filePath, bool isWritten)
+{
+    file.close();
+    if (isWritten && file) {
+        return true;
+    }
+    std::error_code error;
+    std::filesystem::remove(filePath, error);
+    return false;
+}
+} // namespace
+
+bool MeshWriter::SetPly(
+    const std::filesystem::path& filePath,
+    vtkPolyData* mesh,
+    const std::array<double, 16>& modelToWorld,
+    vtkUnsignedCharArray* colors)
+{
+    WorldTransform transform;
+    const vtkIdType triangleCount = GetTriangleCount(mesh);
+    if (triangleCount == 0 || !BuildWorldTransform(modelToWorld, transform)) {
+        return false;
+    }
+    const vtkIdType pointCount = mesh->GetNumberOfPoints();
+    if (pointCount > static_cast<vtkIdType>(std::numeric_limits<std::int32_t>::max())) {
+        return false;
+    }
+    if (colors
+        && (colors->GetNumberOfComponents() != 3
+            || colors->GetNumberOfTuples() != pointCount)) {
+        return false;
+    }
+    vtkDataArray* normals = mesh->GetPointData()
+        ? mesh->GetPointData()->GetNormals()
+        : nullptr;
+    if (normals
+        && (normals->GetNumberOfComponents() != 3
+            || normals->GetNumberOfTuples() != pointCount)) {
+        normals = nullptr;
+    }
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream header;
+    header << "ply\n"
+        << "format binary_little_endian 1.0\n"
+        << "element vertex " << pointCount << "\n"
+        << "property float x\nproperty float y\nproperty float z\n";
+    if (normals) {
+        header << "property float nx\nproperty float ny\nproperty float nz\n";
+    }
+    if (colors) {
+        header << "property uchar red\nproperty uchar green\nproperty uchar blue\n";
+    }
+    header << "element face " << triangleCount << "\n"
+        << "property list uchar int vertex_indices\n"
+        << "end_header\n";
+    const std::string headerText = header.str();
+    file.write(headerText.data(), static_cast<std::streamsize>(headerText.size()));
+
+    const std::size_t vertexBytes = 3 * sizeof(float)
+        + (normals ? 3 * sizeof(float) : 0)
+        + (colors ? 3 : 0);
+    vtkPoints* points = mesh->GetPoints();
+    const bool isVertexWritten = file && SetRecords(file, pointCount, vertexBytes,
+        [&](vtkIdType pointId, char* record) {
+            double model[3] = {};
+            double world[3] = {};
+            points->GetPoint(pointId, model);
+            SetWorldPoint(transform, model, world);
+            if (!std::isfinite(world[0]) || !std::isfinite(world[1])
+                || !std::isfinite(world[2])) {
+                return false;
+            }
+            for (int axis = 0; axis < 3; ++axis) {
+                SetFloat(record, world[axis]);
+                record += sizeof(float);
+            }
+            if (normals) {
+                normals->GetTuple(pointId, model);
+                SetWorldNormal(transform, model, world);
+                for (int axis = 0; axis < 3; ++axis) {
+                    SetFloat(record, world[axis]);
+                    record += sizeof(float);
+                }
+            }
+            if (colors) {
+                colors->GetTypedTuple(
+                    pointId, reinterpret_cast<unsigned char*>(record));
+            }
+            return true;
+        });
+
+    vtkCellArray* polys = mesh->GetPolys();
+    vtkSMPThreadLocalObject<vtkIdList> cellPoints;
+    const bool isFaceWritten = isVertexWritten
+        && SetRecords(file, triangleCount, kPlyFaceBytes,
+            [&](vtkIdType cellId, char* record) {
+                vtkIdList* pointIds = cellPoints.Local();
+                polys->GetCellAtId(cellId, pointIds);
+                if (pointIds->GetNumberOfIds() != 3) {
+                    return false;
+                }
+                record[0] = 3;
+                for (vtkIdType corner = 0; corner < 3; ++corner) {
+                    SetInt32(record + 1 + corner * sizeof(std::int32_t),
+                        static_cast<std::int32_t>(pointIds->GetId(corner)));
+                }
+                return true;
+            });
+    return SetFileClosed(file, filePath, isFaceWritten);
+}
+
+bool MeshWriter::SetStl(
+    const std::filesystem::path& filePath,
+    vtkPolyData* mesh,
+    const std::array<double, 16>& modelToWorld)
+{
+    WorldTransform transform;
+    const vtkIdType triangleCount = GetTriangleCount(mesh);
+    if (triangleCount == 0 || !BuildWorldTransform(modelToWorld, transform)
+        || triangleCount > static_cast<vtkIdType>(
+            std::numeric_limits<std::uint32_t>::max())) {
+        return false;
+    }
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    // 头部不能以 "solid" 开头，否则部分读取器会按 ASCII STL 解析。
+    char header[kStlHeaderBytes + sizeof(std::uint32_t)] = {};
+    const char title[] = "MVVCVTK binary STL";
+    std::memcpy(header, title, sizeof(title) - 1);
+    SetInt32(header + kStlHeaderBytes, static_cast<std::int32_t>(
+        static_cast<std::uint32_t>(triangleCount)));
+    file.write(header, sizeof(header));
+
+    vtkPoints* points = mesh->GetPoints();
+    vtkCellArray* polys = mesh->GetPolys();
+    vtkSMPThreadLocalObject<vtkIdList> cellPoints;
+    const bool isWritten = file && SetRecords(file, triangleCount, kStlTriangleBytes,
+        [&](vtkIdType cellId, char* record) {
+            vtkIdList* pointIds = cellPoints.Local();
+            polys->GetCellAtId(cellId, pointIds);
+            if (pointIds->GetNumberOfIds() != 3) {
+                return false;
+            }
+            double world[3][3] = {};
+            for (vtkIdType corner = 0; corner < 3; ++corner) {
+                double model[3] = {};
+                points->GetPoint(pointIds->GetId(corner), model);
+                SetWorldPoint(transform, model, world[corner]);
+                if (!std::isfinite(world[corner][0]) || !std::isfinite(world[corner][1])
+                    || !std::isfinite(world[corner][2])) {
+                    return false;
+                }
+            }
+            double edgeA[3] = {};
+            double edgeB[3] = {};
+            double normal[3] = {};
+            vtkMath::Subtract(world[1], world[0], edgeA);
+            vtkMath::Subtract(world[2], world[0], edgeB);
+            vtkMath::Cross(edgeA, edgeB, normal);
+            vtkMath::Normalize(normal);
+            for (int axis = 0; axis < 3; ++axis) {
+                SetFloat(record + axis * sizeof(float), normal[axis]);
+            }
+            for (int corner = 0; corner < 3; ++corner) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    SetFloat(record + (3 + corner * 3 + axis) * sizeof(float),
+                        world[corner][axis]);
+                }
+            }
+            std::memset(record + 12 * sizeof(float), 0, sizeof(std::uint16_t));
+            return true;
+        });
+    return SetFileClosed(file, filePath, isWritten);
+}
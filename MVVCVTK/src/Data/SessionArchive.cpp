@@ -0,0 +1,796 @@
+#include "Data/SessionArchive.h"
+#include "ExportControl.h"
+#include "MemMappedFile.h"
+#include "Platform/Path.h"
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkLZ4DataCompressor.h>
+#include <vtkSMPThreadLocal.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+// 文件头魔数与格式版本；任一字段布局变化都必须递增版本，旧归档随之拒绝加载。
+constexpr char kSessionMagic[8] = { 'M', 'V', 'V', 'C', 'S', 'E', 'S', 'S' };
+constexpr std::uint32_t kSessionFormatVersion = 1;
+// 默认块原始字节数，与 VolumeCache 一致；块按整张切片对齐，切片本身超过该值时一块一张。
+constexpr std::uint64_t kSessionChunkBytes = 4ULL * 1024ULL * 1024ULL;
+// 写归档时每批并行压缩的块数；逐批落盘，压缩缓冲峰值约为 64 块而非整卷。
+constexpr std::size_t kSessionWriteBatch = 64;
+constexpr std::size_t kSessionLayerCount = 3;
+
+// image 标量近似连续，用 LZ4；mask 与标签体由大片常量区组成，游程编码更紧凑且解码只是填充。
+enum class ChunkCodec : std::uint32_t {
+    Lz4 = 0,
+    RunLength = 1
+};
+
+struct ChunkEntry {
+    std::uint64_t offset = 0;      // 相对文件起点的块数据偏移
+    std::uint64_t storedBytes = 0; // 落盘字节数；与 rawBytes 相等表示未压缩原样存储
+    std::uint64_t rawBytes = 0;    // 解压后字节数，恒为整张切片字节数的倍数
+};
+
+// 归档映射上的顺序读取游标；越界读取返回 false，字段一律 memcpy 取出，不要求对齐。
+class SessionReader final {
+public:
+    SessionReader(const unsigned char* data, std::size_t size)
+        : m_data(data), m_size(size)
+    {
+    }
+
+    template <typename T>
+    bool Get(T& value)
+    {
+        return GetBytes(&value, sizeof(T));
+    }
+
+    bool GetBytes(void* target, std::size_t byteCount)
+    {
+        if (byteCount > m_size - m_offset) {
+            return false;
+        }
+        std::memcpy(target, m_data + m_offset, byteCount);
+        m_offset += byteCount;
+        return true;
+    }
+
+    std::size_t GetRemaining() const
+    {
+        return m_size - m_offset;
+    }
+
+private:
+    const unsigned char* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_offset = 0;
+};
+
+template <typename T>
+void SetValue(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// 游程记录为 uint32 长度 + 一个元素的原始字节；Word 只用于按位比较与填充，不解释数值。
+template <typename Word>
+void SetRunLengthEncoded(
+    const unsigned char* source,
+    std::size_t rawBytes,
+    std::vector<unsigned char>& encoded)
+{
+    constexpr std::size_t runBytes = sizeof(std::uint32_t) + sizeof(Word);
+    const std::size_t wordCount = rawBytes / sizeof(Word);
+    encoded.clear();
+    std::size_t index = 0;
+    while (index < wordCount) {
+        Word value;
+        std::memcpy(&value, source + index * sizeof(Word), sizeof(Word));
+        const std::size_t limit = std::min<std::size_t>(
+            wordCount, index + std::numeric_limits<std::uint32_t>::max());
+        std::size_t end = index + 1;
+        while (end < limit) {
+            Word next;
+            std::memcpy(&next, source + end * sizeof(Word), sizeof(Word));
+            if (next != value) {
+                break;
+            }
+            ++end;
+        }
+        // 编码不短于原始字节时放弃，调用方原样存储。
+        if (encoded.size() + runBytes >= rawBytes) {
+            encoded.clear();
+            return;
+        }
+        const auto runLength = static_cast<std::uint32_t>(end - index);
+        const std::size_t at = encoded.size();
+        encoded.resize(at + runBytes);
+        std::memcpy(encoded.data() + at, &runLength, sizeof(runLength));
+        std::memcpy(encoded.data() + at + sizeof(runLength), &value, sizeof(Word));
+        index = end;
+    }
+}
+
+template <typename Word>
+bool GetRunLengthDecoded(
+    const unsigned char* source,
+    std::size_t storedBytes,
+    unsigned char* target,
+    std::size_t rawBytes)
+{
+    constexpr std::size_t runBytes = sizeof(std::uint32_t) + sizeof(Word);
+    if (storedBytes % runBytes != 0) {
+        return false;
+    }
+    const std::size_t wordCount = rawBytes / sizeof(Word);
+    std::size_t written = 0;
+    for (std::size_t offset = 0; offset < storedBytes; offset += runBytes) {
+        std::uint32_t runLength = 0;
+        Word value;
+        std::memcpy(&runLength, source + offset, sizeof(runLength));
+        std::memcpy(&value, source + offset + sizeof(runLength), sizeof(Word));
+        if (runLength == 0 || runLength > wordCount - written) {
+            return false;
+        }
+        std::fill_n(reinterpret_cast<Word*>(target) + written, runLength, value);
+        written += runLength;
+    }
+    return written == wordCount;
+}
+
+// 返回 false 表示应原样存储；encoded 此时为空。
+bool SetChunkEncoded(
+    ChunkCodec codec,
+    std::size_t elementBytes,
+    const unsigned char* source,
+    std::size_t rawBytes,
+    vtkLZ4DataCompressor* compressor,
+    std::vector<unsigned char>& encoded)
+{
+    if (codec == ChunkCodec::RunLength) {
+        if (elementBytes == sizeof(std::uint8_t)) {
+            SetRunLengthEncoded<std::uint8_t>(source, rawBytes, encoded);
+        }
+        else if (elementBytes == sizeof(std::uint32_t)) {
+            SetRunLengthEncoded<std::uint32_t>(source, rawBytes, encoded);
+        }
+        else {
+            encoded.clear();
+        }
+        return !encoded.empty();
+    }
+    encoded.resize(compressor->GetMaximumCompressionSpace(rawBytes));
+    const std::size_t storedBytes = compressor->Compress(
+        source, rawBytes, encoded.data(), encoded.size());
+    if (storedBytes == 0 || storedBytes >= rawBytes) {
+        encoded.clear();
+        return false;
+    }
+    encoded.resize(storedBytes);
+    return true;
+}
+
+bool GetChunkDecoded(
+    ChunkCodec codec,
+    std::size_t elementBytes,
+    const unsigned char* source,
+    const ChunkEntry& chunk,
+    unsigned char* target,
+    vtkLZ4DataCompressor* compressor)
+{
+    const auto storedBytes = static_cast<std::size_t>(chunk.storedBytes);
+    const auto rawBytes = static_cast<std::size_t>(chunk.rawBytes);
+    if (storedBytes == rawBytes) {
+        std::memcpy(target, source, rawBytes);
+        return true;
+    }
+    if (codec == ChunkCodec::RunLength) {
+        if (elementBytes == sizeof(std::uint8_t)) {
+            return GetRunLengthDecoded<std::uint8_t>(source, storedBytes, target, rawBytes);
+        }
+        if (elementBytes == sizeof(std::uint32_t)) {
+            return GetRunLengthDecoded<std::uint32_t>(source, storedBytes, target, rawBytes);
+        }
+        return false;
+    }
+    return compressor->Uncompress(source, storedBytes, target, rawBytes) == rawBytes;
+}
+
+vtkSmartPointer<vtkImageData> BuildImage(
+    const std::array<int, 3>& dims,
+    const std::array<double, 3>& spacing,
+    const std::array<double, 3>& origin,
+    int scalarType)
+{
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(dims[0], dims[1], dims[2]);
+    image->SetSpacing(spacing[0], spacing[1], spacing[2]);
+    image->SetOrigin(origin[0], origin[1], origin[2]);
+    image->AllocateScalars(scalarType, 1);
+    return image->GetScalarPointer() ? image : nullptr;
+}
+
+// 各层的固定约束：mask 为 uchar、标签体为 int32，二者用游程编码；image 任意单分量类型用 LZ4。
+bool GetLayerValid(SessionArchive::Layer layer, int scalarType, ChunkCodec codec)
+{
+    switch (layer) {
+    case SessionArchive::Layer::Image:
+        return codec == ChunkCodec::Lz4 && vtkDataArray::GetDataTypeSize(scalarType) > 0;
+    case SessionArchive::Layer::Mask:
+        return codec == ChunkCodec::RunLength && scalarType == VTK_UNSIGNED_CHAR;
+    case SessionArchive::Layer::Label:
+        return codec == ChunkCodec::RunLength && scalarType == VTK_INT;
+    }
+    return false;
+}
+
+bool GetImageMatched(vtkImageData* image, const std::array<int, 3>& dims, int scalarType)
+{
+    if (!image || image->GetNumberOfScalarComponents() != 1
+        || !image->GetScalarPointer()
+        || (scalarType != 0 && image->GetScalarType() != scalarType)) {
+        return false;
+    }
+    int imageDims[3] = {};
+    image->GetDimensions(imageDims);
+    return imageDims[0] == dims[0] && imageDims[1] == dims[1] && imageDims[2] == dims[2];
+}
+} // namespace
+
+class SessionArchive::Impl final {
+public:
+    struct LayerTable {
+        bool isPresent = false;
+        int scalarType = 0;
+        ChunkCodec codec = ChunkCodec::Lz4;
+        std::size_t elementBytes = 0;
+        int slicesPerChunk = 0;
+        std::vector<ChunkEntry> chunks;
+    };
+
+    bool Load(const std::string& filePath);
+    bool GetSlices(Layer layer, int zBegin, int zEnd, void* target) const;
+    std::size_t GetSliceVoxels() const
+    {
+        return static_cast<std::size_t>(dims[0]) * static_cast<std::size_t>(dims[1]);
+    }
+    const LayerTable* GetLayer(Layer layer) const
+    {
+        const auto index = static_cast<std::size_t>(layer);
+        return index < layers.size() && layers[index].isPresent ? &layers[index] : nullptr;
+    }
+
+    MemMappedFile file;
+    bool isLoaded = false;
+    std::array<int, 3> dims = { 0, 0, 0 };
+    std::array<double, 3> spacing = { 1.0, 1.0, 1.0 };
+    std::array<double, 3> origin = { 0.0, 0.0, 0.0 };
+    std::array<double, 2> scalarRange = { 0.0, 0.0 };
+    std::shared_ptr<const VolumeStatistics> statistics;
+    std::vector<SessionCropOp> cropOperations;
+    std::array<LayerTable, kSessionLayerCount> layers;
+};
+
+bool SessionArchive::Impl::Load(const std::string& filePath)
+{
+    // 只映射不预取：校验只触及头与块表，块数据在 GetSlices/GetImage 解压时才缺页读入。
+    if (!file.Load(filePath, 0, MemMappedFile::Prefetch::OnDemand)) {
+        return false;
+    }
+    const auto* fileData = static_cast<const unsigned char*>(file.GetData());
+    const std::size_t fileSize = file.GetSize();
+    SessionReader reader(fileData, fileSize);
+
+    // 1. 头部与几何。
+    char magic[sizeof(kSessionMagic)] = {};
+    std::uint32_t formatVersion = 0;
+    if (!reader.GetBytes(magic, sizeof(magic))
+        || std::memcmp(magic, kSessionMagic, sizeof(magic)) != 0
+        || !reader.Get(formatVersion) || formatVersion != kSessionFormatVersion
+        || !reader.Get(dims) || !reader.Get(spacing) || !reader.Get(origin)
+        || !reader.Get(scalarRange)) {
+        return false;
+    }
+    std::size_t voxelCount = 1;
+    for (const int dim : dims) {
+        if (dim <= 0 || voxelCount > std::numeric_limits<std::size_t>::max()
+                / static_cast<std::size_t>(dim)) {
+            return false;
+        }
+        voxelCount *= static_cast<std::size_t>(dim);
+    }
+
+    // 2. 统计与裁切历史；计数先按剩余字节数设上限，损坏文件不会触发巨量分配。
+    std::uint32_t hasStatistics = 0;
+    if (!reader.Get(hasStatistics)) {
+        return false;
+    }
+    if (hasStatistics != 0) {
+        VolumeStatistics loaded;
+        std::uint32_t hasChecksum = 0;
+        std::uint64_t binCount = 0;
+        if (!reader.Get(loaded.scalarRange) || !reader.Get(loaded.binWidth)
+            || !reader.Get(loaded.checksum) || !reader.Get(hasChecksum)
+            || !reader.Get(binCount)
+            || binCount > reader.GetRemaining() / sizeof(std::uint64_t)) {
+            return false;
+        }
+        loaded.hasChecksum = hasChecksum != 0;
+        loaded.histogram.resize(static_cast<std::size_t>(binCount));
+        if (!reader.GetBytes(
+                loaded.histogram.data(), loaded.histogram.size() * sizeof(std::uint64_t))) {
+            return false;
+        }
+        statistics = std::make_shared<const VolumeStatistics>(std::move(loaded));
+    }
+    std::uint32_t cropCount = 0;
+    if (!reader.Get(cropCount)
+        || cropCount > reader.GetRemaining() / sizeof(std::uint64_t)) {
+        return false;
+    }
+    cropOperations.resize(cropCount);
+    for (auto& operation : cropOperations) {
+        if (!reader.Get(operation.operationIndex) || !reader.Get(operation.geometryType)
+            || !reader.Get(operation.removalMode)
+            || !reader.Get(operation.boxToInputModelMatrix)
+            || !reader.Get(operation.planeCenterInInputModel)
+            || !reader.Get(operation.planeNormalInInputModel)) {
+            return false;
+        }
+    }
+
+    // 3. 层描述与块表：块按整张切片覆盖 Z 轴，数据区必须落在文件内。
+    std::uint32_t layerCount = 0;
+    if (!reader.Get(layerCount) || layerCount == 0 || layerCount > kSessionLayerCount) {
+        return false;
+    }
+    const std::size_t sliceVoxels = GetSliceVoxels();
+    for (std::uint32_t index = 0; index < layerCount; ++index) {
+        std::uint32_t layerId = 0;
+        std::int32_t scalarType = 0;
+        std::uint32_t codec = 0;
+        std::int32_t slicesPerChunk = 0;
+        std::uint64_t chunkCount = 0;
+        if (!reader.Get(layerId) || layerId >= kSessionLayerCount
+            || layers[layerId].isPresent
+            || !reader.Get(scalarType) || !reader.Get(codec)
+            || !reader.Get(slicesPerChunk) || !reader.Get(chunkCount)
+            || slicesPerChunk <= 0
+            || !GetLayerValid(static_cast<Layer>(layerId), scalarType,
+                static_cast<ChunkCodec>(codec))
+            || chunkCount != static_cast<std::uint64_t>(
+                (dims[2] + slicesPerChunk - 1) / slicesPerChunk)) {
+            return false;
+        }
+        LayerTable& table = layers[layerId];
+        table.scalarType = scalarType;
+        table.codec = static_cast<ChunkCodec>(codec);
+        table.elementBytes = static_cast<std::size_t>(vtkDataArray::GetDataTypeSize(scalarType));
+        table.slicesPerChunk = slicesPerChunk;
+        table.chunks.resize(static_cast<std::size_t>(chunkCount));
+        if (table.elementBytes == 0
+            || sliceVoxels > std::numeric_limits<std::size_t>::max() / table.elementBytes
+                / static_cast<std::size_t>(dims[2])
+            || !reader.GetBytes(table.chunks.data(), table.chunks.size() * sizeof(ChunkEntry))) {
+            return false;
+        }
+        const std::uint64_t sliceBytes = sliceVoxels * table.elementBytes;
+        for (std::size_t chunkIndex = 0; chunkIndex < table.chunks.size(); ++chunkIndex) {
+            const auto& chunk = table.chunks[chunkIndex];
+            const int firstSlice = static_cast<int>(chunkIndex) * slicesPerChunk;
+            const int sliceCount = std::min(slicesPerChunk, dims[2] - firstSlice);
+            if (chunk.rawBytes != sliceBytes * static_cast<std::uint64_t>(sliceCount)
+                || chunk.storedBytes == 0 || chunk.storedBytes > chunk.rawBytes
+                || chunk.offset > fileSize
+                || chunk.storedBytes > fileSize - chunk.offset) {
+                return false;
+            }
+        }
+        table.isPresent = true;
+    }
+    if (!layers[static_cast<std::size_t>(Layer::Image)].isPresent) {
+        return false;
+    }
+    isLoaded = true;
+    return true;
+}
+
+bool SessionArchive::Impl::GetSlices(
+    Layer layer,
+    int zBegin,
+    int zEnd,
+    void* target) const
+{
+    const LayerTable* table = isLoaded ? GetLayer(layer) : nullptr;
+    if (!table || !target || zBegin < 0 || zEnd < zBegin || zEnd >= dims[2]) {
+        return false;
+    }
+    const std::size_t sliceBytes = GetSliceVoxels() * table->elementBytes;
+    const auto* fileData = static_cast<const unsigned char*>(file.GetData());
+    auto* output = static_cast<unsigned char*>(target);
+    const int firstChunk = zBegin / table->slicesPerChunk;
+    const int lastChunk = zEnd / table->slicesPerChunk;
+
+    // 完全落在请求区间内的块直接解压到目标；首尾部分覆盖的块先解压到线程缓冲再复制重叠切片。
+    vtkSMPThreadLocalObject<vtkLZ4DataCompressor> compressors;
+    vtkSMPThreadLocal<std::vector<unsigned char>> buffers;
+    std::atomic<bool> hasFailed{ false };
+    vtkSMPTools::For(firstChunk, lastChunk + 1, 1,
+        [&](vtkIdType begin, vtkIdType end) {
+            for (vtkIdType index = begin;
+                 index < end && !hasFailed.load(std::memory_order_relaxed);
+                 ++index) {
+                const auto& chunk = table->chunks[static_cast<std::size_t>(index)];
+                const int chunkFirst = static_cast<int>(index) * table->slicesPerChunk;
+                const int chunkLast = std::min(
+                    chunkFirst + table->slicesPerChunk, dims[2]) - 1;
+                const int copyFirst = std::max(chunkFirst, zBegin);
+                const int copyLast = std::min(chunkLast, zEnd);
+                unsigned char* chunkTarget =
+                    output + static_cast<std::size_t>(copyFirst - zBegin) * sliceBytes;
+                bool isDecoded = false;
+                try {
+                    if (copyFirst == chunkFirst && copyLast == chunkLast) {
+                        isDecoded = GetChunkDecoded(
+                            table->codec, table->elementBytes, fileData + chunk.offset,
+                            chunk, chunkTarget, compressors.Local());
+                    }
+                    else {
+                        auto& buffer = buffers.Local();
+                        buffer.resize(static_cast<std::size_t>(chunk.rawBytes));
+                        isDecoded = GetChunkDecoded(
+                            table->codec, table->elementBytes, fileData + chunk.offset,
+                            chunk, buffer.data(), compressors.Local());
+                        if (isDecoded) {
+                            std::memcpy(chunkTarget,
+                                buffer.data()
+                                    + static_cast<std::size_t>(copyFirst - chunkFirst) * sliceBytes,
+                                static_cast<std::size_t>(copyLast - copyFirst + 1) * sliceBytes);
+                        }
+                    }
+                }
+                catch (...) {
+                    isDecoded = false;
+                }
+                if (!isDecoded) {
+                    hasFailed.store(true, std::memory_order_relaxed);
+                }
+            }
+        });
+    return !hasFailed.load();
+}
+
+SessionArchive::SessionArchive()
+    : m_impl(std::make_unique<Impl>())
+{
+}
+
+SessionArchive::~SessionArchive() = default;
+
+bool SessionArchive::SetSession(
+    const std::string& filePath,
+    const SessionSnapshot& snapshot,
+    std::size_t chunkBytes,
+    const std::shared_ptr<ExportControl>& control)
+{
+    const ImageState& state = snapshot.state;
+    if (filePath.empty() || !GetImageMatched(state.image, state.dims, 0)
+        || (state.validityMask
+            && !GetImageMatched(state.validityMask, state.dims, VTK_UNSIGNED_CHAR))
+        || (snapshot.labelImage
+            && !GetImageMatched(snapshot.labelImage, state.dims, VTK_INT))
+        || snapshot.cropOperations.size() > std::numeric_limits<std::uint32_t>::max()) {
+        return false;
+    }
+
+    struct LayerSource {
+        Layer layer = Layer::Image;
+        vtkImageData* image = nullptr;
+        ChunkCodec codec = ChunkCodec::Lz4;
+        std::size_t elementBytes = 0;
+        int slicesPerChunk = 0;
+        std::vector<ChunkEntry> chunks;
+        std::streamoff tableOffset = 0;
+    };
+    std::vector<LayerSource> sources;
+    const auto addSource = [&](Layer layer, vtkImageData* image, ChunkCodec codec) {
+        LayerSource source;
+        source.layer = layer;
+        source.image = image;
+        source.codec = codec;
+        sources.push_back(std::move(source));
+    };
+    addSource(Layer::Image, state.image, ChunkCodec::Lz4);
+    if (state.validityMask) {
+        addSource(Layer::Mask, state.validityMask, ChunkCodec::RunLength);
+    }
+    if (snapshot.labelImage) {
+        addSource(Layer::Label, snapshot.labelImage, ChunkCodec::RunLength);
+    }
+    const std::size_t sliceVoxels =
+        static_cast<std::size_t>(state.dims[0]) * static_cast<std::size_t>(state.dims[1]);
+    const std::size_t targetChunkBytes =
+        chunkBytes > 0 ? chunkBytes : static_cast<std::size_t>(kSessionChunkBytes);
+    for (auto& source : sources) {
+        source.elementBytes = static_cast<std::size_t>(source.image->GetScalarSize());
+        const std::size_t sliceBytes = sliceVoxels * source.elementBytes;
+        source.slicesPerChunk = static_cast<int>(std::clamp<std::size_t>(
+            targetChunkBytes / std::max<std::size_t>(sliceBytes, 1),
+            1, static_cast<std::size_t>(state.dims[2])));
+        source.chunks.resize(static_cast<std::size_t>(
+            (state.dims[2] + source.slicesPerChunk - 1) / source.slicesPerChunk));
+    }
+
+    const auto archivePath = PlatformPath::GetNativePath(filePath);
+    std::error_code error;
+    if (archivePath.has_parent_path()) {
+        std::filesystem::create_directories(archivePath.parent_path(), error);
+        if (error) {
+            return false;
+        }
+    }
+    auto temporaryPath = archivePath;
+    temporaryPath += ".tmp";
+    std::size_t totalChunks = 0;
+    for (const auto& source : sources) {
+        totalChunks += source.chunks.size();
+    }
+    std::size_t doneChunks = 0;
+
+    const auto setWritten = [&]() {
+        std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            return false;
+        }
+        // 1. 头部、统计与裁切历史，字段顺序与 Impl::Load 的读取顺序一一对应。
+        stream.write(kSessionMagic, sizeof(kSessionMagic));
+        SetValue(stream, kSessionFormatVersion);
+        SetValue(stream, state.dims);
+        SetValue(stream, state.spacing);
+        SetValue(stream, state.origin);
+        SetValue(stream, state.scalarRange);
+        SetValue(stream, static_cast<std::uint32_t>(state.statistics ? 1 : 0));
+        if (state.statistics) {
+            const VolumeStatistics& statistics = *state.statistics;
+            SetValue(stream, statistics.scalarRange);
+            SetValue(stream, statistics.binWidth);
+            SetValue(stream, statistics.checksum);
+            SetValue(stream, static_cast<std::uint32_t>(statistics.hasChecksum ? 1 : 0));
+            SetValue(stream, static_cast<std::uint64_t>(statistics.histogram.size()));
+            stream.write(
+                reinterpret_cast<const char*>(statistics.histogram.data()),
+                static_cast<std::streamsize>(
+                    statistics.histogram.size() * sizeof(std::uint64_t)));
+        }
+        SetValue(stream, static_cast<std::uint32_t>(snapshot.cropOperations.size()));
+        for (const auto& operation : snapshot.cropOperations) {
+            SetValue(stream, operation.operationIndex);
+            SetValue(stream, operation.geometryType);
+            SetValue(stream, operation.removalMode);
+            SetValue(stream, operation.boxToInputModelMatrix);
+            SetValue(stream, operation.planeCenterInInputModel);
+            SetValue(stream, operation.planeNormalInInputModel);
+        }
+
+        // 2. 层描述与块表先占位，块数据落盘后回填偏移与长度。
+        SetValue(stream, static_cast<std::uint32_t>(sources.size()));
+        for (auto& source : sources) {
+            SetValue(stream, static_cast<std::uint32_t>(source.layer));
+            SetValue(stream, static_cast<std::int32_t>(source.image->GetScalarType()));
+            SetValue(stream, static_cast<std::uint32_t>(source.codec));
+            SetValue(stream, static_cast<std::int32_t>(source.slicesPerChunk));
+            SetValue(stream, static_cast<std::uint64_t>(source.chunks.size()));
+            source.tableOffset = stream.tellp();
+            stream.write(
+                reinterpret_cast<const char*>(source.chunks.data()),
+                static_cast<std::streamsize>(source.chunks.size() * sizeof(ChunkEntry)));
+        }
+
+        // 3. 各层按批并行编码、顺序写出；编码不划算的块原样存储，读取时以长度相等识别。
+        vtkSMPThreadLocalObject<vtkLZ4DataCompressor> compressors;
+        std::vector<std::vector<unsigned char>> batch(kSessionWriteBatch);
+        for (auto& source : sources) {
+            const auto* scalars =
+                static_cast<const unsigned char*>(source.image->GetScalarPointer());
+            const std::size_t sliceBytes = sliceVoxels * source.elementBytes;
+            const std::size_t layerBytes = sliceBytes * static_cast<std::size_t>(state.dims[2]);
+            const std::size_t chunkRawBytes =
+                sliceBytes * static_cast<std::size_t>(source.slicesPerChunk);
+            for (std::size_t first = 0; first < source.chunks.size() && stream;
+                 first += kSessionWriteBatch) {
+                // 批边界是唯一的取消检查点：批内块已并行编码，中途停下也只能丢弃。
+                if (control && control->GetIsCancelled()) {
+                    return false;
+                }
+                const std::size_t count =
+                    std::min(kSessionWriteBatch, source.chunks.size() - first);
+                vtkSMPTools::For(0, static_cast<vtkIdType>(count), 1,
+                    [&](vtkIdType begin, vtkIdType end) {
+                        for (vtkIdType slot = begin; slot < end; ++slot) {
+                            const std::size_t index = first + static_cast<std::size_t>(slot);
+                            const std::size_t rawOffset = index * chunkRawBytes;
+                            const std::size_t rawBytes =
+                                std::min(chunkRawBytes, layerBytes - rawOffset);
+                            (void)SetChunkEncoded(
+                                source.codec, source.elementBytes, scalars + rawOffset,
+                                rawBytes, compressors.Local(),
+                                batch[static_cast<std::size_t>(slot)]);
+                            source.chunks[index].rawBytes = rawBytes;
+                        }
+                    });
+                for (std::size_t slot = 0; slot < count; ++slot) {
+                    auto& chunk = source.chunks[first + slot];
+                    const auto& encoded = batch[slot];
+                    chunk.offset = static_cast<std::uint64_t>(stream.tellp());
+                    if (encoded.empty()) {
+                        chunk.storedBytes = chunk.rawBytes;
+                        stream.write(
+                            reinterpret_cast<const char*>(
+                                scalars + (first + slot) * chunkRawBytes),
+                            static_cast<std::streamsize>(chunk.rawBytes));
+                    }
+                    else {
+                        chunk.storedBytes = encoded.size();
+                        stream.write(
+                            reinterpret_cast<const char*>(encoded.data()),
+                            static_cast<std::streamsize>(encoded.size()));
+                    }
+                }
+                doneChunks += count;
+                // 分母多留一份给改名，归档替换完成前进度不报满。
+                if (control) {
+                    control->SetProgress(doneChunks, totalChunks + 1);
+                }
+            }
+        }
+        for (const auto& source : sources) {
+            stream.seekp(source.tableOffset);
+            stream.write(
+                reinterpret_cast<const char*>(source.chunks.data()),
+                static_cast<std::streamsize>(source.chunks.size() * sizeof(ChunkEntry)));
+        }
+        stream.flush();
+        return static_cast<bool>(stream);
+    };
+
+    bool isWritten = false;
+    try {
+        isWritten = setWritten();
+    }
+    catch (...) {
+        isWritten = false;
+    }
+    // 改名前最后检查一次取消；改名之后归档已替换旧文件，不再回退。
+    if (isWritten && control && control->GetIsCancelled()) {
+        isWritten = false;
+    }
+    if (isWritten) {
+        std::filesystem::rename(temporaryPath, archivePath, error);
+        isWritten = !error;
+    }
+    if (!isWritten) {
+        std::filesystem::remove(temporaryPath, error);
+    }
+    return isWritten;
+}
+
+bool SessionArchive::Load(const std::string& filePath)
+{
+    Clear();
+    bool isLoaded = false;
+    try {
+        isLoaded = m_impl->Load(filePath);
+    }
+    catch (...) {
+        isLoaded = false;
+    }
+    if (!isLoaded) {
+        Clear();
+    }
+    return isLoaded;
+}
+
+void SessionArchive::Clear()
+{
+    m_impl = std::make_unique<Impl>();
+}
+
+bool SessionArchive::HasLayer(Layer layer) const
+{
+    return m_impl->isLoaded && m_impl->GetLayer(layer) != nullptr;
+}
+
+const std::array<int, 3>& SessionArchive::GetDimensions() const
+{
+    return m_impl->dims;
+}
+
+const std::array<double, 3>& SessionArchive::GetSpacing() const
+{
+    return m_impl->spacing;
+}
+
+const std::array<double, 3>& SessionArchive::GetOrigin() const
+{
+    return m_impl->origin;
+}
+
+const std::array<double, 2>& SessionArchive::GetScalarRange() const
+{
+    return m_impl->scalarRange;
+}
+
+const std::shared_ptr<const VolumeStatistics>& SessionArchive::GetStatistics() const
+{
+    return m_impl->statistics;
+}
+
+const std::vector<SessionCropOp>& SessionArchive::GetCropOperations() const
+{
+    return m_impl->cropOperations;
+}
+
+int SessionArchive::GetScalarType(Layer layer) const
+{
+    const auto* table = m_impl->isLoaded ? m_impl->GetLayer(layer) : nullptr;
+    return table ? table->scalarType : 0;
+}
+
+bool SessionArchive::GetSlices(Layer layer, int zBegin, int zEnd, void* target) const
+{
+    return m_impl->GetSlices(layer, zBegin, zEnd, target);
+}
+
+vtkSmartPointer<vtkImageData> SessionArchive::GetImage(Layer layer) const
+{
+    const auto* table = m_impl->isLoaded ? m_impl->GetLayer(layer) : nullptr;
+    if (!table) {
+        return nullptr;
+    }
+    vtkSmartPointer<vtkImageData> image;
+    try {
+        image = BuildImage(
+            m_impl->dims, m_impl->spacing, m_impl->origin, table->scalarType);
+    }
+    catch (...) {
+        return nullptr;
+    }
+    if (!image
+        || !m_impl->GetSlices(layer, 0, m_impl->dims[2] - 1, image->GetScalarPointer())) {
+        return nullptr;
+    }
+    image->Modified();
+    return image;
+}
+
+bool SessionArchive::GetSession(SessionSnapshot& snapshot) const
+{
+    if (!m_impl->isLoaded) {
+        return false;
+    }
+    auto image = GetImage(Layer::Image);
+    auto validityMask = HasLayer(Layer::Mask) ? GetImage(Layer::Mask) : nullptr;
+    auto labelImage = HasLayer(Layer::Label) ? GetImage(Layer::Label) : nullptr;
+    if (!image || (HasLayer(Layer::Mask) && !validityMask)
+        || (HasLayer(Layer::Label) && !labelImage)) {
+        return false;
+    }
+    snapshot.state = ImageState{
+        std::move(image), std::move(validityMask), m_impl->dims, m_impl->spacing,
+        m_impl->origin, m_impl->scalarRange, 0, m_impl->statistics };
+    snapshot.labelImage = std::move(labelImage);
+    snapshot.cropOperations = m_impl->cropOperations;
+    return true;
+}
@@ -0,0 +1,546 @@
+#include "Data/VolumeCache.h"
+#include "MemMappedFile.h"
+#include "Platform/Path.h"
+
+#include <vtkDataArray.h>
+#include <vtkImageData.h>
+#include <vtkLZ4DataCompressor.h>
+#include <vtkSMPThreadLocalObject.h>
+#include <vtkSMPTools.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace {
+// 文件头魔数与格式版本；任一字段布局变化都必须递增版本，旧缓存随之整体失效。
+constexpr char kCacheMagic[8] = { 'M', 'V', 'V', 'C', 'V', 'O', 'L', 'C' };
+constexpr std::uint32_t kCacheFormatVersion = 1;
+// 压缩块的原始字节数：4 MiB 足以摊薄 LZ4 帧开销，又能让中等体也拆出足够的并行块。
+constexpr std::uint64_t kCacheChunkBytes = 4ULL * 1024ULL * 1024ULL;
+// 写缓存时每批并行压缩的块数；逐批落盘，压缩缓冲峰值约为 64 块而非整卷。
+constexpr std::size_t kCacheWriteBatch = 64;
+// 预览点采样步长，与流式加载预览一致。
+constexpr int kCachePreviewStride = 8;
+
+struct ChunkEntry {
+    std::uint64_t offset = 0;      // 相对文件起点的块数据偏移
+    std::uint64_t storedBytes = 0; // 落盘字节数；与 rawBytes 相等表示未压缩原样存储
+    std::uint64_t rawBytes = 0;    // 解压后字节数
+};
+
+// 缓存映射上的顺序读取游标；越界读取返回 false，字段一律 memcpy 取出，不要求对齐。
+class CacheReader final {
+public:
+    CacheReader(const unsigned char* data, std::size_t size)
+        : m_data(data), m_size(size)
+    {
+    }
+
+    template <typename T>
+    bool Get(T& value)
+    {
+        return GetBytes(&value, sizeof(T));
+    }
+
+    bool GetBytes(void* target, std::size_t byteCount)
+    {
+        const unsigned char* source = GetView(byteCount);
+        if (!source) {
+            return false;
+        }
+        std::memcpy(target, source, byteCount);
+        return true;
+    }
+
+    const unsigned char* GetView(std::size_t byteCount)
+    {
+        if (byteCount > m_size - m_offset) {
+            return nullptr;
+        }
+        const unsigned char* view = m_data + m_offset;
+        m_offset += byteCount;
+        return view;
+    }
+
+private:
+    const unsigned char* m_data = nullptr;
+    std::size_t m_size = 0;
+    std::size_t m_offset = 0;
+};
+
+template <typename T>
+void SetValue(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// 键文本：源路径 + 文件身份（mtime/字节数）+ 完整 layout；浮点以 hexfloat 书写，避免十进制舍入造成误命中。
+std::optional<std::string> GetSourceKeyUnchecked(
+    const std::string& sourcePath,
+    const VolumeLayout& layout)
+{
+    const std::filesystem::path nativePath = PlatformPath::GetNativePath(sourcePath);
+    std::error_code error;
+    const auto canonicalPath = std::filesystem::weakly_canonical(nativePath, error);
+    if (error) {
+        return std::nullopt;
+    }
+
+    std::uintmax_t byteCount = 0;
+    std::int64_t writeTime = std::numeric_limits<std::int64_t>::min();
+    std::size_t fileCount = 0;
+    const auto setFileSeen = [&](const std::filesystem::path& filePath) {
+        // 两次查询共用 error，逐个检查，避免 last_write_time 成功时掩盖 file_size 的失败。
+        const auto fileBytes = std::filesystem::file_size(filePath, error);
+        if (error) {
+            return false;
+        }
+        const auto fileTime = std::filesystem::last_write_time(filePath, error);
+        if (error) {
+            return false;
+        }
+        byteCount += fileBytes;
+        writeTime = std::max<std::int64_t>(
+            writeTime, static_cast<std::int64_t>(fileTime.time_since_epoch().count()));
+        ++fileCount;
+        return true;
+    };
+    if (std::filesystem::is_directory(canonicalPath, error)) {
+        for (const auto& entry : std::filesystem::directory_iterator(canonicalPath, error)) {
+            if (entry.is_regular_file(error) && !setFileSeen(entry.path())) {
+                return std::nullopt;
+            }
+        }
+        if (error || fileCount == 0) {
+            return std::nullopt;
+        }
+    }
+    else if (error || !setFileSeen(canonicalPath)) {
+        return std::nullopt;
+    }
+
+    const auto& dims = layout.GetDimensions();
+    const auto& spacing = layout.GetSpacing();
+    const auto& origin = layout.GetOrigin();
+    std::ostringstream key;
+    key << PlatformPath::GetUtf8Path(canonicalPath)
+        << "|files=" << fileCount
+        << "|bytes=" << byteCount
+        << "|mtime=" << writeTime
+        << "|type=" << static_cast<int>(layout.GetScalarType())
+        << "|dims=" << dims[0] << ',' << dims[1] << ',' << dims[2]
+        << std::hexfloat
+        << "|spacing=" << spacing[0] << ',' << spacing[1] << ',' << spacing[2]
+        << "|origin=" << origin[0] << ',' << origin[1] << ',' << origin[2];
+    return key.str();
+}
+
+// 目录遍历在条目变化时可能抛出；缓存只是加速路径，任何异常都按未命中处理。
+std::optional<std::string> GetSourceKey(
+    const std::string& sourcePath,
+    const VolumeLayout& layout)
+{
+    try {
+        return GetSourceKeyUnchecked(sourcePath, layout);
+    }
+    catch (...) {
+        return std::nullopt;
+    }
+}
+
+// 64 位 FNV-1a；只用于生成文件名，碰撞由文件头内保存的完整键兜底。
+std::string GetKeyFileName(const std::string& key)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char value : key) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    }
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << hash << ".mvcache";
+    return name.str();
+}
+
+// 点采样预览：预览体素 (px,py,pz) 取完整体 (s*px,s*py,s*pz)，逐元素按字节复制以兼容任意标量类型。
+std::vector<unsigned char> GetPreviewBytes(
+    const unsigned char* source,
+    const std::array<int, 3>& dims,
+    std::size_t elementBytes,
+    std::array<int, 3>& previewDims)
+{
+    const std::size_t stride = static_cast<std::size_t>(kCachePreviewStride);
+    for (int axis = 0; axis < 3; ++axis) {
+        previewDims[axis] = static_cast<int>(
+            (static_cast<std::size_t>(dims[axis]) + stride - 1) / stride);
+    }
+    const std::size_t nx = static_cast<std::size_t>(dims[0]);
+    const std::size_t sliceSize = nx * static_cast<std::size_t>(dims[1]);
+    std::vector<unsigned char> preview(
+        static_cast<std::size_t>(previewDims[0]) * static_cast<std::size_t>(previewDims[1])
+        * static_cast<std::size_t>(previewDims[2]) * elementBytes);
+    unsigned char* target = preview.data();
+    for (int pz = 0; pz < previewDims[2]; ++pz) {
+        for (int py = 0; py < previewDims[1]; ++py) {
+            const unsigned char* row = source
+                + (static_cast<std::size_t>(pz) * stride * sliceSize
+                    + static_cast<std::size_t>(py) * stride * nx) * elementBytes;
+            for (int px = 0; px < previewDims[0]; ++px) {
+                std::memcpy(
+                    target, row + static_cast<std::size_t>(px) * stride * elementBytes,
+                    elementBytes);
+                target += elementBytes;
+            }
+        }
+    }
+    return preview;
+}
+
+vtkSmartPointer<vtkImageData> BuildImage(
+    const std::array<int, 3>& dims,
+    const std::array<double, 3>& spacing,
+    const std::array<double, 3>& origin,
+    int scalarType)
+{
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(dims[0], dims[1], dims[2]);
+    image->SetSpacing(spacing[0], spacing[1], spacing[2]);
+    image->SetOrigin(origin[0], origin[1], origin[2]);
+    image->AllocateScalars(scalarType, 1);
+    return image->GetScalarPointer() ? image : nullptr;
+}
+} // namespace
+
+VolumeCache::VolumeCache(std::string directoryPath)
+    : m_directory(std::move(directoryPath))
+{
+}
+
+const std::string& VolumeCache::GetDirectory() const noexcept
+{
+    return m_directory;
+}
+
+bool VolumeCache::GetVolume(
+    const std::string& sourcePath,
+    const VolumeLayout& layout,
+    const PreviewVisit& visitPreview,
+    ImageState& state) const
+{
+    const auto key = GetSourceKey(sourcePath, layout);
+    if (!key || m_directory.empty()) {
+        return false;
+    }
+    const auto cachePath =
+        PlatformPath::GetNativePath(m_directory) / GetKeyFileName(*key);
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(cachePath, error)) {
+        return false;
+    }
+    MemMappedFile cacheFile;
+    // 各块按需缺页并在解压后即不再访问，不预读整个缓存文件。
+    if (!cacheFile.Load(
+            PlatformPath::GetUtf8Path(cachePath), 0, MemMappedFile::Prefetch::OnDemand)) {
+        return false;
+    }
+    const auto* fileData = static_cast<const unsigned char*>(cacheFile.GetData());
+    CacheReader reader(fileData, cacheFile.GetSize());
+
+    // 1. 头部：魔数、版本与完整键逐字节一致后才信任其余字段。
+    char magic[sizeof(kCacheMagic)] = {};
+    std::uint32_t formatVersion = 0;
+    std::uint32_t keyBytes = 0;
+    if (!reader.GetBytes(magic, sizeof(magic))
+        || std::memcmp(magic, kCacheMagic, sizeof(magic)) != 0
+        || !reader.Get(formatVersion) || formatVersion != kCacheFormatVersion
+        || !reader.Get(keyBytes) || keyBytes != key->size()) {
+        return false;
+    }
+    const unsigned char* storedKey = reader.GetView(keyBytes);
+    if (!storedKey || std::memcmp(storedKey, key->data(), keyBytes) != 0) {
+        return false;
+    }
+
+    // 2. 几何、范围与统计。
+    std::int32_t scalarType = 0;
+    std::array<int, 3> dims = {};
+    std::array<double, 3> spacing = {};
+    std::array<double, 3> origin = {};
+    std::array<double, 2> scalarRange = {};
+    VolumeStatistics statistics;
+    std::uint32_t hasChecksum = 0;
+    std::uint64_t binCount = 0;
+    if (!reader.Get(scalarType) || !reader.Get(dims)
+        || !reader.Get(spacing) || !reader.Get(origin)
+        || !reader.Get(scalarRange)
+        || !reader.Get(statistics.scalarRange) || !reader.Get(statistics.binWidth)
+        || !reader.Get(statistics.checksum) || !reader.Get(hasChecksum)
+        || !reader.Get(binCount)
+        || dims != layout.GetDimensions()
+        || binCount > cacheFile.GetSize() / sizeof(std::uint64_t)) {
+        return false;
+    }
+    statistics.hasChecksum = hasChecksum != 0;
+    statistics.histogram.resize(static_cast<std::size_t>(binCount));
+    if (!reader.GetBytes(
+            statistics.histogram.data(), statistics.histogram.size() * sizeof(std::uint64_t))) {
+        return false;
+    }
+    const std::size_t elementBytes =
+        static_cast<std::size_t>(vtkDataArray::GetDataTypeSize(scalarType));
+    if (elementBytes == 0) {
+        return false;
+    }
+
+    // 3. 未压缩预览：先于完整体交付，让各 view 在解压期间即可出图。
+    std::array<int, 3> previewDims = {};
+    if (!reader.Get(previewDims)) {
+        return false;
+    }
+    std::size_t previewBytes = elementBytes;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (previewDims[axis] != (dims[axis] + kCachePreviewStride - 1) / kCachePreviewStride) {
+            return false;
+        }
+        previewBytes *= static_cast<std::size_t>(previewDims[axis]);
+    }
+    const unsigned char* previewData = reader.GetView(previewBytes);
+    if (!previewData) {
+        return false;
+    }
+    if (visitPreview) {
+        const double stride = static_cast<double>(kCachePreviewStride);
+        const std::array<double, 3> previewSpacing = {
+            spacing[0] * stride, spacing[1] * stride, spacing[2] * stride
+        };
+        auto previewImage = BuildImage(previewDims, previewSpacing, origin, scalarType);
+        if (previewImage) {
+            std::memcpy(previewImage->GetScalarPointer(), previewData, previewBytes);
+            ImageState preview{
+                std::move(previewImage), {}, previewDims, previewSpacing, origin,
+                scalarRange, 0 };
+            preview.isPreview = true;
+            visitPreview(std::move(preview));
+        }
+    }
+
+    // 4. 块表：每块偏移与长度必须落在文件内，原始字节之和必须等于整卷字节数。
+    std::uint64_t chunkBytes = 0;
+    std::uint64_t chunkCount = 0;
+    if (!reader.Get(chunkBytes) || !reader.Get(chunkCount)
+        || chunkBytes == 0
+        || chunkCount > cacheFile.GetSize() / sizeof(ChunkEntry)) {
+        return false;
+    }
+    std::vector<ChunkEntry> chunks(static_cast<std::size_t>(chunkCount));
+    if (!reader.GetBytes(chunks.data(), chunks.size() * sizeof(ChunkEntry))) {
+        return false;
+    }
+    const std::uint64_t volumeBytes =
+        static_cast<std::uint64_t>(layout.GetVoxelCount()) * elementBytes;
+    std::uint64_t rawOffset = 0;
+    for (const auto& chunk : chunks) {
+        if (chunk.rawBytes == 0
+            || chunk.rawBytes != std::min<std::uint64_t>(chunkBytes, volumeBytes - rawOffset)
+            || chunk.offset > cacheFile.GetSize()
+            || chunk.storedBytes > cacheFile.GetSize() - chunk.offset) {
+            return false;
+        }
+        rawOffset += chunk.rawBytes;
+    }
+    if (rawOffset != volumeBytes) {
+        return false;
+    }
+
+    // 5. 各块互不重叠，按块并行解压到新分配的 scalar；每线程独占一个压缩器实例。
+    auto image = BuildImage(dims, spacing, origin, scalarType);
+    if (!image) {
+        return false;
+    }
+    auto* target = static_cast<unsigned char*>(image->GetScalarPointer());
+    vtkSMPThreadLocalObject<vtkLZ4DataCompressor> compressors;
+    std::atomic<bool> hasFailed{ false };
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), 1,
+        [&](vtkIdType begin, vtkIdType end) {
+            for (vtkIdType index = begin; index < end; ++index) {
+                const auto& chunk = chunks[static_cast<std::size_t>(index)];
+                unsigned char* chunkTarget =
+                    target + static_cast<std::size_t>(index) * chunkBytes;
+                const unsigned char* chunkSource = fileData + chunk.offset;
+                if (chunk.storedBytes == chunk.rawBytes) {
+                    std::memcpy(chunkTarget, chunkSource, static_cast<std::size_t>(chunk.rawBytes));
+                }
+                else if (compressors.Local()->Uncompress(
+                        chunkSource, static_cast<std::size_t>(chunk.storedBytes),
+                        chunkTarget, static_cast<std::size_t>(chunk.rawBytes))
+                    != chunk.rawBytes) {
+                    hasFailed.store(true, std::memory_order_relaxed);
+                }
+            }
+        });
+    if (hasFailed.load()) {
+        return false;
+    }
+    image->Modified();
+
+    state = ImageState{
+        std::move(image), {}, dims, spacing, origin, scalarRange, 0,
+        statistics.histogram.empty()
+            ? nullptr
+            : std::make_shared<const VolumeStatistics>(std::move(statistics)) };
+    return true;
+}
+
+bool VolumeCache::SetVolume(
+    const std::string& sourcePath,
+    const VolumeLayout& layout,
+    const ImageState& state) const
+{
+    vtkImageData* image = state.image;
+    if (!image || image->GetNumberOfScalarComponents() != 1
+        || !image->GetScalarPointer() || state.dims != layout.GetDimensions()
+        || m_directory.empty()) {
+        return false;
+    }
+    const auto key = GetSourceKey(sourcePath, layout);
+    if (!key) {
+        return false;
+    }
+    const int scalarType = image->GetScalarType();
+    const std::size_t elementBytes = static_cast<std::size_t>(image->GetScalarSize());
+    const std::uint64_t volumeBytes =
+        static_cast<std::uint64_t>(layout.GetVoxelCount()) * elementBytes;
+    const auto* source = static_cast<const unsigned char*>(image->GetScalarPointer());
+
+    const auto directory = PlatformPath::GetNativePath(m_directory);
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        return false;
+    }
+    const auto cachePath = directory / GetKeyFileName(*key);
+    auto temporaryPath = cachePath;
+    temporaryPath += ".tmp";
+
+    const auto setWritten = [&]() {
+        std::ofstream stream(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            return false;
+        }
+        // 1. 头部、统计与预览，字段顺序与 GetVolume 的读取顺序一一对应。
+        stream.write(kCacheMagic, sizeof(kCacheMagic));
+        SetValue(stream, kCacheFormatVersion);
+        SetValue(stream, static_cast<std::uint32_t>(key->size()));
+        stream.write(key->data(), static_cast<std::streamsize>(key->size()));
+        SetValue(stream, static_cast<std::int32_t>(scalarType));
+        SetValue(stream, state.dims);
+        SetValue(stream, state.spacing);
+        SetValue(stream, state.origin);
+        SetValue(stream, state.scalarRange);
+        const VolumeStatistics emptyStatistics;
+        const VolumeStatistics& statistics =
+            state.statistics ? *state.statistics : emptyStatistics;
+        SetValue(stream, statistics.scalarRange);
+        SetValue(stream, statistics.binWidth);
+        SetValue(stream, statistics.checksum);
+        SetValue(stream, static_cast<std::uint32_t>(statistics.hasChecksum ? 1 : 0));
+        SetValue(stream, static_cast<std::uint64_t>(statistics.histogram.size()));
+        stream.write(
+            reinterpret_cast<const char*>(statistics.histogram.data()),
+            static_cast<std::streamsize>(statistics.histogram.size() * sizeof(std::uint64_t)));
+
+        std::array<int, 3> previewDims = {};
+        const auto preview = GetPreviewBytes(source, state.dims, elementBytes, previewDims);
+        SetValue(stream, previewDims);
+        stream.write(
+            reinterpret_cast<const char*>(preview.data()),
+            static_cast<std::streamsize>(preview.size()));
+
+        // 2. 块表先占位，块数据落盘后回填偏移与长度。
+        const std::uint64_t chunkCount = (volumeBytes + kCacheChunkBytes - 1) / kCacheChunkBytes;
+        SetValue(stream, kCacheChunkBytes);
+        SetValue(stream, chunkCount);
+        const std::streamoff tableOffset = stream.tellp();
+        std::vector<ChunkEntry> chunks(static_cast<std::size_t>(chunkCount));
+        stream.write(
+            reinterpret_cast<const char*>(chunks.data()),
+            static_cast<std::streamsize>(chunks.size() * sizeof(ChunkEntry)));
+
+        // 3. 按批并行压缩、顺序写出；压缩不划算的块原样存储，读取时以长度相等识别。
+        vtkSMPThreadLocalObject<vtkLZ4DataCompressor> compressors;
+        std::vector<std::vector<unsigned char>> batch(kCacheWriteBatch);
+        for (std::size_t first = 0; first < chunks.size() && stream; first += kCacheWriteBatch) {
+            const std::size_t count = std::min(kCacheWriteBatch, chunks.size() - first);
+            vtkSMPTools::For(0, static_cast<vtkIdType>(count), 1,
+                [&](vtkIdType begin, vtkIdType end) {
+                    for (vtkIdType slot = begin; slot < end; ++slot) {
+                        const std::size_t index = first + static_cast<std::size_t>(slot);
+                        const std::uint64_t rawOffset = index * kCacheChunkBytes;
+                        const auto rawBytes = static_cast<std::size_t>(
+                            std::min<std::uint64_t>(kCacheChunkBytes, volumeBytes - rawOffset));
+                        auto* compressor = compressors.Local();
+                        auto& compressed = batch[static_cast<std::size_t>(slot)];
+                        compressed.resize(compressor->GetMaximumCompressionSpace(rawBytes));
+                        const std::size_t storedBytes = compressor->Compress(
+                            source + rawOffset, rawBytes, compressed.data(), compressed.size());
+                        if (storedBytes == 0 || storedBytes >= rawBytes) {
+                            compressed.clear();
+                        }
+                        else {
+                            compressed.resize(storedBytes);
+                        }
+                        chunks[index].rawBytes = rawBytes;
+                    }
+                });
+            for (std::size_t slot = 0; slot < count; ++slot) {
+                auto& chunk = chunks[first + slot];
+                const auto& compressed = batch[slot];
+                chunk.offset = static_cast<std::uint64_t>(stream.tellp());
+                if (compressed.empty()) {
+                    chunk.storedBytes = chunk.rawBytes;
+                    stream.write(
+                        reinterpret_cast<const char*>(source + (first + slot) * kCacheChunkBytes),
+                        static_cast<std::streamsize>(chunk.rawBytes));
+                }
+                else {
+                    chunk.storedBytes = compressed.size();
+                    stream.write(
+                        reinterpret_cast<const char*>(compressed.data()),
+                        static_cast<std::streamsize>(compressed.size()));
+                }
+            }
+        }
+        stream.seekp(tableOffset);
+        stream.write(
+            reinterpret_cast<const char*>(chunks.data()),
+            static_cast<std::streamsize>(chunks.size() * sizeof(ChunkEntry)));
+        stream.flush();
+        return static_cast<bool>(stream);
+    };
+
+    bool isWritten = false;
+    try {
+        isWritten = setWritten();
+    }
+    catch (...) {
+        isWritten = false;
+    }
+    if (isWritten) {
+        std::filesystem::rename(temporaryPath, cachePath, error);
+        isWritten = !error;
+    }
+    if (!isWritten) {
+        std::filesystem::remove(temporaryPath, error);
+    }
+    return isWritten;
+}
@@ -0,0 +1,645 @@
+#include "Data/VolumeReorder.h"
+#include "Data/VolumeTypes.h"
+
+#include <vtkSMPTools.h>
+#include <vtkType.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#define MVVCVTK_REORDER_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MVVCVTK_REORDER_SSE2 1
+#include <emmintrin.h>
+#if defined(__SSSE3__) || defined(__AVX__)
+#define MVVCVTK_REORDER_SSSE3 1
+#include <tmmintrin.h>
+#endif
+#endif
+
+namespace {
+// 单个并行块的字节数；块内 src 反向、dst 正向都是连续流，256 KiB 可同时驻留在 L2。
+constexpr std::size_t kChunkBytes = 256ULL * 1024ULL;
+
+// 编译期尺寸的非 SIMD 像素（多分量 TIFF）；赋值即定长拷贝，避免运行时 memcpy 尺寸分派。
+template <std::size_t Bytes>
+struct PixelBytes {
+    unsigned char bytes[Bytes];
+};
+
+template <std::size_t Bytes>
+struct ElementOf {
+    using Type = PixelBytes<Bytes>;
+};
+template <> struct ElementOf<1> { using Type = std::uint8_t; };
+template <> struct ElementOf<2> { using Type = std::uint16_t; };
+template <> struct ElementOf<4> { using Type = std::uint32_t; };
+template <> struct ElementOf<8> { using Type = std::uint64_t; };
+
+#if defined(MVVCVTK_REORDER_AVX2)
+using SimdVector = __m256i;
+constexpr std::size_t kSimdBytes = 32;
+
+template <std::size_t Bytes>
+constexpr bool GetSimdReady() { return Bytes == 1 || Bytes == 2 || Bytes == 4 || Bytes == 8; }
+
+inline SimdVector GetSimdLoad(const void* source)
+{
+    return _mm256_loadu_si256(static_cast<const __m256i*>(source));
+}
+
+inline void SetSimdStore(void* target, SimdVector value)
+{
+    _mm256_storeu_si256(static_cast<__m256i*>(target), value);
+}
+
+// 256 位整体倒序：先在 128 位 lane 内倒序，再交换两个 lane。
+template <std::size_t Bytes>
+inline SimdVector GetSimdReversed(SimdVector value)
+{
+    if constexpr (Bytes == 1) {
+        const __m256i lanes = _mm256_setr_epi8(
+            15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+            15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        return _mm256_permute4x64_epi64(
+            _mm256_shuffle_epi8(value, lanes), 0x4E);
+    }
+    else if constexpr (Bytes == 2) {
+        const __m256i lanes = _mm256_setr_epi8(
+            14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+            14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+        return _mm256_permute4x64_epi64(
+            _mm256_shuffle_epi8(value, lanes), 0x4E);
+    }
+    else if constexpr (Bytes == 4) {
+        return _mm256_permutevar8x32_epi32(
+            value, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    }
+    else {
+        return _mm256_permute4x64_epi64(value, 0x1B);
+    }
+}
+#elif defined(MVVCVTK_REORDER_SSE2)
+using SimdVector = __m128i;
+constexpr std::size_t kSimdBytes = 16;
+
+template <std::size_t Bytes>
+constexpr bool GetSimdReady()
+{
+#if defined(MVVCVTK_REORDER_SSSE3)
+    return Bytes == 1 || Bytes == 2 || Bytes == 4 || Bytes == 8;
+#else
+    // 纯 SSE2 没有字节级 shuffle，单字节元素走标量尾循环。
+    return Bytes == 2 || Bytes == 4 || Bytes == 8;
+#endif
+}
+
+inline SimdVector GetSimdLoad(const void* source)
+{
+    return _mm_loadu_si128(static_cast<const __m128i*>(source));
+}
+
+inline void SetSimdStore(void* target, SimdVector value)
+{
+    _mm_storeu_si128(static_cast<__m128i*>(target), value);
+}
+
+template <std::size_t Bytes>
+inline SimdVector GetSimdReversed(SimdVector value)
+{
+    if constexpr (Bytes == 1) {
+#if defined(MVVCVTK_REORDER_SSSE3)
+        return _mm_shuffle_epi8(value, _mm_setr_epi8(
+            15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+#else
+        return value;
+#endif
+    }
+    else if constexpr (Bytes == 2) {
+        value = _mm_shufflelo_epi16(value, 0x1B);
+        value = _mm_shufflehi_epi16(value, 0x1B);
+        return _mm_shuffle_epi32(value, 0x4E);
+    }
+    else if constexpr (Bytes == 4) {
+        return _mm_shuffle_epi32(value, 0x1B);
+    }
+    else {
+        return _mm_shuffle_epi32(value, 0x4E);
+    }
+}
+#else
+template <std::size_t Bytes>
+constexpr bool GetSimdReady() { return false; }
+#endif
+
+// dst[i] = src[count - 1 - i]；src 从尾部向前、dst 从头部向后，各自保持连续访存。
+template <std::size_t Bytes>
+void SetReversedCopy(
+    const typename ElementOf<Bytes>::Type* src,
+    typename ElementOf<Bytes>::Type* dst,
+    std::size_t count) noexcept
+{
+    std::size_t index = 0;
+#if defined(MVVCVTK_REORDER_AVX2) || defined(MVVCVTK_REORDER_SSE2)
+    if constexpr (GetSimdReady<Bytes>()) {
+        constexpr std::size_t width = kSimdBytes / Bytes;
+        for (; index + width <= count; index += width) {
+            SetSimdStore(dst + index, GetSimdReversed<Bytes>(
+                GetSimdLoad(src + count - index - width)));
+        }
+    }
+#endif
+    for (; index < count; ++index) {
+        dst[index] = src[count - 1 - index];
+    }
+}
+
+// 交换 front[i] 与 backEnd[-1-i]，i ∈ [0,count)；调用方保证两段不重叠。
+template <std::size_t Bytes>
+void SetReversedSwap(
+    typename ElementOf<Bytes>::Type* front,
+    typename ElementOf<Bytes>::Type* backEnd,
+    std::size_t count) noexcept
+{
+    std::size_t index = 0;
+#if defined(MVVCVTK_REORDER_AVX2) || defined(MVVCVTK_REORDER_SSE2)
+    if constexpr (GetSimdReady<Bytes>()) {
+        constexpr std::size_t width = kSimdBytes / Bytes;
+        for (; index + width <= count; index += width) {
+            auto* back = backEnd - index - width;
+            const SimdVector head = GetSimdLoad(front + index);
+            const SimdVector tail = GetSimdLoad(back);
+            SetSimdStore(front + index, GetSimdReversed<Bytes>(tail));
+            SetSimdStore(back, GetSimdReversed<Bytes>(head));
+        }
+    }
+#endif
+    for (; index < count; ++index) {
+        std::swap(front[index], backEnd[-1 - static_cast<std::ptrdiff_t>(index)]);
+    }
+}
+
+std::size_t GetChunkSize(std::size_t elementBytes) noexcept
+{
+    return std::max<std::size_t>(1, kChunkBytes / elementBytes);
+}
+
+// 原地路径按前半层切块；单元素层也保留一个工作项，使访问回调覆盖到中点。
+std::size_t GetChunkCount(std::size_t length, std::size_t chunkSize) noexcept
+{
+    return std::max<std::size_t>(1, (length + chunkSize - 1) / chunkSize);
+}
+
+// 块写完后数据仍在缓存内，由 visit(item, offset, count) 顺带消费；offset 为全卷元素下标。
+struct NoChunkVisit {
+    void operator()(std::size_t, std::size_t, std::size_t) const noexcept {}
+};
+
+// 工作项 = (Z 层, 层内块)；薄体（如单层 TIFF）也能按块铺满线程池。
+template <std::size_t Bytes, typename Visit = NoChunkVisit>
+void SetSlicesReversed(
+    const void* src,
+    void* dst,
+    std::size_t sliceSize,
+    std::size_t sliceCount,
+    Visit&& visit = Visit{})
+{
+    using Element = typename ElementOf<Bytes>::Type;
+    static_assert(sizeof(Element) == Bytes, "reorder element must be tightly packed");
+    const auto* srcBase = static_cast<const Element*>(src);
+    auto* dstBase = static_cast<Element*>(dst);
+    const std::size_t chunkSize = GetChunkSize(Bytes);
+    const std::size_t chunkCount = GetChunkCount(sliceSize, chunkSize);
+    vtkSMPTools::For(
+        vtkIdType{ 0 },
+        static_cast<vtkIdType>(chunkCount * sliceCount),
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType item = first; item < last; ++item) {
+                const std::size_t itemIndex = static_cast<std::size_t>(item);
+                const std::size_t z = itemIndex / chunkCount;
+                const std::size_t begin = (itemIndex % chunkCount) * chunkSize;
+                const std::size_t end = std::min(sliceSize, begin + chunkSize);
+                const Element* srcSlice = srcBase + z * sliceSize;
+                Element* dstSlice = dstBase + z * sliceSize;
+                // dst [begin,end) 对应 src [sliceSize-end, sliceSize-begin) 的倒序。
+                SetReversedCopy<Bytes>(
+                    srcSlice + (sliceSize - end), dstSlice + begin, end - begin);
+                visit(itemIndex, z * sliceSize + begin, end - begin);
+            }
+        });
+}
+
+template <std::size_t Bytes, typename Visit = NoChunkVisit>
+void SetSlicesReversedInPlace(
+    void* data,
+    std::size_t sliceSize,
+    std::size_t sliceCount,
+    Visit&& visit = Visit{})
+{
+    using Element = typename ElementOf<Bytes>::Type;
+    static_assert(sizeof(Element) == Bytes, "reorder element must be tightly packed");
+    auto* base = static_cast<Element*>(data);
+    // 原地倒序只需遍历前半层，每个前半元素与其镜像交换；奇数长度的中点保持不动。
+    const std::size_t halfSize = sliceSize / 2;
+    const bool hasMiddle = (sliceSize % 2) != 0;
+    const std::size_t chunkSize = GetChunkSize(Bytes);
+    const std::size_t chunkCount = GetChunkCount(halfSize, chunkSize);
+    vtkSMPTools::For(
+        vtkIdType{ 0 },
+        static_cast<vtkIdType>(chunkCount * sliceCount),
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType item = first; item < last; ++item) {
+                const std::size_t itemIndex = static_cast<std::size_t>(item);
+                const std::size_t z = itemIndex / chunkCount;
+                const std::size_t chunk = itemIndex % chunkCount;
+                const std::size_t begin = std::min(halfSize, chunk * chunkSize);
+                const std::size_t end = std::min(halfSize, begin + chunkSize);
+                Element* slice = base + z * sliceSize;
+                SetReversedSwap<Bytes>(
+                    slice + begin, slice + (sliceSize - begin), end - begin);
+                const std::size_t sliceOffset = z * sliceSize;
+                if (end > begin) {
+                    visit(itemIndex, sliceOffset + begin, end - begin);
+                    visit(itemIndex, sliceOffset + sliceSize - end, end - begin);
+                }
+                if (hasMiddle && chunk + 1 == chunkCount) {
+                    visit(itemIndex, sliceOffset + halfSize, std::size_t{ 1 });
+                }
+            }
+        });
+}
+
+// 非常见像素尺寸保留运行时 memcpy，但仍按层并行。
+void SetSlicesReversedBytes(
+    const void* src,
+    void* dst,
+    std::size_t sliceSize,
+    std::size_t sliceCount,
+    std::size_t elementBytes)
+{
+    const auto* srcBase = static_cast<const unsigned char*>(src);
+    auto* dstBase = static_cast<unsigned char*>(dst);
+    const std::size_t sliceBytes = sliceSize * elementBytes;
+    vtkSMPTools::For(
+        vtkIdType{ 0 },
+        static_cast<vtkIdType>(sliceCount),
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType z = first; z < last; ++z) {
+                const auto* srcSlice = srcBase + static_cast<std::size_t>(z) * sliceBytes;
+                auto* dstSlice = dstBase + static_cast<std::size_t>(z) * sliceBytes;
+                for (std::size_t index = 0; index < sliceSize; ++index) {
+                    std::memcpy(
+                        dstSlice + index * elementBytes,
+                        srcSlice + (sliceSize - 1 - index) * elementBytes,
+                        elementBytes);
+                }
+            }
+        });
+}
+
+bool GetSliceLayout(
+    const std::array<std::size_t, 3>& dims,
+    std::size_t elementBytes,
+    std::size_t& sliceSize,
+    std::size_t& sliceCount)
+{
+    if (dims[0] == 0 || dims[1] == 0 || dims[2] == 0 || elementBytes == 0
+        || dims[0] > std::numeric_limits<std::size_t>::max() / dims[1]) {
+        return false;
+    }
+    sliceSize = dims[0] * dims[1];
+    sliceCount = dims[2];
+    if (sliceSize > std::numeric_limits<std::size_t>::max() / sliceCount) {
+        return false;
+    }
+    const std::size_t total = sliceSize * sliceCount;
+    return total <= std::numeric_limits<std::size_t>::max() / elementBytes
+        && total <= static_cast<std::size_t>(std::numeric_limits<vtkIdType>::max());
+}
+
+// 单个工作项的统计片段；min/max 以 double 归并，int32/uint32/float/double 均可精确表示。
+struct ChunkSummary {
+    double minValue = std::numeric_limits<double>::infinity();
+    double maxValue = -std::numeric_limits<double>::infinity();
+    std::uint64_t checksum = 0;
+};
+
+// 位置相关的逐元素混合后求和：加法满足交换律，校验和只取决于写出的 RAS 体，
+// 与块划分、线程数以及原地/复制路径无关。
+inline std::uint64_t GetElementHash(std::uint64_t bits, std::size_t index) noexcept
+{
+    std::uint64_t value =
+        bits ^ (static_cast<std::uint64_t>(index) * 0x9E3779B97F4A7C15ULL);
+    value *= 0xBF58476D1CE4E5B9ULL;
+    return value ^ (value >> 31);
+}
+
+template <typename T>
+void SetChunkSummary(
+    const T* values,
+    std::size_t offset,
+    std::size_t count,
+    bool hasChecksum,
+    ChunkSummary& summary) noexcept
+{
+    using Bits = typename ElementOf<sizeof(T)>::Type;
+    // 浮点比较天然跳过 NaN，与 vtkDataArray::GetRange 的语义一致；无穷值计入范围。
+    T minValue = std::numeric_limits<T>::has_infinity
+        ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    T maxValue = std::numeric_limits<T>::has_infinity
+        ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+    const T* chunk = values + offset;
+    for (std::size_t index = 0; index < count; ++index) {
+        const T value = chunk[index];
+        if (value < minValue) minValue = value;
+        if (value > maxValue) maxValue = value;
+    }
+    if (!(minValue > maxValue)) {
+        summary.minValue = std::min(summary.minValue, static_cast<double>(minValue));
+        summary.maxValue = std::max(summary.maxValue, static_cast<double>(maxValue));
+    }
+    if (hasChecksum) {
+        std::uint64_t checksum = 0;
+        for (std::size_t index = 0; index < count; ++index) {
+            Bits bits{};
+            std::memcpy(&bits, chunk + index, sizeof(T));
+            checksum += GetElementHash(static_cast<std::uint64_t>(bits), offset + index);
+        }
+        summary.checksum += checksum;
+    }
+}
+
+// 直方图需要全局范围，只能在翻转归并后再扫一遍；按连续区段分组累计，组内独占 bin 数组，
+// 整数计数求和与调度顺序无关。bin 规则与 vtkImageAccumulate 相同：floor((v-origin)/spacing)。
+template <typename T>
+void SetHistogram(
+    const T* values,
+    std::size_t valueCount,
+    VolumeStatistics& statistics)
+{
+    const int binCount = VolumeStatistics::kHistogramBinCount;
+    const double origin = statistics.scalarRange[0];
+    const double rangeWidth = statistics.scalarRange[1] - statistics.scalarRange[0];
+    double binSpacing = 1.0;
+    statistics.binWidth = 0.0;
+    if (rangeWidth > 0.0 && binCount == 1) {
+        statistics.binWidth = std::nextafter(
+            rangeWidth, std::numeric_limits<double>::infinity());
+        binSpacing = statistics.binWidth;
+    }
+    else if (rangeWidth > 0.0) {
+        statistics.binWidth = rangeWidth / static_cast<double>(binCount - 1);
+        binSpacing = statistics.binWidth;
+    }
+
+    const std::size_t groupElements = GetChunkSize(sizeof(T));
+    const std::size_t groupLimit = std::max<std::size_t>(
+        1, 2 * static_cast<std::size_t>(std::thread::hardware_concurrency()));
+    const std::size_t groupCount = std::min(
+        groupLimit, GetChunkCount(valueCount, groupElements));
+    std::vector<std::vector<std::uint64_t>> groupBins(
+        groupCount, std::vector<std::uint64_t>(static_cast<std::size_t>(binCount), 0));
+    vtkSMPTools::For(
+        vtkIdType{ 0 },
+        static_cast<vtkIdType>(groupCount),
+        vtkIdType{ 1 },
+        [&](vtkIdType first, vtkIdType last) {
+            for (vtkIdType group = first; group < last; ++group) {
+                const std::size_t groupIndex = static_cast<std::size_t>(group);
+                const std::size_t begin = valueCount * groupIndex / groupCount;
+                const std::size_t end = valueCount * (groupIndex + 1) / groupCount;
+                auto& bins = groupBins[groupIndex];
+                for (std::size_t index = begin; index < end; ++index) {
+                    const double position =
+                        (static_cast<double>(values[index]) - origin) / binSpacing;
+                    if (position >= 0.0 && position < static_cast<double>(binCount)) {
+                        ++bins[static_cast<std::size_t>(position)];
+                    }
+                }
+            }
+        });
+
+    statistics.histogram.assign(static_cast<std::size_t>(binCount), 0);
+    for (const auto& bins : groupBins) {
+        for (std::size_t bin = 0; bin < bins.size(); ++bin) {
+            statistics.histogram[bin] += bins[bin];
+        }
+    }
+}
+
+// 归并块统计；没有非 NaN 值或范围含无穷时只翻转，不发布直方图（与 HistogramConverter 拒绝条件一致）。
+template <typename T>
+void SetStatistics(
+    const T* values,
+    std::size_t valueCount,
+    const std::vector<ChunkSummary>& summaries,
+    bool hasChecksum,
+    VolumeStatistics& statistics)
+{
+    statistics = VolumeStatistics{};
+    ChunkSummary total;
+    for (const auto& summary : summaries) {
+        total.minValue = std::min(total.minValue, summary.minValue);
+        total.maxValue = std::max(total.maxValue, summary.maxValue);
+        total.checksum += summary.checksum;
+    }
+    statistics.checksum = total.checksum;
+    statistics.hasChecksum = hasChecksum;
+    if (!std::isfinite(total.minValue) || !std::isfinite(total.maxValue)
+        || total.maxValue < total.minValue) {
+        return;
+    }
+    statistics.scalarRange = { total.minValue, total.maxValue };
+    SetHistogram(values, valueCount, statistics);
+}
+
+// 单分量 VTK 标量类型到 C++ 类型的分派；64 位整数无法用 double 精确归并，暂不支持。
+template <typename Fn>
+bool GetScalarDispatched(int scalarType, Fn&& fn)
+{
+    switch (scalarType) {
+    case VTK_FLOAT: fn(float{}); return true;
+    case VTK_DOUBLE: fn(double{}); return true;
+    case VTK_UNSIGNED_CHAR: fn(std::uint8_t{}); return true;
+    case VTK_SIGNED_CHAR: fn(std::int8_t{}); return true;
+    case VTK_CHAR: fn(char{}); return true;
+    case VTK_UNSIGNED_SHORT: fn(std::uint16_t{}); return true;
+    case VTK_SHORT: fn(std::int16_t{}); return true;
+    case VTK_UNSIGNED_INT: fn(std::uint32_t{}); return true;
+    case VTK_INT: fn(std::int32_t{}); return true;
+    default: return false;
+    }
+}
+} // namespace
+
+bool VolumeReorder::SetRasScalars(
+    const void* src,
+    void* dst,
+    const std::array<std::size_t, 3>& dims,
+    std::size_t elementBytes)
+{
+    std::size_t sliceSize = 0;
+    std::size_t sliceCount = 0;
+    if (!src || !dst || src == dst
+        || !GetSliceLayout(dims, elementBytes, sliceSize, sliceCount)) {
+        return false;
+    }
+
+    switch (elementBytes) {
+    case 1: SetSlicesReversed<1>(src, dst, sliceSize, sliceCount); break;
+    case 2: SetSlicesReversed<2>(src, dst, sliceSize, sliceCount); break;
+    case 3: SetSlicesReversed<3>(src, dst, sliceSize, sliceCount); break;
+    case 4: SetSlicesReversed<4>(src, dst, sliceSize, sliceCount); break;
+    case 6: SetSlicesReversed<6>(src, dst, sliceSize, sliceCount); break;
+    case 8: SetSlicesReversed<8>(src, dst, sliceSize, sliceCount); break;
+    case 12: SetSlicesReversed<12>(src, dst, sliceSize, sliceCount); break;
+    case 16: SetSlicesReversed<16>(src, dst, sliceSize, sliceCount); break;
+    default:
+        SetSlicesReversedBytes(src, dst, sliceSize, sliceCount, elementBytes);
+        break;
+    }
+    return true;
+}
+
+bool VolumeReorder::SetRasScalarsInPlace(
+    void* data,
+    const std::array<std::size_t, 3>& dims,
+    std::size_t elementBytes)
+{
+    std::size_t sliceSize = 0;
+    std::size_t sliceCount = 0;
+    if (!data || !GetSliceLayout(dims, elementBytes, sliceSize, sliceCount)) {
+        return false;
+    }
+
+    switch (elementBytes) {
+    case 1: SetSlicesReversedInPlace<1>(data, sliceSize, sliceCount); break;
+    case 2: SetSlicesReversedInPlace<2>(data, sliceSize, sliceCount); break;
+    case 3: SetSlicesReversedInPlace<3>(data, sliceSize, sliceCount); break;
+    case 4: SetSlicesReversedInPlace<4>(data, sliceSize, sliceCount); break;
+    case 6: SetSlicesReversedInPlace<6>(data, sliceSize, sliceCount); break;
+    case 8: SetSlicesReversedInPlace<8>(data, sliceSize, sliceCount); break;
+    case 12: SetSlicesReversedInPlace<12>(data, sliceSize, sliceCount); break;
+    case 16: SetSlicesReversedInPlace<16>(data, sliceSize, sliceCount); break;
+    default: {
+        // 非常见尺寸的原地翻转没有热点需求；逐层借临时缓冲复用复制内核。
+        const std::size_t sliceBytes = sliceSize * elementBytes;
+        std::vector<unsigned char> sliceCopy(sliceBytes);
+        auto* base = static_cast<unsigned char*>(data);
+        for (std::size_t z = 0; z < sliceCount; ++z) {
+            std::memcpy(sliceCopy.data(), base + z * sliceBytes, sliceBytes);
+            SetSlicesReversedBytes(
+                sliceCopy.data(), base + z * sliceBytes, sliceSize, 1, elementBytes);
+        }
+        break;
+    }
+    }
+    return true;
+}
+
+bool VolumeReorder::SetRasScalars(
+    const void* src,
+    void* dst,
+    const std::array<std::size_t, 3>& dims,
+    int scalarType,
+    bool hasChecksum,
+    VolumeStatistics& statistics)
+{
+    std::size_t sliceSize = 0;
+    std::size_t sliceCount = 0;
+    bool isSupported = false;
+    (void)GetScalarDispatched(scalarType, [&](auto value) {
+        using T = decltype(value);
+        isSupported = src && dst && src != dst
+            && GetSliceLayout(dims, sizeof(T), sliceSize, sliceCount);
+        if (!isSupported) {
+            return;
+        }
+        const std::size_t itemCount =
+            GetChunkCount(sliceSize, GetChunkSize(sizeof(T))) * sliceCount;
+        std::vector<ChunkSummary> summaries(itemCount);
+        const auto* values = static_cast<const T*>(dst);
+        SetSlicesReversed<sizeof(T)>(src, dst, sliceSize, sliceCount,
+            [&](std::size_t item, std::size_t offset, std::size_t count) {
+                SetChunkSummary(values, offset, count, hasChecksum, summaries[item]);
+            });
+        SetStatistics(values, sliceSize * sliceCount, summaries, hasChecksum, statistics);
+    });
+    return isSupported;
+}
+
+bool VolumeReorder::SetRasScalarsInPlace(
+    void* data,
+    const std::array<std::size_t, 3>& dims,
+    int scalarType,
+    bool hasChecksum,
+    VolumeStatistics& statistics)
+{
+    std::size_t sliceSize = 0;
+    std::size_t sliceCount = 0;
+    bool isSupported = false;
+    (void)GetScalarDispatched(scalarType, [&](auto value) {
+        using T = decltype(value);
+        isSupported = data
+            && GetSliceLayout(dims, sizeof(T), sliceSize, sliceCount);
+        if (!isSupported) {
+            return;
+        }
+        const std::size_t itemCount =
+            GetChunkCount(sliceSize / 2, GetChunkSize(sizeof(T))) * sliceCount;
+        std::vector<ChunkSummary> summaries(itemCount);
+        const auto* values = static_cast<const T*>(data);
+        SetSlicesReversedInPlace<sizeof(T)>(data, sliceSize, sliceCount,
+            [&](std::size_t item, std::size_t offset, std::size_t count) {
+                SetChunkSummary(values, offset, count, hasChecksum, summaries[item]);
+            });
+        SetStatistics(values, sliceSize * sliceCount, summaries, hasChecksum, statistics);
+    });
+    return isSupported;
+}
+
+bool VolumeReorder::GetStatistics(
+    const void* data,
+    const std::array<std::size_t, 3>& dims,
+    int scalarType,
+    bool hasChecksum,
+    VolumeStatistics& statistics)
+{
+    std::size_t sliceSize = 0;
+    std::size_t sliceCount = 0;
+    bool isSupported = false;
+    (void)GetScalarDispatched(scalarType, [&](auto value) {
+        using T = decltype(value);
+        isSupported = data
+            && GetSliceLayout(dims, sizeof(T), sliceSize, sliceCount);
+        if (!isSupported) {
+            return;
+        }
+        const std::size_t valueCount = sliceSize * sliceCount;
+        const std::size_t chunkSize = GetChunkSize(sizeof(T));
+        std::vector<ChunkSummary> summaries(GetChunkCount(valueCount, chunkSize));
+        const auto* values = static_cast<const T*>(data);
+        vtkSMPTools::For(
+            vtkIdType{ 0 },
+            static_cast<vtkIdType>(summaries.size()),
+            [&](vtkIdType first, vtkIdType last) {
+                for (vtkIdType item = first; item < last; ++item) {
+                    const std::size_t begin = static_cast<std::size_t>(item) * chunkSize;
+                    const std::size_t end = std::min(valueCount, begin + chunkSize);
+                    SetChunkSummary(values, begin, end - begin, hasChecksum,
+                        summaries[static_cast<std::size_t>(item)]);
+                }
+            });
+        SetStatistics(values, valueCount, summaries, hasChecksum, statistics);
+    });
+    return isSupported;
+}
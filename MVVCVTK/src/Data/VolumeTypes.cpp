@@ -5,11 +5,34 @@
 #include <limits>
 #include <utility>
 
+namespace {
+template <typename T>
+constexpr VolumeScalarType kScalarTypeOf = VolumeScalarType::Float32;
+template <>
+constexpr VolumeScalarType kScalarTypeOf<std::uint8_t> = VolumeScalarType::UInt8;
+template <>
+constexpr VolumeScalarType kScalarTypeOf<std::uint16_t> = VolumeScalarType::UInt16;
+template <>
+constexpr VolumeScalarType kScalarTypeOf<std::int16_t> = VolumeScalarType::Int16;
+
+template <typename T>
+bool GetBufferMatched(const std::vector<T>& voxels, const VolumeLayout& layout) noexcept
+{
+    return voxels.size() == layout.GetVoxelCount()
+        && layout.GetScalarType() == kScalarTypeOf<T>;
+}
+} // namespace
+
 std::optional<VolumeLayout> VolumeLayout::Create(
     std::array<int, 3> dimensions,
     std::array<float, 3> spacing,
-    std::array<float, 3> origin)
+    std::array<float, 3> origin,
+    VolumeScalarType scalarType)
 {
+    const std::size_t scalarBytes = GetScalarBytes(scalarType);
+    if (scalarBytes == 0) {
+        return std::nullopt;
+    }
     std::size_t voxelCount = 1;
     for (std::size_t index = 0; index < dimensions.size(); ++index) {
         if (dimensions[index] <= 0 || !std::isfinite(spacing[index])
@@ -23,39 +46,89 @@ std::optional<VolumeLayout> VolumeLayout::Create(
         voxelCount *= dimension;
     }
     if (voxelCount > static_cast<std::size_t>(std::numeric_limits<std::ptrdiff_t>::max())
-        || voxelCount > std::numeric_limits<std::size_t>::max() / sizeof(float)) {
+        || voxelCount > std::numeric_limits<std::size_t>::max() / scalarBytes) {
         return std::nullopt;
     }
-    const std::size_t byteCount = voxelCount * sizeof(float);
+    const std::size_t byteCount = voxelCount * scalarBytes;
     return VolumeLayout(
-        dimensions, spacing, origin, voxelCount, byteCount);
+        dimensions, spacing, origin, scalarType, voxelCount, byteCount);
+}
+
+std::size_t VolumeLayout::GetScalarBytes(VolumeScalarType scalarType) noexcept
+{
+    switch (scalarType) {
+    case VolumeScalarType::UInt8:
+        return sizeof(std::uint8_t);
+    case VolumeScalarType::UInt16:
+        return sizeof(std::uint16_t);
+    case VolumeScalarType::Int16:
+        return sizeof(std::int16_t);
+    case VolumeScalarType::Float32:
+        return sizeof(float);
+    }
+    return 0;
 }
 
 VolumeLayout::VolumeLayout(
     std::array<int, 3> dimensions,
     std::array<float, 3> spacing,
     std::array<float, 3> origin,
+    VolumeScalarType scalarType,
     std::size_t voxelCount,
     std::size_t byteCount) noexcept
     : m_dimensions(dimensions), m_spacing(spacing), m_origin(origin),
-      m_voxelCount(voxelCount), m_byteCount(byteCount) {}
+      m_scalarType(scalarType), m_voxelCount(voxelCount), m_byteCount(byteCount) {}
 
 const std::array<int, 3>& VolumeLayout::GetDimensions() const noexcept { return m_dimensions; }
 const std::array<float, 3>& VolumeLayout::GetSpacing() const noexcept { return m_spacing; }
 const std::array<float, 3>& VolumeLayout::GetOrigin() const noexcept { return m_origin; }
+VolumeScalarType VolumeLayout::GetScalarType() const noexcept { return m_scalarType; }
 std::size_t VolumeLayout::GetVoxelCount() const noexcept { return m_voxelCount; }
 std::size_t VolumeLayout::GetByteCount() const noexcept { return m_byteCount; }
 
 std::optional<VolumeBuffer> VolumeBuffer::Create(
     std::vector<float> voxels, VolumeLayout layout)
 {
-    if (voxels.size() != layout.GetVoxelCount()) return std::nullopt;
+    if (!GetBufferMatched(voxels, layout)) return std::nullopt;
+    return VolumeBuffer(std::move(voxels), std::move(layout));
+}
+
+std::optional<VolumeBuffer> VolumeBuffer::Create(
+    std::vector<std::uint8_t> voxels, VolumeLayout layout)
+{
+    if (!GetBufferMatched(voxels, layout)) return std::nullopt;
+    return VolumeBuffer(std::move(voxels), std::move(layout));
+}
+
+std::optional<VolumeBuffer> VolumeBuffer::Create(
+    std::vector<std::uint16_t> voxels, VolumeLayout layout)
+{
+    if (!GetBufferMatched(voxels, layout)) return std::nullopt;
+    return VolumeBuffer(std::move(voxels), std::move(layout));
+}
+
+std::optional<VolumeBuffer> VolumeBuffer::Create(
+    std::vector<std::int16_t> voxels, VolumeLayout layout)
+{
+    if (!GetBufferMatched(voxels, layout)) return std::nullopt;
     return VolumeBuffer(std::move(voxels), std::move(layout));
 }
 
 VolumeBuffer::VolumeBuffer(
-    std::vector<float> voxels, VolumeLayout layout) noexcept
+    Storage voxels, VolumeLayout layout) noexcept
     : m_voxels(std::move(voxels)), m_layout(std::move(layout)) {}
 
-const std::vector<float>& VolumeBuffer::GetVoxels() const noexcept { return m_voxels; }
+const std::vector<float>& VolumeBuffer::GetVoxels() const noexcept
+{
+    static const std::vector<float> emptyVoxels;
+    const auto* floatVoxels = std::get_if<std::vector<float>>(&m_voxels);
+    return floatVoxels ? *floatVoxels : emptyVoxels;
+}
+
+const void* VolumeBuffer::GetData() const noexcept
+{
+    return std::visit(
+        [](const auto& voxels) -> const void* { return voxels.data(); }, m_voxels);
+}
+
 const VolumeLayout& VolumeBuffer::GetLayout() const noexcept { return m_layout; }
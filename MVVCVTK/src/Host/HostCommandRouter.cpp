@@ -59,9 +59,11 @@ private:
     bool SetTool(const HostToolSetRequest& request) const;
     bool SwitchTool(const HostToolSwitchRequest& request) const;
     bool LoadFile(HostLoadRequest request, HostCompleteCallback callback) const;
+    bool OpenSession(HostSessionOpenRequest request, HostCompleteCallback callback) const;
     bool ReloadBuffer(HostReloadRequest request, HostCompleteCallback callback) const;
     bool ExportData(HostDataExportRequest request, HostCompleteCallback callback) const;
     bool ExportSlices(HostSliceExportRequest request, HostCompleteCallback callback) const;
+    bool CancelExport(const HostExportCancelRequest& request) const;
     std::optional<VolumeLayout> BuildLoadLayout(
         const HostLoadRequest& request) const;
     std::optional<std::array<int, 3>> GetRawDims(
@@ -97,6 +99,11 @@ bool HostCommandRouter::Impl::Dispatch(
             std::move(*value),
             std::move(onComplete));
     }
+    if (auto* value = dynamic_cast<HostSessionOpenRequest*>(&request)) {
+        return OpenSession(
+            std::move(*value),
+            std::move(onComplete));
+    }
     if (auto* value = dynamic_cast<HostReloadRequest*>(&request)) {
         return ReloadBuffer(
             std::move(*value),
@@ -112,6 +119,10 @@ bool HostCommandRouter::Impl::Dispatch(
             std::move(*value),
             std::move(onComplete));
     }
+    if (const auto* value = dynamic_cast<const HostExportCancelRequest*>(
+        &request)) {
+        return !onComplete && CancelExport(*value);
+    }
     if (const auto* value = dynamic_cast<const HostViewSetRequest*>(
         &request)) {
         return !onComplete && SetView(*value);
@@ -148,6 +159,20 @@ bool HostCommandRouter::Impl::LoadFile(
         std::move(callback));
 }
 
+bool HostCommandRouter::Impl::OpenSession(
+    HostSessionOpenRequest request, HostCompleteCallback callback) const
+{
+    if (!m_renderViews || request.filePath.empty()) {
+        return false;
+    }
+    const auto* view = m_renderViews->GetPrimaryView();
+    if (!view || !view->service) {
+        return false;
+    }
+    return view->service->LoadSessionAsync(
+        std::move(request.filePath), std::move(callback));
+}
+
 bool HostCommandRouter::Impl::ReloadBuffer(
     HostReloadRequest request, HostCompleteCallback callback) const
 {
@@ -179,8 +204,22 @@ std::optional<VolumeLayout> HostCommandRouter::Impl::BuildLoadLayout(
         if (!rawDimensions) return std::nullopt;
         dimensions = *rawDimensions;
     }
+    VolumeScalarType scalarType = VolumeScalarType::Float32;
+    switch (request.scalarType) {
+    case HostScalarType::UInt8:
+        scalarType = VolumeScalarType::UInt8;
+        break;
+    case HostScalarType::UInt16:
+        scalarType = VolumeScalarType::UInt16;
+        break;
+    case HostScalarType::Int16:
+        scalarType = VolumeScalarType::Int16;
+        break;
+    case HostScalarType::Float32:
+        break;
+    }
     return VolumeLayout::Create(
-        dimensions, request.geometry.spacing, request.geometry.origin);
+        dimensions, request.geometry.spacing, request.geometry.origin, scalarType);
 }
 
 std::optional<std::array<int, 3>> HostCommandRouter::Impl::GetRawDims(
@@ -263,6 +302,9 @@ bool HostCommandRouter::Impl::ExportData(
         case HostDataExportFormat::Obj:
             extension = ".obj";
             break;
+        case HostDataExportFormat::Session:
+            extension = ".mvs";
+            break;
         default:
             return false;
         }
@@ -287,7 +329,9 @@ bool HostCommandRouter::Impl::ExportData(
     view->service->ExportDataAsync(
         std::move(request.outputPath),
         std::move(extension),
-        std::move(callback));
+        request.targetTriangleCount,
+        std::move(callback),
+        std::move(request.onProgress));
     return true;
 }
 
@@ -302,10 +346,26 @@ bool HostCommandRouter::Impl::ExportSlices(
         return false;
     }
     view->service->ExportSlicesAsync(
-        request.outputDir, request.angleDeg, std::move(callback));
+        request.outputDir, request.angleDeg, std::move(callback),
+        std::move(request.onProgress));
     return true;
 }
 
+bool HostCommandRouter::Impl::CancelExport(
+    const HostExportCancelRequest& request) const
+{
+    if (!m_renderViews || request.exportId == 0) {
+        return false;
+    }
+    // exportId 只在发起导出的 service 内有意义；逐个视图询问，命中即停。
+    for (const auto& view : m_renderViews->GetViews()) {
+        if (view.service && view.service->CancelExport(request.exportId)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::optional<VizMode> HostCommandRouter::Impl::GetAppViewMode(HostRenderMode mode) const
 {
     switch (mode) {
@@ -5,6 +5,8 @@
 #include "AppStateEvents.h"
 #include "AppTypes.h"
 #include "DataManager.h"
+#include "ExportTaskQueue.h"
+#include "ImagePyramid.h"
 #include "StdRenderContext.h"
 
 #include <algorithm>
@@ -49,7 +51,9 @@ private:
         vtkSmartPointer<vtkRenderWindow> renderWindow,
         std::shared_ptr<AbstractDataManager> dataMgr,
         std::shared_ptr<SharedInteractionState> sharedState,
-        std::shared_ptr<IStateEventSource> stateEventSource) const;
+        std::shared_ptr<IStateEventSource> stateEventSource,
+        std::shared_ptr<ImagePyramid> pyramid,
+        std::shared_ptr<ExportTaskQueue> exportQueue) const;
     std::optional<VizMode> GetAppViewMode(HostRenderMode mode) const;
     std::optional<HostRenderMode> GetHostViewMode(VizMode mode) const;
     std::optional<PreInitConfig> BuildAppInit(const HostViewInitConfig& config) const;
@@ -69,7 +73,9 @@ std::pair<std::shared_ptr<VizService>, std::shared_ptr<StdRenderContext>> HostRe
     vtkSmartPointer<vtkRenderWindow> renderWindow,
     std::shared_ptr<AbstractDataManager> dataMgr,
     std::shared_ptr<SharedInteractionState> sharedState,
-    std::shared_ptr<IStateEventSource> stateEventSource) const
+    std::shared_ptr<IStateEventSource> stateEventSource,
+    std::shared_ptr<ImagePyramid> pyramid,
+    std::shared_ptr<ExportTaskQueue> exportQueue) const
 {
     const auto appInit = BuildAppInit(cfg.viewInit);
     if (!appInit) {
@@ -82,6 +88,10 @@ std::pair<std::shared_ptr<VizService>, std::shared_ptr<StdRenderContext>> HostRe
         std::move(dataMgr),
         std::move(sharedState),
         std::move(stateEventSource));
+    service->SetImagePyramid(std::move(pyramid));
+    if (exportQueue) {
+        service->SetExportQueue(std::move(exportQueue));
+    }
     auto context = std::make_shared<StdRenderContext>();
 
     if (renderWindow) {
@@ -288,7 +298,9 @@ bool HostRenderViewSet::Impl::Build(
             config.renderWindow,
             core.sharedDataMgr,
             core.sharedState,
-            core.sharedStateBroadcaster);
+            core.sharedStateBroadcaster,
+            core.sharedPyramid,
+            core.sharedExportQueue);
         if (!pair.first || !pair.second) {
             m_views.clear();
             return false;
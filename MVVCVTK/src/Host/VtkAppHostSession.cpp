@@ -8,7 +8,10 @@
 
 #include "AppState.h"
 #include "DataManager.h"
+#include "ExportTaskQueue.h"
+#include "ImagePyramid.h"
 #include "StdRenderContext.h"
+#include "VolumeCache.h"
 
 #include <algorithm>
 #include <exception>
@@ -75,6 +78,24 @@ HostCoreServices::GetImageWriter() const
     };
 }
 
+std::function<bool(
+    DataVersion,
+    vtkSmartPointer<vtkImageData>)>
+HostCoreServices::GetLabelWriter() const
+{
+    const std::weak_ptr<RawVolumeDataManager> weakData =
+        sharedDataMgr;
+    return [weakData](
+        DataVersion version,
+        vtkSmartPointer<vtkImageData> labelImage) {
+        const auto data = weakData.lock();
+        return data
+            && data->SetLabelImage(
+                version,
+                std::move(labelImage));
+    };
+}
+
 class VtkAppHostSession::Impl final {
 public:
     struct FeatureEntry final {
@@ -138,6 +159,8 @@ HostCoreServices VtkAppHostSession::Impl::BuildCore()
     value.sharedState =
         std::make_shared<SharedInteractionState>(
             value.sharedStateBroadcaster);
+    value.sharedPyramid = std::make_shared<ImagePyramid>();
+    value.sharedExportQueue = std::make_shared<ExportTaskQueue>();
     return value;
 }
 
@@ -174,6 +197,11 @@ bool VtkAppHostSession::Impl::BuildSession()
     }
 
     core = BuildCore();
+    if (!config.volumeCacheDirectory.empty()) {
+        core.sharedDataMgr->SetVolumeCache(
+            std::make_shared<const VolumeCache>(
+                config.volumeCacheDirectory));
+    }
     if (!renderViews.Build(core, config.renderViews)) {
         return false;
     }
@@ -348,6 +376,7 @@ bool VtkAppHostSession::Impl::AttachFeature(
     context.inputPort = &hotkeyRouter->GetInputPort();
     context.getImageSnapshot = core.GetImageReader();
     context.setImageState = core.GetImageWriter();
+    context.setLabelImage = core.GetLabelWriter();
     context.setActiveViews = [viewSet = &renderViews, id](
         const std::vector<std::shared_ptr<InteractiveService>>& services) {
         return viewSet
@@ -13,7 +13,7 @@
 #include <unistd.h>
 #endif
 
-bool MemMappedFile::Load(const std::string& path, size_t length) {
+bool MemMappedFile::Load(const std::string& path, size_t length, Prefetch prefetch) {
     Clear();
     const auto nativePath = PlatformPath::GetNativePath(path);
 #ifdef _WIN32
@@ -34,6 +34,7 @@ bool MemMappedFile::Load(const std::string& path, size_t length) {
         CloseHandle(hFile); return false;
     }
 
+    (void)prefetch;  // MapViewOfFile 本身按访问缺页
     HANDLE hMap = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
     if (!hMap) { CloseHandle(hFile); return false; }
 
@@ -60,10 +61,13 @@ bool MemMappedFile::Load(const std::string& path, size_t length) {
         ::close(fd); return false;
     }
 
+    int flags = MAP_PRIVATE;
 #ifdef __linux__
-    int flags = MAP_PRIVATE | MAP_POPULATE;  // 预读所有页
+    if (prefetch == Prefetch::All) {
+        flags |= MAP_POPULATE;               // 预读所有页；macOS / BSD 无此标志
+    }
 #else
-    int flags = MAP_PRIVATE;                 // macOS / BSD 兼容
+    (void)prefetch;
 #endif
     void* ptr = ::mmap(nullptr, mapBytes, PROT_READ, flags, fd, 0);
     if (ptr == MAP_FAILED) { ::close(fd); return false; }
@@ -74,6 +74,15 @@ void CompositeStrategy::SetVisualState(const RenderParams& params, UpdateFlags f
     }
 }
 
+void CompositeStrategy::SetImagePyramid(
+    std::shared_ptr<ImagePyramid> pyramid)
+{
+    // 参考平面不做降采样，金字塔只转交主 3D 子策略。
+    if (m_mainStrategy) {
+        m_mainStrategy->SetImagePyramid(std::move(pyramid));
+    }
+}
+
 void CompositeStrategy::SetInputMask(
     vtkSmartPointer<vtkImageData> validityMask)
 {
@@ -1,13 +1,11 @@
 #include "IsoSurfaceStrategy.h"
+#include "Data/ImageMaskOutsideFilter.h"
 #include <vtkProperty.h>
 #include <vtkCamera.h>
 #include <vtkMatrix4x4.h>
 #include <vtkObjectFactory.h>
 #include <vtkOpenGLPolyDataMapper.h>
-#include <vtkClipPolyData.h>
-#include <vtkImplicitFunction.h>
 #include <vtkImageData.h>
-#include <vtkType.h>
 
 #include <cmath>
 #include <utility>
@@ -35,68 +33,6 @@ private:
 
 vtkStandardNewMacro(IsoSurfaceStrategy::Mapper);
 
-class IsoSurfaceStrategy::MaskImplicit final
-    : public vtkImplicitFunction {
-public:
-    static MaskImplicit* New();
-    vtkTypeMacro(MaskImplicit, vtkImplicitFunction);
-
-    bool SetMask(vtkImageData* validityMask)
-    {
-        if (!validityMask
-            || validityMask->GetScalarType()
-                != VTK_UNSIGNED_CHAR
-            || validityMask->GetNumberOfScalarComponents()
-                != 1) {
-            return false;
-        }
-        m_validityMask = validityMask;
-        Modified();
-        return true;
-    }
-
-    double EvaluateFunction(double point[3]) override
-    {
-        if (!m_validityMask) {
-            return -1.0;
-        }
-        double continuousIndex[3] = {};
-        m_validityMask
-            ->TransformPhysicalPointToContinuousIndex(
-                point, continuousIndex);
-        int extent[6] = {};
-        m_validityMask->GetExtent(extent);
-        int index[3] = {};
-        for (int axis = 0; axis < 3; ++axis) {
-            index[axis] = static_cast<int>(
-                std::llround(continuousIndex[axis]));
-            if (index[axis] < extent[axis * 2]
-                || index[axis]
-                    > extent[axis * 2 + 1]) {
-                return -1.0;
-            }
-        }
-        const auto* value =
-            static_cast<const unsigned char*>(
-                m_validityMask->GetScalarPointer(
-                    index[0], index[1], index[2]));
-        return value && *value != 0 ? 1.0 : -1.0;
-    }
-
-    void EvaluateGradient(
-        double[3],
-        double gradient[3]) override
-    {
-        gradient[0] = 0.0;
-        gradient[1] = 0.0;
-        gradient[2] = 0.0;
-    }
-
-private:
-    vtkSmartPointer<vtkImageData> m_validityMask;
-};
-
-vtkStandardNewMacro(IsoSurfaceStrategy::MaskImplicit);
 
 
 static constexpr int kIsoTargetDim = 766;
@@ -145,8 +81,7 @@ IsoSurfaceStrategy::IsoSurfaceStrategy() {
     m_actor = vtkSmartPointer<vtkActor>::New();
     m_cubeAxes = vtkSmartPointer<vtkCubeAxesActor>::New();
     m_isoFilter = vtkSmartPointer<vtkFlyingEdges3D>::New();
-    m_maskFunc = vtkSmartPointer<MaskImplicit>::New();
-    m_clip = vtkSmartPointer<vtkClipPolyData>::New();
+    m_maskFilter = vtkSmartPointer<ImageMaskOutsideFilter>::New();
     m_mapper = vtkSmartPointer<Mapper>::New();
     // predicate 直接读取 vertexMC；禁用 VBO Shift/Scale 才能保持 input-model 坐标。
     m_mapper->SetVBOShiftScaleMethod(vtkOpenGLPolyDataMapper::DISABLE_SHIFT_SCALE);
@@ -161,11 +96,7 @@ IsoSurfaceStrategy::IsoSurfaceStrategy() {
     m_actor->GetProperty()->SetInterpolationToFlat();
     m_isoFilter->ComputeNormalsOff();
     m_isoFilter->ComputeGradientsOff();
-    m_clip->SetInputConnection(m_isoFilter->GetOutputPort());
-    m_clip->SetClipFunction(m_maskFunc);
-    m_clip->SetValue(0.0);
-    m_clip->InsideOutOff();
-    m_clip->GenerateClippedOutputOff();
+    m_isoFilter->SetInputConnection(m_maskFilter->GetOutputPort());
 
     AttachProp(m_actor);
     AttachProp(m_cubeAxes);
@@ -183,8 +114,8 @@ void IsoSurfaceStrategy::SetInputData(vtkSmartPointer<vtkDataObject> data) {
     if (poly) {
         // 如果上游已经给的是 mesh，则直接走 PolyData 路径，不再重复提等值面。
         m_lastInput = data;
-        m_hasMask = false;
         m_mask = nullptr;
+        (void)m_maskFilter->SetMask(nullptr);
         poly->GetCenter(m_dataCenter);
         m_mapper->SetInputData(poly);
         m_mapper->ScalarVisibilityOff();
@@ -206,18 +137,17 @@ void IsoSurfaceStrategy::SetInputData(vtkSmartPointer<vtkDataObject> data) {
     // 交互来源不再拥有独立 producer，也不改 mapper 输入。
     auto img = vtkImageData::SafeDownCast(data);
     if (img) {
-        auto resample =
-            ImageProcessor::GetDownsampledImage(img, kIsoTargetDim);
+        auto resample = BuildDownsampledProducer(img, kIsoTargetDim);
         if (!resample) {
             return;
         }
 
         m_lastInput = data;
-        m_hasMask = false;
         m_mask = nullptr;
+        (void)m_maskFilter->SetMask(nullptr);
         img->GetCenter(m_dataCenter);
         m_resample = std::move(resample);
-        m_isoFilter->SetInputConnection(
+        m_maskFilter->SetInputConnection(
             m_resample->GetOutputPort());
 
         m_currentIsoValue = 0.0;
@@ -229,48 +159,27 @@ void IsoSurfaceStrategy::SetInputData(vtkSmartPointer<vtkDataObject> data) {
 
 }
 
-bool IsoSurfaceStrategy::SetMapperInput()
-{
-    if (!m_mapper) {
-        return false;
-    }
-    if (m_hasMask) {
-        if (!m_clip) {
-            return false;
-        }
-        m_mapper->SetInputConnection(m_clip->GetOutputPort());
-        return true;
-    }
-    if (!m_isoFilter) {
-        return false;
-    }
-    m_mapper->SetInputConnection(m_isoFilter->GetOutputPort());
-    return true;
-}
-
 void IsoSurfaceStrategy::SetInputMask(
     vtkSmartPointer<vtkImageData> validityMask)
 {
     if (!vtkImageData::SafeDownCast(m_lastInput)
         || !validityMask) {
-        m_hasMask = false;
         m_mask = nullptr;
-        (void)SetMapperInput();
+        (void)m_maskFilter->SetMask(nullptr);
         return;
     }
 
-    auto mask = ImageProcessor::GetDownsampledMask(
-        validityMask, kIsoTargetDim);
+    // mask 层与 image 层同目标维度降采样，extent 一致；无效体素在提取时即视为外侧，切口自然闭合。
+    auto mask = BuildDownsampledProducer(
+        validityMask, kIsoTargetDim, PyramidLevelKind::Mask);
     if (!mask) {
         return;
     }
     mask->Update();
-    if (!m_maskFunc->SetMask(mask->GetOutput())) {
+    if (!m_maskFilter->SetMask(GetProducerImage(mask))) {
         return;
     }
     m_mask = std::move(mask);
-    m_hasMask = true;
-    (void)SetMapperInput();
 }
 
 void IsoSurfaceStrategy::AttachRenderer(vtkSmartPointer<vtkRenderer> ren) {
@@ -4,7 +4,6 @@
 #include <vtkVolumeProperty.h>
 #include <vtkColorTransferFunction.h>
 #include <vtkPiecewiseFunction.h>
-#include <vtkImageResample.h>
 #include <vtkImageAnisotropicDiffusion3D.h>
 #include <vtkCamera.h>
 #include <vtkMatrix4x4.h>
@@ -346,11 +345,13 @@ bool VolumeStrategy::SetMaskKey(vtkImageData* image)
 }
 
 double VolumeStrategy::GetQualityStep(
-    vtkImageResample* qualityResample) const
+    vtkAlgorithm* qualityResample) const
 {
     if (!qualityResample) return 0.0;
     qualityResample->UpdateInformation();
-    const double* spacing = qualityResample->GetOutput()->GetSpacing();
+    auto* output = GetProducerImage(qualityResample);
+    if (!output) return 0.0;
+    const double* spacing = output->GetSpacing();
     const double minSpacing = std::min(
         { spacing[0], spacing[1], spacing[2] });
     return std::isfinite(minSpacing) && minSpacing > 0.0
@@ -374,16 +375,20 @@ bool VolumeStrategy::BuildMasks(const int customTargetDim)
     }
     if (customTargetDim <= 0) return false;
 
-    auto qualityMask = ImageProcessor::GetDownsampledMask(
-        m_lastMask, 766);
+    if (customTargetDim != 766) {
+        SetDownsampledLevels(
+            m_lastMask, { 766, customTargetDim }, PyramidLevelKind::Mask);
+    }
+    auto qualityMask = BuildDownsampledProducer(
+        m_lastMask, 766, PyramidLevelKind::Mask);
     if (!qualityMask) return false;
-    vtkSmartPointer<vtkImageResample> customMask;
+    vtkSmartPointer<vtkAlgorithm> customMask;
     if (customTargetDim == 766) {
         customMask = qualityMask;
     }
     else {
-        customMask = ImageProcessor::GetDownsampledMask(
-            m_lastMask, customTargetDim);
+        customMask = BuildDownsampledProducer(
+            m_lastMask, customTargetDim, PyramidLevelKind::Mask);
         if (!customMask) return false;
     }
     qualityMask->Update();
@@ -433,16 +438,26 @@ bool VolumeStrategy::BuildProducers()
         inputPort = denoiseFilter->GetOutputPort();
     }
 
-    auto qualityResample = ImageProcessor::GetDownsampledImage(
-        image, qualityTargetDim, inputPort);
+    // denoise 输出随策略配置变化，只能走本地管线；原始输入的降采样层由共享金字塔跨视图复用。
+    const auto buildResample = [this, image, inputPort](int targetDim)
+        -> vtkSmartPointer<vtkAlgorithm> {
+        if (inputPort) {
+            return ImageProcessor::GetDownsampledImage(
+                image, targetDim, inputPort);
+        }
+        return BuildDownsampledProducer(image, targetDim);
+    };
+    if (!inputPort && customTargetDim != qualityTargetDim) {
+        SetDownsampledLevels(image, { qualityTargetDim, customTargetDim });
+    }
+    auto qualityResample = buildResample(qualityTargetDim);
     if (!qualityResample) return false;
-    vtkSmartPointer<vtkImageResample> customResample;
+    vtkSmartPointer<vtkAlgorithm> customResample;
     if (customTargetDim == qualityTargetDim) {
         customResample = qualityResample;
     }
     else {
-        customResample = ImageProcessor::GetDownsampledImage(
-            image, customTargetDim, inputPort);
+        customResample = buildResample(customTargetDim);
         if (!customResample) return false;
     }
     if (GetQualityStep(qualityResample) <= 0.0) return false;
@@ -521,7 +536,7 @@ bool VolumeStrategy::SetMapperInput()
         const auto maskResample = activeQuality == VolumeQuality::Custom
             ? m_customMask : m_qualityMask;
         if (!maskResample) return false;
-        activeMask = maskResample->GetOutput();
+        activeMask = GetProducerImage(maskResample);
     }
     // BuildMasks 只准备缓存；所有可能失败的质量校验也必须先完成，
     // 再统一提交不会返回失败的 mapper input/mask setter。
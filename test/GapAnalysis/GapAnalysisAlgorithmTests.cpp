@@ -5,6 +5,7 @@
 
 #include "Algorithms/VoidDetector.h"
 #include "Algorithms/VolumeBuffer.h"
+#include "Algorithms/VoxelBitMask.h"
 #include "Services/GapAnalysisService.h"
 #include "GapDisplayTests.h"
 
@@ -19,6 +20,7 @@
 #include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -150,15 +152,9 @@ void SetSolidImage(vtkImageData* image)
     image->Modified();
 }
 
-std::size_t GetMaskCount(const std::vector<uint8_t>& mask)
+std::size_t GetMaskCount(const GapBitMask& mask)
 {
-    std::size_t count = 0;
-    for (const auto value : mask) {
-        if (value != 0) {
-            ++count;
-        }
-    }
-    return count;
+    return mask.GetCount();
 }
 
 void SetRegionExpect(const VoidRegion& region, int& failureCount)
@@ -307,6 +303,258 @@ void StartAlgoCase(int& failureCount)
         failureCount);
 }
 
+void StartNativeCase(int& failureCount)
+{
+    // uint16 快照直接共享原生存储；三个算法步骤按类型展开后须与 float 快照逐位一致。
+    const auto floatVolume = BuildTestVolume();
+    const auto floatVoxels = BuildTestVoxels();
+    auto nativeVoxels = std::make_shared<std::vector<std::uint16_t>>(floatVoxels.size());
+    std::transform(floatVoxels.begin(), floatVoxels.end(), nativeVoxels->begin(),
+        [](float value) { return static_cast<std::uint16_t>(value); });
+
+    GapVolumeBuffer nativeVolume;
+    nativeVolume.dims = TestDims;
+    SetExpect(nativeVolume.SetSharedVoxels(nativeVoxels, nativeVoxels->data()),
+        "uint16 voxels should be shared without a float copy.", failureCount);
+    SetExpect(nativeVolume.voxelType == GapScalarType::UInt16
+            && nativeVolume.voxels.empty()
+            && nativeVolume.voxelsPtr == nativeVoxels->data(),
+        "shared uint16 snapshot should alias the native storage.", failureCount);
+    SetExpect(nativeVolume.GetVoxelValue(3, 3, 3) == 0.0f
+            && nativeVolume.GetVoxelValue(0, 0, 0) == 1.0f,
+        "native voxel reads should widen to float values.", failureCount);
+
+    const auto floatInterior = VoidDetector::CreateInteriorMask(floatVolume, 0.5f);
+    const auto nativeInterior = VoidDetector::CreateInteriorMask(nativeVolume, 0.5f);
+    SetExpect(std::equal(
+            floatInterior.GetWords(),
+            floatInterior.GetWords() + floatInterior.GetWordCount(),
+            nativeInterior.GetWords()),
+        "uint16 interior mask should match the float snapshot.", failureCount);
+
+    const auto floatCandidates = VoidDetector::BuildCandidates(floatVolume, floatInterior, BuildVoidParams());
+    const auto nativeCandidates = VoidDetector::BuildCandidates(nativeVolume, nativeInterior, BuildVoidParams());
+    SetExpect(std::equal(
+            floatCandidates.GetWords(),
+            floatCandidates.GetWords() + floatCandidates.GetWordCount(),
+            nativeCandidates.GetWords()),
+        "uint16 candidates should match the float snapshot.", failureCount);
+
+    std::vector<int> labels;
+    const auto regions = VoidDetector::BuildRegions(
+        nativeVolume,
+        nativeCandidates,
+        BuildVoidParams(),
+        labels);
+    SetExpect(regions.size() == 1, "uint16 snapshot should detect one enclosed void.", failureCount);
+    if (regions.size() == 1) {
+        SetRegionExpect(regions.front(), failureCount);
+    }
+}
+
+void StartRegionCase(int& failureCount)
+{
+    // 128x128x40 体按 16 层分为三块：U 形区只在第三块闭合，立方块跨第一条块边界，
+    // 行尾与下一行行首按扁平 offset 相邻；单体素区被最小体积筛掉且不占 id。
+    const std::array<int, 3> dims = { 128, 128, 40 };
+    GapVolumeBuffer volume;
+    volume.dims = dims;
+    volume.SetOwnedVoxels(std::vector<float>(
+        static_cast<std::size_t>(dims[0]) * dims[1] * dims[2], 0.0f));
+    GapBitMask candidates(volume.voxels.size());
+    const auto setCandidate = [&](int x, int y, int z) {
+        candidates.SetBit(GetLinearIndex(x, y, z, dims));
+    };
+    for (int z = 0; z <= 35; ++z) {
+        setCandidate(10, 10, z);
+        setCandidate(20, 10, z);
+    }
+    for (int x = 11; x < 20; ++x) {
+        setCandidate(x, 10, 35);
+    }
+    setCandidate(5, 5, 1);
+    setCandidate(127, 50, 3);
+    setCandidate(0, 51, 3);
+    for (int z = 15; z <= 17; ++z) {
+        for (int y = 60; y <= 62; ++y) {
+            for (int x = 60; x <= 62; ++x) {
+                setCandidate(x, y, z);
+            }
+        }
+    }
+
+    auto params = BuildVoidParams();
+    params.minVolumeMM3 = 2.0;
+    std::vector<int> labels;
+    const auto regions = VoidDetector::BuildRegions(volume, candidates, params, labels);
+    SetExpect(regions.size() == 3, "slab labeling should keep three regions.", failureCount);
+    if (regions.size() != 3) {
+        return;
+    }
+    const std::array<int, 3> firstSeed = { 10, 10, 0 };
+    const std::array<int, 3> wrapSeed = { 127, 50, 3 };
+    const std::array<int, 3> cubeSeed = { 60, 60, 15 };
+    const std::array<int, 6> cubeBbox = { 60, 62, 60, 62, 15, 17 };
+    SetExpect(regions[0].id == 1 && regions[0].voxelCount == 81 && regions[0].seedVoxel == firstSeed
+            && regions[1].id == 2 && regions[1].voxelCount == 2 && regions[1].seedVoxel == wrapSeed
+            && regions[2].id == 3 && regions[2].voxelCount == 27 && regions[2].seedVoxel == cubeSeed
+            && regions[2].bbox == cubeBbox,
+        "region ids should follow the first voxel of each kept component across slabs.", failureCount);
+    SetExpect(labels[GetLinearIndex(20, 10, 0, dims)] == 1
+            && labels[GetLinearIndex(15, 10, 35, dims)] == 1
+            && labels[GetLinearIndex(5, 5, 1, dims)] == 0
+            && labels[GetLinearIndex(0, 51, 3, dims)] == 2
+            && labels[GetLinearIndex(61, 61, 16, dims)] == 3,
+        "slab labeling should merge across slab borders and clear filtered regions.", failureCount);
+}
+
+void StartExteriorCase(int& failureCount)
+{
+    // 128x128x48 实心体按 16 层分为三块：通道从 z=0 面升到第三块、横移后折回第一块尽头的小腔，
+    // 外部可达须逐轮跨块往返传播；跨块封闭腔保留为内部，贴着 mask=0 voxel 的腔通向域外。
+    const std::array<int, 3> dims = { 128, 128, 48 };
+    GapVolumeBuffer volume;
+    volume.dims = dims;
+    volume.SetOwnedVoxels(std::vector<float>(
+        static_cast<std::size_t>(dims[0]) * dims[1] * dims[2], 1.0f));
+    std::vector<std::uint8_t> validityMask(volume.voxels.size(), 255);
+    const auto setAir = [&](int x, int y, int z) {
+        volume.voxels[GetLinearIndex(x, y, z, dims)] = 0.0f;
+    };
+    for (int z = 0; z <= 40; ++z) {
+        setAir(5, 5, z);
+        setAir(30, 5, z + 2);
+    }
+    for (int x = 6; x < 30; ++x) {
+        setAir(x, 5, 40);
+    }
+    for (int x = 30; x <= 33; ++x) {
+        setAir(x, 5, 2);
+        setAir(x, 6, 2);
+    }
+    for (int z = 14; z <= 17; ++z) {
+        for (int y = 60; y <= 62; ++y) {
+            for (int x = 60; x <= 62; ++x) {
+                setAir(x, y, z);
+                setAir(x + 20, y, z + 16);
+            }
+        }
+    }
+    validityMask[GetLinearIndex(81, 63, 31, dims)] = 0;
+    volume.SetOwnedMask(std::move(validityMask));
+
+    const auto interior = VoidDetector::CreateInteriorMask(volume, 0.5f);
+    SetExpect(GetMaskCount(interior) == 36,
+        "slab exterior fill should keep only the sealed cavity.", failureCount);
+    SetExpect(interior.GetBit(GetLinearIndex(61, 61, 15, dims))
+            && interior.GetBit(GetLinearIndex(60, 62, 17, dims))
+            && !interior.GetBit(GetLinearIndex(33, 6, 2, dims))
+            && !interior.GetBit(GetLinearIndex(30, 5, 20, dims))
+            && !interior.GetBit(GetLinearIndex(81, 61, 31, dims)),
+        "exterior reachability should cross slab borders in both directions.", failureCount);
+}
+
+void StartBitMaskCase(int& failureCount)
+{
+    // 位 mask 的区间置位与任意位移取字必须跨字边界正确，越界位读作 0。
+    GapBitMask mask(130);
+    mask.SetRange(3, 70);
+    mask.SetBit(129);
+    SetExpect(mask.GetCount() == 68 && mask.GetWordCount() == 3
+            && mask.GetBit(3) && mask.GetBit(69) && !mask.GetBit(70) && mask.GetBit(129),
+        "bit mask ranges should span word boundaries.", failureCount);
+    SetExpect(mask.GetWordAt(60) == 0x3FF
+            && mask.GetWordAt(-2) == (mask.GetWords()[0] << 2)
+            && mask.GetWordAt(129) == 1
+            && mask.GetWordAt(-64) == 0,
+        "shifted bit mask words should read zero outside the mask.", failureCount);
+
+    // 70x6x6 体的每行跨越字边界：两轮腐蚀后 y/z 仍留种子并回长全体，三轮后种子耗尽。
+    const std::array<int, 3> dims = { 70, 6, 6 };
+    GapVolumeBuffer volume;
+    volume.dims = dims;
+    volume.SetOwnedVoxels(std::vector<float>(
+        static_cast<std::size_t>(dims[0]) * dims[1] * dims[2], 0.0f));
+    GapBitMask interior(volume.voxels.size());
+    interior.SetRange(0, volume.voxels.size());
+    auto params = BuildVoidParams();
+    params.erosionIterations = 2;
+    SetExpect(GetMaskCount(VoidDetector::BuildCandidates(volume, interior, params)) == 2520,
+        "word-parallel erosion should keep seeds that regrow the whole block.", failureCount);
+    params.erosionIterations = 3;
+    SetExpect(GetMaskCount(VoidDetector::BuildCandidates(volume, interior, params)) == 0,
+        "word-parallel erosion should exhaust a block thinner than its iterations.", failureCount);
+
+    // 128x128x12 体跨三个腐蚀字块：三轮后小立方体耗尽、大立方体只剩中心种子，
+    // 后两轮只重算大立方体附近的块，结果仍须回长出完整的大立方体。
+    const std::array<int, 3> blockDims = { 128, 128, 12 };
+    GapVolumeBuffer blockVolume;
+    blockVolume.dims = blockDims;
+    blockVolume.SetOwnedVoxels(std::vector<float>(
+        static_cast<std::size_t>(blockDims[0]) * blockDims[1] * blockDims[2], 0.0f));
+    GapBitMask blockInterior(blockVolume.voxels.size());
+    for (int z = 1; z <= 3; ++z) {
+        for (int y = 10; y <= 12; ++y) {
+            blockInterior.SetRange(GetLinearIndex(10, y, z, blockDims), GetLinearIndex(13, y, z, blockDims));
+        }
+    }
+    for (int z = 2; z <= 10; ++z) {
+        for (int y = 100; y <= 108; ++y) {
+            blockInterior.SetRange(GetLinearIndex(60, y, z, blockDims), GetLinearIndex(69, y, z, blockDims));
+        }
+    }
+    const auto blockCandidates = VoidDetector::BuildCandidates(blockVolume, blockInterior, params);
+    SetExpect(GetMaskCount(blockCandidates) == 729
+            && blockCandidates.GetBit(GetLinearIndex(60, 100, 2, blockDims))
+            && !blockCandidates.GetBit(GetLinearIndex(11, 11, 2, blockDims)),
+        "dirty-block erosion should match a full rescan across blocks.", failureCount);
+}
+
+void StartRegrowCase(int& failureCount)
+{
+    // 128x128x40 体按 16 层分为三块：种子立方体在第一块，细蛇形通道升到第三块再折回第二块，
+    // 行尾 (127,12,20) 按扁平 offset 接到下一行行首 (0,13,20)；孤立细线没有种子，不得回长。
+    const std::array<int, 3> dims = { 128, 128, 40 };
+    GapVolumeBuffer volume;
+    volume.dims = dims;
+    volume.SetOwnedVoxels(std::vector<float>(
+        static_cast<std::size_t>(dims[0]) * dims[1] * dims[2], 0.0f));
+    GapBitMask interior(volume.voxels.size());
+    const auto setInterior = [&](int x, int y, int z) {
+        interior.SetBit(GetLinearIndex(x, y, z, dims));
+    };
+    for (int z = 2; z <= 6; ++z) {
+        for (int y = 10; y <= 14; ++y) {
+            for (int x = 10; x <= 14; ++x) {
+                setInterior(x, y, z);
+            }
+        }
+    }
+    for (int z = 7; z <= 35; ++z) {
+        setInterior(12, 12, z);
+        setInterior(70, 70, z - 2);
+    }
+    for (int x = 13; x <= 40; ++x) {
+        setInterior(x, 12, 35);
+    }
+    for (int z = 20; z <= 34; ++z) {
+        setInterior(40, 12, z);
+    }
+    for (int x = 41; x < dims[0]; ++x) {
+        setInterior(x, 12, 20);
+    }
+    setInterior(0, 13, 20);
+
+    auto params = BuildVoidParams();
+    params.erosionIterations = 1;
+    const auto candidates = VoidDetector::BuildCandidates(volume, interior, params);
+    SetExpect(GetMaskCount(candidates) == 285
+            && candidates.GetBit(GetLinearIndex(40, 12, 20, dims))
+            && candidates.GetBit(GetLinearIndex(0, 13, 20, dims))
+            && !candidates.GetBit(GetLinearIndex(70, 70, 20, dims)),
+        "slab regrowth should follow flat adjacency across slab borders.", failureCount);
+}
+
 void StartBufferCase(int& failureCount)
 {
     // owned 路径复制后必须各自拥有 vector；移动后别名必须重绑，不能保留源对象地址。
@@ -502,7 +750,7 @@ void StartSharedCase(int& failureCount)
 
 void StartConvertCase(int& failureCount)
 {
-    // 非 float 输入必须在同步入口完成 float 转换；之后调用方改写 VTK scalars 不能污染算法输入。
+    // 非 float 输入在同步入口 DeepCopy 后按原生类型共享；之后调用方改写 VTK scalars 不能污染算法输入。
     auto image = BuildShortImage();
     GapAnalysisService service;
     SetExpect(service.SetGapInput(image),
@@ -533,6 +781,11 @@ void StartConvertCase(int& failureCount)
     {
         int failureCount = 0;
         StartAlgoCase(failureCount);
+        StartNativeCase(failureCount);
+        StartRegionCase(failureCount);
+        StartExteriorCase(failureCount);
+        StartBitMaskCase(failureCount);
+        StartRegrowCase(failureCount);
         StartBufferCase(failureCount);
         StartSnapCase(failureCount);
         StartSharedCase(failureCount);
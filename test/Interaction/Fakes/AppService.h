@@ -3,6 +3,7 @@
 #include "AppTypes.h"
 #include "VolumeTypes.h"
 
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <string>
@@ -22,6 +23,16 @@ public:
         return true;
     }
 
+    bool LoadSessionAsync(
+        std::string path,
+        std::function<void(bool isSuccess)> onComplete)
+    {
+        m_sessionPath = std::move(path);
+        ++m_sessionCount;
+        if (onComplete) onComplete(true);
+        return true;
+    }
+
     bool ReloadFromBufferAsync(
         VolumeBuffer buffer,
         std::function<void(bool isSuccess)> onComplete)
@@ -45,26 +56,44 @@ public:
 
     bool SendReloadUpdate() { return true; }
 
-    void ExportDataAsync(
+    std::uint64_t ExportDataAsync(
         std::string outputDir,
         std::string extension,
-        std::function<void(bool isSuccess)> onComplete)
+        std::size_t targetTriangleCount,
+        std::function<void(bool isSuccess)> onComplete,
+        std::function<void(std::uint64_t, double)> onProgress = nullptr)
     {
         m_exportDir = std::move(outputDir);
         m_exportExtension = std::move(extension);
+        m_exportTriangleCount = targetTriangleCount;
         ++m_exportCount;
+        const std::uint64_t exportId = ++m_lastExportId;
+        if (onProgress) onProgress(exportId, 1.0);
         if (onComplete) onComplete(true);
+        return exportId;
     }
 
-    void ExportSlicesAsync(const std::string& path, std::optional<double> angleDeg,
-        std::function<void(bool isSuccess)> onComplete)
+    std::uint64_t ExportSlicesAsync(const std::string& path, std::optional<double> angleDeg,
+        std::function<void(bool isSuccess)> onComplete,
+        std::function<void(std::uint64_t, double)> onProgress = nullptr)
     {
         m_slicePath = path;
         m_sliceAngleDeg = angleDeg;
         ++m_sliceCount;
+        const std::uint64_t exportId = ++m_lastExportId;
+        if (onProgress) onProgress(exportId, 1.0);
         if (onComplete) onComplete(true);
+        return exportId;
+    }
+
+    bool CancelExport(std::uint64_t exportId)
+    {
+        m_cancelledExportId = exportId;
+        return exportId != 0 && exportId == m_cancellableExportId;
     }
 
+    void SetCancellableExport(std::uint64_t exportId) { m_cancellableExportId = exportId; }
+
     void SetVizMode(VizMode mode) { m_vizMode = mode; ++m_vizModeSetCount; }
     VizMode GetVizMode() const { return m_vizMode; }
     int GetVizModeSetCount() const { return m_vizModeSetCount; }
@@ -89,14 +118,18 @@ public:
     uint32_t GetVisibilityMask() const { return m_visibilityMask; }
     bool GetDenoiseOn() const { return m_isDenoiseOn; }
     int GetLoadCount() const { return m_loadCount; }
+    int GetSessionCount() const { return m_sessionCount; }
     int GetReloadCount() const { return m_reloadCount; }
     int GetExportCount() const { return m_exportCount; }
     int GetSliceCount() const { return m_sliceCount; }
+    std::uint64_t GetCancelledExportId() const { return m_cancelledExportId; }
     const std::string& GetLoadPath() const { return m_loadPath; }
+    const std::string& GetSessionPath() const { return m_sessionPath; }
     const VolumeLayout& GetLoadLayout() const { return *m_loadLayout; }
     const VolumeBuffer& GetReloadBuffer() const { return *m_reloadBuffer; }
     const std::string& GetExportDir() const { return m_exportDir; }
     const std::string& GetExportExtension() const { return m_exportExtension; }
+    std::size_t GetExportTriangleCount() const { return m_exportTriangleCount; }
     const std::string& GetSlicePath() const { return m_slicePath; }
     const std::optional<double>& GetSliceAngleDeg() const { return m_sliceAngleDeg; }
     void SetSpacingAccepted(bool isAccepted) { m_isSpacingAccepted = isAccepted; }
@@ -184,12 +217,18 @@ private:
     int m_visibilitySetCount = 0;
     int m_dirtySetCount = 0;
     int m_loadCount = 0;
+    int m_sessionCount = 0;
     int m_reloadCount = 0;
     int m_exportCount = 0;
     int m_sliceCount = 0;
+    std::uint64_t m_lastExportId = 0;
+    std::uint64_t m_cancelledExportId = 0;
+    std::uint64_t m_cancellableExportId = 0;
     std::string m_loadPath;
+    std::string m_sessionPath;
     std::string m_exportDir;
     std::string m_exportExtension;
+    std::size_t m_exportTriangleCount = 0;
     std::string m_slicePath;
     std::optional<double> m_sliceAngleDeg;
     bool m_isReloadAccepted = true;
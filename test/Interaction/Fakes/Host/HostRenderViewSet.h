@@ -32,6 +32,11 @@ public:
         return true;
     }
 
+    const std::vector<HostRenderViewRuntime>& GetViews() const
+    {
+        return m_views;
+    }
+
     const HostRenderViewRuntime* GetPrimaryView() const
     {
         for (const auto& view : m_views) {
@@ -7,6 +7,7 @@
 #include "StdRenderContext.h"
 
 #include <array>
+#include <cstdint>
 #include <limits>
 #include <iostream>
 #include <memory>
@@ -27,17 +28,21 @@ static_assert(
 static_assert(std::is_polymorphic_v<HostRequest>);
 static_assert(std::has_virtual_destructor_v<HostRequest>);
 static_assert(std::is_base_of_v<HostRequest, HostLoadRequest>);
+static_assert(std::is_base_of_v<HostRequest, HostSessionOpenRequest>);
 static_assert(std::is_base_of_v<HostRequest, HostReloadRequest>);
 static_assert(std::is_base_of_v<HostRequest, HostDataExportRequest>);
 static_assert(std::is_base_of_v<HostRequest, HostSliceExportRequest>);
+static_assert(std::is_base_of_v<HostRequest, HostExportCancelRequest>);
 static_assert(std::is_base_of_v<HostRequest, HostViewSetRequest>);
 static_assert(std::is_base_of_v<HostRequest, HostViewResetRequest>);
 static_assert(std::is_base_of_v<HostRequest, HostToolSetRequest>);
 static_assert(std::is_base_of_v<HostRequest, HostToolSwitchRequest>);
 static_assert(std::is_final_v<HostLoadRequest>);
+static_assert(std::is_final_v<HostSessionOpenRequest>);
 static_assert(std::is_final_v<HostReloadRequest>);
 static_assert(std::is_final_v<HostDataExportRequest>);
 static_assert(std::is_final_v<HostSliceExportRequest>);
+static_assert(std::is_final_v<HostExportCancelRequest>);
 static_assert(std::is_final_v<HostViewSetRequest>);
 static_assert(std::is_final_v<HostViewResetRequest>);
 static_assert(std::is_final_v<HostToolSetRequest>);
@@ -484,7 +489,8 @@ void StartDataCases(int& failureCount)
         std::pair{ HostDataExportFormat::Raw, std::string{ ".raw" } },
         std::pair{ HostDataExportFormat::Ply, std::string{ ".ply" } },
         std::pair{ HostDataExportFormat::Stl, std::string{ ".stl" } },
-        std::pair{ HostDataExportFormat::Obj, std::string{ ".obj" } }
+        std::pair{ HostDataExportFormat::Obj, std::string{ ".obj" } },
+        std::pair{ HostDataExportFormat::Session, std::string{ ".mvs" } }
     };
     for (const auto& [format, suffix] : exportCases) {
         HostDataExportRequest exportRequest;
@@ -528,6 +534,17 @@ void StartDataCases(int& failureCount)
         "IsoSurface 窗口必须把缺省格式收敛为 PLY。",
         failureCount);
 
+    HostDataExportRequest decimatedMesh;
+    decimatedMesh.outputPath = "exports";
+    decimatedMesh.format = HostDataExportFormat::Stl;
+    decimatedMesh.targetTriangleCount = 5000;
+    SetExpect(
+        SendData(fixture, std::move(decimatedMesh))
+            && service->GetExportExtension() == ".stl"
+            && service->GetExportTriangleCount() == 5000,
+        "网格导出的目标三角形数必须原样传递到服务。",
+        failureCount);
+
     service->SetVizMode(VizMode::SliceTop_down);
     HostDataExportRequest inferredSlice;
     inferredSlice.outputPath = "exports";
@@ -562,6 +579,43 @@ void StartDataCases(int& failureCount)
         "Host slice export 路由必须原样保留 UTF-8 路径字节。",
         failureCount);
 
+    std::uint64_t progressId = 0;
+    double progressValue = 0.0;
+    HostSliceExportRequest progressRequest;
+    progressRequest.outputDir = "slices";
+    progressRequest.sourceView.viewId = "slice";
+    progressRequest.onProgress =
+        [&progressId, &progressValue](std::uint64_t exportId, double progress) {
+            progressId = exportId;
+            progressValue = progress;
+        };
+    SetExpect(
+        SendData(fixture, std::move(progressRequest))
+            && progressId != 0 && progressValue == 1.0,
+        "导出进度回调必须沿路由传到服务并带回 exportId。",
+        failureCount);
+
+    sliceService->SetCancellableExport(progressId);
+    HostExportCancelRequest cancelRequest;
+    cancelRequest.exportId = progressId;
+    SetExpect(
+        SendData(fixture, std::move(cancelRequest))
+            && sliceService->GetCancelledExportId() == progressId,
+        "取消请求必须找到持有该导出的视图服务。",
+        failureCount);
+    HostExportCancelRequest unknownCancel;
+    unknownCancel.exportId = progressId + 100;
+    SetExpect(
+        !SendData(fixture, std::move(unknownCancel)),
+        "没有视图认领的 exportId 必须被拒绝。",
+        failureCount);
+    HostExportCancelRequest callbackCancel;
+    callbackCancel.exportId = progressId;
+    SetExpect(
+        !SendData(fixture, std::move(callbackCancel), [](bool) {}),
+        "取消请求是同步结果，不接受完成回调。",
+        failureCount);
+
     HostLoadRequest rawRequest =
         GetLoadRequest("scan_3x4x5.raw", BuildGeometry());
     rawRequest.geometry.dimensions = { 0, 0, 0 };
@@ -576,6 +630,23 @@ void StartDataCases(int& failureCount)
     SetExpect(!SendData(fixture, std::move(partial)),
         "部分零维度必须被拒绝。", failureCount);
 
+    const std::string sessionPath = u8"C:/体数据 é/会话.mvs";
+    HostSessionOpenRequest sessionRequest;
+    sessionRequest.filePath = sessionPath;
+    bool isSessionCallbackSuccess = false;
+    SetExpect(
+        SendData(fixture, std::move(sessionRequest),
+            [&isSessionCallbackSuccess](bool isSuccess) {
+                isSessionCallbackSuccess = isSuccess;
+            })
+            && service->GetSessionCount() == 1
+            && service->GetSessionPath() == sessionPath
+            && isSessionCallbackSuccess,
+        "会话打开必须把 UTF-8 路径与回调交给主视图服务。",
+        failureCount);
+    SetExpect(!SendData(fixture, HostSessionOpenRequest{}),
+        "空会话路径必须被拒绝。", failureCount);
+
     std::vector<float> voxels{ 1.0f, 2.0f, 3.0f, 4.0f };
     SetExpect(SendData(
         fixture,
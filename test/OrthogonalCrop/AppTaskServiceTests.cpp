@@ -1,9 +1,14 @@
 #include "Tasks/AppDataExportTaskService.h"
 #include "Tasks/AppDataLoadTaskService.h"
+#include "Tasks/ExportTaskQueue.h"
 #include "Algorithms/CropAlgorithm.h"
 #include "AppState.h"
 #include "AppStateEvents.h"
 #include "Data/DataManager.h"
+#include "Data/ExportControl.h"
+#include "Data/SessionArchive.h"
+#include "Data/VolumeCache.h"
+#include "Data/VolumeReorder.h"
 #include "Data/VolumeTypes.h"
 #include "PlanarTestSuites.h"
 #include "Render/CropShaderController.h"
@@ -14,9 +19,14 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <cmath>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <stdexcept>
@@ -30,6 +40,8 @@
 #include <vtkCommand.h>
 #include <vtkDataArray.h>
 #include <vtkFlyingEdges3D.h>
+#include <vtkImageReslice.h>
+#include <vtkMatrix4x4.h>
 #include <vtkOBJReader.h>
 #include <vtkPNGReader.h>
 #include <vtkPLYReader.h>
@@ -37,6 +49,8 @@
 #include <vtkRenderer.h>
 #include <vtkRenderWindow.h>
 #include <vtkSTLReader.h>
+#include <vtkTIFFWriter.h>
+#include <vtkTransform.h>
 #include <vtkTriangleFilter.h>
 #include <vtkUnsignedCharArray.h>
 #include <vtkVolume.h>
@@ -95,8 +109,18 @@ public:
         exportedParams = params;
         return true;
     }
-    bool ExportSlices(const std::string&, Orientation, const WindowLevelParams&,
-        const std::array<double, 16>&) override { return false; }
+    bool ExportSlices(
+        const ImageSnapshot& snapshot,
+        const std::string& dirPath,
+        Orientation,
+        const WindowLevelParams&,
+        const std::array<double, 16>&,
+        const std::shared_ptr<ExportControl>&) override
+    {
+        exportedSnapshot = snapshot;
+        exportedDir = dirPath;
+        return true;
+    }
 
     ImageSnapshot imageSnapshot;
     ImageSnapshot exportedSnapshot;
@@ -156,6 +180,14 @@ void StartVolumeTypes(int& failureCount)
     SetExpect(!VolumeBuffer::Create(std::vector<float>(11), *layout)
         && !VolumeBuffer::Create(std::vector<float>(13), *layout),
         "short and long owning buffers must fail", failureCount);
+    const auto nativeLayout = VolumeLayout::Create(
+        { 2, 2, 3 }, { 1, 1, 1 }, { 0, 0, 0 }, VolumeScalarType::UInt16);
+    SetExpect(nativeLayout
+            && nativeLayout->GetByteCount() == 12 * sizeof(std::uint16_t)
+            && VolumeBuffer::Create(std::vector<std::uint16_t>(12), *nativeLayout)
+            && !VolumeBuffer::Create(std::vector<float>(12), *nativeLayout),
+        "native layouts must count element bytes and reject mismatched buffers",
+        failureCount);
 }
 
 void StartOwningTasks(int& failureCount)
@@ -294,6 +326,25 @@ void StartExportSnapshot(int& failureCount)
             && dataManager->exportedParams.tfNodes[1].b == 1.0,
         "data export must preserve target and admission-time snapshots",
         failureCount);
+
+    // 切片导出同样在接纳时冻结批次，排队期间 current 被替换也不影响。
+    dataManager->imageSnapshot = firstState;
+    auto sliceTask = service.BuildSlicesTask(
+        "slices", std::nullopt, VizMode::SliceTop_down);
+    dataManager->imageSnapshot = secondState;
+    SetExpect(sliceTask.has_value(),
+        "slice export task should accept a valid snapshot",
+        failureCount);
+    if (!sliceTask) return;
+    auto sliceResult = sliceTask->get_future();
+    (*sliceTask)();
+    SetExpect(sliceResult.get()
+            && dataManager->exportedSnapshot
+                == firstState
+            && dataManager->exportedDir
+                == "slices",
+        "slice export must use the admission-time snapshot",
+        failureCount);
 }
 
 void StartExportFiles(int& failureCount)
@@ -742,13 +793,29 @@ void StartExportFiles(int& failureCount)
         plyPath.u8string().c_str());
     partialReader->Update();
     vtkPolyData* partialMesh = partialReader->GetOutput();
+    // 无效体素在提取时视为外侧：网格不越过首个无效列中心，且在无效列与有效列之间生成闭合切口。
+    const double maskedWorldX = modelToWorld[3]
+        + (firstValidX - 1) * snapshot->image->GetSpacing()[0];
+    const double validWorldX = modelToWorld[3]
+        + firstValidX * snapshot->image->GetSpacing()[0];
+    bool isPartialInside = isPartialSaved && partialMesh
+        && partialMesh->GetNumberOfCells() > 0;
+    bool hasCutFace = false;
+    if (isPartialInside) {
+        for (vtkIdType pointId = 0;
+            pointId < partialMesh->GetNumberOfPoints();
+            ++pointId) {
+            double point[3] = {};
+            partialMesh->GetPoint(pointId, point);
+            isPartialInside = isPartialInside
+                && point[0] > maskedWorldX;
+            hasCutFace = hasCutFace
+                || point[0] < validWorldX - 1e-6;
+        }
+    }
     SetExpect(
-        isPartialSaved && partialMesh
-            && partialMesh->GetNumberOfCells() > 0
-            && plyMesh
-            && partialMesh->GetNumberOfCells()
-                < plyMesh->GetNumberOfCells(),
-        "a partial validity mask should reduce the exported mesh",
+        isPartialInside && hasCutFace,
+        "a partial validity mask should cut the exported mesh with a closed face",
         failureCount);
 
     auto mismatchState =
@@ -786,6 +853,360 @@ void StartExportFiles(int& failureCount)
         outputDir, error);
 }
 
+void StartRawSlabExport(int& failureCount)
+{
+    // 绕 X 旋转 30° 后整卷按 Z slab 流式重采样写出；字节必须与一次性整卷 reslice 完全一致。
+    DataManagerProbe dataManager;
+    SetExpect(
+        dataManager.SetInitial(BuildExportImage()),
+        "slab RAW export needs an image snapshot",
+        failureCount);
+    const auto snapshot = dataManager.GetSnapshot();
+    const double angle = 30.0 * 3.14159265358979323846 / 180.0;
+    const std::array<double, 16> modelToWorld = {
+        1.0, 0.0, 0.0, 5.0,
+        0.0, std::cos(angle), -std::sin(angle), 0.0,
+        0.0, std::sin(angle), std::cos(angle), 0.0,
+        0.0, 0.0, 0.0, 1.0
+    };
+
+    auto worldToModel = vtkSmartPointer<vtkMatrix4x4>::New();
+    worldToModel->DeepCopy(modelToWorld.data());
+    worldToModel->Invert();
+    auto transform = vtkSmartPointer<vtkTransform>::New();
+    transform->SetMatrix(worldToModel);
+    auto reference = vtkSmartPointer<vtkImageReslice>::New();
+    reference->SetInputData(snapshot->image);
+    reference->SetResliceTransform(transform);
+    reference->SetInterpolationModeToLinear();
+    reference->SetOutputDimensionality(3);
+    reference->SetAutoCropOutput(true);
+    reference->SetBackgroundLevel(0.0);
+    reference->Update();
+    int referenceDims[3] = {};
+    reference->GetOutput()->GetDimensions(referenceDims);
+    const auto referenceBytes =
+        static_cast<std::size_t>(reference->GetOutput()->GetNumberOfPoints())
+        * sizeof(float);
+
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto outputDir =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_slab_" + std::to_string(uniqueId));
+    DataExportParams params;
+    params.extension = ".raw";
+    params.modelToWorld = modelToWorld;
+    const bool isSaved = dataManager.ExportData(
+        snapshot, outputDir.u8string(), params);
+    const auto rawPath = outputDir
+        / (std::to_string(referenceDims[0])
+            + "x" + std::to_string(referenceDims[1])
+            + "x" + std::to_string(referenceDims[2])
+            + "_transform.raw");
+    std::vector<char> written;
+    if (isSaved) {
+        std::ifstream rawFile(rawPath, std::ios::binary);
+        written.assign(
+            std::istreambuf_iterator<char>(rawFile),
+            std::istreambuf_iterator<char>());
+    }
+    SetExpect(isSaved
+            && referenceDims[2] > 1
+            && written.size() == referenceBytes
+            && std::memcmp(written.data(),
+                reference->GetOutput()->GetScalarPointer(),
+                referenceBytes) == 0,
+        "slab RAW export should match a whole-volume reslice byte for byte",
+        failureCount);
+    std::error_code error;
+    std::filesystem::remove_all(outputDir, error);
+}
+
+void StartExportQueue(int& failureCount)
+{
+    // 并发上限 1：首个任务阻塞占住唯一槽位，第二个留在队列；排队取消立即以失败就绪且不运行。
+    ExportTaskQueue queue(1);
+    std::atomic<bool> isReleased{ false };
+    std::atomic<bool> isQueuedRun{ false };
+    auto blockingControl = std::make_shared<ExportControl>();
+    std::future<bool> blockingResult;
+    const auto blockingId = queue.StartTask(
+        std::packaged_task<bool()>([&isReleased, blockingControl] {
+            while (!isReleased.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return !blockingControl->GetIsCancelled();
+        }),
+        blockingControl, blockingResult);
+    std::future<bool> queuedResult;
+    const auto queuedId = queue.StartTask(
+        std::packaged_task<bool()>([&isQueuedRun] {
+            isQueuedRun = true;
+            return true;
+        }),
+        std::make_shared<ExportControl>(), queuedResult);
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (queue.GetRunningCount() == 0
+        && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    SetExpect(blockingId != 0 && queuedId != 0 && blockingId != queuedId
+            && queue.GetRunningCount() == 1 && queue.GetQueuedCount() == 1,
+        "export queue should run one task and hold the next at concurrency 1",
+        failureCount);
+
+    const bool isQueuedCancelled = queue.CancelTask(queuedId);
+    SetExpect(isQueuedCancelled
+            && queuedResult.wait_for(std::chrono::seconds(0))
+                == std::future_status::ready
+            && !queuedResult.get()
+            && queue.GetQueuedCount() == 0,
+        "cancelling a queued export should fail it immediately",
+        failureCount);
+
+    SetExpect(queue.CancelTask(blockingId)
+            && blockingControl->GetIsCancelled(),
+        "cancelling a running export should raise its control flag",
+        failureCount);
+    isReleased = true;
+    SetExpect(!blockingResult.get() && !isQueuedRun
+            && !queue.CancelTask(blockingId),
+        "a cancelled export should finish as failed and leave the queue",
+        failureCount);
+
+    queue.SetConcurrency(0);
+    SetExpect(queue.GetConcurrency() == 1,
+        "export queue concurrency should never drop below one",
+        failureCount);
+
+    // 数据层：带 control 的 RAW 导出按 slab 写满进度；已取消的 control 不产生任何文件。
+    DataManagerProbe dataManager;
+    SetExpect(
+        dataManager.SetInitial(BuildExportImage()),
+        "export progress needs an image snapshot",
+        failureCount);
+    const auto snapshot = dataManager.GetSnapshot();
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto outputDir =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_queue_" + std::to_string(uniqueId));
+    DataExportParams params;
+    params.extension = ".raw";
+    params.control = std::make_shared<ExportControl>();
+    const bool isSaved = dataManager.ExportData(
+        snapshot, outputDir.u8string(), params);
+    SetExpect(isSaved && params.control->GetProgress() == 1.0,
+        "RAW export should report full progress through its control",
+        failureCount);
+
+    const auto cancelledDir = outputDir / "cancelled";
+    params.control = std::make_shared<ExportControl>();
+    params.control->SetCancelled();
+    const bool isCancelledSaved = dataManager.ExportData(
+        snapshot, cancelledDir.u8string(), params);
+    std::error_code error;
+    SetExpect(!isCancelledSaved
+            && (!std::filesystem::exists(cancelledDir, error)
+                || std::filesystem::is_empty(cancelledDir, error)),
+        "a pre-cancelled export should write nothing",
+        failureCount);
+    std::filesystem::remove_all(outputDir, error);
+}
+
+void StartPermutedRawExport(int& failureCount)
+{
+    // 绕 Z 旋转 90° 并平移：世界 X 取模型 -Y、世界 Y 取模型 X，走步长转置而非插值，结果须与 reslice 一致。
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(3, 2, 2);
+    image->AllocateScalars(VTK_SHORT, 1);
+    auto* values = static_cast<short*>(image->GetScalarPointer());
+    for (int z = 0; z < 2; ++z) {
+        for (int y = 0; y < 2; ++y) {
+            for (int x = 0; x < 3; ++x) {
+                values[(z * 2 + y) * 3 + x] =
+                    static_cast<short>(x + 10 * y + 100 * z);
+            }
+        }
+    }
+    DataManagerProbe dataManager;
+    SetExpect(dataManager.SetInitial(image),
+        "permuted RAW export needs an image snapshot",
+        failureCount);
+    const auto snapshot = dataManager.GetSnapshot();
+    const std::array<double, 16> modelToWorld = {
+        0.0, -1.0, 0.0, 7.0,
+        1.0, 0.0, 0.0, -3.0,
+        0.0, 0.0, 1.0, 2.5,
+        0.0, 0.0, 0.0, 1.0
+    };
+
+    auto worldToModel = vtkSmartPointer<vtkMatrix4x4>::New();
+    worldToModel->DeepCopy(modelToWorld.data());
+    worldToModel->Invert();
+    auto transform = vtkSmartPointer<vtkTransform>::New();
+    transform->SetMatrix(worldToModel);
+    auto reference = vtkSmartPointer<vtkImageReslice>::New();
+    reference->SetInputData(snapshot->image);
+    reference->SetResliceTransform(transform);
+    reference->SetInterpolationModeToLinear();
+    reference->SetOutputDimensionality(3);
+    reference->SetAutoCropOutput(true);
+    reference->Update();
+    int referenceDims[3] = {};
+    reference->GetOutput()->GetDimensions(referenceDims);
+
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto outputDir =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_permuted_" + std::to_string(uniqueId));
+    DataExportParams params;
+    params.extension = ".raw";
+    params.modelToWorld = modelToWorld;
+    const bool isSaved = dataManager.ExportData(
+        snapshot, outputDir.u8string(), params);
+    std::vector<short> written;
+    if (isSaved) {
+        std::ifstream rawFile(
+            outputDir / "2x3x2_transform.raw", std::ios::binary);
+        written.resize(12);
+        rawFile.read(
+            reinterpret_cast<char*>(written.data()),
+            static_cast<std::streamsize>(written.size() * sizeof(short)));
+        if (!rawFile || rawFile.peek() != std::char_traits<char>::eof()) {
+            written.clear();
+        }
+    }
+    // 输出 (o0, o1, o2) 取源 (x=o1, y=1-o0, z=o2)。
+    SetExpect(isSaved
+            && referenceDims[0] == 2 && referenceDims[1] == 3
+            && referenceDims[2] == 2
+            && written.size() == 12
+            && written[0] == 10 && written[1] == 0
+            && written[2] == 11 && written[5] == 2
+            && written[6] == 110 && written[11] == 102
+            && std::memcmp(written.data(),
+                reference->GetOutput()->GetScalarPointer(),
+                written.size() * sizeof(short)) == 0,
+        "axis-permuted RAW export should transpose scalars exactly like reslice",
+        failureCount);
+    std::error_code error;
+    std::filesystem::remove_all(outputDir, error);
+}
+
+void StartDecimatedMeshExport(int& failureCount)
+{
+    // 球面距离场的等值面约数千三角形；给定目标数后 PLY/STL 须同步抽稀，且 PLY 仍带法向与逐点颜色。
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(24, 24, 24);
+    image->AllocateScalars(VTK_FLOAT, 1);
+    auto* values = static_cast<float*>(image->GetScalarPointer());
+    for (int z = 0; z < 24; ++z) {
+        for (int y = 0; y < 24; ++y) {
+            for (int x = 0; x < 24; ++x) {
+                const double dx = x - 11.5;
+                const double dy = y - 11.5;
+                const double dz = z - 11.5;
+                values[(z * 24 + y) * 24 + x] = static_cast<float>(
+                    std::sqrt(dx * dx + dy * dy + dz * dz));
+            }
+        }
+    }
+    DataManagerProbe dataManager;
+    SetExpect(dataManager.SetInitial(image),
+        "decimated mesh export needs an image snapshot",
+        failureCount);
+    const auto snapshot = dataManager.GetSnapshot();
+
+    auto fullIso = vtkSmartPointer<vtkFlyingEdges3D>::New();
+    fullIso->SetInputData(snapshot->image);
+    fullIso->SetValue(0, 8.0);
+    auto fullTriangles = vtkSmartPointer<vtkTriangleFilter>::New();
+    fullTriangles->SetInputConnection(fullIso->GetOutputPort());
+    fullTriangles->Update();
+    const vtkIdType fullCount =
+        fullTriangles->GetOutput()->GetNumberOfCells();
+
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto outputDir =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_decimate_" + std::to_string(uniqueId));
+    DataExportParams params;
+    params.isoValue = 8.0;
+    params.scalarRange = { 0.0, 20.0 };
+    params.tfNodes = {
+        { 0.0, 1.0, 1.0, 0.0, 0.0 },
+        { 1.0, 1.0, 0.0, 0.0, 1.0 }
+    };
+    params.targetTriangleCount =
+        static_cast<std::size_t>(fullCount / 4);
+    params.extension = ".ply";
+    const bool isPlySaved = dataManager.ExportData(
+        snapshot, outputDir.u8string(), params);
+    params.extension = ".stl";
+    const bool isStlSaved = dataManager.ExportData(
+        snapshot, outputDir.u8string(), params);
+
+    auto plyReader = vtkSmartPointer<vtkPLYReader>::New();
+    plyReader->SetFileName(
+        (outputDir / "24x24x24_transform.ply").u8string().c_str());
+    plyReader->Update();
+    auto stlReader = vtkSmartPointer<vtkSTLReader>::New();
+    stlReader->SetFileName(
+        (outputDir / "24x24x24_transform.stl").u8string().c_str());
+    stlReader->Update();
+    vtkPolyData* plyMesh = plyReader->GetOutput();
+    vtkPolyData* stlMesh = stlReader->GetOutput();
+    const vtkIdType plyCount = plyMesh ? plyMesh->GetNumberOfCells() : 0;
+    // 二次误差抽稀按比例收敛，允许略高于目标数，但必须明显少于全分辨率。
+    SetExpect(isPlySaved && isStlSaved
+            && fullCount > 1000
+            && plyCount > 0
+            && plyCount <= fullCount / 3
+            && stlMesh
+            && stlMesh->GetNumberOfCells() == plyCount,
+        "mesh export should decimate PLY and STL to the requested triangle budget",
+        failureCount);
+
+    vtkPointData* plyPoints = plyMesh ? plyMesh->GetPointData() : nullptr;
+    auto* plyRgb = plyPoints
+        ? vtkUnsignedCharArray::SafeDownCast(plyPoints->GetScalars())
+        : nullptr;
+    vtkDataArray* plyNormals = plyPoints ? plyPoints->GetNormals() : nullptr;
+    bool isRgbMatched = plyRgb
+        && plyRgb->GetNumberOfComponents() == 3
+        && plyRgb->GetNumberOfTuples() == plyMesh->GetNumberOfPoints();
+    if (isRgbMatched) {
+        // 抽稀后的点标量仍贴近 iso，颜色取 TF 在 8/20 处的插值。
+        for (vtkIdType pointId = 0;
+            pointId < plyRgb->GetNumberOfTuples();
+            ++pointId) {
+            unsigned char rgb[3] = {};
+            plyRgb->GetTypedTuple(pointId, rgb);
+            isRgbMatched = isRgbMatched
+                && rgb[0] >= 145 && rgb[0] <= 161
+                && rgb[1] == 0
+                && rgb[2] >= 94 && rgb[2] <= 110;
+        }
+    }
+    SetExpect(isRgbMatched
+            && plyNormals
+            && plyNormals->GetNumberOfComponents() == 3
+            && plyNormals->GetNumberOfTuples() == plyMesh->GetNumberOfPoints(),
+        "decimated PLY should keep per-point normals and transfer-function colors",
+        failureCount);
+    std::error_code error;
+    std::filesystem::remove_all(outputDir, error);
+}
+
 void StartStateGate(int& failureCount)
 {
     auto broadcaster = std::make_shared<SharedStateBroadcaster>();
@@ -838,6 +1259,10 @@ void StartMaskSnapshot(int& failureCount)
 
     ImageState candidate = *expected;
     candidate.validityMask = mask;
+    auto maskDelta = std::make_shared<ValidityMaskDelta>();
+    maskDelta->parentVersion = expected->version;
+    maskDelta->removedRuns = { { 1, 2 } };
+    candidate.maskDelta = maskDelta;
     ImageSnapshot publishedSnapshot;
     SetExpect(dataManager.SetCandidate(
             candidate,
@@ -854,6 +1279,18 @@ void StartMaskSnapshot(int& failureCount)
         failureCount);
     const auto currentVersion =
         current ? current->version : 0;
+    // 增量不随 snapshot 发布，按版本领取一次后即释放。
+    const auto staleDelta =
+        dataManager.GetMaskDelta(currentVersion - 1);
+    const auto takenDelta =
+        dataManager.GetMaskDelta(currentVersion);
+    SetExpect(current && !current->maskDelta
+            && !staleDelta
+            && takenDelta == maskDelta
+            && !dataManager.GetMaskDelta(currentVersion),
+        "mask delta should be held outside the snapshot and taken once",
+        failureCount);
+    candidate.maskDelta = nullptr;
     SetExpect(!dataManager.SetCandidate(
             candidate,
             expected,
@@ -878,6 +1315,7 @@ void StartMaskSnapshot(int& failureCount)
         0.0, 0.0, 0.0, 1.0
     };
     const bool isExported = dataManager.ExportSlices(
+        dataManager.GetImageSnapshot(),
         outputDir.u8string(),
         Orientation::Top_down,
         { 100.0, 50.0 },
@@ -905,6 +1343,870 @@ void StartMaskSnapshot(int& failureCount)
     std::filesystem::remove_all(outputDir, error);
 }
 
+void StartSliceStackExport(int& failureCount)
+{
+    // uint16 3x2x2 按 LeftRight 导出：每个 X 一张 2x2 图，列/行分别取 Y/Z，灰度走 16 位查表路径。
+    DataManagerProbe dataManager;
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(3, 2, 2);
+    image->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+    auto* values = static_cast<unsigned short*>(
+        image->GetScalarPointer());
+    for (int index = 0; index < 12; ++index) {
+        values[index] = static_cast<unsigned short>(1000 + index);
+    }
+    SetExpect(dataManager.SetInitial(image),
+        "uint16 slice stack image should publish",
+        failureCount);
+
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto outputDir =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_stack_"
+            + std::to_string(uniqueId));
+    const std::array<double, 16> identity = {
+        1.0, 0.0, 0.0, 0.0,
+        0.0, 1.0, 0.0, 0.0,
+        0.0, 0.0, 1.0, 0.0,
+        0.0, 0.0, 0.0, 1.0
+    };
+    const bool isExported = dataManager.ExportSlices(
+        dataManager.GetImageSnapshot(),
+        outputDir.u8string(),
+        Orientation::Left_right,
+        { 8.0, 1004.0 },
+        identity);
+    SetExpect(isExported
+            && std::filesystem::exists(outputDir / "Left_right_0000.png")
+            && std::filesystem::exists(outputDir / "Left_right_0002.png")
+            && !std::filesystem::exists(outputDir / "Left_right_0003.png"),
+        "slice stack export should write one PNG per X slice",
+        failureCount);
+
+    auto reader = vtkSmartPointer<vtkPNGReader>::New();
+    reader->SetFileName(
+        (outputDir / "Left_right_0001.png")
+            .u8string().c_str());
+    if (isExported) {
+        reader->Update();
+    }
+    auto* output = reader->GetOutput();
+    const auto* outputValues =
+        output && output->GetNumberOfPoints() == 4
+        ? static_cast<const unsigned char*>(
+            output->GetScalarPointer())
+        : nullptr;
+    // 窗口 [1000, 1008]：体素 (1,0,0)=1001、(1,1,0)=1004、(1,0,1)=1007、(1,1,1)=1010。
+    SetExpect(outputValues
+            && outputValues[0] == 32
+            && outputValues[1] == 128
+            && outputValues[2] == 223
+            && outputValues[3] == 255,
+        "slice stack export should map Y/Z strides and window level per pixel",
+        failureCount);
+    std::error_code error;
+    std::filesystem::remove_all(outputDir, error);
+}
+
+void StartRawMappedLoad(int& failureCount)
+{
+    // 3x2x2 LPS 序列加载后必须翻转 X/Y；只读映射源文件，源文件内容保持不变。
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto rawPath =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_mapped_"
+            + std::to_string(uniqueId) + ".raw");
+    std::vector<float> source(12);
+    for (std::size_t index = 0; index < source.size(); ++index) {
+        source[index] = static_cast<float>(index);
+    }
+    {
+        std::ofstream rawFile(rawPath, std::ios::binary);
+        rawFile.write(
+            reinterpret_cast<const char*>(source.data()),
+            static_cast<std::streamsize>(source.size() * sizeof(float)));
+    }
+    const auto layout = VolumeLayout::Create(
+        { 3, 2, 2 }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f });
+    auto dataManager =
+        std::make_unique<RawVolumeDataManager>();
+    bool hasPending = false;
+    const bool isLoaded = layout
+        && dataManager->SetDataLoaded(rawPath.u8string(), *layout)
+        && dataManager->SetCurrentFromPending(hasPending)
+        && hasPending;
+    auto snapshot = dataManager->GetImageSnapshot();
+    const auto* values = isLoaded && snapshot && snapshot->image
+        ? static_cast<const float*>(
+            snapshot->image->GetScalarPointer())
+        : nullptr;
+    SetExpect(values
+            && values[0] == 5.0f && values[5] == 0.0f
+            && values[6] == 11.0f && values[11] == 6.0f
+            && snapshot->scalarRange
+                == std::array<double, 2>{ 0.0, 11.0 },
+        "RAW load should flip each LPS slice into RAS order",
+        failureCount);
+    // 翻转同批产出的统计须与发布范围一致，且覆盖全部 12 个体素。
+    const auto* statistics = snapshot
+        ? snapshot->statistics.get() : nullptr;
+    std::uint64_t binTotal = 0;
+    if (statistics) {
+        for (const auto count : statistics->histogram) {
+            binTotal += count;
+        }
+    }
+    SetExpect(statistics
+            && statistics->scalarRange == snapshot->scalarRange
+            && statistics->hasChecksum
+            && statistics->histogram.back() == 1
+            && binTotal == 12,
+        "RAW load should publish fused range and histogram statistics",
+        failureCount);
+    // 公共 image 访问返回独立外壳但共享同一份 scalar，改外壳几何不影响 current。
+    const auto imageView = dataManager->GetVtkImage();
+    if (imageView) {
+        imageView->SetSpacing(2.0, 2.0, 2.0);
+    }
+    SetExpect(imageView && values
+            && imageView.GetPointer() != snapshot->image.GetPointer()
+            && imageView->GetScalarPointer() == values
+            && snapshot->image->GetSpacing()[0] == 1.0,
+        "GetVtkImage should share scalars through an independent shell",
+        failureCount);
+
+    // scalar 由 snapshot 持有；DataManager 析构后仍可读，且源文件保持 LPS 原值。
+    dataManager.reset();
+    SetExpect(values && values[1] == 4.0f,
+        "loaded scalars must outlive the loading DataManager",
+        failureCount);
+    std::vector<float> reread(source.size());
+    {
+        std::ifstream rawFile(rawPath, std::ios::binary);
+        rawFile.read(
+            reinterpret_cast<char*>(reread.data()),
+            static_cast<std::streamsize>(reread.size() * sizeof(float)));
+    }
+    SetExpect(reread == source,
+        "RAW load must not modify the source RAW file",
+        failureCount);
+    snapshot.reset();
+    std::error_code error;
+    std::filesystem::remove(rawPath, error);
+}
+
+void StartRawNativeLoad(int& failureCount)
+{
+    // uint16 RAW 须保持原生存储：类型、翻转与统计都不经过 float 展开。
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto rawPath =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_native_"
+            + std::to_string(uniqueId) + ".raw");
+    std::vector<std::uint16_t> source(12);
+    for (std::size_t index = 0; index < source.size(); ++index) {
+        source[index] = static_cast<std::uint16_t>(1000 + index);
+    }
+    {
+        std::ofstream rawFile(rawPath, std::ios::binary);
+        rawFile.write(
+            reinterpret_cast<const char*>(source.data()),
+            static_cast<std::streamsize>(source.size() * sizeof(std::uint16_t)));
+    }
+    const auto layout = VolumeLayout::Create(
+        { 3, 2, 2 }, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f },
+        VolumeScalarType::UInt16);
+    RawVolumeDataManager dataManager;
+    bool hasPending = false;
+    const bool isLoaded = layout
+        && dataManager.SetDataLoaded(rawPath.u8string(), *layout)
+        && dataManager.SetCurrentFromPending(hasPending)
+        && hasPending;
+    auto snapshot = dataManager.GetImageSnapshot();
+    const bool isNative = isLoaded && snapshot && snapshot->image
+        && snapshot->image->GetScalarType() == VTK_UNSIGNED_SHORT;
+    const auto* values = isNative
+        ? static_cast<const std::uint16_t*>(
+            snapshot->image->GetScalarPointer())
+        : nullptr;
+    SetExpect(values
+            && values[0] == 1005 && values[5] == 1000
+            && values[6] == 1011 && values[11] == 1006
+            && snapshot->scalarRange
+                == std::array<double, 2>{ 1000.0, 1011.0 }
+            && snapshot->statistics
+            && snapshot->statistics->scalarRange == snapshot->scalarRange,
+        "uint16 RAW load should keep native scalars in RAS order",
+        failureCount);
+    snapshot.reset();
+    std::error_code error;
+    std::filesystem::remove(rawPath, error);
+}
+
+void StartRawStreamLoad(int& failureCount)
+{
+    // 阈值为 0 强制流式：多 slab 之外的结果须与整卷路径逐体素、逐统计一致，且最终 pending 不是预览。
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto rawPath =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_stream_"
+            + std::to_string(uniqueId) + ".raw");
+    const std::array<int, 3> dims = { 17, 9, 10 };
+    std::vector<float> source(
+        static_cast<std::size_t>(dims[0] * dims[1] * dims[2]));
+    for (std::size_t index = 0; index < source.size(); ++index) {
+        source[index] = static_cast<float>((index * 37U) % 101U) - 20.0f;
+    }
+    {
+        std::ofstream rawFile(rawPath, std::ios::binary);
+        rawFile.write(
+            reinterpret_cast<const char*>(source.data()),
+            static_cast<std::streamsize>(source.size() * sizeof(float)));
+    }
+    const auto layout = VolumeLayout::Create(
+        dims, { 0.5f, 0.5f, 1.0f }, { 3.0f, -2.0f, 1.0f });
+    const auto getSnapshot = [&](std::size_t threshold) {
+        RawVolumeDataManager dataManager;
+        dataManager.SetStreamThreshold(threshold);
+        bool hasPreview = true;
+        bool hasPending = false;
+        const bool isLoaded = layout
+            && dataManager.SetDataLoaded(rawPath.u8string(), *layout)
+            && dataManager.SetCurrentFromPreview(hasPreview)
+            && !hasPreview
+            && dataManager.SetCurrentFromPending(hasPending)
+            && hasPending;
+        return isLoaded ? dataManager.GetImageSnapshot() : ImageSnapshot{};
+    };
+    const auto streamed = getSnapshot(0);
+    auto mapped = getSnapshot(std::numeric_limits<std::size_t>::max());
+    const auto* streamedValues = streamed && streamed->image
+        ? static_cast<const float*>(streamed->image->GetScalarPointer())
+        : nullptr;
+    const auto* mappedValues = mapped && mapped->image
+        ? static_cast<const float*>(mapped->image->GetScalarPointer())
+        : nullptr;
+    SetExpect(streamedValues && mappedValues
+            && std::equal(
+                streamedValues, streamedValues + source.size(), mappedValues)
+            && !streamed->isPreview
+            && streamed->origin == mapped->origin
+            && streamed->scalarRange == mapped->scalarRange
+            && streamed->statistics && mapped->statistics
+            && streamed->statistics->checksum == mapped->statistics->checksum
+            && streamed->statistics->histogram == mapped->statistics->histogram,
+        "streamed RAW load should match the mapped load",
+        failureCount);
+
+    mapped.reset();
+    std::error_code error;
+    std::filesystem::remove(rawPath, error);
+}
+
+class StreamProbe final : public RawVolumeDataManager {
+public:
+    // 每次发布预览即由“主线程”领取，确定性地模拟 Timer 在完整批次之前提交预览。
+    bool SetPendingImage(ImageState image) override
+    {
+        const bool isPreview = image.isPreview;
+        if (!RawVolumeDataManager::SetPendingImage(std::move(image))) {
+            return false;
+        }
+        bool hasPreview = false;
+        if (isPreview && SetCurrentFromPreview(hasPreview) && hasPreview) {
+            ++previewCount;
+        }
+        return true;
+    }
+
+    int previewCount = 0;
+};
+
+void StartRawStreamPreview(int& failureCount)
+{
+    // 首个 slab 落地即发布预览；放弃完整批次时 current 回滚到加载前批次，成功时完整批次替换预览。
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto rawPath =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_preview_"
+            + std::to_string(uniqueId) + ".raw");
+    const std::array<int, 3> dims = { 17, 9, 10 };
+    std::vector<float> source(
+        static_cast<std::size_t>(dims[0] * dims[1] * dims[2]));
+    for (std::size_t index = 0; index < source.size(); ++index) {
+        source[index] = static_cast<float>((index * 53U) % 97U);
+    }
+    {
+        std::ofstream rawFile(rawPath, std::ios::binary);
+        rawFile.write(
+            reinterpret_cast<const char*>(source.data()),
+            static_cast<std::streamsize>(source.size() * sizeof(float)));
+    }
+    const auto layout = VolumeLayout::Create(
+        dims, { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f });
+    StreamProbe dataManager;
+    dataManager.SetStreamThreshold(std::numeric_limits<std::size_t>::max());
+    bool hasPending = false;
+    const bool isBaseLoaded = layout
+        && dataManager.SetDataLoaded(rawPath.u8string(), *layout)
+        && dataManager.SetCurrentFromPending(hasPending)
+        && hasPending;
+    const auto base = dataManager.GetImageSnapshot();
+    SetExpect(isBaseLoaded && base && base->image && dataManager.previewCount == 0,
+        "whole-volume RAW load should not publish previews",
+        failureCount);
+
+    dataManager.SetStreamThreshold(0);
+    const bool isStreamed = layout
+        && dataManager.SetDataLoaded(rawPath.u8string(), *layout);
+    const auto preview = dataManager.GetImageSnapshot();
+    SetExpect(isStreamed && dataManager.previewCount >= 1
+            && preview && preview->isPreview,
+        "streamed RAW load should publish a preview before the full batch",
+        failureCount);
+
+    // 模拟加载失败：完整批次被丢弃，current 不得停留在预览上。
+    const bool isCleared = dataManager.ClearPending();
+    const auto restored = dataManager.GetImageSnapshot();
+    SetExpect(isCleared && base && preview && restored && restored->image
+            && !restored->isPreview
+            && restored->image->GetScalarPointer()
+                == base->image->GetScalarPointer()
+            && restored->scalarRange == base->scalarRange
+            && restored->version > preview->version,
+        "ClearPending should roll a committed preview back to the previous batch",
+        failureCount);
+
+    const int previewCount = dataManager.previewCount;
+    hasPending = false;
+    const bool isSwapped = layout
+        && dataManager.SetDataLoaded(rawPath.u8string(), *layout)
+        && dataManager.GetImageSnapshot()->isPreview
+        && dataManager.SetCurrentFromPending(hasPending)
+        && hasPending;
+    const auto swapped = dataManager.GetImageSnapshot();
+    const auto* swappedValues = isSwapped && swapped && swapped->image
+        ? static_cast<const float*>(swapped->image->GetScalarPointer())
+        : nullptr;
+    const auto* baseValues = base && base->image
+        ? static_cast<const float*>(base->image->GetScalarPointer())
+        : nullptr;
+    SetExpect(swappedValues && baseValues
+            && dataManager.previewCount > previewCount
+            && !swapped->isPreview
+            && swapped->dims == base->dims
+            && std::equal(
+                swappedValues, swappedValues + source.size(), baseValues),
+        "the full streamed batch should replace the committed preview",
+        failureCount);
+
+    // 完整批次已发布后没有可回滚的预览：ClearPending 不应再改动 current。
+    const auto swappedVersion = swapped ? swapped->version : DataVersion{ 0 };
+    const bool isIdleCleared = dataManager.ClearPending();
+    const auto idle = dataManager.GetImageSnapshot();
+    SetExpect(isIdleCleared && idle && idle->version == swappedVersion,
+        "ClearPending after a committed full batch should keep current",
+        failureCount);
+
+    std::error_code error;
+    std::filesystem::remove(rawPath, error);
+}
+
+void StartTiffSeriesLoad(int& failureCount)
+{
+    // 目录序列按自然序并行解码：slice_10 须排在 slice_2 之后，每层按 LPS->RAS 翻转写入对应 Z 平面。
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto seriesDir =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_tiff_" + std::to_string(uniqueId));
+    std::error_code error;
+    std::filesystem::create_directories(seriesDir, error);
+    const std::array<int, 3> dims = { 7, 5, 3 };
+    const std::array<int, 3> fileIds = { 1, 2, 10 };
+    for (int z = 0; z < dims[2]; ++z) {
+        auto slice = vtkSmartPointer<vtkImageData>::New();
+        slice->SetDimensions(dims[0], dims[1], 1);
+        slice->AllocateScalars(VTK_UNSIGNED_SHORT, 1);
+        auto* values = static_cast<unsigned short*>(slice->GetScalarPointer());
+        for (int index = 0; index < dims[0] * dims[1]; ++index) {
+            values[index] = static_cast<unsigned short>(z * 1000 + index);
+        }
+        const auto slicePath = seriesDir
+            / ("slice_" + std::to_string(fileIds[static_cast<std::size_t>(z)]) + ".tif");
+        const std::string utf8Path = slicePath.u8string();
+        auto writer = vtkSmartPointer<vtkTIFFWriter>::New();
+        writer->SetInputData(slice);
+        writer->SetFileName(utf8Path.c_str());
+        writer->Write();
+    }
+
+    const auto layout = VolumeLayout::Create(
+        dims, { 1.0f, 1.0f, 2.0f }, { 0.0f, 0.0f, 0.0f });
+    TiffVolumeDataManager dataManager;
+    bool hasPending = false;
+    const bool isLoaded = layout
+        && dataManager.SetDataLoaded(seriesDir.u8string(), *layout)
+        && dataManager.SetCurrentFromPending(hasPending)
+        && hasPending;
+    const auto snapshot = isLoaded ? dataManager.GetImageSnapshot() : ImageSnapshot{};
+    const auto* loadedValues = snapshot && snapshot->image
+        && snapshot->image->GetScalarType() == VTK_UNSIGNED_SHORT
+        ? static_cast<const unsigned short*>(snapshot->image->GetScalarPointer())
+        : nullptr;
+    bool isFlipped = loadedValues != nullptr;
+    const int sliceSize = dims[0] * dims[1];
+    for (int z = 0; isFlipped && z < dims[2]; ++z) {
+        for (int index = 0; index < sliceSize; ++index) {
+            if (loadedValues[z * sliceSize + index]
+                != static_cast<unsigned short>(z * 1000 + sliceSize - 1 - index)) {
+                isFlipped = false;
+                break;
+            }
+        }
+    }
+    SetExpect(isFlipped
+            && snapshot->statistics
+            && snapshot->scalarRange[0] == 0.0
+            && snapshot->scalarRange[1] == 2000.0 + sliceSize - 1,
+        "TIFF series load should place flipped slices in natural order",
+        failureCount);
+
+    std::filesystem::remove_all(seriesDir, error);
+}
+
+void StartVolumeCache(int& failureCount)
+{
+    // 首次加载写入缓存；源内容改写但 mtime/字节数/layout 不变时第二次加载必须命中缓存而非重读源文件。
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto workDir =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_cache_" + std::to_string(uniqueId));
+    std::error_code error;
+    std::filesystem::create_directories(workDir, error);
+    const auto rawPath = workDir / "volume.raw";
+    const std::array<int, 3> dims = { 33, 17, 9 };
+    std::vector<float> source(
+        static_cast<std::size_t>(dims[0] * dims[1] * dims[2]));
+    const auto setSourceWritten = [&](float offset) {
+        for (std::size_t index = 0; index < source.size(); ++index) {
+            source[index] = static_cast<float>(index % 257U) + offset;
+        }
+        std::ofstream rawFile(rawPath, std::ios::binary | std::ios::trunc);
+        rawFile.write(
+            reinterpret_cast<const char*>(source.data()),
+            static_cast<std::streamsize>(source.size() * sizeof(float)));
+    };
+    setSourceWritten(0.0f);
+    const auto layout = VolumeLayout::Create(
+        dims, { 0.5f, 0.5f, 1.0f }, { 1.0f, 2.0f, 3.0f });
+    const auto cache = std::make_shared<const VolumeCache>(
+        (workDir / "cache").u8string());
+    const auto getSnapshot = [&]() {
+        RawVolumeDataManager dataManager;
+        dataManager.SetVolumeCache(cache);
+        bool hasPending = false;
+        const bool isLoaded = layout
+            && dataManager.SetDataLoaded(rawPath.u8string(), *layout)
+            && dataManager.SetCurrentFromPending(hasPending)
+            && hasPending;
+        return isLoaded ? dataManager.GetImageSnapshot() : ImageSnapshot{};
+    };
+
+    // 改写源文件前只保留比较所需的副本。
+    auto loaded = getSnapshot();
+    const auto* loadedScalars = loaded && loaded->image
+        ? static_cast<const float*>(loaded->image->GetScalarPointer())
+        : nullptr;
+    const std::vector<float> loadedValues = loadedScalars
+        ? std::vector<float>(loadedScalars, loadedScalars + source.size())
+        : std::vector<float>{};
+    ImageState loadedState = loaded ? *loaded : ImageState{};
+    loadedState.image = nullptr;
+    loaded.reset();
+    std::size_t cacheFileCount = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(workDir / "cache", error)) {
+        cacheFileCount += entry.is_regular_file() ? 1U : 0U;
+    }
+    const auto sourceTime = std::filesystem::last_write_time(rawPath, error);
+    setSourceWritten(1000.0f);
+    std::filesystem::last_write_time(rawPath, sourceTime, error);
+    auto cached = getSnapshot();
+    const auto* cachedValues = cached && cached->image
+        ? static_cast<const float*>(cached->image->GetScalarPointer())
+        : nullptr;
+    SetExpect(cacheFileCount == 1 && !loadedValues.empty() && cachedValues
+            && std::equal(loadedValues.begin(), loadedValues.end(), cachedValues)
+            && !cached->isPreview
+            && cached->origin == loadedState.origin
+            && cached->spacing == loadedState.spacing
+            && cached->scalarRange == loadedState.scalarRange
+            && cached->statistics && loadedState.statistics
+            && cached->statistics->checksum == loadedState.statistics->checksum
+            && cached->statistics->histogram == loadedState.statistics->histogram,
+        "volume cache hit should reproduce the first load",
+        failureCount);
+
+    // mtime 变化必须使键失效，回退到真实源文件。
+    std::filesystem::last_write_time(
+        rawPath, sourceTime + std::chrono::seconds(2), error);
+    auto reloaded = getSnapshot();
+    const auto* reloadedValues = reloaded && reloaded->image
+        ? static_cast<const float*>(reloaded->image->GetScalarPointer())
+        : nullptr;
+    SetExpect(reloadedValues && reloaded->scalarRange[0] == 1000.0,
+        "volume cache should miss once the source file changes",
+        failureCount);
+
+    cached.reset();
+    reloaded.reset();
+    std::filesystem::remove_all(workDir, error);
+}
+
+void StartSessionArchive(int& failureCount)
+{
+    // 三层 + 统计 + 裁切历史写入后按块读回；块取约两张切片，使 Z 区间读取跨越部分块。
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto workDir =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_session_" + std::to_string(uniqueId));
+    const auto archivePath = workDir / "session.mvvcs";
+    const std::array<int, 3> dims = { 37, 23, 11 };
+    const auto buildLayer = [&](int scalarType) {
+        auto image = vtkSmartPointer<vtkImageData>::New();
+        image->SetDimensions(dims[0], dims[1], dims[2]);
+        image->SetSpacing(0.5, 0.75, 1.25);
+        image->SetOrigin(-3.0, 2.0, 10.0);
+        image->AllocateScalars(scalarType, 1);
+        return image;
+    };
+    auto image = buildLayer(VTK_SHORT);
+    auto validityMask = buildLayer(VTK_UNSIGNED_CHAR);
+    auto labelImage = buildLayer(VTK_INT);
+    auto* imageScalars = static_cast<short*>(image->GetScalarPointer());
+    auto* maskScalars = static_cast<unsigned char*>(validityMask->GetScalarPointer());
+    auto* labelScalars = static_cast<int*>(labelImage->GetScalarPointer());
+    const std::size_t sliceVoxels = static_cast<std::size_t>(dims[0] * dims[1]);
+    const std::size_t voxelCount = sliceVoxels * static_cast<std::size_t>(dims[2]);
+    for (int z = 0; z < dims[2]; ++z) {
+        for (int y = 0; y < dims[1]; ++y) {
+            for (int x = 0; x < dims[0]; ++x) {
+                const std::size_t index =
+                    (static_cast<std::size_t>(z) * dims[1] + y) * dims[0] + x;
+                const bool isKept = x >= 4 && x < 30 && y >= 3 && y < 20 && z >= 1 && z < 9;
+                imageScalars[index] = static_cast<short>((x * 7 + y * 13 + z * 29) % 500 - 100);
+                maskScalars[index] = isKept ? 255 : 0;
+                labelScalars[index] = isKept ? (x < 15 ? 1 : (z < 5 ? 2 : 7)) : 0;
+            }
+        }
+    }
+
+    SessionSnapshot snapshot;
+    snapshot.state.image = image;
+    snapshot.state.validityMask = validityMask;
+    snapshot.state.dims = dims;
+    snapshot.state.spacing = { 0.5, 0.75, 1.25 };
+    snapshot.state.origin = { -3.0, 2.0, 10.0 };
+    snapshot.state.scalarRange = { -100.0, 399.0 };
+    auto statistics = std::make_shared<VolumeStatistics>();
+    statistics->scalarRange = snapshot.state.scalarRange;
+    statistics->histogram = { 3, 0, 5, 8 };
+    statistics->binWidth = 125.0;
+    statistics->checksum = 0x1234ULL;
+    statistics->hasChecksum = true;
+    snapshot.state.statistics = statistics;
+    snapshot.labelImage = labelImage;
+    SessionCropOp boxOperation;
+    boxOperation.operationIndex = 3;
+    boxOperation.geometryType = 1;
+    boxOperation.removalMode = 1;
+    boxOperation.boxToInputModelMatrix[3] = 4.5;
+    SessionCropOp planeOperation;
+    planeOperation.operationIndex = 4;
+    planeOperation.planeCenterInInputModel = { 1.0, 2.0, 3.0 };
+    planeOperation.planeNormalInInputModel = { 0.0, 1.0, 0.0 };
+    snapshot.cropOperations = { boxOperation, planeOperation };
+
+    const bool isSaved = SessionArchive::SetSession(
+        archivePath.u8string(), snapshot, sliceVoxels * sizeof(short) * 2);
+    SessionArchive archive;
+    const bool isLoaded = isSaved && archive.Load(archivePath.u8string());
+    const auto& operations = archive.GetCropOperations();
+    SetExpect(isLoaded
+            && archive.GetDimensions() == dims
+            && archive.GetSpacing() == snapshot.state.spacing
+            && archive.GetOrigin() == snapshot.state.origin
+            && archive.GetScalarRange() == snapshot.state.scalarRange
+            && archive.GetScalarType(SessionArchive::Layer::Image) == VTK_SHORT
+            && archive.GetScalarType(SessionArchive::Layer::Label) == VTK_INT
+            && operations.size() == 2
+            && operations[0].operationIndex == 3 && operations[0].removalMode == 1
+            && operations[0].boxToInputModelMatrix == boxOperation.boxToInputModelMatrix
+            && operations[1].planeCenterInInputModel == planeOperation.planeCenterInInputModel
+            && operations[1].planeNormalInInputModel == planeOperation.planeNormalInInputModel,
+        "session archive should reopen geometry and crop history without decoding layers",
+        failureCount);
+
+    // 只解压覆盖 [3, 7] 的块；首尾块部分重叠。
+    std::vector<unsigned char> maskSlices(sliceVoxels * 5);
+    std::vector<short> imageSlices(sliceVoxels * 3);
+    SetExpect(archive.GetSlices(SessionArchive::Layer::Mask, 3, 7, maskSlices.data())
+            && std::equal(maskSlices.begin(), maskSlices.end(), maskScalars + sliceVoxels * 3)
+            && archive.GetSlices(SessionArchive::Layer::Image, 8, 10, imageSlices.data())
+            && std::equal(imageSlices.begin(), imageSlices.end(), imageScalars + sliceVoxels * 8)
+            && !archive.GetSlices(SessionArchive::Layer::Mask, 9, 11, maskSlices.data()),
+        "session archive slab reads should match the source slices",
+        failureCount);
+
+    SessionSnapshot restored;
+    const bool isRestored = archive.GetSession(restored);
+    const auto getEqual = [&](vtkImageData* restoredImage, const void* source, std::size_t bytes) {
+        return restoredImage && restoredImage->GetScalarPointer()
+            && std::memcmp(restoredImage->GetScalarPointer(), source, bytes) == 0;
+    };
+    SetExpect(isRestored
+            && getEqual(restored.state.image, imageScalars, voxelCount * sizeof(short))
+            && getEqual(restored.state.validityMask, maskScalars, voxelCount)
+            && getEqual(restored.labelImage, labelScalars, voxelCount * sizeof(int))
+            && restored.state.dims == dims
+            && restored.state.statistics
+            && restored.state.statistics->histogram == statistics->histogram
+            && restored.state.statistics->checksum == statistics->checksum
+            && restored.cropOperations.size() == 2,
+        "session archive should restore every layer and the statistics",
+        failureCount);
+
+    // mask 与标签体由大片常量区组成，游程编码后合计应不到原始字节的一半。
+    std::error_code error;
+    const auto archiveBytes = std::filesystem::file_size(archivePath, error);
+    SetExpect(!error
+            && archiveBytes < voxelCount * sizeof(short) + voxelCount * (1 + sizeof(int)) / 2
+            && !std::filesystem::exists(workDir / "session.mvvcs.tmp"),
+        "session archive should run-length encode mask and label layers",
+        failureCount);
+
+    std::filesystem::resize_file(archivePath, archiveBytes - 5, error);
+    SessionArchive truncated;
+    SetExpect(!truncated.Load(archivePath.u8string())
+            && !truncated.HasLayer(SessionArchive::Layer::Image),
+        "a truncated session archive must be rejected",
+        failureCount);
+    std::filesystem::remove_all(workDir, error);
+}
+
+void StartSessionRoundTrip(int& failureCount)
+{
+    // ".mvs" 导出写出冻结批次的 image+mask、登记的标签体与裁切历史；另一个 DataManager 经 SetSessionLoaded 重开后须逐体素一致。
+    const auto uniqueId =
+        std::chrono::steady_clock::now()
+            .time_since_epoch().count();
+    const auto workDir =
+        std::filesystem::temp_directory_path()
+        / ("MVVCVTK_session_io_" + std::to_string(uniqueId));
+    std::error_code error;
+    std::filesystem::create_directories(workDir, error);
+    const auto rawPath = workDir / "volume.raw";
+    std::vector<std::uint16_t> source(5 * 4 * 3);
+    for (std::size_t index = 0; index < source.size(); ++index) {
+        source[index] = static_cast<std::uint16_t>((index * 29U) % 61U);
+    }
+    {
+        std::ofstream rawFile(rawPath, std::ios::binary);
+        rawFile.write(
+            reinterpret_cast<const char*>(source.data()),
+            static_cast<std::streamsize>(source.size() * sizeof(std::uint16_t)));
+    }
+    const auto layout = VolumeLayout::Create(
+        { 5, 4, 3 }, { 0.5f, 0.25f, 2.0f }, { 1.0f, 2.0f, 3.0f },
+        VolumeScalarType::UInt16);
+    RawVolumeDataManager writer;
+    bool hasPending = false;
+    const bool isLoaded = layout
+        && writer.SetDataLoaded(rawPath.u8string(), *layout)
+        && writer.SetCurrentFromPending(hasPending)
+        && hasPending;
+    const auto loaded = writer.GetImageSnapshot();
+    ImageSnapshot published;
+    SessionCropOp cropOperation;
+    cropOperation.operationIndex = 2;
+    cropOperation.geometryType = 1;
+    cropOperation.planeNormalInInputModel = { 0.0, 0.0, -1.0 };
+    auto labelImage = vtkSmartPointer<vtkImageData>::New();
+    if (isLoaded && loaded && loaded->image) {
+        auto mask = vtkSmartPointer<vtkImageData>::New();
+        mask->SetDimensions(loaded->image->GetDimensions());
+        mask->SetSpacing(loaded->image->GetSpacing());
+        mask->SetOrigin(loaded->image->GetOrigin());
+        mask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+        auto* maskValues = static_cast<unsigned char*>(mask->GetScalarPointer());
+        for (std::size_t index = 0; index < source.size(); ++index) {
+            maskValues[index] = index % 7U < 4U ? 255 : 0;
+        }
+        ImageState masked = *loaded;
+        masked.validityMask = mask;
+        masked.cropHistory = std::make_shared<const std::vector<SessionCropOp>>(
+            std::vector<SessionCropOp>{ cropOperation });
+        (void)writer.SetCurrentData(std::move(masked), loaded, published);
+
+        labelImage->SetDimensions(loaded->image->GetDimensions());
+        labelImage->AllocateScalars(VTK_INT, 1);
+        auto* labelValues = static_cast<int*>(labelImage->GetScalarPointer());
+        for (std::size_t index = 0; index < source.size(); ++index) {
+            labelValues[index] = maskValues[index] != 0 ? static_cast<int>(index % 3U) : 0;
+        }
+    }
+    // 标签体只能登记到 current 批次；旧 version 与几何不符的标签体一律拒绝。
+    auto wrongLabel = vtkSmartPointer<vtkImageData>::New();
+    wrongLabel->SetDimensions(5, 4, 2);
+    wrongLabel->AllocateScalars(VTK_INT, 1);
+    const bool isLabelled = published
+        && !writer.SetLabelImage(loaded->version, labelImage)
+        && !writer.SetLabelImage(published->version, wrongLabel)
+        && writer.SetLabelImage(published->version, labelImage)
+        && writer.GetLabelImage(published->version) == labelImage
+        && !writer.GetLabelImage(loaded->version);
+    SetExpect(isLabelled,
+        "a label image should register only against the current version",
+        failureCount);
+    DataExportParams params;
+    params.extension = ".MVS";
+    const bool isSaved = published
+        && writer.ExportData(published, workDir.u8string(), params);
+    const auto sessionPath = workDir / "5x4x3_session.mvs";
+
+    RawVolumeDataManager reader;
+    hasPending = false;
+    const bool isOpened = isSaved
+        && reader.SetSessionLoaded(sessionPath.u8string())
+        && reader.SetCurrentFromPending(hasPending)
+        && hasPending;
+    const auto reopened = reader.GetImageSnapshot();
+    const bool isComparable = isOpened && reopened && reopened->image
+        && reopened->validityMask && published && published->validityMask
+        && reopened->image->GetScalarType() == VTK_UNSIGNED_SHORT;
+    const auto* reopenedValues = isComparable
+        ? static_cast<const std::uint16_t*>(reopened->image->GetScalarPointer())
+        : nullptr;
+    const auto* publishedValues = isComparable
+        ? static_cast<const std::uint16_t*>(published->image->GetScalarPointer())
+        : nullptr;
+    const auto* reopenedMask = isComparable
+        ? static_cast<const unsigned char*>(reopened->validityMask->GetScalarPointer())
+        : nullptr;
+    const auto* publishedMask = isComparable
+        ? static_cast<const unsigned char*>(published->validityMask->GetScalarPointer())
+        : nullptr;
+    SetExpect(reopenedValues && publishedValues && reopenedMask && publishedMask
+            && std::equal(reopenedValues, reopenedValues + source.size(), publishedValues)
+            && std::equal(reopenedMask, reopenedMask + source.size(), publishedMask)
+            && !reopened->isPreview
+            && reopened->dims == published->dims
+            && reopened->spacing == published->spacing
+            && reopened->origin == published->origin
+            && reopened->scalarRange == published->scalarRange,
+        "a saved .mvs session should reopen with the same image and mask",
+        failureCount);
+
+    const auto reopenedLabel = isComparable
+        ? reader.GetLabelImage(reopened->version)
+        : nullptr;
+    SetExpect(reopenedLabel
+            && reopenedLabel->GetScalarType() == VTK_INT
+            && std::memcmp(reopenedLabel->GetScalarPointer(), labelImage->GetScalarPointer(),
+                source.size() * sizeof(int)) == 0
+            && reopened->cropHistory
+            && reopened->cropHistory->size() == 1
+            && reopened->cropHistory->front().operationIndex == cropOperation.operationIndex
+            && reopened->cropHistory->front().geometryType == cropOperation.geometryType
+            && reopened->cropHistory->front().planeNormalInInputModel
+                == cropOperation.planeNormalInInputModel,
+        "a saved .mvs session should restore the label image and crop history",
+        failureCount);
+
+    // 取消的保存不得触碰同名旧归档，也不留下临时文件。
+    const auto savedBytes = std::filesystem::file_size(sessionPath, error);
+    DataExportParams cancelledParams = params;
+    cancelledParams.control = std::make_shared<ExportControl>();
+    cancelledParams.control->SetCancelled();
+    const bool isCancelledSaved = published
+        && writer.ExportData(published, workDir.u8string(), cancelledParams);
+    SetExpect(!isCancelledSaved
+            && std::filesystem::file_size(sessionPath, error) == savedBytes
+            && !std::filesystem::exists(workDir / "5x4x3_session.mvs.tmp"),
+        "a cancelled session save must keep the existing archive",
+        failureCount);
+
+    const auto beforeVersion = reader.GetDataVersion();
+    SetExpect(!reader.SetSessionLoaded((workDir / "missing.mvs").u8string())
+            && !reader.SetSessionLoaded(rawPath.u8string())
+            && reader.GetDataVersion() == beforeVersion,
+        "opening a missing or foreign file as a session must fail",
+        failureCount);
+    std::filesystem::remove_all(workDir, error);
+}
+
+void StartVolumeReorder(int& failureCount)
+{
+    // 宽层跨越多个并行块与 SIMD 宽度；3/5 字节像素覆盖定长结构与运行时回退，结果须与逐像素镜像一致。
+    const std::array<std::size_t, 3> dims = { 1031, 129, 2 };
+    const std::size_t sliceSize = dims[0] * dims[1];
+    const std::size_t voxelCount = sliceSize * dims[2];
+    for (const std::size_t elementBytes : { 1, 2, 3, 4, 5, 8 }) {
+        std::vector<unsigned char> source(voxelCount * elementBytes);
+        for (std::size_t index = 0; index < source.size(); ++index) {
+            source[index] = static_cast<unsigned char>((index * 131U + 7U) & 0xFFU);
+        }
+        std::vector<unsigned char> expected(source.size());
+        for (std::size_t z = 0; z < dims[2]; ++z) {
+            for (std::size_t index = 0; index < sliceSize; ++index) {
+                std::copy_n(
+                    source.data() + (z * sliceSize + sliceSize - 1 - index) * elementBytes,
+                    elementBytes,
+                    expected.data() + (z * sliceSize + index) * elementBytes);
+            }
+        }
+
+        std::vector<unsigned char> copied(source.size());
+        SetExpect(VolumeReorder::SetRasScalars(
+                source.data(), copied.data(), dims, elementBytes)
+                && copied == expected,
+            "reorder copy should mirror every slice",
+            failureCount);
+        std::vector<unsigned char> inPlace = source;
+        SetExpect(VolumeReorder::SetRasScalarsInPlace(
+                inPlace.data(), dims, elementBytes)
+                && inPlace == expected,
+            "in-place reorder should match the copy kernel",
+            failureCount);
+    }
+
+    std::vector<float> target(4, -1.0f);
+    SetExpect(!VolumeReorder::SetRasScalars(
+            target.data(), target.data(), { 2, 2, 1 }, sizeof(float))
+            && !VolumeReorder::SetRasScalars(
+                nullptr, target.data(), { 2, 2, 1 }, sizeof(float))
+            && !VolumeReorder::SetRasScalarsInPlace(
+                target.data(), { 2, 0, 1 }, sizeof(float))
+            && target == std::vector<float>(4, -1.0f),
+        "invalid reorder requests must fail without writing",
+        failureCount);
+}
+
 void StartInputSwap(int& failureCount)
 {
     auto dataManager =
@@ -1216,8 +2518,22 @@ int AppTaskSuite::GetFailCount() const
     StartOwningTasks(failureCount);
     StartExportSnapshot(failureCount);
     StartExportFiles(failureCount);
+    StartRawSlabExport(failureCount);
+    StartPermutedRawExport(failureCount);
+    StartExportQueue(failureCount);
+    StartDecimatedMeshExport(failureCount);
     StartStateGate(failureCount);
     StartMaskSnapshot(failureCount);
+    StartSliceStackExport(failureCount);
+    StartRawMappedLoad(failureCount);
+    StartRawNativeLoad(failureCount);
+    StartVolumeReorder(failureCount);
+    StartRawStreamLoad(failureCount);
+    StartRawStreamPreview(failureCount);
+    StartTiffSeriesLoad(failureCount);
+    StartVolumeCache(failureCount);
+    StartSessionArchive(failureCount);
+    StartSessionRoundTrip(failureCount);
     StartRenderOwnerGate(failureCount);
     StartInputSwap(failureCount);
     StartVisualConfigGetters(failureCount);
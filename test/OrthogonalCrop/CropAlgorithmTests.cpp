@@ -13,6 +13,7 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <vector>
@@ -401,6 +402,17 @@ bool StartImageBuildCase()
             && mergedValues[1] == 255
             && mergedValues[2] == 0,
         "Repeated CPU crop should AND the new predicate with the baseline mask.") && isPassed;
+    isPassed = SetExpect(
+        result.maskDelta
+            && result.maskDelta->parentVersion == 7
+            && result.maskDelta->maskScalars
+                == result.maskImage->GetPointData()->GetScalars()
+            && result.maskDelta->removedRuns
+                == std::vector<ValidityMaskRun>{ { 0, 1 } }
+            && mergedResult.maskDelta
+            && mergedResult.maskDelta->removedRuns
+                == std::vector<ValidityMaskRun>{ { 0, 1 } },
+        "Image build should report only voxels flipped from kept to removed as the mask delta.") && isPassed;
 
     auto upperPlane = BuildPlane(2);
     upperPlane.planeCenterInInputModel = { 2.0, 0.0, 0.0 };
@@ -2,9 +2,12 @@
 
 #include "AppService.h"
 #include "DataConverters.h"
+#include "VolumeReorder.h"
 #include "Host/VtkAppHostSession.h"
 #include "Host/Types/HostRequestTypes.h"
+#include "ImageMaskOutsideFilter.h"
 #include "ImageProcessor.h"
+#include "ImagePyramid.h"
 #include "CompositeStrategy.h"
 #include "IsoSurfaceStrategy.h"
 #include "VolumeStrategy.h"
@@ -18,7 +21,6 @@
 #include <vtkFlyingEdges3D.h>
 #include <vtkGPUVolumeRayCastMapper.h>
 #include <vtkIdTypeArray.h>
-#include <vtkImageResample.h>
 #include <vtkImageReslice.h>
 #include <vtkInformation.h>
 #include <vtkPiecewiseFunction.h>
@@ -43,6 +45,7 @@
 #include <filesystem>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <random>
 #include <utility>
@@ -190,6 +193,265 @@ int GetHistogramFailCount()
                 == static_cast<vtkIdType>(largeCount),
         "Histogram count remains exact above 2^24") ? 0 : 1;
 
+    // 加载期统计与 accumulate 管线须给出逐 bin 一致的分位数；单行体翻转即整体倒序。
+    std::vector<float> lpsValues(4099);
+    for (std::size_t index = 0; index < lpsValues.size(); ++index) {
+        lpsValues[index] = static_cast<float>(
+            (index * 7919U) % 1013U) * 0.25f - 40.0f;
+    }
+    std::vector<float> rasValues(lpsValues.size());
+    VolumeStatistics statistics;
+    const bool hasStatistics = VolumeReorder::SetRasScalars(
+        lpsValues.data(), rasValues.data(),
+        { rasValues.size(), 1, 1 }, VTK_FLOAT, true, statistics);
+    HistogramConverter defaultConverter;
+    auto statisticImage = BuildFloatImage(rasValues);
+    bool isPercentileMatched = hasStatistics
+        && statistics.hasChecksum
+        && statistics.histogram.size()
+            == static_cast<std::size_t>(VolumeStatistics::kHistogramBinCount)
+        && std::accumulate(
+            statistics.histogram.begin(),
+            statistics.histogram.end(),
+            std::uint64_t{ 0 }) == rasValues.size()
+        && std::equal(rasValues.begin(), rasValues.end(), lpsValues.rbegin());
+    for (const double quantile : { 0.0, 0.02, 0.5, 0.98, 1.0 }) {
+        isPercentileMatched = isPercentileMatched
+            && HistogramConverter::GetHistogramPercentile(statistics, quantile)
+                == defaultConverter.GetHistogramPercentile(
+                    statisticImage, quantile);
+    }
+    failureCount += GetCaseResult(
+        isPercentileMatched
+            && !HistogramConverter::GetHistogramPercentile(
+                VolumeStatistics{}, 0.5),
+        "Load statistics percentile matches accumulate histogram") ? 0 : 1;
+
+    // 版本缓存统计：无 mask 时与 accumulate 管线逐 bin 一致；批量分位数与逐个查询相同；
+    // mask 只保留后半段时分位数随之右移，同版本重复查询命中缓存，换版本重新扫描。
+    const auto cachedStatistics = defaultConverter.GetStatistics(
+        statisticImage, nullptr, 7);
+    const std::vector<double> quantiles = { 0.98, 0.0, 0.5, 0.02, 1.0 };
+    const auto batch = cachedStatistics
+        ? HistogramConverter::GetHistogramPercentiles(*cachedStatistics, quantiles)
+        : std::nullopt;
+    bool isBatchMatched = batch && batch->size() == quantiles.size()
+        && defaultConverter.GetStatistics(statisticImage, nullptr, 7)
+            == cachedStatistics;
+    for (std::size_t index = 0; isBatchMatched && index < quantiles.size(); ++index) {
+        isBatchMatched = (*batch)[index]
+            == defaultConverter.GetHistogramPercentile(
+                statisticImage, quantiles[index]);
+    }
+    const auto cdf = cachedStatistics
+        ? HistogramConverter::BuildHistogramCdf(*cachedStatistics)
+        : std::vector<double>{};
+    failureCount += GetCaseResult(
+        isBatchMatched
+            && !cdf.empty() && cdf.back() == 1.0
+            && HistogramConverter::GetHistogramCdf(*cachedStatistics, -1000.0) == 0.0
+            && HistogramConverter::GetHistogramCdf(*cachedStatistics, 1000.0) == 1.0
+            && !HistogramConverter::GetHistogramPercentiles(
+                *cachedStatistics, { 0.5, 1.5 }),
+        "Cached statistics answer batch percentiles and CDF") ? 0 : 1;
+
+    auto rampImage = BuildFloatImage({ 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f });
+    auto rampMask = vtkSmartPointer<vtkImageData>::New();
+    rampMask->SetDimensions(8, 1, 1);
+    rampMask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto* rampMaskValues = static_cast<unsigned char*>(rampMask->GetScalarPointer());
+    std::fill_n(rampMaskValues, 4, static_cast<unsigned char>(0));
+    std::fill_n(rampMaskValues + 4, 4, static_cast<unsigned char>(255));
+    HistogramConverter maskConverter;
+    maskConverter.SetBinCount(8);
+    const auto maskedStatistics = maskConverter.GetStatistics(rampImage, rampMask, 3);
+    const auto maskedMedian = maskedStatistics
+        ? HistogramConverter::GetHistogramPercentile(*maskedStatistics, 0.5)
+        : std::nullopt;
+    const auto maskedCdf = maskedStatistics
+        ? HistogramConverter::GetHistogramCdf(*maskedStatistics, 3.5)
+        : std::nullopt;
+    const bool isMaskCached =
+        maskConverter.GetStatistics(rampImage, rampMask, 3) == maskedStatistics;
+    const auto nextStatistics = maskConverter.GetStatistics(rampImage, nullptr, 4);
+    failureCount += GetCaseResult(
+        maskedStatistics
+            && std::accumulate(
+                maskedStatistics->histogram.begin(),
+                maskedStatistics->histogram.end(),
+                std::uint64_t{ 0 }) == 4
+            && maskedMedian == 5.0
+            && maskedCdf == 0.0
+            && isMaskCached
+            && nextStatistics && nextStatistics != maskedStatistics
+            && HistogramConverter::GetHistogramPercentile(*nextStatistics, 0.5) == 3.0
+            && !maskConverter.GetStatistics(rampImage, constantImage, 5),
+        "Masked statistics count only valid voxels and cache per version") ? 0 : 1;
+
+    // mask 有效段跨 8 字节边界时按段累计的计数须与逐体素一致。
+    std::vector<float> runValues(29);
+    std::iota(runValues.begin(), runValues.end(), 0.0f);
+    auto runImage = BuildFloatImage(runValues);
+    auto runMask = vtkSmartPointer<vtkImageData>::New();
+    runMask->SetDimensions(29, 1, 1);
+    runMask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto* runMaskValues = static_cast<unsigned char*>(runMask->GetScalarPointer());
+    std::fill_n(runMaskValues, 29, static_cast<unsigned char>(0));
+    runMaskValues[0] = 255;
+    std::fill_n(runMaskValues + 7, 10, static_cast<unsigned char>(1));
+    runMaskValues[28] = 255;
+    HistogramConverter runConverter;
+    runConverter.SetBinCount(29);
+    const auto runStatistics = runConverter.GetStatistics(runImage, runMask, 0);
+    bool isRunMatched = runStatistics && runStatistics->histogram.size() == 29;
+    for (std::size_t index = 0; isRunMatched && index < 29; ++index) {
+        isRunMatched = runStatistics->histogram[index]
+            == (runMaskValues[index] != 0 ? 1U : 0U);
+    }
+    failureCount += GetCaseResult(isRunMatched,
+        "Masked statistics walk valid runs across word boundaries") ? 0 : 1;
+
+    // 重尾体：990 个 [0,10) 体素加 10 个 1000 的离群值。64 个线性 bin 把主体全部压进首 bin，
+    // Log 与 Adaptive 划分应让中位数落回主体内部，且计数总和不变。
+    std::vector<float> tailValues(1000, 1000.0f);
+    for (std::size_t index = 0; index < 990; ++index) {
+        tailValues[index] = static_cast<float>(index) * 0.01f;
+    }
+    auto tailImage = BuildFloatImage(tailValues);
+    const auto getTailMedian = [&tailImage](HistogramBinning binning,
+        std::size_t& binCount, bool& isCountKept) {
+        HistogramConverter tailConverter;
+        tailConverter.SetBinCount(64);
+        tailConverter.SetBinning(binning);
+        const auto tailStatistics = tailConverter.GetStatistics(tailImage, nullptr, 0);
+        binCount = tailStatistics ? tailStatistics->histogram.size() : 0;
+        isCountKept = tailStatistics
+            && std::accumulate(
+                tailStatistics->histogram.begin(),
+                tailStatistics->histogram.end(),
+                std::uint64_t{ 0 }) == 1000
+            && (binning == HistogramBinning::Linear
+                ? tailStatistics->binStarts.empty()
+                : tailStatistics->binStarts.size() == binCount
+                    && std::is_sorted(
+                        tailStatistics->binStarts.begin(),
+                        tailStatistics->binStarts.end()))
+            && HistogramConverter::GetHistogramCdf(*tailStatistics, 500.0) < 1.0;
+        return tailStatistics
+            ? HistogramConverter::GetHistogramPercentile(*tailStatistics, 0.5)
+            : std::nullopt;
+    };
+    std::size_t linearBins = 0;
+    std::size_t logBins = 0;
+    std::size_t adaptiveBins = 0;
+    bool isLinearKept = false;
+    bool isLogKept = false;
+    bool isAdaptiveKept = false;
+    const auto linearMedian = getTailMedian(
+        HistogramBinning::Linear, linearBins, isLinearKept);
+    const auto logMedian = getTailMedian(
+        HistogramBinning::Log, logBins, isLogKept);
+    const auto adaptiveMedian = getTailMedian(
+        HistogramBinning::Adaptive, adaptiveBins, isAdaptiveKept);
+    failureCount += GetCaseResult(
+        isLinearKept && isLogKept && isAdaptiveKept
+            && linearBins == 64 && logBins == 64
+            && adaptiveBins > 0 && adaptiveBins <= 64
+            && linearMedian == 0.0
+            && logMedian && *logMedian > 0.0 && *logMedian < 10.0
+            && adaptiveMedian && *adaptiveMedian > 0.0 && *adaptiveMedian < 10.0,
+        "Log and adaptive bins resolve heavy-tailed percentiles") ? 0 : 1;
+
+    // 裁切增量：子批共享 scalar、mask 只多裁掉 removedRuns 覆盖的体素时，由父批缓存扣减得到的统计须与整卷扫描逐 bin 相同；
+    // 增量与缓存父批不符或扣减出现负数时退回扫描，结果仍正确。
+    auto parentMask = vtkSmartPointer<vtkImageData>::New();
+    parentMask->SetDimensions(1000, 1, 1);
+    parentMask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto* parentMaskValues = static_cast<unsigned char*>(parentMask->GetScalarPointer());
+    auto childMask = vtkSmartPointer<vtkImageData>::New();
+    childMask->SetDimensions(1000, 1, 1);
+    childMask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto* childMaskValues = static_cast<unsigned char*>(childMask->GetScalarPointer());
+    auto maskDelta = std::make_shared<ValidityMaskDelta>();
+    maskDelta->parentVersion = 10;
+    maskDelta->maskScalars = childMask->GetPointData()->GetScalars();
+    for (std::size_t index = 0; index < 1000; ++index) {
+        parentMaskValues[index] = index % 5 == 0 ? 0 : 255;
+        const bool isRemoved = parentMaskValues[index] != 0 && (index % 3 == 0 || index > 995);
+        childMaskValues[index] = parentMaskValues[index] != 0 && !isRemoved ? 255 : 0;
+        if (!isRemoved) {
+            continue;
+        }
+        auto& runs = maskDelta->removedRuns;
+        if (!runs.empty() && runs.back().end == index) {
+            ++runs.back().end;
+        }
+        else {
+            runs.push_back({ index, index + 1 });
+        }
+    }
+    auto childImage = vtkSmartPointer<vtkImageData>::New();
+    childImage->ShallowCopy(tailImage);
+    ValidityMaskDelta staleDelta = *maskDelta;
+    staleDelta.parentVersion = 9;
+    ValidityMaskDelta badDelta = *maskDelta;
+    badDelta.removedRuns = { { 990, 1000 } };
+    const auto getDeltaMatched = [&](HistogramBinning binning) {
+        HistogramConverter scanConverter;
+        scanConverter.SetBinCount(64);
+        scanConverter.SetBinning(binning);
+        const auto scanned = scanConverter.GetStatistics(childImage, childMask, 0);
+        const auto getSame = [&scanned](const std::shared_ptr<const VolumeStatistics>& other) {
+            return scanned && other
+                && other->histogram == scanned->histogram
+                && other->binStarts == scanned->binStarts
+                && other->binWidth == scanned->binWidth
+                && other->scalarRange == scanned->scalarRange;
+        };
+        bool isMatched = true;
+        for (const ValidityMaskDelta* delta : { maskDelta.get(), &staleDelta, &badDelta }) {
+            HistogramConverter deltaConverter;
+            deltaConverter.SetBinCount(64);
+            deltaConverter.SetBinning(binning);
+            isMatched = isMatched
+                && deltaConverter.GetStatistics(tailImage, parentMask, 10)
+                && getSame(deltaConverter.GetStatistics(childImage, childMask, 11, delta));
+        }
+        return isMatched;
+    };
+    HistogramConverter seededConverter;
+    auto seededDelta = *maskDelta;
+    seededDelta.parentVersion = 7;
+    seededDelta.removedRuns = { { 3, 4 }, { 4000, 4001 } };
+    auto seededMask = vtkSmartPointer<vtkImageData>::New();
+    seededMask->SetDimensions(static_cast<int>(rasValues.size()), 1, 1);
+    seededMask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto* seededMaskValues = static_cast<unsigned char*>(seededMask->GetScalarPointer());
+    std::fill_n(seededMaskValues, rasValues.size(), static_cast<unsigned char>(255));
+    seededMaskValues[3] = 0;
+    seededMaskValues[4000] = 0;
+    seededDelta.maskScalars = seededMask->GetPointData()->GetScalars();
+    const bool isSeeded = seededConverter.SetCachedStatistics(
+        statisticImage, 7, std::make_shared<const VolumeStatistics>(statistics));
+    const auto seededStatistics = seededConverter.GetStatistics(
+        statisticImage, seededMask, 8, &seededDelta);
+    HistogramConverter logSeedConverter;
+    logSeedConverter.SetBinning(HistogramBinning::Log);
+    failureCount += GetCaseResult(
+        getDeltaMatched(HistogramBinning::Linear)
+            && getDeltaMatched(HistogramBinning::Log)
+            && getDeltaMatched(HistogramBinning::Adaptive)
+            && isSeeded
+            && seededStatistics
+            && seededStatistics->hasChecksum
+            && std::accumulate(
+                seededStatistics->histogram.begin(),
+                seededStatistics->histogram.end(),
+                std::uint64_t{ 0 }) == rasValues.size() - 2
+            && !logSeedConverter.SetCachedStatistics(
+                statisticImage, 7, std::make_shared<const VolumeStatistics>(statistics)),
+        "Crop mask delta updates cached statistics without rescanning") ? 0 : 1;
+
     const auto tempDir = std::filesystem::temp_directory_path();
     const std::string fileId = std::to_string(
         reinterpret_cast<std::uintptr_t>(image.GetPointer()));
@@ -257,8 +519,8 @@ int GetResampleFailCount()
             && customDims[0] == 256
             && customDims[1] == 128
             && customDims[2] == 64
-            && quality->GetInterpolationMode()
-                == VTK_RESLICE_LINEAR
+            && quality->GetMode()
+                == ImageDownsampleFilter::Mode::Average
             && qualityOrigin[0] == 4.0
             && std::abs(
                 qualitySpacing[0]
@@ -274,7 +536,7 @@ int GetResampleFailCount()
             << qualityDims[2] << " custom="
             << customDims[0] << 'x' << customDims[1]
             << 'x' << customDims[2] << " mode="
-            << (quality ? quality->GetInterpolationMode() : -1)
+            << (quality ? static_cast<int>(quality->GetMode()) : -1)
             << " origin="
             << qualityOrigin[0]
             << '\n';
@@ -285,9 +547,9 @@ int GetResampleFailCount()
 
     auto mask = ImageProcessor::GetDownsampledMask(image, 256);
     failureCount += GetCaseResult(
-        mask && mask->GetInterpolationMode()
-            == VTK_RESLICE_NEAREST,
-        "Validity mask uses nearest interpolation") ? 0 : 1;
+        mask && mask->GetMode()
+            == ImageDownsampleFilter::Mode::Max,
+        "Validity mask uses max pooling") ? 0 : 1;
     failureCount += GetCaseResult(
         !ImageProcessor::GetDownsampledImage(image, 0)
             && !ImageProcessor::GetDownsampledImage(nullptr, 256),
@@ -308,6 +570,109 @@ int GetResampleFailCount()
             && smallExtent[3] - smallExtent[2] + 1 == 64
             && smallExtent[5] - smallExtent[4] + 1 == 32,
         "Resample does not enlarge input below target") ? 0 : 1;
+    smallResample->Update();
+    failureCount += GetCaseResult(
+        smallResample->GetOutput()->GetScalarPointer()
+            == smallImage->GetScalarPointer(),
+        "Resample below target shares input scalars") ? 0 : 1;
+
+    // 2× 缩小：三角核在内部保持线性斜坡，max 池化保留单体素宽的有效线。
+    auto ramp = vtkSmartPointer<vtkImageData>::New();
+    ramp->SetDimensions(16, 8, 8);
+    ramp->AllocateScalars(VTK_FLOAT, 1);
+    auto thinMask = vtkSmartPointer<vtkImageData>::New();
+    thinMask->SetDimensions(16, 8, 8);
+    thinMask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto* rampValues = static_cast<float*>(ramp->GetScalarPointer());
+    auto* maskValues =
+        static_cast<unsigned char*>(thinMask->GetScalarPointer());
+    for (int z = 0; z < 8; ++z) {
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < 16; ++x) {
+                const int index = (z * 8 + y) * 16 + x;
+                rampValues[index] = static_cast<float>(
+                    x + 10 * y + 100 * z);
+                maskValues[index] = x == 1 ? 255 : 0;
+            }
+        }
+    }
+    auto rampHalf = ImageProcessor::GetDownsampledImage(ramp, 8);
+    auto maskHalf = ImageProcessor::GetDownsampledMask(thinMask, 8);
+    if (rampHalf) rampHalf->Update();
+    if (maskHalf) maskHalf->Update();
+    auto* rampOutput = rampHalf ? rampHalf->GetOutput() : nullptr;
+    auto* maskOutput = maskHalf ? maskHalf->GetOutput() : nullptr;
+    int rampDims[3] = { 0, 0, 0 };
+    if (rampOutput) rampOutput->GetDimensions(rampDims);
+    const float rampInterior = rampOutput && rampDims[0] == 8
+        ? *static_cast<float*>(rampOutput->GetScalarPointer(3, 1, 1))
+        : -1.0f;
+    int validCount = 0;
+    if (maskOutput && maskOutput->GetScalarType() == VTK_UNSIGNED_CHAR) {
+        const auto* values =
+            static_cast<unsigned char*>(maskOutput->GetScalarPointer());
+        const vtkIdType count = maskOutput->GetNumberOfPoints();
+        for (vtkIdType index = 0; index < count; ++index) {
+            validCount += values[index] == 255 ? 1 : 0;
+        }
+    }
+    failureCount += GetCaseResult(
+        rampDims[0] == 8 && rampDims[1] == 4 && rampDims[2] == 4
+            && std::abs(rampInterior - 226.0f) < 1e-3f
+            && rampOutput->GetSpacing()[0] == 2.0,
+        "Integer downsample averages around each output sample") ? 0 : 1;
+    failureCount += GetCaseResult(
+        validCount >= 16,
+        "Mask downsample keeps a one-voxel valid line") ? 0 : 1;
+    return failureCount;
+}
+
+int GetPyramidFailCount()
+{
+    int failureCount = 0;
+    auto image = vtkSmartPointer<vtkImageData>::New();
+    image->SetDimensions(200, 100, 50);
+    image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto pyramid = std::make_shared<ImagePyramid>();
+    const auto first = pyramid->GetLevel(image, 64);
+    const auto second = pyramid->GetLevel(image, 64);
+    int levelDims[3] = { 0, 0, 0 };
+    if (first) first->GetDimensions(levelDims);
+    failureCount += GetCaseResult(
+        first && first == second
+            && pyramid->GetBuildCount() == 1
+            && std::max({ levelDims[0], levelDims[1], levelDims[2] }) == 64
+            && first->GetScalarPointer() != image->GetScalarPointer(),
+        "Pyramid builds one shared level per image and target") ? 0 : 1;
+
+    const bool isBatchBuilt =
+        pyramid->SetLevels(image, { 64, 32, 16 })
+        && pyramid->GetLevel(image, 64, PyramidLevelKind::Mask);
+    failureCount += GetCaseResult(
+        isBatchBuilt
+            && pyramid->GetBuildCount() == 4
+            && pyramid->GetLevelCount() == 4
+            && ImagePyramid::GetLevelDim(image, 2) == 50,
+        "Pyramid batch only builds missing levels and keys mask separately") ? 0 : 1;
+
+    // 两个 3D 策略共享同一金字塔时，同一输入的 766 显示层只计算一次。
+    IsoSurfaceStrategy firstIso;
+    IsoSurfaceStrategy secondIso;
+    firstIso.SetImagePyramid(pyramid);
+    secondIso.SetImagePyramid(pyramid);
+    firstIso.SetInputData(image);
+    secondIso.SetInputData(image);
+    failureCount += GetCaseResult(
+        pyramid->GetBuildCount() == 5
+            && pyramid->GetLevelCount() == 5,
+        "Pyramid shares the display level across strategies") ? 0 : 1;
+
+    image->Modified();
+    const auto rebuilt = pyramid->GetLevel(image, 64);
+    failureCount += GetCaseResult(
+        rebuilt && rebuilt != first
+            && pyramid->GetLevelCount() == 1,
+        "Pyramid drops levels of a modified source") ? 0 : 1;
     return failureCount;
 }
 
@@ -810,11 +1175,16 @@ int GetRenderContractFailCount()
         ? vtkFlyingEdges3D::SafeDownCast(
             isoInput->GetProducer())
         : nullptr;
-    auto* isoResample = isoFilter
+    auto* isoMaskFilter = isoFilter
         && isoFilter->GetInputConnection(0, 0)
-        ? vtkImageResample::SafeDownCast(
+        ? ImageMaskOutsideFilter::SafeDownCast(
             isoFilter->GetInputConnection(0, 0)->GetProducer())
         : nullptr;
+    auto* isoResample = isoMaskFilter
+        && isoMaskFilter->GetInputConnection(0, 0)
+        ? ImageDownsampleFilter::SafeDownCast(
+            isoMaskFilter->GetInputConnection(0, 0)->GetProducer())
+        : nullptr;
     if (isoResample) {
         isoResample->Update();
     }
@@ -829,10 +1199,43 @@ int GetRenderContractFailCount()
                 isoDimensions[1],
                 isoDimensions[2] }) == 766
             && isoFilter
+            && !isoMaskFilter->GetMask()
             && isoMapper->GetInputConnection(0, 0)
                 == isoInput.GetPointer(),
         "Iso uses one fixed Quality 766 producer") ? 0 : 1;
 
+    // 全有效 mask 直接共享输入 scalar；挖掉一个体素后才复制，且无符号类型 min 为 0 时外侧值夹为 0。
+    auto maskInput = vtkSmartPointer<vtkImageData>::New();
+    maskInput->SetDimensions(4, 3, 2);
+    maskInput->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto* maskInputValues =
+        static_cast<unsigned char*>(maskInput->GetScalarPointer());
+    for (int index = 0; index < 24; ++index) {
+        maskInputValues[index] = static_cast<unsigned char>(index * 10);
+    }
+    auto fullMask = vtkSmartPointer<vtkImageData>::New();
+    fullMask->SetDimensions(4, 3, 2);
+    fullMask->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    auto* fullMaskValues =
+        static_cast<unsigned char*>(fullMask->GetScalarPointer());
+    std::fill(fullMaskValues, fullMaskValues + 24, static_cast<unsigned char>(255));
+    auto outsideFilter = vtkSmartPointer<ImageMaskOutsideFilter>::New();
+    outsideFilter->SetInputData(maskInput);
+    const bool isFullMaskSet = outsideFilter->SetMask(fullMask);
+    outsideFilter->Update();
+    const bool isFullShared = isFullMaskSet
+        && outsideFilter->GetOutput()->GetScalarPointer() == maskInputValues;
+    fullMaskValues[5] = 0;
+    fullMask->Modified();
+    outsideFilter->Update();
+    const auto* maskedValues = static_cast<const unsigned char*>(
+        outsideFilter->GetOutput()->GetScalarPointer());
+    failureCount += GetCaseResult(
+        isFullShared
+            && maskedValues && maskedValues != maskInputValues
+            && maskedValues[5] == 0 && maskedValues[6] == 60,
+        "Mask outside filter shares fully valid input and copies only on holes") ? 0 : 1;
+
     auto polyData = vtkSmartPointer<vtkPolyData>::New();
     auto points = vtkSmartPointer<vtkPoints>::New();
     points->InsertNextPoint(0.0, 0.0, 0.0);
@@ -1779,5 +2182,6 @@ int GetViewFailCount()
     return failureCount
         + GetHistogramFailCount()
         + GetResampleFailCount()
+        + GetPyramidFailCount()
         + GetRenderContractFailCount();
 }